@@ -0,0 +1,33 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <pthread.h>
+#include <sched.h>
+
+int
+main(void)
+{
+
+  cpu_set_t mask;
+
+  CPU_ZERO(&mask);
+  CPU_SET(0, &mask);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mask);
+
+  return 0;
+}
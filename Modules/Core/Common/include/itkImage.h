@@ -185,7 +185,20 @@ public:
 
 
   /** Allocate the image memory. The size of the image must
-   * already be set, e.g. by calling SetRegions(). */
+   * already be set, e.g. by calling SetRegions().
+   *
+   * When MultiThreaderBase::GetGlobalNUMAAware() is true, a new buffer of
+   * at least one megabyte of trivial pixels is first written in parallel,
+   * with the same partition of the buffered region as
+   * MultiThreaderBase::ParallelizeImageRegion(), so that its pages are
+   * placed on the NUMA nodes of the work units which will process them.
+   * The buffer is split by
+   * MultiThreaderBase::GetCurrentThreadDefaultMultiThreader(), i.e. with the
+   * global default threader, number of threads and splitter, because the
+   * filters which will use it are not known when it is allocated. The
+   * pages of a filter which is set up otherwise, e.g. with its own
+   * SetNumberOfWorkUnits(), MultiThreader or ImageRegionSplitter, are not
+   * placed on the nodes of its work units. */
   void
   Allocate(bool initializePixels = false) override;
 
@@ -401,6 +414,11 @@ protected:
   using Superclass::Graft;
 
 private:
+  /** Write the newly reserved buffer in parallel, with zeros when
+   * initializePixels is true, otherwise only one byte per memory page. */
+  void
+  FirstTouchBuffer(bool initializePixels);
+
   /** Memory for the current buffer. */
   PixelContainerPointer m_Buffer{ PixelContainer::New() };
 };
@@ -29,6 +29,7 @@
 #define itkImage_hxx
 
 #include "itkProcessObject.h"
+#include "itkMultiThreaderBase.h"
 #include <algorithm>
 
 namespace itk
@@ -41,10 +42,82 @@ Image<TPixel, VImageDimension>::Allocate(bool initializePixels)
   this->ComputeOffsetTable();
   SizeValueType num = static_cast<SizeValueType>(this->GetOffsetTable()[VImageDimension]);
 
+  if constexpr (std::is_trivially_default_constructible_v<TPixel> && std::is_trivially_destructible_v<TPixel>)
+  {
+    // Smaller buffers are not worth dispatching work units.
+    constexpr SizeValueType minimumNUMABytes = SizeValueType{ 1 } << 20;
+
+    // A job of a thread pool, like a mini pipeline run by a work unit,
+    // already writes its buffers on its own node, and waiting for other jobs
+    // from within a job could exhaust the pool.
+    if (m_Buffer->GetImportPointer() == nullptr && num * sizeof(TPixel) >= minimumNUMABytes &&
+        MultiThreaderBase::GetGlobalNUMAAware() && !MultiThreaderBase::GetCurrentThreadIsWorker())
+    {
+      // The operating system places each page on the node of the thread which
+      // writes it first, so the new buffer is written by the work units of the
+      // filters which will use it.
+      m_Buffer->Reserve(num, false);
+      this->FirstTouchBuffer(initializePixels);
+      return;
+    }
+  }
   m_Buffer->Reserve(num, initializePixels);
 }
 
 
+template <typename TPixel, unsigned int VImageDimension>
+void
+Image<TPixel, VImageDimension>::FirstTouchBuffer(bool initializePixels)
+{
+  // A page is at least that large, so writing one byte every pageSize bytes
+  // touches all the pages.
+  constexpr SizeValueType pageSize = 4096;
+
+  // The buffer is split like the one of a filter which keeps the global
+  // defaults, because the filters which will use it are not known here.
+  MultiThreaderBase * const multiThreader = MultiThreaderBase::GetCurrentThreadDefaultMultiThreader();
+  multiThreader->template ParallelizeImageRegion<VImageDimension>(
+    this->GetBufferedRegion(),
+    [this, initializePixels](const RegionType & region) {
+      const SizeValueType lineLength = region.GetSize(0);
+      if (lineLength == 0)
+      {
+        return;
+      }
+      const SizeValueType numberOfLines = region.GetNumberOfPixels() / lineLength;
+      IndexType           index = region.GetIndex();
+      for (SizeValueType line = 0; line < numberOfLines; ++line)
+      {
+        TPixel * const lineBegin = this->GetBufferPointer() + this->ComputeOffset(index);
+        if (initializePixels)
+        {
+          std::fill_n(lineBegin, lineLength, TPixel{});
+        }
+        else
+        {
+          auto * const        bytes = reinterpret_cast<volatile char *>(lineBegin);
+          const SizeValueType numberOfBytes = lineLength * sizeof(TPixel);
+          for (SizeValueType byte = 0; byte < numberOfBytes; byte += pageSize)
+          {
+            bytes[byte] = 0;
+          }
+          bytes[numberOfBytes - 1] = 0;
+        }
+
+        for (unsigned int d = 1; d < VImageDimension; ++d)
+        {
+          if (++index[d] < region.GetIndex(d) + static_cast<IndexValueType>(region.GetSize(d)))
+          {
+            break;
+          }
+          index[d] = region.GetIndex(d);
+        }
+      }
+    },
+    nullptr);
+}
+
+
 template <typename TPixel, unsigned int VImageDimension>
 void
 Image<TPixel, VImageDimension>::Initialize()
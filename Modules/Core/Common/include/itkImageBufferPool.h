@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferPool_h
+#define itkImageBufferPool_h
+
+#include "itkObject.h"
+#include "itkIntTypes.h"
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+
+struct ImageBufferPoolGlobals;
+
+/** \class ImageBufferPool
+ * \brief Recycle the buffers of the images instead of returning them to the
+ * system.
+ *
+ * The pool is a process wide singleton, like OutputWindow, and is disabled
+ * by default. Once enabled with ImageBufferPool::SetEnabled(true), the
+ * buffers allocated by ImportImageContainer, and so by Image::Allocate(), are
+ * acquired from the pool, and are given back to it when the image releases
+ * its data, for example when the ReleaseDataFlag of a filter output is on.
+ * A pipeline run over many images of the same size then reuses the same
+ * buffers, which avoids the cost of allocating and page faulting fresh
+ * memory for each output. A recycled buffer is not zero-initialized when the
+ * image is allocated with Allocate(false), so it holds the values of its
+ * previous use until it is written.
+ *
+ * The buffers are grouped in buckets of sizes spaced by at most 1/8 of their
+ * power of two, so a request reuses an idle buffer of the same bucket and
+ * wastes at most 12.5% of its size. The idle buffers are kept up to
+ * MaximumPooledBytes; a buffer released beyond this cap is returned to the
+ * system. Only the pixel types which need no destructor are pooled.
+ *
+ * The pooled buffers are allocated with an aligned operator new, so they
+ * must not be freed with delete[]. An ImportImageContainer whose memory
+ * management is turned off with ContainerManageMemoryOff() therefore gives
+ * its pooled buffer back to the pool, and hands over a copy of it allocated
+ * with new[] instead.
+ *
+ * All the methods are thread safe.
+ *
+ * \code
+ * itk::ImageBufferPool::SetEnabled(true);
+ * itk::ImageBufferPool::GetInstance()->SetMaximumPooledBytes(4ull << 30);
+ * \endcode
+ *
+ * \sa ImportImageContainer
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferPool : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferPool);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferPool;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageBufferPool);
+
+  /** This is a singleton pattern New. There will only be ONE
+   * reference to a ImageBufferPool object per process. */
+  static Pointer
+  New();
+
+  /** Return the singleton instance with no reference counting. */
+  static Pointer
+  GetInstance();
+
+  /** Supply a user defined pool. The pool must not be replaced while
+   * buffers acquired from the previous one are in use. */
+  static void
+  SetInstance(ImageBufferPool * instance);
+
+  /** Enable or disable the acquisition of the image buffers from the pool.
+   * Disabled by default. Disabling the pool frees its idle buffers; the
+   * buffers in use are freed when they are released. */
+  /** @ITKStartGrouping */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+  /** @ITKEndGrouping */
+
+  /** Whether some buffers acquired from the pool have not been released. */
+  static bool
+  HasAcquiredBuffers();
+
+  /** The alignment of the buffers, in bytes. */
+  static constexpr SizeValueType Alignment = 64;
+
+  /** Return the size of the bucket of buffers used for a request of the
+   * given number of bytes. */
+  static SizeValueType
+  GetBucketSize(SizeValueType numberOfBytes);
+
+  /** Return a buffer of at least numberOfBytes bytes, reusing an idle buffer
+   * of the same bucket when there is one. Return nullptr when the memory
+   * cannot be allocated. */
+  void *
+  Acquire(SizeValueType numberOfBytes);
+
+  /** Give back a buffer returned by Acquire(). Return false, and do
+   * nothing, when the buffer was not acquired from this pool. */
+  bool
+  Release(void * buffer);
+
+  /** Whether the buffer was acquired from this pool and not released. */
+  bool
+  IsAcquired(const void * buffer) const;
+
+  /** Free the idle buffers. */
+  void
+  Clear();
+
+  /** Set/Get the maximum number of bytes of the idle buffers kept by the
+   * pool. The default is 1 GiB. Lowering the cap frees idle buffers. */
+  /** @ITKStartGrouping */
+  void
+  SetMaximumPooledBytes(SizeValueType maximumPooledBytes);
+  SizeValueType
+  GetMaximumPooledBytes() const;
+  /** @ITKEndGrouping */
+
+  /** Statistics of the pool: the number of acquisitions served by an idle
+   * buffer (hits) or by a new allocation (misses), the number of released
+   * buffers freed because of the cap, and the bytes of the idle buffers and
+   * of the buffers in use. */
+  /** @ITKStartGrouping */
+  SizeValueType
+  GetNumberOfHits() const;
+  SizeValueType
+  GetNumberOfMisses() const;
+  SizeValueType
+  GetNumberOfDiscardedBuffers() const;
+  SizeValueType
+  GetPooledBytes() const;
+  SizeValueType
+  GetAcquiredBytes() const;
+  /** @ITKEndGrouping */
+
+  /** Reset the counts of hits, misses and discarded buffers. */
+  void
+  ResetStatistics();
+
+protected:
+  ImageBufferPool();
+  ~ImageBufferPool() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferPoolGlobals, PimplGlobals);
+
+  /** Free idle buffers until their size is at most maximumPooledBytes.
+   * Called with m_Mutex locked. */
+  void
+  Trim(SizeValueType maximumPooledBytes);
+
+  mutable std::mutex                           m_Mutex{};
+  std::map<SizeValueType, std::vector<void *>> m_IdleBuffers{};
+  std::unordered_map<void *, SizeValueType>    m_AcquiredBuffers{};
+  SizeValueType                                m_MaximumPooledBytes{ SizeValueType{ 1 } << 30 };
+  SizeValueType                                m_PooledBytes{ 0 };
+  SizeValueType                                m_AcquiredBytes{ 0 };
+  SizeValueType                                m_NumberOfHits{ 0 };
+  SizeValueType                                m_NumberOfMisses{ 0 };
+  SizeValueType                                m_NumberOfDiscardedBuffers{ 0 };
+
+  static ImageBufferPoolGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegionSplitterCacheTiles_h
+#define itkImageRegionSplitterCacheTiles_h
+
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImageRegion.h"
+
+namespace itk
+{
+
+/** \class ImageRegionSplitterCacheTiles
+ * \brief Divide an image region into tiles whose working set fits in cache
+ *
+ * ImageRegionSplitterCacheTiles divides a region into many tiles, which are
+ * small enough that the pixels read and written to process a tile,
+ * including a margin of Radius pixels on each side for the neighborhood
+ * filters, fit in CacheSize bytes. The tiles keep whole lines along the
+ * first dimension as long as possible, and are otherwise made about as
+ * large along each of the remaining dimensions, so that the margin is a
+ * small part of the tile.
+ *
+ * When it is the splitter of an ImageSource with dynamic multi-threading,
+ * either set with ImageSource::SetImageRegionSplitter() or as the global
+ * default splitter of ImageSourceCommon, the tiles of the output requested
+ * region are handed out one at a time to the work units as they finish the
+ * previous ones. The margin is then ImageSource::GetTileHaloRadius(), the
+ * neighborhood radius of the filter, and the tiles are processed in memory
+ * order. When the region has fewer tiles
+ * than work units, it is split as usual instead.
+ *
+ * Through the ImageRegionSplitterBase interface, the region is split in its
+ * tiles, computed with no margin, when there are no more tiles than the
+ * requested number of pieces, but more than the slabs of
+ * ImageRegionSplitterSlowDimension. Otherwise it is split in these slabs,
+ * so this splitter can also be used where the number of pieces is bounded,
+ * e.g. by the number of work units, and small regions are not left in a
+ * single piece.
+ *
+ * \sa ImageRegionSplitterSlowDimension
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataProcessing
+ * \ingroup ITKCommon
+ */
+
+class ITKCommon_EXPORT ImageRegionSplitterCacheTiles : public ImageRegionSplitterSlowDimension
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegionSplitterCacheTiles);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegionSplitterCacheTiles;
+  using Superclass = ImageRegionSplitterSlowDimension;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageRegionSplitterCacheTiles);
+
+  /** Set/Get the number of bytes of cache in which the working set of a
+   * tile should fit, typically the size of the L2 cache of a core. The
+   * default is 512 KiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(CacheSize, SizeValueType);
+  itkGetConstMacro(CacheSize, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the number of bytes read and written per pixel of a tile,
+   * summed over the input and output images. The default is 8, e.g. one
+   * float input and one float output image. */
+  /** @ITKStartGrouping */
+  itkSetMacro(BytesPerPixel, SizeValueType);
+  itkGetConstMacro(BytesPerPixel, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Get the size of the tiles of region, for a margin of radius pixels
+   * around each tile. A tile is not made smaller than MinimumTileSize, or
+   * twice the radius, along a dimension, so its working set may exceed the
+   * cache size for large radii. */
+  template <unsigned int VImageDimension>
+  Size<VImageDimension>
+  GetTileSize(const ImageRegion<VImageDimension> & region, const Size<VImageDimension> & radius) const
+  {
+    Size<VImageDimension> tileSize;
+    this->ComputeTileSize(
+      VImageDimension, region.GetSize().m_InternalArray, radius.m_InternalArray, tileSize.m_InternalArray);
+    return tileSize;
+  }
+
+  /** Get the number of tiles of size tileSize in region. */
+  template <unsigned int VImageDimension>
+  static SizeValueType
+  GetNumberOfTiles(const ImageRegion<VImageDimension> & region, const Size<VImageDimension> & tileSize)
+  {
+    return ComputeNumberOfTiles(VImageDimension, region.GetSize().m_InternalArray, tileSize.m_InternalArray);
+  }
+
+  /** Get the tile tileNumber of size tileSize in region. The tiles are
+   * numbered along the first dimension first, i.e. in memory order. */
+  template <unsigned int VImageDimension>
+  static ImageRegion<VImageDimension>
+  GetTile(SizeValueType tileNumber, const ImageRegion<VImageDimension> & region, const Size<VImageDimension> & tileSize)
+  {
+    ImageRegion<VImageDimension> tile = region;
+    ComputeTile(VImageDimension,
+                tileNumber,
+                tileSize.m_InternalArray,
+                tile.GetModifiableIndex().m_InternalArray,
+                tile.GetModifiableSize().m_InternalArray);
+    return tile;
+  }
+
+  /** The size under which a tile is not divided along a dimension. */
+  static constexpr SizeValueType MinimumTileSize = 8;
+
+protected:
+  ImageRegionSplitterCacheTiles() = default;
+  ~ImageRegionSplitterCacheTiles() override = default;
+
+  /** Templateless implementation of GetTileSize(). */
+  void
+  ComputeTileSize(unsigned int        dim,
+                  const SizeValueType regionSize[],
+                  const SizeValueType radius[],
+                  SizeValueType       tileSize[]) const;
+
+  /** Templateless implementation of GetNumberOfTiles(). */
+  static SizeValueType
+  ComputeNumberOfTiles(unsigned int dim, const SizeValueType regionSize[], const SizeValueType tileSize[]);
+
+  /** Templateless implementation of GetTile(), which replaces the region
+   * with its tile. */
+  static void
+  ComputeTile(unsigned int        dim,
+              SizeValueType       tileNumber,
+              const SizeValueType tileSize[],
+              IndexValueType      regionIndex[],
+              SizeValueType       regionSize[]);
+
+  unsigned int
+  GetNumberOfSplitsInternal(unsigned int         dim,
+                            const IndexValueType regionIndex[],
+                            const SizeValueType  regionSize[],
+                            unsigned int         requestedNumber) const override;
+
+  unsigned int
+  GetSplitInternal(unsigned int   dim,
+                   unsigned int   i,
+                   unsigned int   numberOfPieces,
+                   IndexValueType regionIndex[],
+                   SizeValueType  regionSize[]) const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  SizeValueType m_CacheSize{ 512 * 1024 };
+  SizeValueType m_BytesPerPixel{ 8 };
+};
+} // end namespace itk
+
+#endif
@@ -31,6 +31,7 @@
 #include "itkProcessObject.h"
 #include "itkImage.h"
 #include "itkImageRegionSplitterBase.h"
+#include "itkImageRegionSplitterCacheTiles.h"
 #include "itkImageSourceCommon.h"
 
 namespace itk
@@ -228,6 +229,15 @@ public:
   ProcessObject::DataObjectPointer
   MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
   /** @ITKEndGrouping */
+
+  /** Set the splitter used to split the output requested region for
+   * multi-threading, instead of the global default splitter. Subclasses
+   * which override GetImageRegionSplitter() to require a particular split
+   * ignore it. With an ImageRegionSplitterCacheTiles and dynamic
+   * multi-threading, the tiles are handed out to the work units one at a
+   * time. */
+  itkSetConstObjectMacro(ImageRegionSplitter, ImageRegionSplitterBase);
+
 protected:
   ImageSource();
   ~ImageSource() override = default;
@@ -256,6 +266,23 @@ protected:
   void
   ClassicMultiThread(ThreadFunctionType callbackFunction);
 
+  /** Call DynamicThreadedGenerateData() for the cache sized tiles of the
+   * output requested region, which the work units take one at a time.
+   * Returns false, without processing anything, when there are fewer tiles
+   * than work units. */
+  bool
+  TiledMultiThread(const ImageRegionSplitterCacheTiles * splitter);
+
+  /** Get the radius of the neighborhood of the inputs which is read to
+   * compute an output pixel. It is the halo of the tiles of an
+   * ImageRegionSplitterCacheTiles. By default, it is how much the requested
+   * region of the primary input is padded around the output requested
+   * region. This is zero where the padding is cropped by the largest
+   * possible region, so neighborhood filters override it to return their
+   * radius. */
+  virtual Size<OutputImageDimension>
+  GetTileHaloRadius() const;
+
   /** If an imaging filter can be implemented as a multithreaded
    * algorithm, the filter will provide an implementation of
    * ThreadedGenerateData() or DynamicThreadedGenerateData().
@@ -358,7 +385,8 @@ protected:
    * deriving from this class to write a filter consideration to the
    * algorithm used to divide the image should be made. If a change is
    * desired this method should be overridden to return the
-   * appropriate object.
+   * appropriate object. By default, the splitter set with
+   * SetImageRegionSplitter() is returned, or the global default splitter.
    */
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
@@ -404,6 +432,9 @@ protected:
   itkBooleanMacro(DynamicMultiThreading);
   /** @ITKEndGrouping */
   bool m_DynamicMultiThreading{ true };
+
+private:
+  ImageRegionSplitterBase::ConstPointer m_ImageRegionSplitter{};
 };
 } // end namespace itk
 
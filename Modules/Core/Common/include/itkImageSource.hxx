@@ -34,6 +34,9 @@
 
 #include "itkMath.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace itk
 {
 template <typename TOutputImage>
@@ -136,6 +139,10 @@ template <typename TOutputImage>
 const ImageRegionSplitterBase *
 ImageSource<TOutputImage>::GetImageRegionSplitter() const
 {
+  if (m_ImageRegionSplitter)
+  {
+    return m_ImageRegionSplitter;
+  }
   return this->GetGlobalDefaultSplitter();
 }
 
@@ -199,6 +206,57 @@ ImageSource<TOutputImage>::ClassicMultiThread(ThreadFunctionType callbackFunctio
   this->GetMultiThreader()->SetSingleMethodAndExecute(callbackFunction, &str);
 }
 
+template <typename TOutputImage>
+bool
+ImageSource<TOutputImage>::TiledMultiThread(const ImageRegionSplitterCacheTiles * splitter)
+{
+  const OutputImageRegionType    region = this->GetOutput()->GetRequestedRegion();
+  const Size<OutputImageDimension> tileSize = splitter->GetTileSize(region, this->GetTileHaloRadius());
+  const SizeValueType              numberOfTiles = ImageRegionSplitterCacheTiles::GetNumberOfTiles(region, tileSize);
+  const ThreadIdType               numberOfWorkUnits = this->GetNumberOfWorkUnits();
+  if (numberOfTiles < numberOfWorkUnits)
+  {
+    return false;
+  }
+
+  std::atomic<SizeValueType> nextTile{ 0 };
+  MultiThreaderBase *        multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  multiThreader->SetUpdateProgress(this->GetThreaderUpdateProgress());
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [this, &region, &tileSize, &nextTile, numberOfTiles](SizeValueType) {
+      for (SizeValueType tile = nextTile++; tile < numberOfTiles; tile = nextTile++)
+      {
+        this->DynamicThreadedGenerateData(ImageRegionSplitterCacheTiles::GetTile(tile, region, tileSize));
+      }
+    },
+    this);
+  return true;
+}
+
+template <typename TOutputImage>
+auto
+ImageSource<TOutputImage>::GetTileHaloRadius() const -> Size<OutputImageDimension>
+{
+  Size<OutputImageDimension> radius{};
+  const auto *               input = dynamic_cast<const ImageBase<OutputImageDimension> *>(this->GetPrimaryInput());
+  if (input)
+  {
+    const OutputImageRegionType region = this->GetOutput()->GetRequestedRegion();
+    const auto &                inputRegion = input->GetRequestedRegion();
+    const auto                  upperIndex = region.GetUpperIndex();
+    const auto                  inputUpperIndex = inputRegion.GetUpperIndex();
+    for (unsigned int d = 0; d < OutputImageDimension; ++d)
+    {
+      radius[d] = static_cast<SizeValueType>(std::max(
+        { region.GetIndex(d) - inputRegion.GetIndex(d), inputUpperIndex[d] - upperIndex[d], IndexValueType{ 0 } }));
+    }
+  }
+  return radius;
+}
+
 template <typename TOutputImage>
 void
 ImageSource<TOutputImage>::GenerateData()
@@ -212,11 +270,13 @@ ImageSource<TOutputImage>::GenerateData()
   // separate threads
   this->BeforeThreadedGenerateData();
 
+  const auto * tileSplitter = dynamic_cast<const ImageRegionSplitterCacheTiles *>(this->GetImageRegionSplitter());
+
   if (!m_DynamicMultiThreading)
   {
     this->ClassicMultiThread(this->ThreaderCallback);
   }
-  else
+  else if (tileSplitter == nullptr || !this->TiledMultiThread(tileSplitter))
   {
     this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
     this->GetMultiThreader()->SetUpdateProgress(this->GetThreaderUpdateProgress());
@@ -281,6 +341,8 @@ ImageSource<TOutputImage>::ThreaderCallback(void * arg)
 
   if (workUnitID < total)
   {
+    PipelineTracer::Span span("WorkUnit", str->Filter->GetNameOfClass());
+    span.SetRegion(TOutputImage::ImageDimension, splitRegion.GetIndex().data(), splitRegion.GetSize().data());
     str->Filter->ThreadedGenerateData(splitRegion, workUnitID);
   }
   // else don't use this thread. Threads were not split conveniently.
@@ -293,6 +355,7 @@ ImageSource<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   itkPrintSelfBooleanMacro(DynamicMultiThreading);
+  itkPrintSelfObjectMacro(ImageRegionSplitter);
 }
 
 } // end namespace itk
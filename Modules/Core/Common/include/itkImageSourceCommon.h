@@ -47,6 +47,13 @@ struct ITKCommon_EXPORT ImageSourceCommon
   static const ImageRegionSplitterBase *
   GetGlobalDefaultSplitter();
 
+  /** Set the splitter returned by GetGlobalDefaultSplitter(), which is used
+   * by the image sources which do not select their own splitter, and by
+   * MultiThreaderBase::ParallelizeImageRegion(). Setting nullptr restores
+   * the default ImageRegionSplitterSlowDimension. */
+  static void
+  SetGlobalDefaultSplitter(const ImageRegionSplitterBase * splitter);
+
 private:
   itkGetGlobalDeclarationMacro(ImageSourceCommonGlobals, PimplGlobals);
   static ImageSourceCommonGlobals * m_PimplGlobals;
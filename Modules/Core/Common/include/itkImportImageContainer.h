@@ -31,6 +31,11 @@ namespace itk
  * conforms to the ImageContainerInterface. This is a full-fledged Object,
  * so there is modification time, debug, and reference count information.
  *
+ * When the ImageBufferPool is enabled, the buffers allocated by the
+ * container are acquired from the pool and given back to it on release.
+ * Turning off the memory management of a pooled buffer replaces it with a
+ * copy allocated with new[], which the application frees with delete[].
+ *
  * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
  * imported buffer.
  *
@@ -154,9 +159,13 @@ public:
    *  is intended to be used by external applications.
    *  Note that the normal logic of this class set the value of the boolean
    *  flag. This may override your setting if you call this methods prematurely.
+   *  When the buffer was acquired from the ImageBufferPool, turning the
+   *  memory management off gives it back to the pool and replaces it with a
+   *  copy allocated with new[], so GetBufferPointer() must be called again.
    *  \warning Improper use of these methods will result in memory leaks */
   /** @ITKStartGrouping */
-  itkSetMacro(ContainerManageMemory, bool);
+  virtual void
+  SetContainerManageMemory(const bool manageMemory);
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
   /** @ITKEndGrouping */
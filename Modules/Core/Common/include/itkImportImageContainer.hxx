@@ -28,7 +28,11 @@
 #ifndef itkImportImageContainer_hxx
 #define itkImportImageContainer_hxx
 
+#include "itkImageBufferPool.h"
+#include "itkPipelineTracer.h"
 #include <algorithm> // For copy_n.
+#include <memory>    // For uninitialized_value_construct_n.
+#include <type_traits>
 
 namespace itk
 {
@@ -150,6 +154,28 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   this->Modified();
 }
 
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::SetContainerManageMemory(const bool manageMemory)
+{
+  if (m_ContainerManageMemory == manageMemory)
+  {
+    return;
+  }
+  if (!manageMemory && m_ImportPointer && ImageBufferPool::HasAcquiredBuffers() &&
+      ImageBufferPool::GetInstance()->IsAcquired(m_ImportPointer))
+  {
+    // The application frees the buffer with delete[], which cannot free a
+    // pooled buffer, so it gets a copy and the pooled one is given back.
+    TElement * const copy = new TElement[m_Capacity];
+    std::copy_n(m_ImportPointer, m_Size, copy);
+    ImageBufferPool::GetInstance()->Release(m_ImportPointer);
+    m_ImportPointer = copy;
+  }
+  m_ContainerManageMemory = manageMemory;
+  this->Modified();
+}
+
 template <typename TElementIdentifier, typename TElement>
 TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
@@ -159,13 +185,33 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
 
   try
   {
-    if (UseValueInitialization)
+    // The pooled buffers are recycled without destroying their elements, so
+    // only the elements which need no destructor are pooled.
+    if constexpr (std::is_trivially_destructible_v<TElement> && alignof(TElement) <= ImageBufferPool::Alignment)
     {
-      data = new TElement[size]();
+      if (ImageBufferPool::GetEnabled())
+      {
+        data = static_cast<TElement *>(ImageBufferPool::GetInstance()->Acquire(size * sizeof(TElement)));
+        if (data && UseValueInitialization)
+        {
+          std::uninitialized_value_construct_n(data, size);
+        }
+        else if (data)
+        {
+          std::uninitialized_default_construct_n(data, size);
+        }
+      }
     }
-    else
+    if (!data)
     {
-      data = new TElement[size];
+      if (UseValueInitialization)
+      {
+        data = new TElement[size]();
+      }
+      else
+      {
+        data = new TElement[size];
+      }
     }
   }
   catch (...)
@@ -178,6 +224,7 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
     // of memory.  Do not use the exception macro.
     throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
   }
+  PipelineTracer::AddAllocatedBytes(size * sizeof(TElement));
   return data;
 }
 
@@ -188,7 +235,11 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    // The buffers acquired from the pool are given back to it
+    if (!ImageBufferPool::HasAcquiredBuffers() || !ImageBufferPool::GetInstance()->Release(m_ImportPointer))
+    {
+      delete[] m_ImportPointer;
+    }
   }
   m_ImportPointer = nullptr;
   m_Capacity = 0;
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+#include <string>
+
+namespace itk
+{
+/** \class MemoryMappedFileEnums
+ *
+ * \brief enums for MemoryMappedFile
+ *
+ * \ingroup ITKCommon
+ */
+class MemoryMappedFileEnums
+{
+public:
+  /**
+   * \ingroup ITKCommon
+   * How the mapped memory may be accessed.
+   */
+  enum class Access : uint8_t
+  {
+    /** Writing to the memory is an access violation. */
+    ReadOnly,
+    /** Written pages become private copies, the file is never modified. */
+    CopyOnWrite
+  };
+};
+// Define how to print enumeration
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const MemoryMappedFileEnums::Access value);
+
+/** \class MemoryMappedFile
+ * \brief Maps a range of bytes of a file into memory.
+ *
+ * The range is mapped with mmap() on POSIX systems and MapViewOfFile() on
+ * Windows, so that opening it costs no reading, and only the pages that are
+ * accessed are loaded from the file, and can later be discarded by the
+ * system. The range does not need to start on a page boundary. The mapping
+ * is released by Unmap() or when this object is destroyed.
+ *
+ * \sa MemoryMappedImageContainer
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT MemoryMappedFile : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedFile;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedFile);
+
+  using AccessEnum = MemoryMappedFileEnums::Access;
+
+  /** Maps length bytes of the file, starting at offset, after releasing
+   * any previous mapping. Throws an exception when the file cannot be
+   * opened or mapped, or is too short. */
+  void
+  Map(const std::string & fileName, SizeValueType offset, SizeValueType length, AccessEnum access);
+
+  /** Releases the mapping. */
+  void
+  Unmap();
+
+  /** Returns the address of the first mapped byte of the file, or nullptr
+   * when nothing is mapped. */
+  void *
+  GetPointer() const
+  {
+    return m_Pointer;
+  }
+
+  /** Get the mapped file and range. */
+  /** @ITKStartGrouping */
+  itkGetStringMacro(FileName);
+  itkGetConstMacro(Offset, SizeValueType);
+  itkGetConstMacro(Length, SizeValueType);
+  itkGetEnumMacro(Access, AccessEnum);
+  /** @ITKEndGrouping */
+
+  /** Returns the granularity of the offsets at which mappings start, the
+   * page size on POSIX systems. */
+  static SizeValueType
+  GetAllocationGranularity();
+
+protected:
+  MemoryMappedFile() = default;
+  ~MemoryMappedFile() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::string   m_FileName{};
+  SizeValueType m_Offset{ 0 };
+  SizeValueType m_Length{ 0 };
+  AccessEnum    m_Access{ AccessEnum::ReadOnly };
+  // The mapping itself starts on an allocation granularity boundary
+  void *        m_MappedAddress{ nullptr };
+  SizeValueType m_MappedLength{ 0 };
+  void *        m_Pointer{ nullptr };
+};
+} // end namespace itk
+
+#endif // itkMemoryMappedFile_h
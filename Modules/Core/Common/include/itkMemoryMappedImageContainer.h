@@ -0,0 +1,118 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_h
+#define itkMemoryMappedImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "itkMemoryMappedFile.h"
+
+namespace itk
+{
+
+/** \class MemoryMappedImageContainer
+ * \brief An image pixel container whose elements are memory mapped from a file.
+ *
+ * MapFile() makes the elements of the container the bytes of a file, so
+ * that an image using this container as its PixelContainer is available
+ * without reading the file, and only the pages of the file that are
+ * accessed take memory. The elements have to be stored in the file exactly
+ * as they are in memory, that is in the byte order of this machine.
+ *
+ * With read-only access, writing to the elements is an access violation.
+ * With copy-on-write access, written pages become private copies, and the
+ * file is never modified.
+ *
+ * Once mapped, the container behaves as an ImportImageContainer that does
+ * not manage its memory: growing it with Reserve() copies the elements to
+ * a newly allocated buffer and releases the mapping.
+ *
+ * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
+ * mapped buffer.
+ *
+ * \tparam TElement The element type stored in the container.
+ *
+ * \sa MemoryMappedFile
+ *
+ * \ingroup ImageObjects
+ * \ingroup IOFilters
+ * \ingroup ITKCommon
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MemoryMappedImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Save the template parameters. */
+  using typename Superclass::ElementIdentifier;
+  using typename Superclass::Element;
+
+  using AccessEnum = MemoryMappedFileEnums::Access;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedImageContainer);
+
+  /** Maps numberOfElements elements, starting at byte offset in the file,
+   * releasing the previous content of the container. The offset has to
+   * be a multiple of the alignment of TElement. Throws an exception when
+   * the file cannot be mapped. */
+  void
+  MapFile(const std::string & fileName,
+          SizeValueType       offset,
+          ElementIdentifier   numberOfElements,
+          AccessEnum          access = AccessEnum::CopyOnWrite);
+
+  /** Returns the current mapping, or nullptr when the elements are not
+   * memory mapped. */
+  const MemoryMappedFile *
+  GetMemoryMappedFile() const
+  {
+    return m_MemoryMappedFile.GetPointer();
+  }
+
+protected:
+  MemoryMappedImageContainer() = default;
+  ~MemoryMappedImageContainer() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Releases the mapping, in addition to any memory the container
+   * manages. */
+  void
+  DeallocateManagedMemory() override;
+
+private:
+  MemoryMappedFile::Pointer m_MemoryMappedFile{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkMemoryMappedImageContainer.hxx"
+#endif
+
+#endif
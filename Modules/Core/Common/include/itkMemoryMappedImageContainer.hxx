@@ -0,0 +1,63 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_hxx
+#define itkMemoryMappedImageContainer_hxx
+
+namespace itk
+{
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::MapFile(const std::string & fileName,
+                                                                  SizeValueType       offset,
+                                                                  ElementIdentifier   numberOfElements,
+                                                                  AccessEnum          access)
+{
+  if (offset % alignof(TElement) != 0)
+  {
+    itkExceptionMacro("Cannot map elements of " << fileName << " at offset " << offset
+                                                << ", which is not a multiple of their alignment "
+                                                << alignof(TElement));
+  }
+
+  auto file = MemoryMappedFile::New();
+  file->Map(fileName, offset, static_cast<SizeValueType>(numberOfElements) * sizeof(TElement), access);
+
+  // Releases the previous mapping, if any
+  this->SetImportPointer(static_cast<TElement *>(file->GetPointer()), numberOfElements, false);
+  m_MemoryMappedFile = file;
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
+{
+  Superclass::DeallocateManagedMemory();
+  m_MemoryMappedFile = nullptr;
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(MemoryMappedFile);
+}
+} // end namespace itk
+
+#endif
@@ -35,6 +35,7 @@
 #include "itkImageRegion.h"
 #include "itkImageIORegion.h"
 #include "itkSingletonMacro.h"
+#include "itkPipelineTracer.h"
 #include <atomic>
 #include <functional>
 #include <thread>
@@ -65,7 +66,8 @@ public:
     Pool,
     TBB,
     Single,
-    Last = Single,
+    WorkStealing,
+    Last = WorkStealing,
     Unknown = -1
   };
 
@@ -170,6 +172,7 @@ public:
   static constexpr ThreaderEnum Pool = ThreaderEnum::Pool;
   static constexpr ThreaderEnum TBB = ThreaderEnum::TBB;
   static constexpr ThreaderEnum Single = ThreaderEnum::Single;
+  static constexpr ThreaderEnum WorkStealing = ThreaderEnum::WorkStealing;
   static constexpr ThreaderEnum Last = ThreaderEnum::Last;
   static constexpr ThreaderEnum Unknown = ThreaderEnum::Unknown;
 #endif
@@ -192,6 +195,8 @@ public:
         return "TBB";
       case ThreaderEnum::Single:
         return "Single";
+      case ThreaderEnum::WorkStealing:
+        return "WorkStealing";
       case ThreaderEnum::Unknown:
       default:
         return "Unknown";
@@ -225,6 +230,37 @@ public:
   static ThreadIdType
   GetGlobalDefaultNumberOfThreads();
   /** @ITKEndGrouping */
+  /** Set/Get whether image buffers and work units are placed for a NUMA
+   * system. When enabled, Image::Allocate() first-touches new buffers in
+   * parallel, using the same partition of the buffered region as
+   * ParallelizeImageRegion(), so each memory page is placed on the node of
+   * the thread which writes it first. The ThreadPool created afterwards pins
+   * its workers to the NUMA nodes, and the PoolMultiThreader queues each
+   * work unit on the node which holds its part of the region. The default is
+   * picked up from the ITK_GLOBAL_NUMA_AWARE environment variable, and is
+   * false otherwise. The ThreadPool reads this setting once, when it is
+   * created, so it should be set before the first filter is run. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalNUMAAware(bool numaAware);
+  static bool
+  GetGlobalNUMAAware();
+  /** @ITKEndGrouping */
+
+  /** Get whether the calling thread is one of the workers of the ThreadPool
+   * or of the WorkStealingThreadPool, i.e. whether it is executing a work
+   * unit of a PoolMultiThreader or of a WorkStealingMultiThreader. */
+  static bool
+  GetCurrentThreadIsWorker();
+
+  /** Get a multi-threader created by New() with the global default threader
+   * and number of threads, for short parallel work which is not done on
+   * behalf of a filter, like the first touch of a new image buffer. Each
+   * calling thread gets its own instance, which is created on its first call
+   * and recreated when these global defaults change. It should not be
+   * modified. */
+  static MultiThreaderBase *
+  GetCurrentThreadDefaultMultiThreader();
 #if !defined(ITK_LEGACY_REMOVE)
   /** Get/Set the number of threads to use.
    * DEPRECATED! Use WorkUnits and MaximumNumberOfThreads instead. */
@@ -359,7 +395,9 @@ ITK_GCC_PRAGMA_DIAG_POP()
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [&funcP](const IndexValueType index[], const SizeValueType size[]) {
+      [&funcP, filter](const IndexValueType index[], const SizeValueType size[]) {
+        PipelineTracer::Span span("WorkUnit", PipelineTracer::GetNameOfFilter(filter, "ParallelizeImageRegion"));
+        span.SetRegion(VDimension, index, size);
         ImageRegion<VDimension> region;
         for (unsigned int d = 0; d < VDimension; ++d)
         {
@@ -407,7 +445,9 @@ ITK_GCC_PRAGMA_DIAG_POP()
         SplitDimension,
         splitIndex.m_InternalArray,
         splitSize.m_InternalArray,
-        [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
+        [restrictedDirection, &requestedRegion, &funcP, filter](const IndexValueType index[],
+                                                                const SizeValueType  size[]) {
+          PipelineTracer::Span span("WorkUnit", PipelineTracer::GetNameOfFilter(filter, "ParallelizeImageRegion"));
           ImageRegion<VDimension> restrictedRequestedRegion;
           restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
           restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
@@ -420,6 +460,9 @@ ITK_GCC_PRAGMA_DIAG_POP()
               ++splitDimension;
             }
           }
+          span.SetRegion(VDimension,
+                         restrictedRequestedRegion.GetIndex().m_InternalArray,
+                         restrictedRequestedRegion.GetSize().m_InternalArray);
           funcP(restrictedRequestedRegion);
         },
         filter);
@@ -447,6 +490,7 @@ protected:
     const SizeValueType       firstIndex;
     const SizeValueType       lastIndexPlus1;
     ProcessObject *           filter;
+    const char *              name;
   };
 
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
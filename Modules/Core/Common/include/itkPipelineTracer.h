@@ -0,0 +1,225 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineTracer_h
+#define itkPipelineTracer_h
+
+#include "itkObject.h"
+#include "itkIntTypes.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+
+class ProcessObject;
+struct PipelineTracerGlobals;
+
+/** \class PipelineTracer
+ * \brief Record when and where the filters of a pipeline are executed.
+ *
+ * The tracer is a process wide singleton, like OutputWindow, and is disabled
+ * by default. Once enabled with PipelineTracer::SetEnabled(true), it records
+ * a timed event for:
+ *   - each call to the GenerateData() method of a ProcessObject, with the
+ *     number of bytes allocated by the image buffers of the filter while it
+ *     is running,
+ *   - each piece of the requested region updated by a StreamingImageFilter,
+ *   - each work unit executed by MultiThreaderBase::ParallelizeImageRegion()
+ *     and MultiThreaderBase::ParallelizeArray(), and each work unit of the
+ *     classic ThreadedGenerateData() multi-threading, with the thread which
+ *     executed it.
+ *
+ * The events are written with WriteChromeTrace() in the trace event format
+ * of the Chromium project, which can be loaded in chrome://tracing or
+ * https://ui.perfetto.dev to see how long each filter runs, how the streamed
+ * pieces are processed and how well the work units are balanced between the
+ * threads.
+ *
+ * When the tracer is disabled, each instrumented call only checks a flag.
+ * Other code can be instrumented with a PipelineTracer::Span object, which
+ * records an event for the scope in which it lives.
+ *
+ * \code
+ * itk::PipelineTracer::SetEnabled(true);
+ * writer->Update();
+ * itk::PipelineTracer::GetInstance()->WriteChromeTraceFile("pipeline.json");
+ * \endcode
+ *
+ * \sa TimeProbesCollectorBase, MemoryProbesCollectorBase
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineTracer : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineTracer);
+
+  /** Standard class type aliases. */
+  using Self = PipelineTracer;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PipelineTracer);
+
+  /** This is a singleton pattern New. There will only be ONE
+   * reference to a PipelineTracer object per process. */
+  static Pointer
+  New();
+
+  /** Return the singleton instance with no reference counting. */
+  static Pointer
+  GetInstance();
+
+  /** Supply a user defined tracer. */
+  static void
+  SetInstance(PipelineTracer * instance);
+
+  /** Enable or disable the recording of the events. Disabled by default. */
+  /** @ITKStartGrouping */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+  /** @ITKEndGrouping */
+
+  /** An event recorded by the tracer. Times are in nanoseconds since the
+   * construction of the tracer or the last call to Clear(). */
+  struct Event
+  {
+    std::string   Category;
+    std::string   Name;
+    std::string   Detail;
+    uint64_t      Start{};
+    uint64_t      Duration{};
+    unsigned int  ThreadIndex{};
+    SizeValueType AllocatedBytes{};
+  };
+
+  /** \class Span
+   * \brief Record an event for the lifetime of the object.
+   *
+   * Nothing is recorded when the tracer is disabled at construction. The
+   * image buffers allocated by the thread while the span is the innermost
+   * one of this thread are accounted to the span.
+   * \ingroup ITKCommon
+   */
+  class ITKCommon_EXPORT Span
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(Span);
+
+    /** The category and the name must outlive the span. */
+    Span(const char * category, const char * name);
+    ~Span();
+
+    /** Whether this span records an event. */
+    [[nodiscard]] bool
+    IsActive() const
+    {
+      return m_Active;
+    }
+
+    /** Set a description of the event, for example the processed region. */
+    void
+    SetDetail(std::string detail);
+
+    /** Describe the event with the region given by its index and size. */
+    void
+    SetRegion(unsigned int dimension, const IndexValueType index[], const SizeValueType size[]);
+
+  private:
+    friend class PipelineTracer;
+
+    bool                                  m_Active{ false };
+    const char *                          m_Category{ nullptr };
+    const char *                          m_Name{ nullptr };
+    std::string                           m_Detail{};
+    std::chrono::steady_clock::time_point m_Start{};
+    SizeValueType                         m_AllocatedBytes{ 0 };
+    Span *                                m_Parent{ nullptr };
+  };
+
+  /** Account an allocation of the given number of bytes to the innermost
+   * span of the calling thread. Called by the image buffers. */
+  static void
+  AddAllocatedBytes(SizeValueType bytes);
+
+  /** Return the name of class of the filter, or defaultName when filter is
+   * nullptr. */
+  static const char *
+  GetNameOfFilter(const ProcessObject * filter, const char * defaultName);
+
+  /** Add an event to the trace. The thread index of the event is set to the
+   * one of the calling thread. Thread safe. */
+  virtual void
+  RecordEvent(Event event);
+
+  /** Return a copy of the events recorded so far. */
+  std::vector<Event>
+  GetEvents() const;
+
+  SizeValueType
+  GetNumberOfEvents() const;
+
+  /** Remove the recorded events and restart the clock. */
+  void
+  Clear();
+
+  /** Return the number of nanoseconds elapsed between the start of the
+   * trace and time. */
+  uint64_t
+  GetTimeSinceStart(std::chrono::steady_clock::time_point time) const;
+
+  /** Write the recorded events in the JSON trace event format of Chromium,
+   * as complete events in a single process with one track per thread. */
+  /** @ITKStartGrouping */
+  void
+  WriteChromeTrace(std::ostream & os) const;
+  void
+  WriteChromeTraceFile(const std::string & fileName) const;
+  /** @ITKEndGrouping */
+
+protected:
+  PipelineTracer();
+  ~PipelineTracer() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Return a small index for the calling thread, in the order in which the
+   * threads recorded their first event. */
+  unsigned int
+  GetThreadIndex(std::thread::id id);
+
+private:
+  itkGetGlobalDeclarationMacro(PipelineTracerGlobals, PimplGlobals);
+
+  mutable std::mutex                                m_Mutex{};
+  std::vector<Event>                                m_Events{};
+  std::unordered_map<std::thread::id, unsigned int> m_ThreadIndices{};
+  std::chrono::steady_clock::time_point             m_Origin{};
+
+  static PipelineTracerGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
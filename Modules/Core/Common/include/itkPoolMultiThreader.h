@@ -37,6 +37,10 @@ namespace itk
  * \brief A class for performing multithreaded execution with a thread
  * pool back end
  *
+ * When the ThreadPool is NUMA aware, the work units are queued on its nodes
+ * in order, so that each node processes the part of the image buffers that
+ * Image::Allocate() placed on it.
+ *
  * \ingroup OSSystemObjects
  *
  * \ingroup ITKCommon
@@ -20,6 +20,7 @@
 #include "itkCommand.h"
 #include "itkImageAlgorithm.h"
 #include "itkImageRegionSplitterSlowDimension.h"
+#include "itkPipelineTracer.h"
 
 namespace itk
 {
@@ -167,6 +168,9 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
     InputImageRegionType streamRegion = outputRegion;
     m_RegionSplitter->GetSplit(piece, numDivisions, streamRegion);
 
+    PipelineTracer::Span span("Stream", this->GetNameOfClass());
+    span.SetRegion(InputImageDimension, streamRegion.GetIndex().data(), streamRegion.GetSize().data());
+
     inputPtr->SetRequestedRegion(streamRegion);
     inputPtr->PropagateRequestedRegion();
     inputPtr->UpdateOutputData();
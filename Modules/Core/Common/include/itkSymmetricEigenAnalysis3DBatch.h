@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysis3DBatch_h
+#define itkSymmetricEigenAnalysis3DBatch_h
+
+#include "itkSymmetricEigenAnalysis.h"
+#include "itkNumericTraits.h"
+
+namespace itk
+{
+/** \class SymmetricEigenAnalysis3DBatch
+ * \brief Compute the eigen values, and optionally the eigen vectors, of a
+ * batch of 3x3 symmetric matrices.
+ *
+ * SymmetricEigenAnalysisFixedDimension solves one matrix per call, which is
+ * dominated by the set up of the solver when it is called for every pixel of
+ * a tensor or Hessian image. This class solves up to BatchSize matrices at
+ * once. The six elements of the upper triangles are stored as a structure of
+ * arrays, one array per element, and all the matrices go through the same
+ * cyclic Jacobi sweeps. The operations on the arrays are Eigen array
+ * expressions without data dependent branches, which Eigen evaluates with
+ * the SIMD instructions of the target, and the sweeps stop as soon as the
+ * off-diagonal elements of all the matrices are negligible. The matrices are
+ * overwritten by the computation, so they have to be set again before the
+ * next one.
+ *
+ * The matrices are set with SetMatrix(), which reads the upper triangle with
+ * the (row, column) operator, like SymmetricEigenAnalysisFixedDimension.
+ * By default the eigen values are in ascending order; they can also be
+ * ordered by ascending magnitude. Like with SymmetricEigenAnalysisFixedDimension,
+ * disabling the ordering keeps the ascending order. Each row of the matrix
+ * returned by GetEigenVectors() is the eigen vector of the eigen value with
+ * the same index.
+ *
+ * \code
+ * SymmetricEigenAnalysis3DBatch<double> batch;
+ * for (unsigned int i = 0; i < n; ++i)
+ * {
+ *   batch.SetMatrix(i, tensors[i]);
+ * }
+ * batch.ComputeEigenValues(n);
+ * for (unsigned int i = 0; i < n; ++i)
+ * {
+ *   batch.GetEigenValues(i, eigenValues[i]);
+ * }
+ * \endcode
+ *
+ * \sa SymmetricEigenAnalysisFixedDimension
+ * \ingroup ITKCommon
+ */
+template <typename TRealValue = double>
+class ITK_TEMPLATE_EXPORT SymmetricEigenAnalysis3DBatch
+{
+public:
+  using RealValueType = TRealValue;
+
+  /** Maximum number of matrices solved at once. */
+  static constexpr unsigned int BatchSize = 32;
+
+  /** One value per matrix of the batch. */
+  using LaneArrayType = Eigen::Array<RealValueType, BatchSize, 1>;
+
+  SymmetricEigenAnalysis3DBatch();
+
+  /** Maximum number of Jacobi sweeps. The sweeps converge quadratically, a
+   * handful of them is usually enough. */
+  static constexpr unsigned int MaximumNumberOfSweeps = 16;
+
+  /** Set the i-th matrix of the batch. Only the upper triangle is read. */
+  template <typename TMatrix>
+  void
+  SetMatrix(unsigned int i, const TMatrix & A)
+  {
+    m_Elements[0][i] = static_cast<RealValueType>(A(0, 0));
+    m_Elements[1][i] = static_cast<RealValueType>(A(0, 1));
+    m_Elements[2][i] = static_cast<RealValueType>(A(0, 2));
+    m_Elements[3][i] = static_cast<RealValueType>(A(1, 1));
+    m_Elements[4][i] = static_cast<RealValueType>(A(1, 2));
+    m_Elements[5][i] = static_cast<RealValueType>(A(2, 2));
+  }
+
+  /** Compute the eigen values of the first numberOfMatrices matrices. */
+  void
+  ComputeEigenValues(unsigned int numberOfMatrices)
+  {
+    this->Compute<false>(numberOfMatrices);
+  }
+
+  /** Compute the eigen values and vectors of the first numberOfMatrices
+   * matrices. */
+  void
+  ComputeEigenValuesAndVectors(unsigned int numberOfMatrices)
+  {
+    this->Compute<true>(numberOfMatrices);
+  }
+
+  /** Copy the eigen values of the i-th matrix to eigenValues, which must
+   * provide the [] operator. */
+  template <typename TVector>
+  void
+  GetEigenValues(unsigned int i, TVector & eigenValues) const
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      eigenValues[k] = m_EigenValues[k][i];
+    }
+  }
+
+  /** Copy the eigen vectors of the i-th matrix to the rows of eigenVectors,
+   * which must provide the [][] operator. Only valid after
+   * ComputeEigenValuesAndVectors(). */
+  template <typename TEigenMatrix>
+  void
+  GetEigenVectors(unsigned int i, TEigenMatrix & eigenVectors) const
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        eigenVectors[k][j] = m_EigenVectors[3 * k + j][i];
+      }
+    }
+  }
+
+  void
+  SetOrderEigenValues(const bool b)
+  {
+    m_OrderEigenValues = b ? EigenValueOrderEnum::OrderByValue : EigenValueOrderEnum::DoNotOrder;
+  }
+  [[nodiscard]] bool
+  GetOrderEigenValues() const
+  {
+    return m_OrderEigenValues == EigenValueOrderEnum::OrderByValue;
+  }
+  void
+  SetOrderEigenMagnitudes(const bool b)
+  {
+    m_OrderEigenValues = b ? EigenValueOrderEnum::OrderByMagnitude : EigenValueOrderEnum::DoNotOrder;
+  }
+  [[nodiscard]] bool
+  GetOrderEigenMagnitudes() const
+  {
+    return m_OrderEigenValues == EigenValueOrderEnum::OrderByMagnitude;
+  }
+
+private:
+  template <bool VComputeEigenVectors>
+  void
+  Compute(unsigned int numberOfMatrices);
+
+  /** Apply a Jacobi rotation which cancels the element (p, q) of all the
+   * matrices. r is the third index. */
+  template <bool VComputeEigenVectors, unsigned int VP, unsigned int VQ, unsigned int VR>
+  void
+  Rotate();
+
+  /** Sort the eigen values, and the eigen vectors, of all the matrices. */
+  template <bool VComputeEigenVectors>
+  void
+  Sort();
+
+  /** Index in m_Elements of the element (row, column) of the upper triangle. */
+  static constexpr unsigned int
+  ElementIndex(unsigned int row, unsigned int column)
+  {
+    return row <= column ? row * (5 - row) / 2 + column : column * (5 - column) / 2 + row;
+  }
+
+  EigenValueOrderEnum m_OrderEigenValues{ EigenValueOrderEnum::OrderByValue };
+
+  LaneArrayType m_Elements[6];
+  LaneArrayType m_EigenValues[3];
+  LaneArrayType m_EigenVectors[9];
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSymmetricEigenAnalysis3DBatch.hxx"
+#endif
+
+#endif
@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysis3DBatch_hxx
+#define itkSymmetricEigenAnalysis3DBatch_hxx
+
+namespace itk
+{
+template <typename TRealValue>
+SymmetricEigenAnalysis3DBatch<TRealValue>::SymmetricEigenAnalysis3DBatch()
+{
+  // all the lanes are computed, the ones which are not set must hold finite
+  // values
+  for (auto & elements : m_Elements)
+  {
+    elements.setZero();
+  }
+}
+
+template <typename TRealValue>
+template <bool VComputeEigenVectors>
+void
+SymmetricEigenAnalysis3DBatch<TRealValue>::Compute(unsigned int numberOfMatrices)
+{
+  if constexpr (VComputeEigenVectors)
+  {
+    for (unsigned int k = 0; k < 9; ++k)
+    {
+      m_EigenVectors[k].setConstant((k % 4 == 0) ? 1 : 0);
+    }
+  }
+
+  const RealValueType tolerance = NumericTraits<RealValueType>::epsilon() * NumericTraits<RealValueType>::epsilon();
+  for (unsigned int sweep = 0; sweep < MaximumNumberOfSweeps; ++sweep)
+  {
+    // the off-diagonal elements are negligible when their norm is below the
+    // rounding errors of the diagonal
+    const LaneArrayType offDiagonal = m_Elements[1].square() + m_Elements[2].square() + m_Elements[4].square();
+    const LaneArrayType diagonal = m_Elements[0].square() + m_Elements[3].square() + m_Elements[5].square();
+    if (!(offDiagonal > tolerance * diagonal).head(numberOfMatrices).any())
+    {
+      break;
+    }
+    this->Rotate<VComputeEigenVectors, 0, 1, 2>();
+    this->Rotate<VComputeEigenVectors, 0, 2, 1>();
+    this->Rotate<VComputeEigenVectors, 1, 2, 0>();
+  }
+
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    m_EigenValues[k] = m_Elements[ElementIndex(k, k)];
+  }
+  this->Sort<VComputeEigenVectors>();
+}
+
+template <typename TRealValue>
+template <bool VComputeEigenVectors, unsigned int VP, unsigned int VQ, unsigned int VR>
+void
+SymmetricEigenAnalysis3DBatch<TRealValue>::Rotate()
+{
+  constexpr unsigned int pp = ElementIndex(VP, VP);
+  constexpr unsigned int qq = ElementIndex(VQ, VQ);
+  constexpr unsigned int pq = ElementIndex(VP, VQ);
+  constexpr unsigned int rp = ElementIndex(VR, VP);
+  constexpr unsigned int rq = ElementIndex(VR, VQ);
+
+  // t = tan(theta) with the smallest rotation angle which cancels the element
+  // (p, q), written without division by the element so that a zero element
+  // gives the identity rotation
+  const LaneArrayType a = m_Elements[pq];
+  const LaneArrayType d = m_Elements[qq] - m_Elements[pp];
+  const LaneArrayType denominator = d.abs() + (d.square() + 4 * a.square()).sqrt();
+  const LaneArrayType t = (d < 0).select(-2 * a, 2 * a) / (denominator > 0).select(denominator, RealValueType{ 1 });
+  const LaneArrayType c = (1 + t.square()).rsqrt();
+  const LaneArrayType s = t * c;
+
+  m_Elements[pp] -= t * a;
+  m_Elements[qq] += t * a;
+  m_Elements[pq].setZero();
+  const LaneArrayType arp = m_Elements[rp];
+  m_Elements[rp] = c * arp - s * m_Elements[rq];
+  m_Elements[rq] = s * arp + c * m_Elements[rq];
+
+  if constexpr (VComputeEigenVectors)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      const LaneArrayType vp = m_EigenVectors[3 * VP + j];
+      m_EigenVectors[3 * VP + j] = c * vp - s * m_EigenVectors[3 * VQ + j];
+      m_EigenVectors[3 * VQ + j] = s * vp + c * m_EigenVectors[3 * VQ + j];
+    }
+  }
+}
+
+template <typename TRealValue>
+template <bool VComputeEigenVectors>
+void
+SymmetricEigenAnalysis3DBatch<TRealValue>::Sort()
+{
+  const bool byMagnitude = m_OrderEigenValues == EigenValueOrderEnum::OrderByMagnitude;
+
+  // a sorting network of three compare and swap, without branches on the
+  // eigen values
+  const auto compareAndSwap = [this, byMagnitude](unsigned int j, unsigned int k) {
+    using LaneMaskType = Eigen::Array<bool, BatchSize, 1>;
+    const LaneArrayType ej = m_EigenValues[j];
+    const LaneArrayType ek = m_EigenValues[k];
+    const LaneMaskType  swap = byMagnitude ? LaneMaskType(ek.abs() < ej.abs()) : LaneMaskType(ek < ej);
+    m_EigenValues[j] = swap.select(ek, ej);
+    m_EigenValues[k] = swap.select(ej, ek);
+    if constexpr (VComputeEigenVectors)
+    {
+      for (unsigned int c = 0; c < 3; ++c)
+      {
+        const LaneArrayType vj = m_EigenVectors[3 * j + c];
+        const LaneArrayType vk = m_EigenVectors[3 * k + c];
+        m_EigenVectors[3 * j + c] = swap.select(vk, vj);
+        m_EigenVectors[3 * k + c] = swap.select(vj, vk);
+      }
+    }
+  };
+  compareAndSwap(0, 1);
+  compareAndSwap(1, 2);
+  compareAndSwap(0, 1);
+}
+} // end namespace itk
+
+#endif
@@ -21,11 +21,13 @@
 #include "itkConfigure.h"
 #include "itkIntTypes.h"
 
+#include <algorithm>
 #include <deque>
 #include <functional>
 #include <future>
 #include <condition_variable>
 #include <thread>
+#include <vector>
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
@@ -43,6 +45,13 @@ namespace itk
  * Initially the thread pool is started with GlobalDefaultNumberOfThreads.
  * The jobs are submitted via AddWork method.
  *
+ * When MultiThreaderBase::GetGlobalNUMAAware() is true at its creation, the
+ * thread pool distributes its threads over the NUMA nodes of the system,
+ * pins each thread to the processors of its node, and keeps one work queue
+ * per node. Jobs submitted with AddWorkToNode() are then only executed by the
+ * threads of that node, while jobs submitted with AddWork() are executed by
+ * any thread.
+ *
  * This implementation heavily borrows from:
  * https://github.com/progschj/ThreadPool
  *
@@ -96,10 +105,67 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
       const std::lock_guard<std::mutex> lockGuard(this->GetMutex());
       m_WorkQueue.emplace_back([task]() { (*task)(); });
     }
-    m_Condition.notify_one();
+    // wake up one thread of each node, the first one takes the job
+    for (auto & condition : m_NodeConditions)
+    {
+      condition.notify_one();
+    }
+    return res;
+  }
+
+  /** Add this job to the queue of a node. It is executed by one of the
+   * threads of this node, which are pinned to its processors when the pool
+   * is NUMA aware. The node is taken modulo GetNumberOfNodes(), so any value
+   * can be passed. */
+  template <class Function, class... Arguments>
+  auto
+  AddWorkToNode(unsigned int node, Function && function, Arguments &&... arguments)
+    -> std::future<std::invoke_result_t<Function, Arguments...>>
+  {
+    using return_type = std::invoke_result_t<Function, Arguments...>;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+      [function, arguments...]() -> return_type { return function(arguments...); });
+
+    std::future<return_type> res = task->get_future();
+    node %= this->GetNumberOfNodes();
+    {
+      const std::lock_guard<std::mutex> lockGuard(this->GetMutex());
+      m_NodeWorkQueues[node].emplace_back([task]() { (*task)(); });
+    }
+    m_NodeConditions[node].notify_one();
     return res;
   }
 
+  /** Get the number of nodes over which the threads are distributed, each
+   * having its own work queue. It is one unless the pool is NUMA aware. */
+  unsigned int
+  GetNumberOfNodes() const
+  {
+    return static_cast<unsigned int>(m_NodeWorkQueues.size());
+  }
+
+  /** Get the node on which to queue the work unit workUnit of
+   * numberOfWorkUnits, for contiguous parts of a region or array: the
+   * work units are mapped to the nodes in order, by blocks of about equal
+   * size. */
+  unsigned int
+  GetNodeOfWorkUnit(ThreadIdType workUnit, ThreadIdType numberOfWorkUnits) const
+  {
+    return static_cast<unsigned int>(static_cast<uint64_t>(workUnit) * this->GetNumberOfNodes() /
+                                     std::max<ThreadIdType>(numberOfWorkUnits, 1));
+  }
+
+  /** Get the number of NUMA nodes of the system, which is one when it cannot
+   * be determined. */
+  static unsigned int
+  GetNumberOfNUMANodes();
+
+  /** Get whether the calling thread is one of the threads of the pool, i.e.
+   * whether it is executing a job. */
+  static bool
+  GetCurrentThreadIsWorker();
+
   /** Can call this method if we want to add extra threads to the pool. */
   void
   AddThreads(ThreadIdType count);
@@ -148,14 +214,18 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(ThreadPoolGlobals, PimplGlobals);
 
-  /** This is a list of jobs submitted to the thread pool.
-   * This is the only place where the jobs are submitted.
+  /** This is a list of jobs submitted to the thread pool for any thread.
    * Filled by AddWork, emptied by ThreadExecute. */
   std::deque<std::function<void()>> m_WorkQueue; // guarded by m_PimplGlobals->m_Mutex
 
-  /** When a thread is idle, it is waiting on m_Condition.
-   * AddWork signals it to resume a (random) thread. */
-  std::condition_variable m_Condition;
+  /** The lists of jobs submitted to the threads of each node.
+   * Filled by AddWorkToNode, emptied by ThreadExecute. The number of nodes
+   * is set at construction and does not change afterwards. */
+  std::vector<std::deque<std::function<void()>>> m_NodeWorkQueues; // guarded by m_PimplGlobals->m_Mutex
+
+  /** When a thread is idle, it is waiting on the condition of its node.
+   * AddWork and AddWorkToNode signal it to resume a (random) thread. */
+  std::vector<std::condition_variable> m_NodeConditions;
 
   /** Vector to hold all thread handles.
    * Thread handles are used to delete (join) the threads. */
@@ -167,9 +237,14 @@ private:
   /** To lock on the internal variables */
   static ThreadPoolGlobals * m_PimplGlobals;
 
+  /** Start a thread on the given node, pinning it to the processors of the
+   * node when the pool is NUMA aware. */
+  void
+  AddThread(unsigned int node);
+
   /** The continuously running thread function */
   static void
-  ThreadExecute();
+  ThreadExecute(unsigned int node);
 };
 
 } // namespace itk
@@ -0,0 +1,234 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkStealingThreadPool_h
+#define itkWorkStealingThreadPool_h
+
+#include "itkConfigure.h"
+#include "itkIntTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSingletonMacro.h"
+
+
+namespace itk
+{
+
+/**
+ * \class WorkStealingThreadPool
+ * \brief Thread pool with one task deque per worker and work stealing.
+ *
+ * Every worker thread owns a deque of tasks. Tasks submitted from a worker
+ * are pushed onto the back of that worker's own deque and popped again in
+ * LIFO order, which keeps recently produced (cache-hot) work on the thread
+ * that produced it. Idle workers steal from the front of other workers'
+ * deques. Tasks submitted from a thread that is not part of the pool are
+ * distributed round-robin over the worker deques.
+ *
+ * Tasks are grouped into a TaskGroup. Waiting on a TaskGroup does not block
+ * the waiting thread: it keeps executing pending tasks (its own or stolen
+ * ones) until all tasks of the group have finished. This makes nested
+ * parallelism safe, i.e. a task may itself submit tasks and wait for them
+ * without the risk of exhausting the pool and deadlocking.
+ *
+ * The pool is a process-wide singleton, used by WorkStealingMultiThreader.
+ * Initially it is started with GlobalDefaultNumberOfThreads workers.
+ *
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+
+struct WorkStealingThreadPoolGlobals;
+
+class ITKCommon_EXPORT WorkStealingThreadPool : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WorkStealingThreadPool);
+
+  /** Standard class type aliases. */
+  using Self = WorkStealingThreadPool;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(WorkStealingThreadPool);
+
+  /** Returns the global instance */
+  static Pointer
+  New();
+
+  /** Returns the global singleton instance of the WorkStealingThreadPool */
+  static Pointer
+  GetInstance();
+
+  /** \class TaskGroup
+   * \brief A set of tasks which can be waited for as a whole.
+   *
+   * The first exception thrown by any task of the group is kept and
+   * rethrown by WorkStealingThreadPool::Wait().
+   * \ingroup ITKCommon */
+  class ITKCommon_EXPORT TaskGroup
+  {
+  public:
+    TaskGroup() = default;
+    ITK_DISALLOW_COPY_AND_MOVE(TaskGroup);
+    ~TaskGroup() = default;
+
+    /** Number of tasks which have been submitted but have not finished yet. */
+    [[nodiscard]] SizeValueType
+    GetNumberOfPendingTasks() const
+    {
+      return m_Pending.load(std::memory_order_acquire);
+    }
+
+  private:
+    friend class WorkStealingThreadPool;
+
+    std::atomic<SizeValueType> m_Pending{ 0 };
+    std::mutex                 m_Mutex;
+    std::condition_variable    m_Finished;
+    std::exception_ptr         m_FirstException; // guarded by m_Mutex
+  };
+
+  /** Submit a task belonging to the given group. */
+  void
+  Submit(TaskGroup & group, std::function<void()> task);
+
+  /** Wait until all tasks of the group have finished. While waiting, the
+   * calling thread executes pending tasks of the pool. Rethrows the first
+   * exception thrown by any task of the group. */
+  void
+  Wait(TaskGroup & group);
+
+  /** Execute at most one pending task on the calling thread.
+   * Returns whether a task was executed. */
+  bool
+  TryExecuteOneTask();
+
+  /** Can call this method if we want to add extra threads to the pool.
+   * The total number of workers is limited to ITK_MAX_THREADS. */
+  void
+  AddThreads(ThreadIdType count);
+
+  ThreadIdType
+  GetMaximumNumberOfThreads() const
+  {
+    return m_NumberOfWorkers.load(std::memory_order_acquire);
+  }
+
+  /** Index of the calling thread within this pool, or -1 if the
+   * calling thread is not one of the pool's workers. */
+  static int
+  GetCurrentWorkerIndex();
+
+  /** Number of tasks stolen from other workers since the pool was created.
+   * Provided for diagnostics and benchmarking. */
+  SizeValueType
+  GetNumberOfStolenTasks() const
+  {
+    return m_StolenTasks.load(std::memory_order_relaxed);
+  }
+
+protected:
+  WorkStealingThreadPool();
+
+  /** Stop the pool and release threads. To be called by the destructor and atfork. */
+  void
+  CleanUp();
+
+  ~WorkStealingThreadPool() override { this->CleanUp(); }
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  static void
+  PrepareForFork();
+  static void
+  ResumeFromFork();
+
+private:
+  /** Only used to synchronize the global variable across static libraries.*/
+  itkGetGlobalDeclarationMacro(WorkStealingThreadPoolGlobals, PimplGlobals);
+
+  /** Deque of tasks owned by one worker. The owner pushes and pops at the
+   * back, thieves take from the front. */
+  struct WorkerQueue
+  {
+    std::mutex                        m_Mutex;
+    std::deque<std::function<void()>> m_Tasks; // guarded by m_Mutex
+  };
+
+  void
+  Push(std::function<void()> task);
+
+  bool
+  PopOwn(unsigned int workerIndex, std::function<void()> & task);
+
+  bool
+  Steal(unsigned int thiefIndex, std::function<void()> & task);
+
+  void
+  StartWorkers(ThreadIdType count);
+
+  /** One queue per potential worker, allocated upfront so that queues never
+   * move while other threads access them. */
+  std::unique_ptr<WorkerQueue[]> m_Queues;
+
+  /** Worker thread handles, guarded by m_PimplGlobals->m_Mutex. */
+  std::vector<std::thread> m_Threads;
+
+  std::atomic<ThreadIdType> m_NumberOfWorkers{ 0 };
+
+  /** Total number of tasks sitting in any of the worker queues. */
+  std::atomic<SizeValueType> m_QueuedTasks{ 0 };
+
+  /** Round-robin counter for tasks submitted from outside the pool. */
+  std::atomic<unsigned int> m_NextQueue{ 0 };
+
+  std::atomic<SizeValueType> m_StolenTasks{ 0 };
+
+  /** Idle workers sleep on m_Condition, protected by m_SleepMutex.
+   * Submitting threads only take m_SleepMutex when somebody sleeps. */
+  std::mutex                m_SleepMutex;
+  std::condition_variable   m_Condition;
+  std::atomic<ThreadIdType> m_NumberOfSleepingWorkers{ 0 };
+
+  /* Has destruction started? */
+  std::atomic<bool> m_Stopping{ false };
+
+  /** To lock on the internal variables */
+  static WorkStealingThreadPoolGlobals * m_PimplGlobals;
+
+  /** The continuously running thread function */
+  static void
+  ThreadExecute(unsigned int workerIndex);
+};
+
+} // namespace itk
+#endif
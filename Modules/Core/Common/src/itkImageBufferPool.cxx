@@ -0,0 +1,330 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferPool.h"
+#include "itkObjectFactory.h"
+#include "itkSingleton.h"
+#include <atomic>
+#include <new>
+
+namespace itk
+{
+
+struct ImageBufferPoolGlobals
+{
+  ImageBufferPool::Pointer   m_Instance{ nullptr };
+  std::recursive_mutex       m_StaticInstanceLock;
+  std::atomic<bool>          m_Enabled{ false };
+  std::atomic<SizeValueType> m_NumberOfAcquiredBuffers{ 0 };
+};
+
+namespace
+{
+constexpr SizeValueType MinimumBucketSize = 4096;
+
+void
+FreeBuffer(void * buffer)
+{
+  ::operator delete(buffer, std::align_val_t{ ImageBufferPool::Alignment });
+}
+} // namespace
+
+ImageBufferPool::ImageBufferPool() = default;
+
+ImageBufferPool::~ImageBufferPool()
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  this->Trim(0);
+}
+
+itkGetGlobalSimpleMacro(ImageBufferPool, ImageBufferPoolGlobals, PimplGlobals);
+
+ImageBufferPoolGlobals * ImageBufferPool::m_PimplGlobals;
+
+ImageBufferPool::Pointer
+ImageBufferPool::GetInstance()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::recursive_mutex> lockGuard(m_PimplGlobals->m_StaticInstanceLock);
+  if (!m_PimplGlobals->m_Instance)
+  {
+    // Try the factory first
+    m_PimplGlobals->m_Instance = ObjectFactory<Self>::Create();
+    // if the factory did not provide one, then create it here
+    if (!m_PimplGlobals->m_Instance)
+    {
+      m_PimplGlobals->m_Instance = new ImageBufferPool;
+      // Remove extra reference from construction.
+      m_PimplGlobals->m_Instance->UnRegister();
+    }
+  }
+  return m_PimplGlobals->m_Instance;
+}
+
+void
+ImageBufferPool::SetInstance(ImageBufferPool * instance)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::recursive_mutex> lockGuard(m_PimplGlobals->m_StaticInstanceLock);
+  m_PimplGlobals->m_Instance = instance;
+}
+
+/**
+ * This just calls GetInstance
+ */
+ImageBufferPool::Pointer
+ImageBufferPool::New()
+{
+  return GetInstance();
+}
+
+void
+ImageBufferPool::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Enabled = enabled;
+  if (!enabled)
+  {
+    GetInstance()->Clear();
+  }
+}
+
+bool
+ImageBufferPool::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled.load(std::memory_order_relaxed);
+}
+
+bool
+ImageBufferPool::HasAcquiredBuffers()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_NumberOfAcquiredBuffers.load() > 0;
+}
+
+SizeValueType
+ImageBufferPool::GetBucketSize(SizeValueType numberOfBytes)
+{
+  if (numberOfBytes <= MinimumBucketSize)
+  {
+    return MinimumBucketSize;
+  }
+  // eight buckets per power of two
+  SizeValueType powerOfTwo = MinimumBucketSize;
+  while (powerOfTwo <= numberOfBytes / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const SizeValueType step = powerOfTwo / 8;
+  return (numberOfBytes + step - 1) / step * step;
+}
+
+void *
+ImageBufferPool::Acquire(SizeValueType numberOfBytes)
+{
+  const SizeValueType bucketSize = GetBucketSize(numberOfBytes);
+  void *              buffer = nullptr;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    const auto                        idle = m_IdleBuffers.find(bucketSize);
+    if (idle != m_IdleBuffers.end() && !idle->second.empty())
+    {
+      buffer = idle->second.back();
+      idle->second.pop_back();
+      m_PooledBytes -= bucketSize;
+      ++m_NumberOfHits;
+    }
+    else
+    {
+      ++m_NumberOfMisses;
+    }
+  }
+
+  if (!buffer)
+  {
+    buffer = ::operator new(bucketSize, std::align_val_t{ Alignment }, std::nothrow);
+    if (!buffer)
+    {
+      // give the idle buffers back to the system, and try again
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+        this->Trim(0);
+      }
+      buffer = ::operator new(bucketSize, std::align_val_t{ Alignment }, std::nothrow);
+      if (!buffer)
+      {
+        return nullptr;
+      }
+    }
+  }
+
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  m_AcquiredBuffers.emplace(buffer, bucketSize);
+  m_AcquiredBytes += bucketSize;
+  ++m_PimplGlobals->m_NumberOfAcquiredBuffers;
+  return buffer;
+}
+
+bool
+ImageBufferPool::Release(void * buffer)
+{
+  if (!buffer)
+  {
+    return false;
+  }
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    const auto                        acquired = m_AcquiredBuffers.find(buffer);
+    if (acquired == m_AcquiredBuffers.end())
+    {
+      return false;
+    }
+    const SizeValueType bucketSize = acquired->second;
+    m_AcquiredBuffers.erase(acquired);
+    m_AcquiredBytes -= bucketSize;
+    --m_PimplGlobals->m_NumberOfAcquiredBuffers;
+
+    if (GetEnabled())
+    {
+      if (m_PooledBytes + bucketSize <= m_MaximumPooledBytes)
+      {
+        m_IdleBuffers[bucketSize].push_back(buffer);
+        m_PooledBytes += bucketSize;
+        return true;
+      }
+      ++m_NumberOfDiscardedBuffers;
+    }
+  }
+  // the pool is disabled, or the buffer does not fit under the cap
+  FreeBuffer(buffer);
+  return true;
+}
+
+void
+ImageBufferPool::Trim(SizeValueType maximumPooledBytes)
+{
+  // free the largest buffers first
+  for (auto bucket = m_IdleBuffers.rbegin(); bucket != m_IdleBuffers.rend() && m_PooledBytes > maximumPooledBytes;
+       ++bucket)
+  {
+    while (!bucket->second.empty() && m_PooledBytes > maximumPooledBytes)
+    {
+      FreeBuffer(bucket->second.back());
+      bucket->second.pop_back();
+      m_PooledBytes -= bucket->first;
+    }
+  }
+}
+
+bool
+ImageBufferPool::IsAcquired(const void * buffer) const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_AcquiredBuffers.find(const_cast<void *>(buffer)) != m_AcquiredBuffers.end();
+}
+
+void
+ImageBufferPool::Clear()
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  this->Trim(0);
+  m_IdleBuffers.clear();
+}
+
+void
+ImageBufferPool::SetMaximumPooledBytes(SizeValueType maximumPooledBytes)
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_MaximumPooledBytes == maximumPooledBytes)
+    {
+      return;
+    }
+    m_MaximumPooledBytes = maximumPooledBytes;
+    this->Trim(maximumPooledBytes);
+  }
+  this->Modified();
+}
+
+SizeValueType
+ImageBufferPool::GetMaximumPooledBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_MaximumPooledBytes;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfHits() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfHits;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfMisses() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfMisses;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfDiscardedBuffers() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfDiscardedBuffers;
+}
+
+SizeValueType
+ImageBufferPool::GetPooledBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_PooledBytes;
+}
+
+SizeValueType
+ImageBufferPool::GetAcquiredBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_AcquiredBytes;
+}
+
+void
+ImageBufferPool::ResetStatistics()
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  m_NumberOfHits = 0;
+  m_NumberOfMisses = 0;
+  m_NumberOfDiscardedBuffers = 0;
+}
+
+void
+ImageBufferPool::PrintSelf(std::ostream & os, Indent indent) const
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ImageBufferPool (single instance): " << (void *)m_PimplGlobals->m_Instance << std::endl;
+  os << indent << "Enabled: " << (m_PimplGlobals->m_Enabled ? "On" : "Off") << std::endl;
+  os << indent << "MaximumPooledBytes: " << this->GetMaximumPooledBytes() << std::endl;
+  os << indent << "PooledBytes: " << this->GetPooledBytes() << std::endl;
+  os << indent << "AcquiredBytes: " << this->GetAcquiredBytes() << std::endl;
+  os << indent << "NumberOfHits: " << this->GetNumberOfHits() << std::endl;
+  os << indent << "NumberOfMisses: " << this->GetNumberOfMisses() << std::endl;
+  os << indent << "NumberOfDiscardedBuffers: " << this->GetNumberOfDiscardedBuffers() << std::endl;
+}
+} // end namespace itk
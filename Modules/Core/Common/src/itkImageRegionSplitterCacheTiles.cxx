@@ -0,0 +1,160 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionSplitterCacheTiles.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+
+void
+ImageRegionSplitterCacheTiles::ComputeTileSize(unsigned int        dim,
+                                               const SizeValueType regionSize[],
+                                               const SizeValueType radius[],
+                                               SizeValueType       tileSize[]) const
+{
+  // the number of pixels, margins included, which fit in the cache
+  const double maximumNumberOfPixels =
+    std::max(1.0, static_cast<double>(m_CacheSize) / static_cast<double>(std::max<SizeValueType>(m_BytesPerPixel, 1)));
+
+  const auto canHalve = [radius, tileSize](unsigned int d) {
+    return tileSize[d] / 2 >= std::max(MinimumTileSize, 2 * radius[d]);
+  };
+  const auto workingSet = [dim, radius, tileSize] {
+    double numberOfPixels = 1.0;
+    for (unsigned int d = 0; d < dim; ++d)
+    {
+      numberOfPixels *= static_cast<double>(tileSize[d] + 2 * radius[d]);
+    }
+    return numberOfPixels;
+  };
+
+  std::copy_n(regionSize, dim, tileSize);
+  while (workingSet() > maximumNumberOfPixels)
+  {
+    // Halve the largest dimension, the slowest one on ties, but keep whole
+    // lines along the first dimension as long as another one can be halved.
+    unsigned int splitAxis = dim;
+    for (unsigned int d = 1; d < dim; ++d)
+    {
+      if (canHalve(d) && (splitAxis == dim || tileSize[d] >= tileSize[splitAxis]))
+      {
+        splitAxis = d;
+      }
+    }
+    if (splitAxis == dim)
+    {
+      if (!canHalve(0))
+      {
+        break;
+      }
+      splitAxis = 0;
+    }
+    tileSize[splitAxis] = (tileSize[splitAxis] + 1) / 2;
+  }
+}
+
+SizeValueType
+ImageRegionSplitterCacheTiles::ComputeNumberOfTiles(unsigned int        dim,
+                                                    const SizeValueType regionSize[],
+                                                    const SizeValueType tileSize[])
+{
+  SizeValueType numberOfTiles = 1;
+  for (unsigned int d = 0; d < dim; ++d)
+  {
+    if (tileSize[d] == 0)
+    {
+      return 0;
+    }
+    numberOfTiles *= (regionSize[d] + tileSize[d] - 1) / tileSize[d];
+  }
+  return numberOfTiles;
+}
+
+void
+ImageRegionSplitterCacheTiles::ComputeTile(unsigned int        dim,
+                                           SizeValueType       tileNumber,
+                                           const SizeValueType tileSize[],
+                                           IndexValueType      regionIndex[],
+                                           SizeValueType       regionSize[])
+{
+  for (unsigned int d = 0; d < dim; ++d)
+  {
+    const SizeValueType numberOfTiles = (regionSize[d] + tileSize[d] - 1) / tileSize[d];
+    const SizeValueType tileIndex = tileNumber % numberOfTiles;
+    tileNumber /= numberOfTiles;
+
+    regionIndex[d] += static_cast<IndexValueType>(tileIndex * tileSize[d]);
+    regionSize[d] = std::min(tileSize[d], regionSize[d] - tileIndex * tileSize[d]);
+  }
+}
+
+unsigned int
+ImageRegionSplitterCacheTiles::GetNumberOfSplitsInternal(unsigned int         dim,
+                                                         const IndexValueType regionIndex[],
+                                                         const SizeValueType  regionSize[],
+                                                         unsigned int         requestedNumber) const
+{
+  const std::vector<SizeValueType> radius(dim, 0);
+  std::vector<SizeValueType>       tileSize(dim);
+  this->ComputeTileSize(dim, regionSize, radius.data(), tileSize.data());
+  const SizeValueType numberOfTiles = ComputeNumberOfTiles(dim, regionSize, tileSize.data());
+
+  const unsigned int numberOfSlabs =
+    Superclass::GetNumberOfSplitsInternal(dim, regionIndex, regionSize, requestedNumber);
+  if (numberOfTiles <= requestedNumber && numberOfTiles > numberOfSlabs)
+  {
+    return static_cast<unsigned int>(numberOfTiles);
+  }
+  return numberOfSlabs;
+}
+
+unsigned int
+ImageRegionSplitterCacheTiles::GetSplitInternal(unsigned int   dim,
+                                                unsigned int   i,
+                                                unsigned int   numberOfPieces,
+                                                IndexValueType regionIndex[],
+                                                SizeValueType  regionSize[]) const
+{
+  const std::vector<SizeValueType> radius(dim, 0);
+  std::vector<SizeValueType>       tileSize(dim);
+  this->ComputeTileSize(dim, regionSize, radius.data(), tileSize.data());
+  const SizeValueType numberOfTiles = ComputeNumberOfTiles(dim, regionSize, tileSize.data());
+
+  // same choice as GetNumberOfSplitsInternal, which returned numberOfPieces
+  if (numberOfTiles == numberOfPieces &&
+      numberOfTiles > Superclass::GetNumberOfSplitsInternal(dim, regionIndex, regionSize, numberOfPieces))
+  {
+    ComputeTile(dim, i, tileSize.data(), regionIndex, regionSize);
+    return numberOfPieces;
+  }
+  return Superclass::GetSplitInternal(dim, i, numberOfPieces, regionIndex, regionSize);
+}
+
+void
+ImageRegionSplitterCacheTiles::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "CacheSize: " << m_CacheSize << std::endl;
+  os << indent << "BytesPerPixel: " << m_BytesPerPixel << std::endl;
+}
+
+} // namespace itk
@@ -25,7 +25,7 @@ namespace itk
 
 struct ImageSourceCommonGlobals
 {
-  ImageRegionSplitterBase::Pointer m_GlobalDefaultSplitter{ ImageRegionSplitterSlowDimension::New().GetPointer() };
+  ImageRegionSplitterBase::ConstPointer m_GlobalDefaultSplitter{ ImageRegionSplitterSlowDimension::New().GetPointer() };
 };
 
 itkGetGlobalSimpleMacro(ImageSourceCommon, ImageSourceCommonGlobals, PimplGlobals);
@@ -38,5 +38,19 @@ ImageSourceCommon::GetGlobalDefaultSplitter()
   return m_PimplGlobals->m_GlobalDefaultSplitter;
 }
 
+void
+ImageSourceCommon::SetGlobalDefaultSplitter(const ImageRegionSplitterBase * splitter)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if (splitter)
+  {
+    m_PimplGlobals->m_GlobalDefaultSplitter = splitter;
+  }
+  else
+  {
+    m_PimplGlobals->m_GlobalDefaultSplitter = ImageRegionSplitterSlowDimension::New().GetPointer();
+  }
+}
+
 
 } // namespace itk
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedFile.h"
+#include "itksys/SystemTools.hxx"
+
+#if defined(_WIN32)
+#  include "itksys/Encoding.hxx"
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  this->Unmap();
+}
+
+SizeValueType
+MemoryMappedFile::GetAllocationGranularity()
+{
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  return systemInfo.dwAllocationGranularity;
+#else
+  return static_cast<SizeValueType>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void
+MemoryMappedFile::Map(const std::string & fileName, SizeValueType offset, SizeValueType length, AccessEnum access)
+{
+  this->Unmap();
+
+  if (length == 0)
+  {
+    itkExceptionMacro("Cannot map an empty range of " << fileName);
+  }
+
+  const SizeValueType granularity = Self::GetAllocationGranularity();
+  const SizeValueType mappedOffset = offset - offset % granularity;
+  const SizeValueType mappedLength = length + offset % granularity;
+
+#if defined(_WIN32)
+  const HANDLE file = CreateFileW(itksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for mapping. Reason: "
+                                     << itksys::SystemTools::GetLastSystemError());
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<uint64_t>(fileSize.QuadPart) < offset + length)
+  {
+    CloseHandle(file);
+    itkExceptionMacro("Cannot map " << length << " bytes at " << offset << " of the shorter file " << fileName);
+  }
+  // The view keeps the mapping object, which keeps the file open
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  void * address = nullptr;
+  if (mapping != nullptr)
+  {
+    address = MapViewOfFile(mapping,
+                            access == AccessEnum::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ,
+                            static_cast<DWORD>(static_cast<uint64_t>(mappedOffset) >> 32),
+                            static_cast<DWORD>(mappedOffset & 0xFFFFFFFF),
+                            static_cast<SIZE_T>(mappedLength));
+    CloseHandle(mapping);
+  }
+  if (address == nullptr)
+  {
+    itkExceptionMacro("Cannot map " << fileName << ". Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+#else
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for mapping. Reason: "
+                                     << itksys::SystemTools::GetLastSystemError());
+  }
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) != 0 || static_cast<uint64_t>(fileStatus.st_size) < offset + length)
+  {
+    close(file);
+    itkExceptionMacro("Cannot map " << length << " bytes at " << offset << " of the shorter file " << fileName);
+  }
+  // The mapping keeps the file open
+  void * address = access == AccessEnum::CopyOnWrite
+                     ? mmap(nullptr, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, mappedOffset)
+                     : mmap(nullptr, mappedLength, PROT_READ, MAP_SHARED, file, mappedOffset);
+  close(file);
+  if (address == MAP_FAILED)
+  {
+    itkExceptionMacro("Cannot map " << fileName << ". Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+#endif
+
+  m_FileName = fileName;
+  m_Offset = offset;
+  m_Length = length;
+  m_Access = access;
+  m_MappedAddress = address;
+  m_MappedLength = mappedLength;
+  m_Pointer = static_cast<char *>(address) + (offset - mappedOffset);
+  this->Modified();
+}
+
+void
+MemoryMappedFile::Unmap()
+{
+  if (m_MappedAddress == nullptr)
+  {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(m_MappedAddress);
+#else
+  munmap(m_MappedAddress, m_MappedLength);
+#endif
+  m_MappedAddress = nullptr;
+  m_MappedLength = 0;
+  m_Pointer = nullptr;
+  m_Length = 0;
+  this->Modified();
+}
+
+void
+MemoryMappedFile::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "Offset: " << m_Offset << std::endl;
+  os << indent << "Length: " << m_Length << std::endl;
+  os << indent << "Access: " << m_Access << std::endl;
+  os << indent << "Pointer: " << m_Pointer << std::endl;
+}
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const MemoryMappedFileEnums::Access value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case MemoryMappedFileEnums::Access::ReadOnly:
+        return "itk::MemoryMappedFileEnums::Access::ReadOnly";
+      case MemoryMappedFileEnums::Access::CopyOnWrite:
+        return "itk::MemoryMappedFileEnums::Access::CopyOnWrite";
+      default:
+        return "INVALID VALUE FOR itk::MemoryMappedFileEnums::Access";
+    }
+  }();
+}
+} // end namespace itk
@@ -31,6 +31,9 @@
 
 #if defined(ITK_USE_POOL_MULTI_THREADER)
 #  include "itkPoolMultiThreader.h"
+#  include "itkThreadPool.h"
+#  include "itkWorkStealingMultiThreader.h"
+#  include "itkWorkStealingThreadPool.h"
 #endif
 #include "itkNumericTraits.h"
 #include <mutex>
@@ -90,6 +93,12 @@ struct MultiThreaderBaseGlobals
   //  m_GlobalMaximumNumberOfThreads and larger or equal to 1 once it has been
   //  initialized in the constructor of the first MultiThreaderBase instantiation.
   ThreadIdType m_GlobalDefaultNumberOfThreads{ 0 };
+
+  // Whether buffers and work units are placed for a NUMA system. Like the
+  // default threader, the ITK_GLOBAL_NUMA_AWARE environment variable is only
+  // read if SetGlobalNUMAAware was not called before.
+  bool m_GlobalNUMAAwareIsInitialized{ false };
+  bool m_GlobalNUMAAware{ false };
 };
 
 itkGetGlobalSimpleMacro(MultiThreaderBase, MultiThreaderBaseGlobals, PimplGlobals);
@@ -212,6 +221,10 @@ MultiThreaderBase::ThreaderTypeFromString(std::string threaderString)
   {
     return ThreaderEnum::Single;
   }
+  else if (threaderString == "WORKSTEALING")
+  {
+    return ThreaderEnum::WorkStealing;
+  }
   else
   {
     return ThreaderEnum::Unknown;
@@ -248,6 +261,67 @@ MultiThreaderBase::SetGlobalDefaultNumberOfThreads(ThreadIdType val)
     std::clamp<ThreadIdType>(val, 1, m_PimplGlobals->m_GlobalMaximumNumberOfThreads);
 }
 
+void
+MultiThreaderBase::SetGlobalNUMAAware(bool numaAware)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->globalDefaultInitializerMutex);
+
+  m_PimplGlobals->m_GlobalNUMAAware = numaAware;
+  m_PimplGlobals->m_GlobalNUMAAwareIsInitialized = true;
+}
+
+bool
+MultiThreaderBase::GetGlobalNUMAAware()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->globalDefaultInitializerMutex);
+
+  if (!m_PimplGlobals->m_GlobalNUMAAwareIsInitialized)
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_NUMA_AWARE", envVar))
+    {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      m_PimplGlobals->m_GlobalNUMAAware = envVar != "NO" && envVar != "OFF" && envVar != "FALSE" && envVar != "0";
+    }
+    m_PimplGlobals->m_GlobalNUMAAwareIsInitialized = true;
+  }
+  return m_PimplGlobals->m_GlobalNUMAAware;
+}
+
+bool
+MultiThreaderBase::GetCurrentThreadIsWorker()
+{
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+  return ThreadPool::GetCurrentThreadIsWorker() || WorkStealingThreadPool::GetCurrentWorkerIndex() >= 0;
+#else
+  return false;
+#endif
+}
+
+MultiThreaderBase *
+MultiThreaderBase::GetCurrentThreadDefaultMultiThreader()
+{
+  // A multi-threader must not run two parallel sections at once, so each
+  // calling thread has its own.
+  thread_local Pointer      multiThreader;
+  thread_local ThreaderEnum threaderType{ ThreaderEnum::Unknown };
+  thread_local ThreadIdType numberOfWorkUnits{ 0 };
+
+  const ThreaderEnum globalThreaderType = GetGlobalDefaultThreader();
+  const ThreadIdType globalNumberOfThreads = GetGlobalDefaultNumberOfThreads();
+  if (multiThreader.IsNull() || threaderType != globalThreaderType || numberOfWorkUnits != globalNumberOfThreads)
+  {
+    multiThreader = MultiThreaderBase::New();
+    threaderType = globalThreaderType;
+    numberOfWorkUnits = globalNumberOfThreads;
+  }
+  return multiThreader.GetPointer();
+}
+
 void
 MultiThreaderBase::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
 {
@@ -411,6 +485,12 @@ MultiThreaderBase::New()
 #endif
       case ThreaderEnum::Single:
         return SingleMultiThreader::New();
+      case ThreaderEnum::WorkStealing:
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+        return WorkStealingMultiThreader::New();
+#else
+        itkGenericExceptionMacro("ITK has been built without WorkStealingMultiThreader support!");
+#endif
       default:
         itkGenericExceptionMacro("MultiThreaderBase::GetGlobalDefaultThreader returned Unknown!");
     }
@@ -478,6 +558,7 @@ MultiThreaderBase::ParallelizeArray(SizeValueType             firstIndex,
   // This implementation simply delegates parallelization to the old interface
   // SetSingleMethod+SingleMethodExecute. This method is meant to be overloaded!
 
+  const char * const name = PipelineTracer::GetNameOfFilter(filter, "ParallelizeArray");
   if (!this->GetUpdateProgress())
   {
     filter = nullptr;
@@ -487,7 +568,7 @@ MultiThreaderBase::ParallelizeArray(SizeValueType             firstIndex,
 
   if (firstIndex + 1 < lastIndexPlus1)
   {
-    struct ArrayCallback acParams{ aFunc, firstIndex, lastIndexPlus1, filter };
+    struct ArrayCallback acParams{ aFunc, firstIndex, lastIndexPlus1, filter, name };
     this->SetSingleMethodAndExecute(&MultiThreaderBase::ParallelizeArrayHelper, &acParams);
   }
   else if (firstIndex + 1 == lastIndexPlus1)
@@ -517,6 +598,11 @@ MultiThreaderBase::ParallelizeArrayHelper(void * arg)
 
   TotalProgressReporter reporter(acParams->filter, range);
 
+  PipelineTracer::Span span("WorkUnit", acParams->name);
+  if (span.IsActive())
+  {
+    span.SetDetail("indices [" + std::to_string(first) + ", " + std::to_string(afterLast) + ')');
+  }
   for (SizeValueType i = first; i < afterLast; ++i)
   {
     acParams->functor(i);
@@ -587,6 +673,7 @@ MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Global Maximum Number Of Threads: " << m_PimplGlobals->m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: " << m_PimplGlobals->m_GlobalDefaultNumberOfThreads << std::endl;
   os << indent << "Global Default Threader Type: " << m_PimplGlobals->m_GlobalDefaultThreader << std::endl;
+  os << indent << "Global NUMA Aware: " << (m_PimplGlobals->m_GlobalNUMAAware ? "On" : "Off") << std::endl;
   os << indent << "SingleMethod: " << m_SingleMethod << std::endl;
   os << indent << "SingleData: " << m_SingleData << std::endl;
 }
@@ -610,6 +697,8 @@ operator<<(std::ostream & out, const MultiThreaderBaseEnums::Threader value)
         return "itk::MultiThreaderBaseEnums::Threader::TBB";
       case MultiThreaderBaseEnums::Threader::Single:
         return "itk::MultiThreaderBaseEnums::Threader::Single";
+      case MultiThreaderBaseEnums::Threader::WorkStealing:
+        return "itk::MultiThreaderBaseEnums::Threader::WorkStealing";
         //      TODO    case MultiThreaderBaseEnums::Threader::Last:
         //                    return "itk::MultiThreaderBaseEnums::Threader::Last";
       case MultiThreaderBaseEnums::Threader::Unknown:
@@ -0,0 +1,334 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineTracer.h"
+#include "itkObjectFactory.h"
+#include "itkProcessObject.h"
+#include "itkSingleton.h"
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+
+namespace itk
+{
+
+struct PipelineTracerGlobals
+{
+  PipelineTracer::Pointer m_Instance{ nullptr };
+  std::recursive_mutex    m_StaticInstanceLock;
+  std::atomic<bool>       m_Enabled{ false };
+};
+
+namespace
+{
+// The innermost span of each thread, to which the allocations are accounted.
+thread_local PipelineTracer::Span * t_InnermostSpan = nullptr;
+
+void
+WriteJSONString(std::ostream & os, const std::string & value)
+{
+  os << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+             << std::setfill(' ');
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+
+// Trace event times are in microseconds.
+void
+WriteMicroseconds(std::ostream & os, uint64_t nanoseconds)
+{
+  os << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000 << std::setfill(' ');
+}
+} // namespace
+
+PipelineTracer::Span::Span(const char * category, const char * name)
+{
+  if (PipelineTracer::GetEnabled())
+  {
+    m_Active = true;
+    m_Category = category;
+    m_Name = name;
+    m_Parent = t_InnermostSpan;
+    t_InnermostSpan = this;
+    m_Start = std::chrono::steady_clock::now();
+  }
+}
+
+PipelineTracer::Span::~Span()
+{
+  if (!m_Active)
+  {
+    return;
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  t_InnermostSpan = m_Parent;
+
+  const PipelineTracer::Pointer tracer = PipelineTracer::GetInstance();
+  Event                         event;
+  event.Category = m_Category;
+  event.Name = m_Name;
+  event.Detail = std::move(m_Detail);
+  event.Start = tracer->GetTimeSinceStart(m_Start);
+  event.Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - m_Start).count();
+  event.AllocatedBytes = m_AllocatedBytes;
+  tracer->RecordEvent(std::move(event));
+}
+
+void
+PipelineTracer::Span::SetDetail(std::string detail)
+{
+  if (m_Active)
+  {
+    m_Detail = std::move(detail);
+  }
+}
+
+void
+PipelineTracer::Span::SetRegion(unsigned int dimension, const IndexValueType index[], const SizeValueType size[])
+{
+  if (!m_Active)
+  {
+    return;
+  }
+  std::ostringstream detail;
+  detail << "index [";
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    detail << (d > 0 ? ", " : "") << index[d];
+  }
+  detail << "] size [";
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    detail << (d > 0 ? ", " : "") << size[d];
+  }
+  detail << ']';
+  m_Detail = detail.str();
+}
+
+PipelineTracer::PipelineTracer()
+  : m_Origin(std::chrono::steady_clock::now())
+{}
+
+PipelineTracer::~PipelineTracer() = default;
+
+itkGetGlobalSimpleMacro(PipelineTracer, PipelineTracerGlobals, PimplGlobals);
+
+PipelineTracerGlobals * PipelineTracer::m_PimplGlobals;
+
+PipelineTracer::Pointer
+PipelineTracer::GetInstance()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::recursive_mutex> lockGuard(m_PimplGlobals->m_StaticInstanceLock);
+  if (!m_PimplGlobals->m_Instance)
+  {
+    // Try the factory first
+    m_PimplGlobals->m_Instance = ObjectFactory<Self>::Create();
+    // if the factory did not provide one, then create it here
+    if (!m_PimplGlobals->m_Instance)
+    {
+      m_PimplGlobals->m_Instance = new PipelineTracer;
+      // Remove extra reference from construction.
+      m_PimplGlobals->m_Instance->UnRegister();
+    }
+  }
+  return m_PimplGlobals->m_Instance;
+}
+
+void
+PipelineTracer::SetInstance(PipelineTracer * instance)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::recursive_mutex> lockGuard(m_PimplGlobals->m_StaticInstanceLock);
+  m_PimplGlobals->m_Instance = instance;
+}
+
+/**
+ * This just calls GetInstance
+ */
+PipelineTracer::Pointer
+PipelineTracer::New()
+{
+  return GetInstance();
+}
+
+void
+PipelineTracer::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if (enabled)
+  {
+    // start the clock of the trace before the first span
+    GetInstance();
+  }
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+bool
+PipelineTracer::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled.load(std::memory_order_relaxed);
+}
+
+void
+PipelineTracer::AddAllocatedBytes(SizeValueType bytes)
+{
+  if (t_InnermostSpan)
+  {
+    t_InnermostSpan->m_AllocatedBytes += bytes;
+  }
+}
+
+const char *
+PipelineTracer::GetNameOfFilter(const ProcessObject * filter, const char * defaultName)
+{
+  return filter ? filter->GetNameOfClass() : defaultName;
+}
+
+void
+PipelineTracer::RecordEvent(Event event)
+{
+  const std::thread::id             id = std::this_thread::get_id();
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  event.ThreadIndex = this->GetThreadIndex(id);
+  m_Events.push_back(std::move(event));
+}
+
+unsigned int
+PipelineTracer::GetThreadIndex(std::thread::id id)
+{
+  const auto inserted = m_ThreadIndices.emplace(id, static_cast<unsigned int>(m_ThreadIndices.size()));
+  return inserted.first->second;
+}
+
+std::vector<PipelineTracer::Event>
+PipelineTracer::GetEvents() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_Events;
+}
+
+SizeValueType
+PipelineTracer::GetNumberOfEvents() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_Events.size();
+}
+
+void
+PipelineTracer::Clear()
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  m_Events.clear();
+  m_ThreadIndices.clear();
+  m_Origin = std::chrono::steady_clock::now();
+}
+
+uint64_t
+PipelineTracer::GetTimeSinceStart(std::chrono::steady_clock::time_point time) const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  // spans which started before the last Clear() start at 0
+  if (time < m_Origin)
+  {
+    return 0;
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_Origin).count();
+}
+
+void
+PipelineTracer::WriteChromeTrace(std::ostream & os) const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  os << "{\"traceEvents\":[";
+  for (size_t i = 0; i < m_Events.size(); ++i)
+  {
+    const Event & event = m_Events[i];
+    os << (i > 0 ? ",\n" : "\n") << "{\"name\":";
+    WriteJSONString(os, event.Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, event.Category);
+    os << ",\"ph\":\"X\",\"ts\":";
+    WriteMicroseconds(os, event.Start);
+    os << ",\"dur\":";
+    WriteMicroseconds(os, event.Duration);
+    os << ",\"pid\":1,\"tid\":" << event.ThreadIndex << ",\"args\":{";
+    const char * separator = "";
+    if (!event.Detail.empty())
+    {
+      os << "\"detail\":";
+      WriteJSONString(os, event.Detail);
+      separator = ",";
+    }
+    if (event.AllocatedBytes > 0)
+    {
+      os << separator << "\"allocatedBytes\":" << event.AllocatedBytes;
+    }
+    os << "}}";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+void
+PipelineTracer::WriteChromeTraceFile(const std::string & fileName) const
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for writing.");
+  }
+  this->WriteChromeTrace(file);
+}
+
+void
+PipelineTracer::PrintSelf(std::ostream & os, Indent indent) const
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "PipelineTracer (single instance): " << (void *)m_PimplGlobals->m_Instance << std::endl;
+  os << indent << "Enabled: " << (m_PimplGlobals->m_Enabled ? "On" : "Off") << std::endl;
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << std::endl;
+}
+} // end namespace itk
@@ -132,8 +132,11 @@ PoolMultiThreader::SingleMethodExecute()
   {
     m_ThreadInfoArray[threadLoop].UserData = m_SingleData;
     m_ThreadInfoArray[threadLoop].NumberOfWorkUnits = m_NumberOfWorkUnits;
-    m_ThreadInfoArray[threadLoop].Future = m_ThreadPool->AddWork(
-      [method = m_SingleMethod, threadInfo = &m_ThreadInfoArray[threadLoop]] { method(threadInfo); });
+    m_ThreadInfoArray[threadLoop].Future =
+      m_ThreadPool->AddWorkToNode(m_ThreadPool->GetNodeOfWorkUnit(threadLoop, m_NumberOfWorkUnits),
+                                  [method = m_SingleMethod, threadInfo = &m_ThreadInfoArray[threadLoop]] {
+                                    method(threadInfo);
+                                  });
   }
 
   // Now, the parent thread calls this->SingleMethod() itself
@@ -158,6 +161,7 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
                                     ArrayThreadingFunctorType aFunc,
                                     ProcessObject *           filter)
 {
+  const char * const name = PipelineTracer::GetNameOfFilter(filter, "ParallelizeArray");
   if (!this->GetUpdateProgress())
   {
     filter = nullptr;
@@ -171,17 +175,26 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
       ++chunkSize; // we want slightly bigger chunks to be processed first
     }
 
-    auto lambda = [aFunc](SizeValueType start, SizeValueType end) {
+    auto lambda = [aFunc, name](SizeValueType start, SizeValueType end) {
+      PipelineTracer::Span span("WorkUnit", name);
+      if (span.IsActive())
+      {
+        span.SetDetail("indices [" + std::to_string(start) + ", " + std::to_string(end) + ')');
+      }
       for (SizeValueType ii = start; ii < end; ++ii)
       {
         aFunc(ii);
       }
     };
 
-    SizeValueType workUnit = 1;
+    // the chunks are queued on the nodes in order, like the parts of a region
+    const SizeValueType numberOfChunks = (lastIndexPlus1 - firstIndex + chunkSize - 1) / chunkSize;
+    SizeValueType       workUnit = 1;
     for (SizeValueType i = firstIndex + chunkSize; i < lastIndexPlus1; i += chunkSize)
     {
-      m_ThreadInfoArray[workUnit++].Future = m_ThreadPool->AddWork(lambda, i, std::min(i + chunkSize, lastIndexPlus1));
+      const unsigned int node = m_ThreadPool->GetNodeOfWorkUnit(workUnit, numberOfChunks);
+      m_ThreadInfoArray[workUnit++].Future =
+        m_ThreadPool->AddWorkToNode(node, lambda, i, std::min(i + chunkSize, lastIndexPlus1));
     }
     itkAssertOrThrowMacro(workUnit <= m_NumberOfWorkUnits, "Number of work units was somehow miscounted!");
 
@@ -264,8 +277,12 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
         total = splitter->GetSplit(i, splitCount, iRegion);
         if (i < total)
         {
+          // queue the work unit on the node where Image::Allocate placed its
+          // part of the buffer, when the pool is NUMA aware
           m_ThreadInfoArray[i].Future =
-            m_ThreadPool->AddWork([funcP, iRegion]() { funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]); });
+            m_ThreadPool->AddWorkToNode(m_ThreadPool->GetNodeOfWorkUnit(i, splitCount), [funcP, iRegion]() {
+              funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
+            });
         }
         else
         {
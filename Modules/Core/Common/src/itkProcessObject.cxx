@@ -32,6 +32,7 @@
 #include <sstream>
 #include <algorithm>
 #include "itkMultiThreaderBase.h"
+#include "itkPipelineTracer.h"
 
 namespace itk
 {
@@ -1681,6 +1682,11 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 
   try
   {
+    PipelineTracer::Span span("Filter", this->GetNameOfClass());
+    if (span.IsActive())
+    {
+      span.SetDetail(this->GetObjectName());
+    }
     this->GenerateData();
   }
   catch (const ProcessAborted &)
@@ -119,6 +119,7 @@ TBBMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
                                    ArrayThreadingFunctorType aFunc,
                                    ProcessObject *           filter)
 {
+  const char * const name = PipelineTracer::GetNameOfFilter(filter, "ParallelizeArray");
   if (!this->GetUpdateProgress())
   {
     filter = nullptr;
@@ -142,6 +143,11 @@ TBBMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
         TotalProgressReporter progress(filter, count, 100);
         progress.CheckAbortGenerateData();
 
+        PipelineTracer::Span span("WorkUnit", name);
+        if (span.IsActive())
+        {
+          span.SetDetail("index " + std::to_string(r.begin()));
+        }
         aFunc(r.begin()); // invoke the function
 
         progress.CompletedPixel();
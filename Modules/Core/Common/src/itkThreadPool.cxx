@@ -27,12 +27,107 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <fstream>
 #include <mutex>
+#include <sstream>
+#include <string>
+
+#if defined(ITK_HAS_SCHED_GETAFFINITY) || defined(ITK_HAS_PTHREAD_SETAFFINITY_NP)
+#  include <sched.h>
+#endif
+#if defined(ITK_HAS_PTHREAD_SETAFFINITY_NP)
+#  include <pthread.h>
+#endif
 
 
 namespace itk
 {
 
+namespace
+{
+// Parse a list of processors or nodes as written by Linux, e.g. "0-3,8-11".
+std::vector<unsigned int>
+ParseList(const std::string & list)
+{
+  std::vector<unsigned int> values;
+  std::istringstream        stream(list);
+  std::string               range;
+  while (std::getline(stream, range, ','))
+  {
+    std::istringstream rangeStream(range);
+    unsigned int       first = 0;
+    if (!(rangeStream >> first))
+    {
+      continue;
+    }
+    unsigned int last = first;
+    char         dash = 0;
+    if (rangeStream >> dash && (dash != '-' || !(rangeStream >> last)))
+    {
+      last = first;
+    }
+    for (unsigned int value = first; value <= last; ++value)
+    {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+// The processors of each NUMA node which may run this process. The nodes
+// without such processors, like memory only nodes, are left out.
+std::vector<std::vector<unsigned int>>
+ReadNUMANodeProcessors()
+{
+  std::vector<std::vector<unsigned int>> nodeProcessors;
+#if defined(__linux__)
+  std::ifstream onlineFile("/sys/devices/system/node/online");
+  std::string   online;
+  if (!std::getline(onlineFile, online))
+  {
+    return nodeProcessors;
+  }
+#  if defined(ITK_HAS_SCHED_GETAFFINITY)
+  cpu_set_t  mask;
+  const bool hasMask = sched_getaffinity(0, sizeof(cpu_set_t), &mask) == 0;
+#  endif
+  for (const unsigned int node : ParseList(online))
+  {
+    std::ifstream cpuListFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string   cpuList;
+    std::getline(cpuListFile, cpuList);
+    std::vector<unsigned int> processors = ParseList(cpuList);
+#  if defined(ITK_HAS_SCHED_GETAFFINITY)
+    if (hasMask)
+    {
+      processors.erase(std::remove_if(processors.begin(),
+                                      processors.end(),
+                                      [&mask](unsigned int processor) {
+                                        return processor >= CPU_SETSIZE || !CPU_ISSET(processor, &mask);
+                                      }),
+                       processors.end());
+    }
+#  endif
+    if (!processors.empty())
+    {
+      nodeProcessors.push_back(std::move(processors));
+    }
+  }
+#endif
+  return nodeProcessors;
+}
+
+// Whether the current thread is one of the threads of the pool.
+thread_local bool currentThreadIsWorker = false;
+
+const std::vector<std::vector<unsigned int>> &
+GetNUMANodeProcessors()
+{
+  static const std::vector<std::vector<unsigned int>> nodeProcessors = ReadNUMANodeProcessors();
+  return nodeProcessors;
+}
+} // namespace
+
 struct ThreadPoolGlobals
 {
   ThreadPoolGlobals() = default;
@@ -46,6 +141,10 @@ struct ThreadPoolGlobals
   // The singleton instance of ThreadPool.
   ThreadPool::Pointer m_ThreadPoolInstance;
 
+  // The processors to which the threads of each node are pinned. Empty
+  // unless the thread pool is NUMA aware and there are several nodes.
+  std::vector<std::vector<unsigned int>> m_NodeProcessors;
+
 #if defined(_WIN32) && defined(ITKCommon_EXPORTS)
   // ThreadPool's destructor is called during DllMain's DLL_PROCESS_DETACH.
   // Because ITKCommon-5.X.dll is usually being detached due to process termination,
@@ -112,13 +211,58 @@ ThreadPool::ThreadPool()
   m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
   m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
   const ThreadIdType threadCount = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+
+  // every node needs at least one thread to execute its queue
+  if (MultiThreaderBase::GetGlobalNUMAAware() && GetNUMANodeProcessors().size() > 1 && threadCount > 1)
+  {
+    m_PimplGlobals->m_NodeProcessors = GetNUMANodeProcessors();
+    m_PimplGlobals->m_NodeProcessors.resize(std::min<size_t>(m_PimplGlobals->m_NodeProcessors.size(), threadCount));
+  }
+  const size_t numberOfNodes = std::max<size_t>(m_PimplGlobals->m_NodeProcessors.size(), 1);
+  m_NodeWorkQueues.resize(numberOfNodes);
+  m_NodeConditions = std::vector<std::condition_variable>(numberOfNodes);
+
   m_Threads.reserve(threadCount);
   for (ThreadIdType i = 0; i < threadCount; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    this->AddThread(i % numberOfNodes);
   }
 }
 
+bool
+ThreadPool::GetCurrentThreadIsWorker()
+{
+  return currentThreadIsWorker;
+}
+
+unsigned int
+ThreadPool::GetNumberOfNUMANodes()
+{
+  return static_cast<unsigned int>(std::max<size_t>(GetNUMANodeProcessors().size(), 1));
+}
+
+void
+ThreadPool::AddThread(unsigned int node)
+{
+  m_Threads.emplace_back(&ThreadPool::ThreadExecute, node);
+#if defined(ITK_HAS_PTHREAD_SETAFFINITY_NP)
+  if (!m_PimplGlobals->m_NodeProcessors.empty())
+  {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (const unsigned int processor : m_PimplGlobals->m_NodeProcessors[node])
+    {
+      if (processor < CPU_SETSIZE)
+      {
+        CPU_SET(processor, &mask);
+      }
+    }
+    // pinning only improves the placement, so a failure is ignored
+    pthread_setaffinity_np(m_Threads.back().native_handle(), sizeof(cpu_set_t), &mask);
+  }
+#endif
+}
+
 void
 ThreadPool::AddThreads(ThreadIdType count)
 {
@@ -126,7 +270,7 @@ ThreadPool::AddThreads(ThreadIdType count)
   m_Threads.reserve(m_Threads.size() + count);
   for (ThreadIdType i = 0; i < count; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    this->AddThread(m_Threads.size() % m_NodeWorkQueues.size());
   }
 }
 
@@ -140,7 +284,12 @@ int
 ThreadPool::GetNumberOfCurrentlyIdleThreads() const
 {
   const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
-  return static_cast<int>(m_Threads.size()) - static_cast<int>(m_WorkQueue.size()); // lousy approximation
+  size_t queuedJobs = m_WorkQueue.size();
+  for (const auto & nodeWorkQueue : m_NodeWorkQueues)
+  {
+    queuedJobs += nodeWorkQueue.size();
+  }
+  return static_cast<int>(m_Threads.size()) - static_cast<int>(queuedJobs); // lousy approximation
 }
 
 void
@@ -157,7 +306,10 @@ ThreadPool::CleanUp()
 
   if (shouldNotify)
   {
-    m_Condition.notify_all();
+    for (auto & condition : m_NodeConditions)
+    {
+      condition.notify_all();
+    }
   }
 
   // Even if the threads have already been terminated,
@@ -187,25 +339,32 @@ ThreadPool::ResumeFromFork()
 }
 
 void
-ThreadPool::ThreadExecute()
+ThreadPool::ThreadExecute(unsigned int node)
 {
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
 
+  std::deque<std::function<void()>> & nodeWorkQueue = threadPool->m_NodeWorkQueues[node];
+  std::condition_variable &           condition = threadPool->m_NodeConditions[node];
+  currentThreadIsWorker = true;
+
   while (true)
   {
     std::function<void()> task;
 
     {
       std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
-      threadPool->m_Condition.wait(mutexHolder,
-                                   [threadPool] { return threadPool->m_Stopping || !threadPool->m_WorkQueue.empty(); });
-      if (threadPool->m_Stopping && threadPool->m_WorkQueue.empty())
+      condition.wait(mutexHolder, [threadPool, &nodeWorkQueue] {
+        return threadPool->m_Stopping || !nodeWorkQueue.empty() || !threadPool->m_WorkQueue.empty();
+      });
+      // the jobs of this node go first, they cannot be executed by the other threads
+      std::deque<std::function<void()>> & workQueue = nodeWorkQueue.empty() ? threadPool->m_WorkQueue : nodeWorkQueue;
+      if (workQueue.empty()) // stopping, and no job is left
       {
         return;
       }
-      task = std::move(threadPool->m_WorkQueue.front());
-      threadPool->m_WorkQueue.pop_front();
+      task = std::move(workQueue.front());
+      workQueue.pop_front();
     }
 
     task(); // execute the task
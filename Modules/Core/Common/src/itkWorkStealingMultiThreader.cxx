@@ -0,0 +1,231 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkStealingMultiThreader.h"
+#include "itkProcessObject.h"
+#include "itkImageSourceCommon.h"
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+WorkStealingMultiThreader::WorkStealingMultiThreader()
+  : m_ThreadPool(WorkStealingThreadPool::GetInstance())
+{
+  ThreadIdType defaultThreads = std::max(1u, GetGlobalDefaultNumberOfThreads());
+  if (defaultThreads > 1) // one work unit for only one thread
+  {
+    defaultThreads *= 4; // more work units than threads leaves something to steal
+  }
+  m_NumberOfWorkUnits = std::min<ThreadIdType>(ITK_MAX_THREADS, defaultThreads);
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+WorkStealingMultiThreader::~WorkStealingMultiThreader() = default;
+
+void
+WorkStealingMultiThreader::SetSingleMethod(ThreadFunctionType f, void * data)
+{
+  m_SingleMethod = std::move(f);
+  m_SingleData = data;
+}
+
+void
+WorkStealingMultiThreader::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
+{
+  Superclass::SetMaximumNumberOfThreads(numberOfThreads);
+  const ThreadIdType threadCount = m_ThreadPool->GetMaximumNumberOfThreads();
+  if (threadCount < m_MaximumNumberOfThreads)
+  {
+    m_ThreadPool->AddThreads(m_MaximumNumberOfThreads - threadCount);
+  }
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+void
+WorkStealingMultiThreader::SingleMethodExecute()
+{
+  if (!m_SingleMethod)
+  {
+    itkExceptionStringMacro("No single method set!");
+  }
+
+  // obey the global maximum number of threads limit
+  m_NumberOfWorkUnits = std::min(this->GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits);
+
+  // WorkUnitInfo structures live on this stack frame, because nested
+  // calls to SingleMethodExecute of the same threader may be in flight.
+  std::vector<WorkUnitInfo> workUnitInfos(m_NumberOfWorkUnits);
+
+  WorkStealingThreadPool::TaskGroup taskGroup;
+  for (ThreadIdType workUnit = 1; workUnit < m_NumberOfWorkUnits; ++workUnit)
+  {
+    WorkUnitInfo & info = workUnitInfos[workUnit];
+    info.WorkUnitID = workUnit;
+    info.NumberOfWorkUnits = m_NumberOfWorkUnits;
+    info.UserData = m_SingleData;
+    m_ThreadPool->Submit(taskGroup, [method = m_SingleMethod, &info] { method(&info); });
+  }
+
+  // Now, the calling thread executes the first work unit itself
+  WorkUnitInfo & info = workUnitInfos[0];
+  info.WorkUnitID = 0;
+  info.NumberOfWorkUnits = m_NumberOfWorkUnits;
+  info.UserData = m_SingleData;
+  std::exception_ptr firstException;
+  try
+  {
+    m_SingleMethod(&info);
+  }
+  catch (...)
+  {
+    firstException = std::current_exception();
+  }
+
+  // The calling thread executes pending work units while it waits for the others
+  try
+  {
+    m_ThreadPool->Wait(taskGroup);
+  }
+  catch (...)
+  {
+    if (firstException == nullptr)
+    {
+      firstException = std::current_exception();
+    }
+  }
+
+  if (firstException != nullptr)
+  {
+    std::rethrow_exception(firstException);
+  }
+}
+
+void
+WorkStealingMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
+                                            SizeValueType             lastIndexPlus1,
+                                            ArrayThreadingFunctorType aFunc,
+                                            ProcessObject *           filter)
+{
+  const char * const name = PipelineTracer::GetNameOfFilter(filter, "ParallelizeArray");
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  if (firstIndex + 1 < lastIndexPlus1)
+  {
+    const SizeValueType count = lastIndexPlus1 - firstIndex;
+    SizeValueType       chunkSize = count / m_NumberOfWorkUnits;
+    if (count % m_NumberOfWorkUnits > 0)
+    {
+      ++chunkSize; // we want slightly bigger chunks to be processed first
+    }
+
+    WorkStealingThreadPool::TaskGroup taskGroup;
+    for (SizeValueType i = firstIndex; i < lastIndexPlus1; i += chunkSize)
+    {
+      const SizeValueType end = std::min(i + chunkSize, lastIndexPlus1);
+      m_ThreadPool->Submit(taskGroup, [&aFunc, filter, name, count, i, end] {
+        TotalProgressReporter progress(filter, count, 100);
+        progress.CheckAbortGenerateData();
+        PipelineTracer::Span span("WorkUnit", name);
+        if (span.IsActive())
+        {
+          span.SetDetail("indices [" + std::to_string(i) + ", " + std::to_string(end) + ')');
+        }
+        for (SizeValueType ii = i; ii < end; ++ii)
+        {
+          aFunc(ii);
+          progress.CompletedPixel();
+        }
+      });
+    }
+    m_ThreadPool->Wait(taskGroup);
+  }
+  else if (firstIndex + 1 == lastIndexPlus1)
+  {
+    aFunc(firstIndex);
+  }
+  // else nothing needs to be executed
+}
+
+void
+WorkStealingMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
+                                                  const IndexValueType index[],
+                                                  const SizeValueType  size[],
+                                                  ThreadingFunctorType funcP,
+                                                  ProcessObject *      filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  ImageIORegion region(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
+  }
+
+  if (m_NumberOfWorkUnits == 1 || region.GetNumberOfPixels() <= 1)
+  {
+    funcP(index, size); // process whole region
+    return;
+  }
+
+  const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
+  const ThreadIdType              splitCount = splitter->GetNumberOfSplits(region, m_NumberOfWorkUnits);
+  const SizeValueType             totalCount = region.GetNumberOfPixels();
+
+  WorkStealingThreadPool::TaskGroup taskGroup;
+  for (ThreadIdType i = 0; i < splitCount; ++i)
+  {
+    ImageIORegion iRegion = region;
+    if (splitter->GetSplit(i, splitCount, iRegion) <= i)
+    {
+      // Let the already submitted pieces finish before reporting the failure
+      m_ThreadPool->Wait(taskGroup);
+      itkExceptionMacro("Could not get work unit " << i
+                                                   << " even though we checked possible number of splits beforehand!");
+    }
+    m_ThreadPool->Submit(taskGroup, [&funcP, filter, totalCount, iRegion] {
+      TotalProgressReporter progress(filter, totalCount, 100);
+      progress.CheckAbortGenerateData();
+      funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
+      progress.Completed(iRegion.GetNumberOfPixels());
+    });
+  }
+  m_ThreadPool->Wait(taskGroup);
+}
+
+void
+WorkStealingMultiThreader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(ThreadPool);
+}
+
+} // namespace itk
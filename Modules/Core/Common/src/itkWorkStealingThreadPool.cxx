@@ -0,0 +1,343 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWorkStealingThreadPool.h"
+#include "itkThreadSupport.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+
+namespace itk
+{
+
+struct WorkStealingThreadPoolGlobals
+{
+  WorkStealingThreadPoolGlobals() = default;
+
+  // To lock on the various internal variables.
+  std::mutex m_Mutex;
+
+  // To allow singleton creation of WorkStealingThreadPool.
+  std::once_flag m_ThreadPoolOnceFlag;
+
+  // The singleton instance of WorkStealingThreadPool.
+  WorkStealingThreadPool::Pointer m_ThreadPoolInstance;
+};
+
+itkGetGlobalSimpleMacro(WorkStealingThreadPool, WorkStealingThreadPoolGlobals, PimplGlobals);
+
+namespace
+{
+// Index of the worker executing on this thread, -1 for threads outside the pool.
+thread_local int tlsWorkerIndex = -1;
+
+// Idle waiters re-check for stealable work at this interval.
+constexpr std::chrono::microseconds waitPollingInterval{ 500 };
+} // namespace
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::New()
+{
+  return Self::GetInstance();
+}
+
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::GetInstance()
+{
+  // This is called once, on-demand to ensure that m_PimplGlobals is
+  // initialized.
+  itkInitGlobalsMacro(PimplGlobals);
+
+  // Create a singleton WorkStealingThreadPool.
+  std::call_once(m_PimplGlobals->m_ThreadPoolOnceFlag, []() {
+    m_PimplGlobals->m_ThreadPoolInstance = ObjectFactory<Self>::Create();
+    if (m_PimplGlobals->m_ThreadPoolInstance.IsNull())
+    {
+      new WorkStealingThreadPool(); // constructor sets m_PimplGlobals->m_ThreadPoolInstance
+    }
+#if defined(ITK_USE_PTHREADS)
+    pthread_atfork(WorkStealingThreadPool::PrepareForFork,
+                   WorkStealingThreadPool::ResumeFromFork,
+                   WorkStealingThreadPool::ResumeFromFork);
+#endif
+  });
+
+  return m_PimplGlobals->m_ThreadPoolInstance;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+  : m_Queues(new WorkerQueue[ITK_MAX_THREADS])
+{
+  // m_PimplGlobals->m_Mutex not needed to be acquired here because construction only occurs via GetInstance which is
+  // protected by call_once.
+
+  m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
+  m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
+  this->StartWorkers(MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+}
+
+void
+WorkStealingThreadPool::StartWorkers(ThreadIdType count)
+{
+  // m_PimplGlobals->m_Mutex must be already held here, or the pool must not be shared yet!
+
+  const ThreadIdType first = m_NumberOfWorkers.load();
+  const ThreadIdType last = std::min<ThreadIdType>(first + count, ITK_MAX_THREADS);
+  m_Threads.reserve(last);
+  for (ThreadIdType i = first; i < last; ++i)
+  {
+    m_Threads.emplace_back(&WorkStealingThreadPool::ThreadExecute, i);
+    m_NumberOfWorkers.store(i + 1, std::memory_order_release);
+  }
+}
+
+void
+WorkStealingThreadPool::AddThreads(ThreadIdType count)
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  this->StartWorkers(count);
+}
+
+int
+WorkStealingThreadPool::GetCurrentWorkerIndex()
+{
+  return tlsWorkerIndex;
+}
+
+void
+WorkStealingThreadPool::Push(std::function<void()> task)
+{
+  const ThreadIdType numberOfWorkers = std::max<ThreadIdType>(1, m_NumberOfWorkers.load(std::memory_order_acquire));
+  const int          self = tlsWorkerIndex;
+  const unsigned int target =
+    self >= 0 ? static_cast<unsigned int>(self) : m_NextQueue.fetch_add(1, std::memory_order_relaxed) % numberOfWorkers;
+  {
+    WorkerQueue &                     queue = m_Queues[target];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    queue.m_Tasks.push_back(std::move(task));
+  }
+
+  m_QueuedTasks.fetch_add(1);
+  if (m_NumberOfSleepingWorkers.load() > 0)
+  {
+    // Taking the lock guarantees that a worker which has just checked
+    // m_QueuedTasks is either not asleep yet or will receive this notification.
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+    }
+    m_Condition.notify_one();
+  }
+}
+
+bool
+WorkStealingThreadPool::PopOwn(unsigned int workerIndex, std::function<void()> & task)
+{
+  WorkerQueue &                     queue = m_Queues[workerIndex];
+  const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+  if (queue.m_Tasks.empty())
+  {
+    return false;
+  }
+  task = std::move(queue.m_Tasks.back());
+  queue.m_Tasks.pop_back();
+  m_QueuedTasks.fetch_sub(1);
+  return true;
+}
+
+bool
+WorkStealingThreadPool::Steal(unsigned int thiefIndex, std::function<void()> & task)
+{
+  const ThreadIdType numberOfWorkers = m_NumberOfWorkers.load(std::memory_order_acquire);
+  if (numberOfWorkers == 0 || m_QueuedTasks.load() == 0)
+  {
+    return false;
+  }
+  // Start with the next worker, so that thieves spread over the victims.
+  const unsigned int start = (thiefIndex + 1) % numberOfWorkers;
+  for (unsigned int i = 0; i < numberOfWorkers; ++i)
+  {
+    const unsigned int victim = (start + i) % numberOfWorkers;
+    if (victim == thiefIndex)
+    {
+      continue;
+    }
+    WorkerQueue &                     queue = m_Queues[victim];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    if (!queue.m_Tasks.empty())
+    {
+      task = std::move(queue.m_Tasks.front());
+      queue.m_Tasks.pop_front();
+      m_QueuedTasks.fetch_sub(1);
+      m_StolenTasks.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+WorkStealingThreadPool::TryExecuteOneTask()
+{
+  const int             self = tlsWorkerIndex;
+  std::function<void()> task;
+  if (self >= 0 ? (this->PopOwn(self, task) || this->Steal(self, task))
+                : this->Steal(static_cast<unsigned int>(ITK_MAX_THREADS), task))
+  {
+    task(); // tasks are wrapped by Submit, so they never throw
+    return true;
+  }
+  return false;
+}
+
+void
+WorkStealingThreadPool::Submit(TaskGroup & group, std::function<void()> task)
+{
+  group.m_Pending.fetch_add(1, std::memory_order_acq_rel);
+  this->Push([&group, task = std::move(task)]() {
+    try
+    {
+      task();
+    }
+    catch (...)
+    {
+      const std::lock_guard<std::mutex> lockGuard(group.m_Mutex);
+      if (group.m_FirstException == nullptr)
+      {
+        group.m_FirstException = std::current_exception();
+      }
+    }
+    // The decrement happens under the group's lock, so that Wait() cannot
+    // return (and the group cannot be destroyed) while we still touch it.
+    const std::lock_guard<std::mutex> lockGuard(group.m_Mutex);
+    if (group.m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      group.m_Finished.notify_all();
+    }
+  });
+}
+
+void
+WorkStealingThreadPool::Wait(TaskGroup & group)
+{
+  while (group.m_Pending.load(std::memory_order_acquire) > 0)
+  {
+    // Help with pending work instead of blocking. This is what makes
+    // nested parallel sections safe: a worker waiting for its children
+    // executes them (or other work) itself.
+    if (this->TryExecuteOneTask())
+    {
+      continue;
+    }
+    // The remaining tasks of this group are running on other threads.
+    // They might still spawn stealable work, so only wait briefly.
+    std::unique_lock<std::mutex> lock(group.m_Mutex);
+    group.m_Finished.wait_for(
+      lock, waitPollingInterval, [&group] { return group.m_Pending.load(std::memory_order_acquire) == 0; });
+  }
+
+  std::exception_ptr exception;
+  {
+    const std::lock_guard<std::mutex> lockGuard(group.m_Mutex);
+    std::swap(exception, group.m_FirstException);
+  }
+  if (exception != nullptr)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+void
+WorkStealingThreadPool::CleanUp()
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+    m_Stopping = true;
+  }
+  m_Condition.notify_all();
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  for (auto & thread : m_Threads)
+  {
+    assert(thread.joinable());
+    thread.join();
+  }
+  m_Threads.clear();
+}
+
+void
+WorkStealingThreadPool::PrepareForFork()
+{
+  m_PimplGlobals->m_ThreadPoolInstance->CleanUp();
+}
+
+void
+WorkStealingThreadPool::ResumeFromFork()
+{
+  WorkStealingThreadPool * instance = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  const ThreadIdType       threadCount = instance->m_NumberOfWorkers.load();
+  instance->m_NumberOfWorkers = 0;
+  instance->m_Stopping = false;
+  instance->AddThreads(threadCount);
+}
+
+void
+WorkStealingThreadPool::ThreadExecute(unsigned int workerIndex)
+{
+  tlsWorkerIndex = static_cast<int>(workerIndex);
+
+  // plain pointer does not increase reference count
+  WorkStealingThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+
+  while (true)
+  {
+    if (threadPool->TryExecuteOneTask())
+    {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> mutexHolder(threadPool->m_SleepMutex);
+    ++threadPool->m_NumberOfSleepingWorkers;
+    threadPool->m_Condition.wait(
+      mutexHolder, [threadPool] { return threadPool->m_Stopping || threadPool->m_QueuedTasks.load() > 0; });
+    --threadPool->m_NumberOfSleepingWorkers;
+    if (threadPool->m_Stopping && threadPool->m_QueuedTasks.load() == 0)
+    {
+      return;
+    }
+  }
+}
+
+void
+WorkStealingThreadPool::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfWorkers: " << m_NumberOfWorkers.load() << std::endl;
+  os << indent << "QueuedTasks: " << m_QueuedTasks.load() << std::endl;
+  os << indent << "StolenTasks: " << m_StolenTasks.load() << std::endl;
+  os << indent << "Stopping: " << (m_Stopping ? "On" : "Off") << std::endl;
+}
+
+WorkStealingThreadPoolGlobals * WorkStealingThreadPool::m_PimplGlobals;
+
+} // namespace itk
@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferPool.h"
+#include "itkImage.h"
+#include "itkRGBPixel.h"
+#include "itkGTest.h"
+#include <algorithm>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+
+// Enable the pool for the lifetime of the fixture, and leave it disabled
+// and empty afterwards.
+class ImageBufferPoolFixture : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    itk::ImageBufferPool::SetEnabled(true);
+    m_Pool = itk::ImageBufferPool::GetInstance();
+    m_Pool->Clear();
+    m_Pool->ResetStatistics();
+    m_Pool->SetMaximumPooledBytes(SizeValueType{ 1 } << 30);
+  }
+
+  void
+  TearDown() override
+  {
+    itk::ImageBufferPool::SetEnabled(false);
+    m_Pool->ResetStatistics();
+  }
+
+  using SizeValueType = itk::SizeValueType;
+
+  template <typename TImage = ImageType>
+  static typename TImage::Pointer
+  MakeImage(bool initializePixels, itk::SizeValueType size = 32)
+  {
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::RegionType(typename TImage::SizeType{ { size, size, size } }));
+    image->Allocate(initializePixels);
+    return image;
+  }
+
+  itk::ImageBufferPool::Pointer m_Pool{};
+};
+} // namespace
+
+TEST(ImageBufferPool, BucketSizes)
+{
+  EXPECT_EQ(itk::ImageBufferPool::GetBucketSize(0), 4096u);
+  EXPECT_EQ(itk::ImageBufferPool::GetBucketSize(4096), 4096u);
+  EXPECT_EQ(itk::ImageBufferPool::GetBucketSize(4097), 4096u + 512u);
+  EXPECT_EQ(itk::ImageBufferPool::GetBucketSize(8192), 8192u);
+  EXPECT_EQ(itk::ImageBufferPool::GetBucketSize(8193), 8192u + 1024u);
+  for (itk::SizeValueType bytes = 4096; bytes < (itk::SizeValueType{ 1 } << 34); bytes = bytes * 3 / 2 + 7)
+  {
+    const itk::SizeValueType bucketSize = itk::ImageBufferPool::GetBucketSize(bytes);
+    EXPECT_GE(bucketSize, bytes);
+    EXPECT_LE(bucketSize, bytes + bytes / 8);
+    EXPECT_EQ(itk::ImageBufferPool::GetBucketSize(bucketSize), bucketSize);
+  }
+}
+
+TEST(ImageBufferPool, DisabledByDefault)
+{
+  EXPECT_FALSE(itk::ImageBufferPool::GetEnabled());
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 8, 8, 8 } }));
+  image->Allocate();
+  EXPECT_FALSE(itk::ImageBufferPool::HasAcquiredBuffers());
+  EXPECT_EQ(itk::ImageBufferPool::New(), itk::ImageBufferPool::GetInstance());
+}
+
+TEST_F(ImageBufferPoolFixture, RecyclesReleasedBuffers)
+{
+  constexpr itk::SizeValueType bytes = 32 * 32 * 32 * sizeof(float);
+
+  ImageType::Pointer image = MakeImage(false);
+  float * const      buffer = image->GetBufferPointer();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % itk::ImageBufferPool::Alignment, 0u);
+  EXPECT_EQ(m_Pool->GetNumberOfMisses(), 1u);
+  EXPECT_EQ(m_Pool->GetAcquiredBytes(), bytes);
+  EXPECT_TRUE(itk::ImageBufferPool::HasAcquiredBuffers());
+  image->FillBuffer(7.0f);
+
+  image = nullptr;
+  EXPECT_EQ(m_Pool->GetAcquiredBytes(), 0u);
+  EXPECT_EQ(m_Pool->GetPooledBytes(), bytes);
+  EXPECT_FALSE(itk::ImageBufferPool::HasAcquiredBuffers());
+
+  // a recycled buffer is not initialized by Allocate(false)
+  image = MakeImage(false);
+  EXPECT_EQ(image->GetBufferPointer(), buffer);
+  EXPECT_EQ(m_Pool->GetNumberOfHits(), 1u);
+  EXPECT_EQ(m_Pool->GetPooledBytes(), 0u);
+  EXPECT_EQ(image->GetBufferPointer()[bytes / sizeof(float) - 1], 7.0f);
+
+  // and is zero-initialized by Allocate(true)
+  image->Initialize();
+  image = MakeImage(true);
+  EXPECT_EQ(image->GetBufferPointer(), buffer);
+  EXPECT_EQ(m_Pool->GetNumberOfHits(), 2u);
+  const float * const begin = image->GetBufferPointer();
+  EXPECT_TRUE(std::all_of(begin, begin + bytes / sizeof(float), [](float value) { return value == 0.0f; }));
+
+  // another size is served by another bucket
+  const ImageType::Pointer other = MakeImage(false, 40);
+  EXPECT_NE(other->GetBufferPointer(), buffer);
+  EXPECT_EQ(m_Pool->GetNumberOfMisses(), 2u);
+}
+
+TEST_F(ImageBufferPoolFixture, DiscardsBuffersBeyondTheCap)
+{
+  m_Pool->SetMaximumPooledBytes(24 * 1024);
+
+  ImageType::Pointer first = MakeImage(false, 16);
+  ImageType::Pointer second = MakeImage(false, 16);
+  first = nullptr;
+  EXPECT_EQ(m_Pool->GetPooledBytes(), 16 * 16 * 16 * sizeof(float));
+  second = nullptr;
+  EXPECT_EQ(m_Pool->GetPooledBytes(), 16 * 16 * 16 * sizeof(float));
+  EXPECT_EQ(m_Pool->GetNumberOfDiscardedBuffers(), 1u);
+
+  m_Pool->SetMaximumPooledBytes(0);
+  EXPECT_EQ(m_Pool->GetPooledBytes(), 0u);
+}
+
+TEST_F(ImageBufferPoolFixture, FreesBuffersReleasedOnceDisabled)
+{
+  ImageType::Pointer image = MakeImage(false);
+  itk::ImageBufferPool::SetEnabled(false);
+  image = nullptr;
+  EXPECT_EQ(m_Pool->GetPooledBytes(), 0u);
+  EXPECT_EQ(m_Pool->GetAcquiredBytes(), 0u);
+  EXPECT_FALSE(itk::ImageBufferPool::HasAcquiredBuffers());
+}
+
+TEST_F(ImageBufferPoolFixture, LeavesImportedBuffersToTheContainer)
+{
+  const ImageType::Pointer pooled = MakeImage(false);
+
+  auto imported = ImageType::New();
+  imported->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 4, 4, 4 } }));
+  imported->GetPixelContainer()->SetImportPointer(new float[64], 64, true);
+  imported = nullptr;
+
+  EXPECT_EQ(m_Pool->GetPooledBytes(), 0u);
+  EXPECT_EQ(m_Pool->GetAcquiredBytes(), 32 * 32 * 32 * sizeof(float));
+}
+
+TEST_F(ImageBufferPoolFixture, PoolsOtherTriviallyDestructiblePixels)
+{
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 3>;
+  const RGBImageType::Pointer image = MakeImage<RGBImageType>(true, 16);
+  EXPECT_EQ(m_Pool->GetNumberOfMisses(), 1u);
+  EXPECT_EQ(image->GetPixel({ { 15, 15, 15 } }), RGBImageType::PixelType(static_cast<unsigned char>(0)));
+}
+
+TEST_F(ImageBufferPoolFixture, HandsOverACopyWhenTheContainerStopsManagingMemory)
+{
+  constexpr itk::SizeValueType bytes = 32 * 32 * 32 * sizeof(float);
+
+  const ImageType::Pointer image = MakeImage(false);
+  image->FillBuffer(3.0f);
+  float * const pooledBuffer = image->GetBufferPointer();
+  EXPECT_TRUE(m_Pool->IsAcquired(pooledBuffer));
+
+  image->GetPixelContainer()->ContainerManageMemoryOff();
+  float * const buffer = image->GetBufferPointer();
+  EXPECT_NE(buffer, pooledBuffer);
+  EXPECT_FALSE(m_Pool->IsAcquired(pooledBuffer));
+  EXPECT_EQ(m_Pool->GetAcquiredBytes(), 0u);
+  EXPECT_EQ(m_Pool->GetPooledBytes(), bytes);
+  EXPECT_TRUE(std::all_of(buffer, buffer + bytes / sizeof(float), [](float value) { return value == 3.0f; }));
+
+  // the application now owns a buffer it can free with delete[]
+  image->Initialize();
+  delete[] buffer;
+  EXPECT_EQ(m_Pool->GetPooledBytes(), bytes);
+}
@@ -18,7 +18,10 @@
 
 // First include the header file to be tested:
 #include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkThreadPool.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 
 namespace
 {
@@ -205,6 +208,39 @@ TEST(Image, FillBufferOfNonEqualityComparableType)
   }
 }
 
+
+// Tests that the parallel first touch of NUMA aware allocations initializes
+// the whole buffer, also from within a job of the thread pool.
+TEST(Image, AllocateWhenNUMAAware)
+{
+  const bool numaAware = itk::MultiThreaderBase::GetGlobalNUMAAware();
+  itk::MultiThreaderBase::SetGlobalNUMAAware(true);
+
+  using ImageType = itk::Image<float, 3>;
+  const auto allocate = [](bool initializePixels) {
+    const auto image = ImageType::New();
+    image->SetRegions(ImageType::RegionType({ 1, 2, 3 }, { 67, 129, 41 }));
+    image->Allocate(initializePixels);
+    return image;
+  };
+
+  ImageType::Pointer image = allocate(true);
+  const auto *       buffer = image->GetBufferPointer();
+  const auto         numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  EXPECT_TRUE(std::all_of(buffer, buffer + numberOfPixels, [](float value) { return value == 0.0f; }));
+
+  image = allocate(false);
+  image->FillBuffer(3.0f);
+  buffer = image->GetBufferPointer();
+  EXPECT_TRUE(std::all_of(buffer, buffer + numberOfPixels, [](float value) { return value == 3.0f; }));
+
+  image = itk::ThreadPool::GetInstance()->AddWork([&allocate] { return allocate(true); }).get();
+  buffer = image->GetBufferPointer();
+  EXPECT_TRUE(std::all_of(buffer, buffer + numberOfPixels, [](float value) { return value == 0.0f; }));
+
+  itk::MultiThreaderBase::SetGlobalNUMAAware(numaAware);
+}
+
 template <typename ImageType>
 typename ImageType::Pointer
 generate_image(typename ImageType::SizeType size)
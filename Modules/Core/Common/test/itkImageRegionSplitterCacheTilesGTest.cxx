@@ -0,0 +1,262 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionSplitterCacheTiles.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImageToImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkGTest.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using RegionType = itk::ImageRegion<Dimension>;
+using SizeType = itk::Size<Dimension>;
+using ImageType = itk::Image<float, Dimension>;
+
+// Count how many times each pixel of region is covered by the pieces.
+std::vector<int>
+CountCoverage(const RegionType & region, const std::vector<RegionType> & pieces)
+{
+  std::vector<int> coverage(region.GetNumberOfPixels(), 0);
+  for (const RegionType & piece : pieces)
+  {
+    EXPECT_TRUE(region.IsInside(piece));
+    const auto upperIndex = piece.GetUpperIndex();
+    for (auto z = piece.GetIndex(2); z <= upperIndex[2]; ++z)
+    {
+      for (auto y = piece.GetIndex(1); y <= upperIndex[1]; ++y)
+      {
+        for (auto x = piece.GetIndex(0); x <= upperIndex[0]; ++x)
+        {
+          const itk::SizeValueType offset =
+            (x - region.GetIndex(0)) +
+            region.GetSize(0) * ((y - region.GetIndex(1)) + region.GetSize(1) * (z - region.GetIndex(2)));
+          ++coverage[offset];
+        }
+      }
+    }
+  }
+  return coverage;
+}
+
+// Adds one to each pixel, reading its input with a margin of two pixels, and
+// records the regions it is called for.
+class PaddedFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PaddedFilter);
+
+  using Self = PaddedFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(PaddedFilter);
+
+  std::vector<RegionType> m_Regions;
+
+protected:
+  PaddedFilter() = default;
+
+  void
+  GenerateInputRequestedRegion() override
+  {
+    Superclass::GenerateInputRequestedRegion();
+    auto *     input = const_cast<ImageType *>(this->GetInput());
+    RegionType region = this->GetOutput()->GetRequestedRegion();
+    region.PadByRadius(2);
+    region.Crop(input->GetLargestPossibleRegion());
+    input->SetRequestedRegion(region);
+  }
+
+  void
+  DynamicThreadedGenerateData(const RegionType & region) override
+  {
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Regions.push_back(region);
+    }
+    itk::ImageRegionConstIterator<ImageType> inputIt(this->GetInput(), region);
+    itk::ImageRegionIterator<ImageType>      outputIt(this->GetOutput(), region);
+    for (; !outputIt.IsAtEnd(); ++inputIt, ++outputIt)
+    {
+      outputIt.Set(inputIt.Get() + 1.0f);
+    }
+  }
+
+private:
+  std::mutex m_Mutex;
+};
+} // namespace
+
+
+TEST(ImageRegionSplitterCacheTiles, ExerciseBasicObjectMethods)
+{
+  const auto splitter = itk::ImageRegionSplitterCacheTiles::New();
+  ITK_GTEST_EXERCISE_BASIC_OBJECT_METHODS(splitter, ImageRegionSplitterCacheTiles, ImageRegionSplitterSlowDimension);
+
+  EXPECT_EQ(splitter->GetCacheSize(), 512u * 1024u);
+  EXPECT_EQ(splitter->GetBytesPerPixel(), 8u);
+}
+
+
+TEST(ImageRegionSplitterCacheTiles, TilesFitInCacheAndCoverRegionOnce)
+{
+  const auto splitter = itk::ImageRegionSplitterCacheTiles::New();
+  splitter->SetCacheSize(256 * 1024);
+  splitter->SetBytesPerPixel(8);
+
+  const RegionType region({ 3, -2, 5 }, { 100, 37, 23 });
+  const SizeType   radius{ { 2, 1, 3 } };
+  const SizeType   tileSize = splitter->GetTileSize(region, radius);
+
+  // whole lines are kept, and the other dimensions are halved
+  EXPECT_EQ(tileSize[0], 100u);
+  EXPECT_LT(tileSize[1] * tileSize[2], 37u * 23u);
+  itk::SizeValueType workingSet = 8;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    workingSet *= tileSize[d] + 2 * radius[d];
+  }
+  EXPECT_LE(workingSet, splitter->GetCacheSize());
+
+  const itk::SizeValueType numberOfTiles = itk::ImageRegionSplitterCacheTiles::GetNumberOfTiles(region, tileSize);
+  std::vector<RegionType>  tiles;
+  for (itk::SizeValueType i = 0; i < numberOfTiles; ++i)
+  {
+    tiles.push_back(itk::ImageRegionSplitterCacheTiles::GetTile(i, region, tileSize));
+  }
+  const std::vector<int> coverage = CountCoverage(region, tiles);
+  EXPECT_TRUE(std::all_of(coverage.begin(), coverage.end(), [](int count) { return count == 1; }));
+
+  // consecutive tiles follow the memory order
+  EXPECT_EQ(tiles[0].GetIndex(), region.GetIndex());
+  EXPECT_EQ(tiles[1].GetIndex(1), region.GetIndex(1) + static_cast<itk::IndexValueType>(tileSize[1]));
+}
+
+
+TEST(ImageRegionSplitterCacheTiles, TilesAreNotSmallerThanTwiceTheRadius)
+{
+  const auto splitter = itk::ImageRegionSplitterCacheTiles::New();
+  splitter->SetCacheSize(1024);
+
+  const RegionType region({ 0, 0, 0 }, { 64, 64, 64 });
+  const SizeType   tileSize = splitter->GetTileSize(region, SizeType{ { 5, 6, 7 } });
+  EXPECT_GE(tileSize[0], 10u);
+  EXPECT_GE(tileSize[1], 12u);
+  EXPECT_GE(tileSize[2], 14u);
+}
+
+
+TEST(ImageRegionSplitterCacheTiles, SplitsInTilesOrSlabs)
+{
+  const auto splitter = itk::ImageRegionSplitterCacheTiles::New();
+  splitter->SetCacheSize(16 * 1024);
+  const auto slowDimensionSplitter = itk::ImageRegionSplitterSlowDimension::New();
+
+  const RegionType         region({ 1, 2, 3 }, { 50, 40, 30 });
+  const SizeType           tileSize = splitter->GetTileSize(region, SizeType{});
+  const itk::SizeValueType numberOfTiles = itk::ImageRegionSplitterCacheTiles::GetNumberOfTiles(region, tileSize);
+  ASSERT_GT(numberOfTiles, 30u);
+
+  // fewer pieces than tiles: split like ImageRegionSplitterSlowDimension
+  for (const unsigned int requested : { 1u, 4u, 7u })
+  {
+    const unsigned int numberOfPieces = splitter->GetNumberOfSplits(region, requested);
+    EXPECT_EQ(numberOfPieces, slowDimensionSplitter->GetNumberOfSplits(region, requested));
+    for (unsigned int i = 0; i < numberOfPieces; ++i)
+    {
+      RegionType piece = region;
+      RegionType slab = region;
+      splitter->GetSplit(i, numberOfPieces, piece);
+      slowDimensionSplitter->GetSplit(i, numberOfPieces, slab);
+      EXPECT_EQ(piece, slab);
+    }
+  }
+
+  // enough pieces: split in the tiles
+  const unsigned int numberOfPieces = splitter->GetNumberOfSplits(region, 100000);
+  ASSERT_EQ(numberOfPieces, numberOfTiles);
+  for (unsigned int i = 0; i < numberOfPieces; ++i)
+  {
+    RegionType piece = region;
+    EXPECT_EQ(splitter->GetSplit(i, numberOfPieces, piece), numberOfPieces);
+    EXPECT_EQ(piece, itk::ImageRegionSplitterCacheTiles::GetTile(i, region, tileSize));
+  }
+
+  // a region which fits in the cache is still split in slabs
+  const RegionType smallRegion({ 0, 0, 0 }, { 8, 8, 8 });
+  EXPECT_EQ(splitter->GetNumberOfSplits(smallRegion, 4), 4u);
+}
+
+
+TEST(ImageRegionSplitterCacheTiles, ImageSourceProcessesTiles)
+{
+  const auto input = ImageType::New();
+  input->SetRegions(RegionType({ 0, 0, 0 }, { 40, 33, 21 }));
+  input->Allocate();
+  float value = 0.0f;
+  for (itk::ImageRegionIterator<ImageType> it(input, input->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(value++);
+  }
+
+  const auto splitter = itk::ImageRegionSplitterCacheTiles::New();
+  splitter->SetCacheSize(32 * 1024);
+  splitter->SetBytesPerPixel(8);
+
+  const auto check = [&input](PaddedFilter * filter, const RegionType & requestedRegion) {
+    filter->SetInput(input);
+    filter->SetNumberOfWorkUnits(3);
+    filter->GetOutput()->SetRequestedRegion(requestedRegion);
+    filter->Update();
+
+    for (itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), requestedRegion); !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(it.Get(), input->GetPixel(it.GetIndex()) + 1.0f);
+    }
+    const std::vector<int> coverage = CountCoverage(requestedRegion, filter->m_Regions);
+    EXPECT_TRUE(std::all_of(coverage.begin(), coverage.end(), [](int count) { return count == 1; }));
+  };
+
+  // selected for the filter, with the margin of the input requested region
+  const RegionType requestedRegion({ 4, 3, 2 }, { 30, 25, 17 });
+  const auto       filter = PaddedFilter::New();
+  filter->SetImageRegionSplitter(splitter);
+  check(filter, requestedRegion);
+  const SizeType tileSize = splitter->GetTileSize(requestedRegion, SizeType::Filled(2));
+  EXPECT_EQ(filter->m_Regions.size(), itk::ImageRegionSplitterCacheTiles::GetNumberOfTiles(requestedRegion, tileSize));
+
+  // selected globally
+  itk::ImageSourceCommon::SetGlobalDefaultSplitter(splitter);
+  EXPECT_EQ(itk::ImageSourceCommon::GetGlobalDefaultSplitter(), splitter.GetPointer());
+  const auto globalFilter = PaddedFilter::New();
+  check(globalFilter, input->GetLargestPossibleRegion());
+  EXPECT_GT(globalFilter->m_Regions.size(), 3u);
+
+  itk::ImageSourceCommon::SetGlobalDefaultSplitter(nullptr);
+  const itk::ImageRegionSplitterBase * defaultSplitter = itk::ImageSourceCommon::GetGlobalDefaultSplitter();
+  EXPECT_NE(dynamic_cast<const itk::ImageRegionSplitterSlowDimension *>(defaultSplitter), nullptr);
+  EXPECT_EQ(dynamic_cast<const itk::ImageRegionSplitterCacheTiles *>(defaultSplitter), nullptr);
+}
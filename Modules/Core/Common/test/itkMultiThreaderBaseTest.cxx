@@ -21,6 +21,7 @@
 #include "itkPlatformMultiThreader.h"
 #include "itkPoolMultiThreader.h"
 #include "itkSingleMultiThreader.h"
+#include "itkWorkStealingMultiThreader.h"
 #ifdef ITK_USE_TBB
 #  include "itkTBBMultiThreader.h"
 #endif
@@ -124,6 +125,7 @@ itkMultiThreaderBaseTest(int argc, char * argv[])
   TEST_SINGLE_CLASS(PlatformMultiThreader);
   TEST_SINGLE_CLASS(PoolMultiThreader);
   TEST_SINGLE_CLASS(SingleMultiThreader);
+  TEST_SINGLE_CLASS(WorkStealingMultiThreader);
 #ifdef ITK_USE_TBB
   TEST_SINGLE_CLASS(TBBMultiThreader);
 #endif
@@ -157,6 +159,7 @@ itkMultiThreaderBaseTest(int argc, char * argv[])
     itk::MultiThreaderBaseEnums::Threader::Pool,
     itk::MultiThreaderBaseEnums::Threader::TBB,
     itk::MultiThreaderBaseEnums::Threader::Single,
+    itk::MultiThreaderBaseEnums::Threader::WorkStealing,
     //            itk::MultiThreaderBaseEnums::Threader::Last,
     itk::MultiThreaderBaseEnums::Threader::Unknown
   };
@@ -92,6 +92,7 @@ itkMultiThreaderExceptionsTest(int, char *[])
     ThreaderEnum::TBB,
 #endif // ITK_USE_TBB
     ThreaderEnum::Single,
+    ThreaderEnum::WorkStealing,
   };
   for (auto thType : threadersToTest)
   {
@@ -0,0 +1,207 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPipelineTracer.h"
+#include "itkExtractImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkMultiThreaderBase.h"
+#include "itkWorkStealingMultiThreader.h"
+#include "itkGTest.h"
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+
+// Enable the tracer for the lifetime of the fixture, and leave it disabled
+// and empty afterwards.
+class PipelineTracerFixture : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    itk::PipelineTracer::GetInstance()->Clear();
+    itk::PipelineTracer::SetEnabled(true);
+  }
+
+  void
+  TearDown() override
+  {
+    itk::PipelineTracer::SetEnabled(false);
+    itk::PipelineTracer::GetInstance()->Clear();
+  }
+
+  static std::vector<itk::PipelineTracer::Event>
+  GetEvents(const std::string & category)
+  {
+    std::vector<itk::PipelineTracer::Event> events;
+    for (const auto & event : itk::PipelineTracer::GetInstance()->GetEvents())
+    {
+      if (event.Category == category)
+      {
+        events.push_back(event);
+      }
+    }
+    return events;
+  }
+
+  static ImageType::Pointer
+  MakeImage()
+  {
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 16, 12, 8 } }));
+    image->AllocateInitialized();
+    return image;
+  }
+};
+} // namespace
+
+TEST(PipelineTracer, DisabledByDefault)
+{
+  EXPECT_FALSE(itk::PipelineTracer::GetEnabled());
+  {
+    itk::PipelineTracer::Span span("Test", "Disabled");
+    EXPECT_FALSE(span.IsActive());
+  }
+  EXPECT_EQ(itk::PipelineTracer::GetInstance()->GetNumberOfEvents(), 0u);
+  EXPECT_EQ(itk::PipelineTracer::New(), itk::PipelineTracer::GetInstance());
+}
+
+TEST_F(PipelineTracerFixture, SpansRecordNestedEventsAndAllocations)
+{
+  {
+    itk::PipelineTracer::Span outer("Test", "Outer");
+    EXPECT_TRUE(outer.IsActive());
+    {
+      const itk::PipelineTracer::Span inner("Test", "Inner");
+      const ImageType::Pointer        image = MakeImage();
+    }
+    const ImageType::Pointer image = MakeImage();
+    outer.SetDetail("some \"quoted\" detail");
+  }
+
+  const std::vector<itk::PipelineTracer::Event> events = GetEvents("Test");
+  ASSERT_EQ(events.size(), 2u);
+  const itk::PipelineTracer::Event & inner = events[0];
+  const itk::PipelineTracer::Event & outer = events[1];
+  EXPECT_EQ(inner.Name, "Inner");
+  EXPECT_EQ(outer.Name, "Outer");
+  EXPECT_EQ(inner.AllocatedBytes, 16 * 12 * 8 * sizeof(float));
+  EXPECT_EQ(outer.AllocatedBytes, 16 * 12 * 8 * sizeof(float));
+  EXPECT_LE(outer.Start, inner.Start);
+  EXPECT_GE(outer.Start + outer.Duration, inner.Start + inner.Duration);
+  EXPECT_EQ(inner.ThreadIndex, outer.ThreadIndex);
+
+  std::ostringstream json;
+  itk::PipelineTracer::GetInstance()->WriteChromeTrace(json);
+  EXPECT_EQ(json.str().find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(json.str().find("\"name\":\"Inner\",\"cat\":\"Test\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.str().find("\"detail\":\"some \\\"quoted\\\" detail\""), std::string::npos);
+  EXPECT_NE(json.str().find("\"allocatedBytes\":6144"), std::string::npos);
+
+  itk::PipelineTracer::GetInstance()->Clear();
+  EXPECT_EQ(itk::PipelineTracer::GetInstance()->GetNumberOfEvents(), 0u);
+}
+
+TEST_F(PipelineTracerFixture, RecordsWorkUnits)
+{
+  const std::vector<itk::MultiThreaderBase::Pointer> multiThreaders = { itk::MultiThreaderBase::New(),
+                                                                        itk::WorkStealingMultiThreader::New() };
+  for (const auto & multiThreader : multiThreaders)
+  {
+    SCOPED_TRACE(multiThreader->GetNameOfClass());
+    itk::PipelineTracer::GetInstance()->Clear();
+    multiThreader->SetNumberOfWorkUnits(4);
+
+    const ImageType::RegionType region(ImageType::SizeType{ { 16, 12, 8 } });
+    multiThreader->ParallelizeImageRegion<3>(region, [](const ImageType::RegionType &) {}, nullptr);
+    std::vector<itk::PipelineTracer::Event> events = GetEvents("WorkUnit");
+    ASSERT_EQ(events.size(), 4u);
+    for (const auto & event : events)
+    {
+      EXPECT_EQ(event.Name, "ParallelizeImageRegion");
+      EXPECT_NE(event.Detail.find("size [16, 12, 2]"), std::string::npos) << event.Detail;
+    }
+
+    itk::PipelineTracer::GetInstance()->Clear();
+    multiThreader->ParallelizeImageRegionRestrictDirection<3>(2, region, [](const ImageType::RegionType &) {}, nullptr);
+    events = GetEvents("WorkUnit");
+    ASSERT_EQ(events.size(), 4u);
+    for (const auto & event : events)
+    {
+      EXPECT_NE(event.Detail.find("size [16, 3, 8]"), std::string::npos) << event.Detail;
+    }
+
+    itk::PipelineTracer::GetInstance()->Clear();
+    multiThreader->ParallelizeArray(0, 100, [](itk::SizeValueType) {}, nullptr);
+    events = GetEvents("WorkUnit");
+    EXPECT_GE(events.size(), 1u);
+    EXPECT_LE(events.size(), 100u);
+    for (const auto & event : events)
+    {
+      EXPECT_EQ(event.Name, "ParallelizeArray");
+    }
+  }
+}
+
+TEST_F(PipelineTracerFixture, RecordsFiltersAndStreamedPieces)
+{
+  using ExtractType = itk::ExtractImageFilter<ImageType, ImageType>;
+  using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+
+  const ImageType::Pointer image = MakeImage();
+  auto                     extract = ExtractType::New();
+  extract->SetInput(image);
+  extract->SetExtractionRegion(image->GetLargestPossibleRegion());
+  extract->SetDirectionCollapseToIdentity();
+  extract->SetObjectName("extract");
+  auto streamer = StreamerType::New();
+  streamer->SetInput(extract->GetOutput());
+  streamer->SetNumberOfStreamDivisions(4);
+  streamer->Update();
+
+  const std::vector<itk::PipelineTracer::Event> pieces = GetEvents("Stream");
+  ASSERT_EQ(pieces.size(), 4u);
+  for (const auto & piece : pieces)
+  {
+    EXPECT_EQ(piece.Name, "StreamingImageFilter");
+    EXPECT_NE(piece.Detail.find("size [16, 12, 2]"), std::string::npos) << piece.Detail;
+  }
+
+  const std::vector<itk::PipelineTracer::Event> filters = GetEvents("Filter");
+  ASSERT_EQ(filters.size(), 4u);
+  // the output buffer of the first piece is reused by the next ones
+  EXPECT_EQ(filters[0].AllocatedBytes, 16 * 12 * 2 * sizeof(float));
+  for (size_t i = 0; i < filters.size(); ++i)
+  {
+    EXPECT_EQ(filters[i].Name, "ExtractImageFilter");
+    EXPECT_EQ(filters[i].Detail, "extract");
+    // each execution of the filter is nested in its piece
+    EXPECT_LE(pieces[i].Start, filters[i].Start);
+    EXPECT_GE(pieces[i].Start + pieces[i].Duration, filters[i].Start + filters[i].Duration);
+  }
+
+  const std::vector<itk::PipelineTracer::Event> workUnits = GetEvents("WorkUnit");
+  EXPECT_GE(workUnits.size(), filters.size());
+  for (const auto & workUnit : workUnits)
+  {
+    EXPECT_EQ(workUnit.Name, "ExtractImageFilter");
+  }
+}
@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkSymmetricEigenAnalysis3DBatch.h"
+#include "itkSymmetricSecondRankTensor.h"
+#include "itkMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using TensorType = itk::SymmetricSecondRankTensor<double, 3>;
+using EigenValuesType = itk::FixedArray<double, 3>;
+
+// Random matrices, with some diagonal, degenerate and zero ones.
+std::vector<TensorType>
+MakeTensors()
+{
+  std::vector<TensorType> tensors(101);
+  unsigned int            value = 1;
+  for (auto & tensor : tensors)
+  {
+    for (unsigned int k = 0; k < 6; ++k)
+    {
+      value = value * 1103515245u + 12345u;
+      tensor[k] = static_cast<double>((value >> 8) % 2001) / 10.0 - 100.0;
+    }
+  }
+  tensors[3].Fill(0.0);
+  tensors[10].Fill(1.0);
+  tensors[17] = TensorType{};
+  tensors[17](0, 0) = tensors[17](1, 1) = tensors[17](2, 2) = -4.0;
+  tensors[40](0, 1) = tensors[40](0, 2) = tensors[40](1, 2) = 0.0;
+  return tensors;
+}
+
+// Compare the eigen values of a batch, filled up to numberOfMatrices, with
+// SymmetricEigenAnalysisFixedDimension.
+void
+ExpectSameEigenValuesAsFixedDimension(itk::EigenValueOrderEnum order)
+{
+  const std::vector<TensorType> tensors = MakeTensors();
+
+  itk::SymmetricEigenAnalysisFixedDimension<3, TensorType, EigenValuesType> expectedCalculator;
+  itk::SymmetricEigenAnalysis3DBatch<double>                                batch;
+  expectedCalculator.SetOrderEigenMagnitudes(order == itk::EigenValueOrderEnum::OrderByMagnitude);
+  batch.SetOrderEigenMagnitudes(order == itk::EigenValueOrderEnum::OrderByMagnitude);
+
+  for (size_t first = 0; first < tensors.size(); first += batch.BatchSize)
+  {
+    const auto numberOfMatrices =
+      static_cast<unsigned int>(std::min<size_t>(batch.BatchSize, tensors.size() - first));
+    for (unsigned int i = 0; i < numberOfMatrices; ++i)
+    {
+      batch.SetMatrix(i, tensors[first + i]);
+    }
+    batch.ComputeEigenValues(numberOfMatrices);
+    for (unsigned int i = 0; i < numberOfMatrices; ++i)
+    {
+      EigenValuesType expected;
+      expectedCalculator.ComputeEigenValues(tensors[first + i], expected);
+      EigenValuesType eigenValues;
+      batch.GetEigenValues(i, eigenValues);
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        EXPECT_NEAR(eigenValues[k], expected[k], 1e-10) << "matrix " << first + i;
+      }
+    }
+  }
+}
+} // namespace
+
+TEST(SymmetricEigenAnalysis3DBatch, EigenValuesOrderedByValue)
+{
+  ExpectSameEigenValuesAsFixedDimension(itk::EigenValueOrderEnum::OrderByValue);
+}
+
+TEST(SymmetricEigenAnalysis3DBatch, EigenValuesOrderedByMagnitude)
+{
+  ExpectSameEigenValuesAsFixedDimension(itk::EigenValueOrderEnum::OrderByMagnitude);
+}
+
+// The eigen vectors are orthonormal, and A v = lambda v.
+TEST(SymmetricEigenAnalysis3DBatch, EigenVectors)
+{
+  const std::vector<TensorType> tensors = MakeTensors();
+
+  itk::SymmetricEigenAnalysis3DBatch<double> batch;
+  for (size_t first = 0; first < tensors.size(); first += batch.BatchSize)
+  {
+    const auto numberOfMatrices =
+      static_cast<unsigned int>(std::min<size_t>(batch.BatchSize, tensors.size() - first));
+    for (unsigned int i = 0; i < numberOfMatrices; ++i)
+    {
+      batch.SetMatrix(i, tensors[first + i]);
+    }
+    batch.ComputeEigenValuesAndVectors(numberOfMatrices);
+    for (unsigned int i = 0; i < numberOfMatrices; ++i)
+    {
+      const TensorType & A = tensors[first + i];
+      EigenValuesType    eigenValues;
+      batch.GetEigenValues(i, eigenValues);
+      itk::Matrix<double, 3, 3> eigenVectors;
+      batch.GetEigenVectors(i, eigenVectors);
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        for (unsigned int l = 0; l < 3; ++l)
+        {
+          double dotProduct = 0.0;
+          for (unsigned int j = 0; j < 3; ++j)
+          {
+            dotProduct += eigenVectors[k][j] * eigenVectors[l][j];
+          }
+          EXPECT_NEAR(dotProduct, k == l ? 1.0 : 0.0, 1e-12);
+
+          double product = 0.0;
+          for (unsigned int j = 0; j < 3; ++j)
+          {
+            product += A(l, j) * eigenVectors[k][j];
+          }
+          EXPECT_NEAR(product, eigenValues[k] * eigenVectors[k][l], 1e-10) << "matrix " << first + i;
+        }
+      }
+    }
+  }
+}
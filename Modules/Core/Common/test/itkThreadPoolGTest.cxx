@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkThreadPool.h"
+#include "itkWorkStealingThreadPool.h"
+#include "itkMultiThreaderBase.h"
+#include "itkGTest.h"
+
+#include <future>
+#include <thread>
+#include <vector>
+
+
+TEST(ThreadPool, GlobalNUMAAwareRoundTrips)
+{
+  const bool numaAware = itk::MultiThreaderBase::GetGlobalNUMAAware();
+
+  itk::MultiThreaderBase::SetGlobalNUMAAware(true);
+  EXPECT_TRUE(itk::MultiThreaderBase::GetGlobalNUMAAware());
+  itk::MultiThreaderBase::SetGlobalNUMAAware(false);
+  EXPECT_FALSE(itk::MultiThreaderBase::GetGlobalNUMAAware());
+
+  itk::MultiThreaderBase::SetGlobalNUMAAware(numaAware);
+}
+
+
+TEST(ThreadPool, NumberOfNodes)
+{
+  const auto pool = itk::ThreadPool::GetInstance();
+
+  EXPECT_GE(itk::ThreadPool::GetNumberOfNUMANodes(), 1u);
+  EXPECT_GE(pool->GetNumberOfNodes(), 1u);
+  EXPECT_LE(pool->GetNumberOfNodes(), itk::ThreadPool::GetNumberOfNUMANodes());
+  EXPECT_LE(pool->GetNumberOfNodes(), pool->GetMaximumNumberOfThreads());
+}
+
+
+TEST(ThreadPool, GetNodeOfWorkUnitMapsWorkUnitsInOrder)
+{
+  const auto pool = itk::ThreadPool::GetInstance();
+
+  for (itk::ThreadIdType numberOfWorkUnits = 1; numberOfWorkUnits <= 40; ++numberOfWorkUnits)
+  {
+    EXPECT_EQ(pool->GetNodeOfWorkUnit(0, numberOfWorkUnits), 0u);
+    unsigned int previousNode = 0;
+    for (itk::ThreadIdType workUnit = 0; workUnit < numberOfWorkUnits; ++workUnit)
+    {
+      const unsigned int node = pool->GetNodeOfWorkUnit(workUnit, numberOfWorkUnits);
+      EXPECT_LT(node, pool->GetNumberOfNodes());
+      EXPECT_GE(node, previousNode);
+      previousNode = node;
+    }
+  }
+}
+
+
+TEST(ThreadPool, AddWorkToNodeExecutesJobsOnWorkers)
+{
+  const auto pool = itk::ThreadPool::GetInstance();
+  EXPECT_FALSE(itk::ThreadPool::GetCurrentThreadIsWorker());
+
+  // any node can be passed, it is taken modulo the number of nodes
+  std::vector<std::future<bool>> results;
+  for (unsigned int node = 0; node < 2 * pool->GetNumberOfNodes() + 3; ++node)
+  {
+    results.push_back(pool->AddWorkToNode(node, [] { return itk::ThreadPool::GetCurrentThreadIsWorker(); }));
+  }
+  results.push_back(pool->AddWork([] { return itk::ThreadPool::GetCurrentThreadIsWorker(); }));
+
+  for (auto & result : results)
+  {
+    EXPECT_TRUE(result.get());
+  }
+}
+
+
+TEST(ThreadPool, MultiThreaderBaseKnowsWorkersOfBothPools)
+{
+  EXPECT_FALSE(itk::MultiThreaderBase::GetCurrentThreadIsWorker());
+  EXPECT_TRUE(
+    itk::ThreadPool::GetInstance()->AddWork([] { return itk::MultiThreaderBase::GetCurrentThreadIsWorker(); }).get());
+
+  // Wait() may execute the task on the calling thread, which is no worker.
+  const auto                             pool = itk::WorkStealingThreadPool::GetInstance();
+  const std::thread::id                  callerId = std::this_thread::get_id();
+  bool                                   isWorker = false;
+  bool                                   ranOnWorker = true;
+  itk::WorkStealingThreadPool::TaskGroup group;
+  pool->Submit(group, [&] {
+    isWorker = itk::MultiThreaderBase::GetCurrentThreadIsWorker();
+    ranOnWorker = std::this_thread::get_id() != callerId;
+  });
+  pool->Wait(group);
+  EXPECT_EQ(isWorker, ranOnWorker);
+}
+
+
+TEST(ThreadPool, CurrentThreadDefaultMultiThreaderFollowsGlobalDefaults)
+{
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+
+  itk::MultiThreaderBase * const multiThreader = itk::MultiThreaderBase::GetCurrentThreadDefaultMultiThreader();
+  ASSERT_NE(multiThreader, nullptr);
+  EXPECT_EQ(itk::MultiThreaderBase::GetCurrentThreadDefaultMultiThreader(), multiThreader);
+  EXPECT_EQ(multiThreader->GetNumberOfWorkUnits(), itk::MultiThreaderBase::New()->GetNumberOfWorkUnits());
+
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads + 1);
+  EXPECT_EQ(itk::MultiThreaderBase::GetCurrentThreadDefaultMultiThreader()->GetNumberOfWorkUnits(),
+            itk::MultiThreaderBase::New()->GetNumberOfWorkUnits());
+
+  // each thread has its own
+  itk::MultiThreaderBase * otherMultiThreader = nullptr;
+  std::thread([&otherMultiThreader] {
+    otherMultiThreader = itk::MultiThreaderBase::GetCurrentThreadDefaultMultiThreader();
+  }).join();
+  EXPECT_NE(otherMultiThreader, itk::MultiThreaderBase::GetCurrentThreadDefaultMultiThreader());
+
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+}
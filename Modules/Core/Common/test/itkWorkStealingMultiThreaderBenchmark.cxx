@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Scaling benchmark of the work-stealing multi-threader against the Pool
+// and TBB multi-threaders. Two workloads are timed:
+//  - Flat: one ParallelizeImageRegion over a volume with uneven cost per slice.
+//  - Nested: an outer ParallelizeArray over "subjects", each of which runs an
+//    inner ParallelizeImageRegion. PoolMultiThreader cannot safely nest (its
+//    workers block on futures), so for Pool the outer loop is serial, which
+//    is what pipelines have to do today.
+
+#include "itkPoolMultiThreader.h"
+#include "itkWorkStealingMultiThreader.h"
+#ifdef ITK_USE_TBB
+#  include "itkTBBMultiThreader.h"
+#endif
+#include "itkTimeProbesCollectorBase.h"
+#include "itkTestingMacros.h"
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using RegionType = itk::ImageRegion<Dimension>;
+
+// Work whose cost grows with the slice index, to create load imbalance.
+double
+ProcessPiece(const RegionType & piece)
+{
+  double sum = 0.0;
+  for (itk::IndexValueType z = piece.GetIndex(2); z < piece.GetUpperIndex()[2] + 1; ++z)
+  {
+    const itk::SizeValueType repeats = 1 + static_cast<itk::SizeValueType>(z) % 4;
+    for (itk::SizeValueType r = 0; r < repeats; ++r)
+    {
+      for (itk::SizeValueType p = 0; p < piece.GetSize(0) * piece.GetSize(1); ++p)
+      {
+        sum += std::sqrt(static_cast<double>(p + z + r));
+      }
+    }
+  }
+  return sum;
+}
+
+double
+RunFlat(itk::MultiThreaderBase * threader, const RegionType & region)
+{
+  std::atomic<itk::SizeValueType> processed{ 0 };
+  double                          checksum = 0.0;
+  std::mutex                      mutex;
+  threader->ParallelizeImageRegion<Dimension>(
+    region,
+    [&](const RegionType & piece) {
+      const double partial = ProcessPiece(piece);
+      processed += piece.GetNumberOfPixels();
+      const std::lock_guard<std::mutex> lock(mutex);
+      checksum += partial;
+    },
+    nullptr);
+  return processed == region.GetNumberOfPixels() ? checksum : -1.0;
+}
+
+double
+RunNested(itk::MultiThreaderBase * outer,
+          itk::MultiThreaderBase * inner,
+          itk::SizeValueType       numberOfSubjects,
+          const RegionType &       region,
+          bool                     serialOuterLoop)
+{
+  std::vector<double> results(numberOfSubjects, 0.0);
+  const auto          subject = [&](itk::SizeValueType i) { results[i] = RunFlat(inner, region); };
+  if (serialOuterLoop)
+  {
+    for (itk::SizeValueType i = 0; i < numberOfSubjects; ++i)
+    {
+      subject(i);
+    }
+  }
+  else
+  {
+    outer->ParallelizeArray(0, numberOfSubjects, subject, nullptr);
+  }
+  double total = 0.0;
+  for (const double r : results)
+  {
+    if (r < 0.0)
+    {
+      return -1.0;
+    }
+    total += r;
+  }
+  return total;
+}
+} // namespace
+
+int
+itkWorkStealingMultiThreaderBenchmark(int argc, char * argv[])
+{
+  if (argc > 5)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv)
+              << " [edgeLength [numberOfSubjects [numberOfRuns [numberOfThreads]]]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const itk::SizeValueType edgeLength = argc > 1 ? std::stoul(argv[1]) : 48;
+  const itk::SizeValueType numberOfSubjects = argc > 2 ? std::stoul(argv[2]) : 8;
+  const unsigned int       numberOfRuns = argc > 3 ? std::stoul(argv[3]) : 3;
+  if (argc > 4)
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(std::stoul(argv[4]));
+  }
+  std::cout << "Threads: " << itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() << std::endl;
+
+  RegionType region;
+  region.SetSize({ { edgeLength, edgeLength, edgeLength } });
+
+  struct Candidate
+  {
+    std::string                     name;
+    itk::MultiThreaderBase::Pointer outer;
+    itk::MultiThreaderBase::Pointer inner;
+    bool                            nests;
+  };
+  std::vector<Candidate> candidates;
+  candidates.push_back({ "Pool", itk::PoolMultiThreader::New(), itk::PoolMultiThreader::New(), false });
+  candidates.push_back(
+    { "WorkStealing", itk::WorkStealingMultiThreader::New(), itk::WorkStealingMultiThreader::New(), true });
+#ifdef ITK_USE_TBB
+  candidates.push_back({ "TBB", itk::TBBMultiThreader::New(), itk::TBBMultiThreader::New(), true });
+#endif
+
+  itk::TimeProbesCollectorBase collector;
+  double                       referenceFlat = 0.0;
+  double                       referenceNested = 0.0;
+  bool                         success = true;
+
+  for (const auto & candidate : candidates)
+  {
+    for (unsigned int run = 0; run < numberOfRuns; ++run)
+    {
+      collector.Start((candidate.name + " flat").c_str());
+      const double flat = RunFlat(candidate.outer, region);
+      collector.Stop((candidate.name + " flat").c_str());
+
+      const std::string nestedName = candidate.name + (candidate.nests ? " nested" : " nested (serial outer)");
+      collector.Start(nestedName.c_str());
+      const double nested = RunNested(candidate.outer, candidate.inner, numberOfSubjects, region, !candidate.nests);
+      collector.Stop(nestedName.c_str());
+
+      if (referenceFlat == 0.0)
+      {
+        referenceFlat = flat;
+        referenceNested = nested;
+      }
+      // Summation order differs between threaders, so compare with a tolerance.
+      if (flat < 0.0 || nested < 0.0 || std::abs(flat - referenceFlat) > 1e-9 * referenceFlat ||
+          std::abs(nested - referenceNested) > 1e-9 * referenceNested)
+      {
+        std::cerr << "Result mismatch for " << candidate.name << " threader!" << std::endl;
+        success = false;
+      }
+    }
+  }
+
+  collector.Report(std::cout);
+  std::cout << "Stolen tasks: " << itk::WorkStealingThreadPool::GetInstance()->GetNumberOfStolenTasks() << std::endl;
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
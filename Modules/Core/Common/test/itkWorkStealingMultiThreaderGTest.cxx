@@ -0,0 +1,198 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWorkStealingMultiThreader.h"
+#include "itkImageRegion.h"
+#include "itkGTest.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+
+TEST(WorkStealingMultiThreader, ExerciseBasicObjectMethods)
+{
+  const auto threader = itk::WorkStealingMultiThreader::New();
+  ITK_GTEST_EXERCISE_BASIC_OBJECT_METHODS(threader, WorkStealingMultiThreader, MultiThreaderBase);
+
+  EXPECT_GE(threader->GetMaximumNumberOfThreads(), 1u);
+  EXPECT_GE(threader->GetNumberOfWorkUnits(), 1u);
+}
+
+
+TEST(WorkStealingMultiThreader, ParallelizeArrayVisitsEveryIndexOnce)
+{
+  const auto threader = itk::WorkStealingMultiThreader::New();
+  threader->SetNumberOfWorkUnits(7);
+
+  constexpr itk::SizeValueType  count{ 1031 };
+  std::vector<std::atomic<int>> visits(count);
+  threader->ParallelizeArray(
+    3, count, [&visits](itk::SizeValueType i) { ++visits[i]; }, nullptr);
+
+  for (itk::SizeValueType i = 0; i < count; ++i)
+  {
+    EXPECT_EQ(visits[i].load(), i < 3 ? 0 : 1) << "at index " << i;
+  }
+}
+
+
+TEST(WorkStealingMultiThreader, ParallelizeImageRegionCoversRegion)
+{
+  constexpr unsigned int Dimension{ 3 };
+  using RegionType = itk::ImageRegion<Dimension>;
+
+  // Through the base class, whose ParallelizeImageRegion() template the
+  // override of the non-template overload hides
+  const itk::MultiThreaderBase::Pointer threader = itk::WorkStealingMultiThreader::New();
+  threader->SetNumberOfWorkUnits(10);
+
+  const RegionType                region({ { 2, -3, 5 } }, { { 17, 9, 13 } });
+  std::atomic<itk::SizeValueType> pixelCount{ 0 };
+  threader->ParallelizeImageRegion<Dimension>(
+    region,
+    [&region, &pixelCount](const RegionType & piece) {
+      EXPECT_TRUE(region.IsInside(piece));
+      pixelCount += piece.GetNumberOfPixels();
+    },
+    nullptr);
+
+  EXPECT_EQ(pixelCount.load(), region.GetNumberOfPixels());
+}
+
+
+// Nested parallel sections must neither deadlock nor lose work,
+// even when there are far more outer work units than pool threads.
+TEST(WorkStealingMultiThreader, NestedParallelism)
+{
+  constexpr unsigned int Dimension{ 2 };
+  using RegionType = itk::ImageRegion<Dimension>;
+
+  const auto outer = itk::WorkStealingMultiThreader::New();
+  outer->SetNumberOfWorkUnits(64);
+  const itk::MultiThreaderBase::Pointer inner = itk::WorkStealingMultiThreader::New();
+  inner->SetNumberOfWorkUnits(16);
+
+  constexpr itk::SizeValueType    outerCount{ 50 };
+  const RegionType                innerRegion({ { 0, 0 } }, { { 31, 23 } });
+  std::vector<itk::SizeValueType> sums(outerCount, 0);
+
+  outer->ParallelizeArray(
+    0,
+    outerCount,
+    [&](itk::SizeValueType i) {
+      std::atomic<itk::SizeValueType> sum{ 0 };
+      inner->ParallelizeImageRegion<Dimension>(
+        innerRegion,
+        [&sum, &inner](const RegionType & piece) {
+          // A third nesting level, through the same threader instance.
+          inner->ParallelizeArray(
+            0, piece.GetNumberOfPixels(), [&sum](itk::SizeValueType) { ++sum; }, nullptr);
+        },
+        nullptr);
+      sums[i] = sum;
+    },
+    nullptr);
+
+  for (const auto sum : sums)
+  {
+    EXPECT_EQ(sum, innerRegion.GetNumberOfPixels());
+  }
+}
+
+
+TEST(WorkStealingMultiThreader, SingleMethodExecuteRunsAllWorkUnits)
+{
+  const auto threader = itk::WorkStealingMultiThreader::New();
+  threader->SetNumberOfWorkUnits(9);
+
+  std::vector<std::atomic<int>> calls(threader->GetNumberOfWorkUnits());
+  threader->SetSingleMethodAndExecute(
+    [](void * arg) -> itk::ITK_THREAD_RETURN_TYPE {
+      auto * info = static_cast<itk::MultiThreaderBase::WorkUnitInfo *>(arg);
+      auto * counts = static_cast<std::vector<std::atomic<int>> *>(info->UserData);
+      ++(*counts)[info->WorkUnitID];
+      return itk::ITK_THREAD_RETURN_DEFAULT_VALUE;
+    },
+    &calls);
+
+  for (const auto & c : calls)
+  {
+    EXPECT_EQ(c.load(), 1);
+  }
+}
+
+
+TEST(WorkStealingMultiThreader, ExceptionFromNestedWorkUnitIsPropagated)
+{
+  const auto threader = itk::WorkStealingMultiThreader::New();
+  threader->SetNumberOfWorkUnits(8);
+
+  EXPECT_THROW(threader->ParallelizeArray(
+                 0,
+                 20,
+                 [&threader](itk::SizeValueType i) {
+                   threader->ParallelizeArray(
+                     0,
+                     20,
+                     [i](itk::SizeValueType j) {
+                       if (i == 13 && j == 7)
+                       {
+                         itkGenericExceptionMacro("Expected failure");
+                       }
+                     },
+                     nullptr);
+                 },
+                 nullptr),
+               itk::ExceptionObject);
+
+  // The pool must remain usable after an exception.
+  std::atomic<int> count{ 0 };
+  threader->ParallelizeArray(
+    0, 100, [&count](itk::SizeValueType) { ++count; }, nullptr);
+  EXPECT_EQ(count.load(), 100);
+}
+
+
+TEST(WorkStealingThreadPool, TaskGroup)
+{
+  const auto pool = itk::WorkStealingThreadPool::GetInstance();
+  EXPECT_EQ(pool, itk::WorkStealingThreadPool::New());
+  EXPECT_EQ(itk::WorkStealingThreadPool::GetCurrentWorkerIndex(), -1);
+
+  std::vector<int>                       values(100, 0);
+  itk::WorkStealingThreadPool::TaskGroup group;
+  std::atomic<int>                       workerTasks{ 0 };
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    pool->Submit(group, [&values, &workerTasks, i] {
+      values[i] = static_cast<int>(i);
+      if (itk::WorkStealingThreadPool::GetCurrentWorkerIndex() >= 0)
+      {
+        ++workerTasks;
+      }
+    });
+  }
+  pool->Wait(group);
+  EXPECT_EQ(group.GetNumberOfPendingTasks(), 0u);
+
+  std::vector<int> expected(values.size());
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(values, expected);
+  EXPECT_LE(workerTasks.load(), 100);
+}
@@ -260,6 +260,43 @@ public:
                                                               m_ThreadedWeightsDerivative[threadId]);
   }
 
+  /** Evaluate the function at numberOfIndices ContinuousIndex positions.
+   *
+   * The weighted sum of the coefficients of each position is computed one
+   * axis at a time. Consecutive positions that only differ along the first
+   * axis, as along the scanlines of an image resampled with an axis aligned
+   * transform, share the sums along the other axes of the columns of
+   * coefficients they use. The values may differ from those of
+   * EvaluateAtContinuousIndex() by rounding errors. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
+  /** Evaluate the derivative at numberOfIndices ContinuousIndex positions,
+   * computing the weighted sums of the coefficients one axis at a time.
+   * The derivatives may differ from those of
+   * EvaluateDerivativeAtContinuousIndex() by rounding errors. */
+  void
+  EvaluateDerivativeAtContinuousIndices(const ContinuousIndexType * indices,
+                                        CovariantVectorType *       derivatives,
+                                        SizeValueType               numberOfIndices) const
+  {
+    this->EvaluateValuesAndDerivatives(indices, nullptr, derivatives, numberOfIndices);
+  }
+
+  /** Evaluate the value and the derivative at numberOfIndices
+   * ContinuousIndex positions, as EvaluateDerivativeAtContinuousIndices()
+   * does. */
+  void
+  EvaluateValueAndDerivativeAtContinuousIndices(const ContinuousIndexType * indices,
+                                                OutputType *                values,
+                                                CovariantVectorType *       derivatives,
+                                                SizeValueType               numberOfIndices) const
+  {
+    this->EvaluateValuesAndDerivatives(indices, values, derivatives, numberOfIndices);
+  }
+
   /** Get/Sets the Spline Order, supports 0th - 5th order splines. The default
    *  is a 3rd order spline. */
   void
@@ -383,6 +420,33 @@ private:
   void
   ApplyMirrorBoundaryConditions(vnl_matrix<long> & evaluateIndex, unsigned int splineOrder) const;
 
+  /** Determines the weights of the region of support of x, and the offsets
+   * of its coefficients in the coefficient buffer along each axis, which
+   * are stored in rows of m_SplineOrder + 1 elements. */
+  void
+  DetermineSeparableRegionOfSupport(const ContinuousIndexType & x,
+                                    vnl_matrix<long> &          evaluateIndex,
+                                    vnl_matrix<double> &        weights,
+                                    vnl_matrix<double> *        weightsDerivative,
+                                    OffsetValueType *           offsets) const;
+
+  /** Sums the coefficients of a region of support along the axes from
+   * VAxis down to VLastAxis, weighted by weights[n] along axis n.
+   * offsets[n] are the offsets of the coefficients along axis n. */
+  template <unsigned int VAxis, unsigned int VLastAxis>
+  double
+  SumWeightedCoefficients(const CoefficientDataType *     coefficients,
+                          const OffsetValueType * const * offsets,
+                          const double * const *          weights) const;
+
+  /** Implements EvaluateValueAndDerivativeAtContinuousIndices(), values
+   * being nullptr when only the derivatives are needed. */
+  void
+  EvaluateValuesAndDerivatives(const ContinuousIndexType * indices,
+                               OutputType *                values,
+                               CovariantVectorType *       derivatives,
+                               SizeValueType               numberOfIndices) const;
+
   Iterator m_CIterator{};                         // Iterator for
                                                   // traversing spline
                                                   // coefficients.
@@ -641,6 +641,201 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Eval
 
   return derivativeValue;
 }
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::DetermineSeparableRegionOfSupport(
+  const ContinuousIndexType & x,
+  vnl_matrix<long> &          evaluateIndex,
+  vnl_matrix<double> &        weights,
+  vnl_matrix<double> *        weightsDerivative,
+  OffsetValueType *           offsets) const
+{
+  this->DetermineRegionOfSupport(evaluateIndex, x, m_SplineOrder);
+  this->SetInterpolationWeights(x, evaluateIndex, weights, m_SplineOrder);
+  if (weightsDerivative != nullptr)
+  {
+    this->SetDerivativeWeights(x, evaluateIndex, *weightsDerivative, m_SplineOrder);
+  }
+  this->ApplyMirrorBoundaryConditions(evaluateIndex, m_SplineOrder);
+
+  // The offsets that GetPixel() computes for the coefficient indices
+  const IndexType &       bufferStart = m_Coefficients->GetBufferedRegion().GetIndex();
+  const OffsetValueType * offsetTable = m_Coefficients->GetOffsetTable();
+  const unsigned int      supportSize = m_SplineOrder + 1;
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    for (unsigned int k = 0; k < supportSize; ++k)
+    {
+      offsets[n * supportSize + k] = (evaluateIndex[n][k] - bufferStart[n]) * offsetTable[n];
+    }
+  }
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <unsigned int VAxis, unsigned int VLastAxis>
+double
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::SumWeightedCoefficients(
+  const CoefficientDataType *     coefficients,
+  const OffsetValueType * const * offsets,
+  const double * const *          weights) const
+{
+  double sum = 0.0;
+  for (unsigned int k = 0; k <= m_SplineOrder; ++k)
+  {
+    const CoefficientDataType * const coefficient = coefficients + offsets[VAxis][k];
+    if constexpr (VAxis == VLastAxis)
+    {
+      sum += weights[VAxis][k] * static_cast<double>(*coefficient);
+    }
+    else
+    {
+      sum += weights[VAxis][k] *
+             this->template SumWeightedCoefficients<VAxis - 1, VLastAxis>(coefficient, offsets, weights);
+    }
+  }
+  return sum;
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  const unsigned int           supportSize = m_SplineOrder + 1;
+  vnl_matrix<long>             evaluateIndex(ImageDimension, supportSize);
+  vnl_matrix<double>           weights(ImageDimension, supportSize);
+  std::vector<OffsetValueType> offsets(ImageDimension * supportSize);
+
+  const double *          weightRows[ImageDimension];
+  const OffsetValueType * offsetRows[ImageDimension];
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    weightRows[n] = weights[n];
+    offsetRows[n] = offsets.data() + n * supportSize;
+  }
+  const CoefficientDataType * const coefficients = m_Coefficients->GetBufferPointer();
+
+  if constexpr (ImageDimension == 1)
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      this->DetermineSeparableRegionOfSupport(indices[i], evaluateIndex, weights, nullptr, offsets.data());
+      values[i] = this->template SumWeightedCoefficients<0, 0>(coefficients, offsetRows, weightRows);
+    }
+  }
+  else
+  {
+    // Sums along all the axes but the first of the columns of coefficients
+    // along the first axis, valid while the indices keep their position
+    // along these axes, that is while the stamp of the sums is current
+    const IndexValueType        columnStart = m_Coefficients->GetBufferedRegion().GetIndex(0);
+    const SizeValueType         numberOfColumns = m_Coefficients->GetBufferedRegion().GetSize(0);
+    std::vector<double>         columnSums(numberOfColumns);
+    std::vector<SizeValueType>  columnStamps(numberOfColumns, 0);
+    SizeValueType               stamp = 0;
+    const ContinuousIndexType * stampIndex = nullptr;
+
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      const ContinuousIndexType & x = indices[i];
+      this->DetermineSeparableRegionOfSupport(x, evaluateIndex, weights, nullptr, offsets.data());
+
+      bool sameColumns = stampIndex != nullptr;
+      for (unsigned int n = 1; sameColumns && n < ImageDimension; ++n)
+      {
+        sameColumns = x[n] == (*stampIndex)[n];
+      }
+      if (!sameColumns)
+      {
+        ++stamp;
+        stampIndex = &x;
+      }
+
+      double value = 0.0;
+      for (unsigned int k = 0; k < supportSize; ++k)
+      {
+        const CoefficientDataType * const column = coefficients + offsetRows[0][k];
+        const IndexValueType              c = evaluateIndex[0][k] - columnStart;
+        if (c < 0 || c >= static_cast<IndexValueType>(numberOfColumns))
+        {
+          value += weightRows[0][k] *
+                   this->template SumWeightedCoefficients<ImageDimension - 1, 1>(column, offsetRows, weightRows);
+          continue;
+        }
+        if (columnStamps[c] != stamp)
+        {
+          columnSums[c] = this->template SumWeightedCoefficients<ImageDimension - 1, 1>(column, offsetRows, weightRows);
+          columnStamps[c] = stamp;
+        }
+        value += weightRows[0][k] * columnSums[c];
+      }
+      values[i] = value;
+    }
+  }
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateValuesAndDerivatives(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  CovariantVectorType *       derivatives,
+  SizeValueType               numberOfIndices) const
+{
+  const unsigned int           supportSize = m_SplineOrder + 1;
+  vnl_matrix<long>             evaluateIndex(ImageDimension, supportSize);
+  vnl_matrix<double>           weights(ImageDimension, supportSize);
+  vnl_matrix<double>           weightsDerivative(ImageDimension, supportSize);
+  std::vector<OffsetValueType> offsets(ImageDimension * supportSize);
+
+  const OffsetValueType * offsetRows[ImageDimension];
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    offsetRows[n] = offsets.data() + n * supportSize;
+  }
+  const CoefficientDataType * const            coefficients = m_Coefficients->GetBufferPointer();
+  const InputImageType *                       inputImage = this->GetInputImage();
+  const typename InputImageType::SpacingType & spacing = inputImage->GetSpacing();
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    this->DetermineSeparableRegionOfSupport(indices[i], evaluateIndex, weights, &weightsDerivative, offsets.data());
+
+    const double * weightRows[ImageDimension];
+    for (unsigned int n = 0; n < ImageDimension; ++n)
+    {
+      weightRows[n] = weights[n];
+    }
+    if (values != nullptr)
+    {
+      values[i] = this->template SumWeightedCoefficients<ImageDimension - 1, 0>(coefficients, offsetRows, weightRows);
+    }
+
+    // Along each axis, the derivative weights replace the weights
+    CovariantVectorType derivativeValue;
+    for (unsigned int n = 0; n < ImageDimension; ++n)
+    {
+      weightRows[n] = weightsDerivative[n];
+      derivativeValue[n] =
+        this->template SumWeightedCoefficients<ImageDimension - 1, 0>(coefficients, offsetRows, weightRows);
+      derivativeValue[n] /= spacing[n];
+      weightRows[n] = weights[n];
+    }
+
+    if (this->m_UseImageDirection)
+    {
+      derivatives[i] = inputImage->TransformLocalVectorToPhysicalVector(derivativeValue);
+    }
+    else
+    {
+      derivatives[i] = derivativeValue;
+    }
+  }
+}
+
 } // namespace itk
 
 #endif
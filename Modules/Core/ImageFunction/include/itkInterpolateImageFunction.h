@@ -113,6 +113,25 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at numberOfIndices continuous index positions.
+   *
+   * Stores the interpolated image intensities in values. No bounds
+   * checking is done: the points are assumed to lie within the image buffer.
+   *
+   * The default implementation calls EvaluateAtContinuousIndex() for each
+   * index. Subclasses may override it to share computations between the
+   * indices, as between those of a scanline of a resampled image. */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBSplineInterpolateImageFunction.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// Tests that the values and the derivatives evaluated at once at many
+// continuous indices are those evaluated at each of them, for points
+// scattered in the image and for points along a scanline.
+template <unsigned int VDimension>
+void
+Expect_evaluation_at_continuous_indices_matches_evaluation_at_each_index(const unsigned int splineOrder)
+{
+  using ImageType = itk::Image<short, VDimension>;
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<ImageType>;
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+  using CovariantVectorType = typename InterpolatorType::CovariantVectorType;
+
+  std::mt19937 randomNumberEngine(splineOrder);
+
+  auto                            image = ImageType::New();
+  typename ImageType::IndexType   start;
+  typename ImageType::SizeType    size;
+  typename ImageType::SpacingType spacing;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    start[d] = 3 - static_cast<itk::IndexValueType>(d);
+    size[d] = 9 + d;
+    spacing[d] = 0.5 + d;
+  }
+  image->SetRegions(typename ImageType::RegionType(start, size));
+  image->SetSpacing(spacing);
+  auto direction = image->GetDirection();
+  if constexpr (VDimension > 1)
+  {
+    direction.Fill(0.0);
+    direction[0][1] = 1.0;
+    direction[1][0] = -1.0;
+    for (unsigned int d = 2; d < VDimension; ++d)
+    {
+      direction[d][d] = 1.0;
+    }
+  }
+  image->SetDirection(direction);
+  image->Allocate();
+  std::uniform_int_distribution<int> valueDistribution(-1000, 1000);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(valueDistribution(randomNumberEngine)));
+  }
+
+  auto interpolator = InterpolatorType::New();
+  interpolator->SetSplineOrder(splineOrder);
+  interpolator->SetInputImage(image);
+
+  // Scattered points, including points near the borders where the mirror
+  // boundary conditions apply, then points along a scanline
+  std::vector<ContinuousIndexType>       indices;
+  std::uniform_real_distribution<double> unitDistribution(0.0, 1.0);
+  for (int i = 0; i < 200; ++i)
+  {
+    ContinuousIndexType index;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      index[d] = start[d] - 0.5 + unitDistribution(randomNumberEngine) * size[d];
+    }
+    indices.push_back(index);
+  }
+  ContinuousIndexType scanlineIndex = indices.back();
+  for (int i = 0; i < 40; ++i)
+  {
+    scanlineIndex[0] = start[0] - 0.5 + i * (size[0] / 40.0);
+    indices.push_back(scanlineIndex);
+  }
+
+  const auto                       numberOfIndices = static_cast<itk::SizeValueType>(indices.size());
+  std::vector<double>              values(numberOfIndices);
+  std::vector<double>              valuesWithDerivatives(numberOfIndices);
+  std::vector<CovariantVectorType> derivatives(numberOfIndices);
+  std::vector<CovariantVectorType> derivativesWithValues(numberOfIndices);
+  interpolator->EvaluateAtContinuousIndices(indices.data(), values.data(), numberOfIndices);
+  interpolator->EvaluateDerivativeAtContinuousIndices(indices.data(), derivatives.data(), numberOfIndices);
+  interpolator->EvaluateValueAndDerivativeAtContinuousIndices(
+    indices.data(), valuesWithDerivatives.data(), derivativesWithValues.data(), numberOfIndices);
+
+  constexpr double tolerance = 1e-9;
+  for (itk::SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    const double expectedValue = interpolator->EvaluateAtContinuousIndex(indices[i]);
+    EXPECT_NEAR(values[i], expectedValue, tolerance) << indices[i];
+    EXPECT_NEAR(valuesWithDerivatives[i], expectedValue, tolerance) << indices[i];
+
+    const CovariantVectorType expectedDerivative = interpolator->EvaluateDerivativeAtContinuousIndex(indices[i]);
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      EXPECT_NEAR(derivatives[i][d], expectedDerivative[d], tolerance) << indices[i];
+      EXPECT_NEAR(derivativesWithValues[i][d], expectedDerivative[d], tolerance) << indices[i];
+    }
+  }
+}
+} // namespace
+
+
+TEST(BSplineInterpolateImageFunction, EvaluationAtContinuousIndicesMatchesEvaluationAtEachIndex)
+{
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    Expect_evaluation_at_continuous_indices_matches_evaluation_at_each_index<1>(splineOrder);
+    Expect_evaluation_at_continuous_indices_matches_evaluation_at_each_index<2>(splineOrder);
+    Expect_evaluation_at_continuous_indices_matches_evaluation_at_each_index<3>(splineOrder);
+  }
+}
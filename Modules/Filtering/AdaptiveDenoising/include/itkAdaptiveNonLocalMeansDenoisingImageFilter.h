@@ -41,6 +41,16 @@ namespace itk
  * Spatially Varying Noise Levels, Journal of Magnetic Resonance Imaging,
  * 31:192-203, June 2010.
  *
+ * By default the distance between two patches is computed pixel by pixel for
+ * every pair of a center and a search neighbor, which costs the size of the
+ * patch per pair. With UseFastPatchDistances on, the search offsets are
+ * processed one at a time instead: the squared differences of the image
+ * with its translation by the offset are summed over the patches with
+ * separable running sums, so that the cost per pair does not depend on the
+ * size of the patch anymore. The weighted patches are aggregated in the same
+ * way, and each thread writes its own part of the output. This needs a few
+ * more images of the size of the input.
+ *
  * \ingroup AdaptiveDenoising
  */
 
@@ -172,6 +182,15 @@ public:
   itkSetMacro(NeighborhoodRadiusForLocalMeanAndVariance, NeighborhoodRadiusType);
   itkGetConstMacro(NeighborhoodRadiusForLocalMeanAndVariance, NeighborhoodRadiusType);
 
+  /**
+   * Compute the patch distances with box sums, one search offset at a time.
+   * The results match the default computation up to floating point rounding.
+   * Default = false.
+   */
+  itkSetMacro(UseFastPatchDistances, bool);
+  itkGetConstMacro(UseFastPatchDistances, bool);
+  itkBooleanMacro(UseFastPatchDistances);
+
 protected:
   AdaptiveNonLocalMeansDenoisingImageFilter();
   ~AdaptiveNonLocalMeansDenoisingImageFilter() override = default;
@@ -179,6 +198,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  void
+  GenerateData() override;
+
   void
   ThreadedGenerateData(const RegionType &, ThreadIdType) override;
 
@@ -191,6 +213,53 @@ protected:
 private:
   RealType CalculateCorrectionFactor(RealType);
 
+  /** Whether a search neighbor may contribute to the center, given their
+   * local means and variances. */
+  bool
+  IsSimilarNeighbor(RealType meanCenter,
+                    RealType varianceCenter,
+                    RealType meanNeighbor,
+                    RealType varianceNeighbor) const;
+
+  /** Compute the minimum distance, the sum of the weights and the maximum
+   * weight of the centers in a tile, when UseFastPatchDistances is on. */
+  void
+  ComputeSumsOfWeights(const RegionType & tile);
+
+  /** Aggregate the weighted patches into the pixels of a tile of the output,
+   * when UseFastPatchDistances is on. */
+  void
+  AggregatePatches(const RegionType & tile);
+
+  /** Fill the buffered region of distances with the sums over the patches of
+   * the squared differences between the residuals and their translation by
+   * offset. */
+  void
+  ComputePatchDistanceSums(const NeighborhoodOffsetType & offset,
+                           RealImageType *                distances,
+                           RealImageType *                scratch) const;
+
+  /** Call function(center, pixel, weight) for each center of centerRegion
+   * whose neighbor at offset gets a non zero weight, where center is the
+   * offset of the center in the target region and pixel its offset in the
+   * buffer of distances. */
+  template <typename TFunction>
+  void
+  VisitWeights(const RegionType &             centerRegion,
+               const NeighborhoodOffsetType & offset,
+               const RealImageType *          distances,
+               TFunction &&                   function) const;
+
+  /** Replace the values of the buffered region of image by their sums over
+   * the patches, the values outside of the buffered region being zero. */
+  void
+  ComputePatchSums(RealImageType * image, RealImageType * scratch) const;
+
+  /** Number of pixels of the patch around index which, translated by offset,
+   * stay inside the target region. */
+  RealType
+  CountPatchPixels(const IndexType & index, const NeighborhoodOffsetType & offset) const;
+
   bool m_UseRicianNoiseModel;
 
   ModifiedBesselCalculatorType m_ModifiedBesselCalculator;
@@ -211,6 +280,19 @@ private:
   RealImagePointer m_IntensitySquaredDistanceImage;
 
   NeighborhoodRadiusType m_NeighborhoodRadiusForLocalMeanAndVariance;
+
+  bool m_UseFastPatchDistances;
+
+  // Images over the target region used when UseFastPatchDistances is on.
+  // The search variance is NonpositiveMin where the pixel cannot be a search
+  // neighbor, and the minimum distance is zero where the pixel is not a
+  // filtered center.
+  RealImagePointer m_ResidualImage;
+  RealImagePointer m_SearchMeanImage;
+  RealImagePointer m_SearchVarianceImage;
+  RealImagePointer m_MinimumDistanceImage;
+  RealImagePointer m_SumOfWeightsImage;
+  RealImagePointer m_MaximumWeightImage;
 };
 
 } // end namespace itk
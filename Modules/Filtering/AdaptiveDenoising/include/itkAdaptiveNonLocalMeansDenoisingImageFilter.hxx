@@ -24,11 +24,15 @@
 #include "itkImageRegionConstIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkMath.h"
 #include "itkMeanImageFilter.h"
 #include "itkNeighborhoodIterator.h"
 #include "itkProgressReporter.h"
 #include "itkStatisticsImageFilter.h"
+#include "itkTotalProgressReporter.h"
 #include "itkVarianceImageFilter.h"
 
 #include <numeric>
@@ -47,6 +51,7 @@ AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>
   , m_SmoothingVariance(2.0)
   , m_MaximumInputPixelIntensity(NumericTraits<RealType>::NonpositiveMin())
   , m_MinimumInputPixelIntensity(NumericTraits<RealType>::max())
+  , m_UseFastPatchDistances(false)
 {
   this->SetNumberOfRequiredInputs(1);
 
@@ -113,6 +118,587 @@ AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>
   this->GetOutput()->FillBuffer(0.0);
 }
 
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateData()
+{
+  if (!this->m_UseFastPatchDistances)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  this->BeforeThreadedGenerateData();
+
+  const InputImageType * inputImage = this->GetInput();
+  const RegionType       region = this->GetTargetImageRegion();
+
+  const auto createImage = [inputImage, &region]() {
+    auto image = RealImageType::New();
+    image->CopyInformation(inputImage);
+    image->SetRegions(region);
+    image->Allocate();
+    return image;
+  };
+  this->m_ResidualImage = createImage();
+  this->m_SearchMeanImage = createImage();
+  this->m_SearchVarianceImage = createImage();
+  this->m_MinimumDistanceImage = createImage();
+  this->m_SumOfWeightsImage = createImage();
+  this->m_MaximumWeightImage = createImage();
+
+  ImageRegionConstIterator<InputImageType> ItI(inputImage, region);
+  ImageRegionConstIterator<RealImageType>  ItM(this->m_MeanImage, region);
+  ImageRegionConstIterator<RealImageType>  ItV(this->m_VarianceImage, region);
+  ImageRegionIterator<RealImageType>       ItR(this->m_ResidualImage, region);
+  ImageRegionIterator<RealImageType>       ItSM(this->m_SearchMeanImage, region);
+  ImageRegionIterator<RealImageType>       ItSV(this->m_SearchVarianceImage, region);
+  for (; !ItI.IsAtEnd(); ++ItI, ++ItM, ++ItV, ++ItR, ++ItSM, ++ItSV)
+  {
+    const auto intensity = static_cast<RealType>(ItI.Get());
+    ItR.Set(intensity - ItM.Get());
+    ItSM.Set(ItM.Get());
+    if (intensity > 0 && ItM.Get() > this->m_Epsilon)
+    {
+      ItSV.Set(ItV.Get());
+    }
+    else
+    {
+      ItSV.Set(NumericTraits<RealType>::NonpositiveMin());
+    }
+  }
+
+  // The work units are processed in tiles, which bounds the size of the
+  // buffers of each thread.
+  constexpr SizeValueType maximumNumberOfPixelsPerTile = SizeValueType{ 1 } << 18;
+  const auto              splitter = ImageRegionSplitterSlowDimension::New();
+  TotalProgressReporter   progress(this, 2 * region.GetNumberOfPixels());
+  const auto forEachTile = [&splitter, &progress](const RegionType & workUnitRegion, auto && process) {
+    const auto requestedNumberOfTiles = static_cast<unsigned int>(
+      (workUnitRegion.GetNumberOfPixels() + maximumNumberOfPixelsPerTile - 1) / maximumNumberOfPixelsPerTile);
+    const unsigned int numberOfTiles = splitter->GetNumberOfSplits(workUnitRegion, requestedNumberOfTiles);
+    for (unsigned int i = 0; i < numberOfTiles; ++i)
+    {
+      RegionType tile = workUnitRegion;
+      splitter->GetSplit(i, numberOfTiles, tile);
+      process(tile);
+      progress.Completed(tile.GetNumberOfPixels());
+    }
+  };
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this, &forEachTile](const RegionType & workUnitRegion) {
+      forEachTile(workUnitRegion, [this](const RegionType & tile) { this->ComputeSumsOfWeights(tile); });
+    },
+    nullptr);
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this, &forEachTile](const RegionType & workUnitRegion) {
+      forEachTile(workUnitRegion, [this](const RegionType & tile) { this->AggregatePatches(tile); });
+    },
+    nullptr);
+
+  this->m_ResidualImage = nullptr;
+  this->m_SearchMeanImage = nullptr;
+  this->m_SearchVarianceImage = nullptr;
+  this->m_MinimumDistanceImage = nullptr;
+  this->m_SumOfWeightsImage = nullptr;
+  this->m_MaximumWeightImage = nullptr;
+
+  this->AfterThreadedGenerateData();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+bool
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::IsSimilarNeighbor(
+  RealType meanCenter,
+  RealType varianceCenter,
+  RealType meanNeighbor,
+  RealType varianceNeighbor) const
+{
+  const RealType meanRatio = meanCenter / meanNeighbor;
+  const RealType meanRatioInverse =
+    (this->m_MaximumInputPixelIntensity - meanCenter) / (this->m_MaximumInputPixelIntensity - meanNeighbor);
+
+  const RealType varianceRatio = varianceCenter / varianceNeighbor;
+
+  return ((meanRatio > this->m_MeanThreshold &&
+           meanRatio < itk::NumericTraits<RealType>::OneValue() / this->m_MeanThreshold) ||
+          (meanRatioInverse > this->m_MeanThreshold &&
+           meanRatioInverse < itk::NumericTraits<RealType>::OneValue() / this->m_MeanThreshold)) &&
+         varianceRatio > this->m_VarianceThreshold &&
+         varianceRatio < itk::NumericTraits<RealType>::OneValue() / this->m_VarianceThreshold;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::CountPatchPixels(
+  const IndexType &              index,
+  const NeighborhoodOffsetType & offset) const -> RealType
+{
+  const RegionType &             region = this->GetTargetImageRegion();
+  const NeighborhoodRadiusType & radius = this->GetNeighborhoodPatchRadius();
+
+  RealType count = NumericTraits<RealType>::OneValue();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const IndexValueType lower = region.GetIndex(d) + std::max<IndexValueType>(0, -offset[d]);
+    const IndexValueType upper = region.GetUpperIndex()[d] - std::max<IndexValueType>(0, offset[d]);
+    const IndexValueType begin = std::max(lower, index[d] - static_cast<IndexValueType>(radius[d]));
+    const IndexValueType end = std::min(upper, index[d] + static_cast<IndexValueType>(radius[d]));
+    if (end < begin)
+    {
+      return NumericTraits<RealType>::ZeroValue();
+    }
+    count *= static_cast<RealType>(end - begin + 1);
+  }
+  return count;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::ComputePatchSums(
+  RealImageType * image,
+  RealImageType * scratch) const
+{
+  const NeighborhoodRadiusType & radius = this->GetNeighborhoodPatchRadius();
+  const auto                     size = image->GetBufferedRegion().GetSize();
+  const OffsetValueType *        offsetTable = image->GetOffsetTable();
+  const auto numberOfPixels = static_cast<OffsetValueType>(image->GetBufferedRegion().GetNumberOfPixels());
+
+  // Running sums along one dimension at a time. Along the first dimension
+  // the lines are summed one by one, along the other ones whole rows of
+  // contiguous pixels are summed together.
+  std::vector<double> sums;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const auto length = static_cast<OffsetValueType>(size[d]);
+    const auto r = static_cast<OffsetValueType>(radius[d]);
+    if (r == 0)
+    {
+      continue;
+    }
+    const OffsetValueType stride = offsetTable[d];
+    const OffsetValueType numberOfBlocks = numberOfPixels / (stride * length);
+    const RealType *      input = image->GetBufferPointer();
+    RealType *            output = scratch->GetBufferPointer();
+    if (d == 0)
+    {
+      for (OffsetValueType block = 0; block < numberOfBlocks; ++block)
+      {
+        const RealType * in = input + block * length;
+        RealType *       out = output + block * length;
+        double           sum = 0.0;
+        for (OffsetValueType j = 0; j < std::min(r, length); ++j)
+        {
+          sum += in[j];
+        }
+        for (OffsetValueType i = 0; i < length; ++i)
+        {
+          if (i + r < length)
+          {
+            sum += in[i + r];
+          }
+          if (i > r)
+          {
+            sum -= in[i - r - 1];
+          }
+          out[i] = static_cast<RealType>(sum);
+        }
+      }
+    }
+    else
+    {
+      sums.resize(stride);
+      for (OffsetValueType block = 0; block < numberOfBlocks; ++block)
+      {
+        const RealType * in = input + block * stride * length;
+        RealType *       out = output + block * stride * length;
+        std::fill(sums.begin(), sums.end(), 0.0);
+        for (OffsetValueType j = 0; j < std::min(r, length); ++j)
+        {
+          for (OffsetValueType k = 0; k < stride; ++k)
+          {
+            sums[k] += in[j * stride + k];
+          }
+        }
+        for (OffsetValueType i = 0; i < length; ++i)
+        {
+          if (i + r < length)
+          {
+            const RealType * addedRow = in + (i + r) * stride;
+            for (OffsetValueType k = 0; k < stride; ++k)
+            {
+              sums[k] += addedRow[k];
+            }
+          }
+          if (i > r)
+          {
+            const RealType * removedRow = in + (i - r - 1) * stride;
+            for (OffsetValueType k = 0; k < stride; ++k)
+            {
+              sums[k] -= removedRow[k];
+            }
+          }
+          RealType * outRow = out + i * stride;
+          for (OffsetValueType k = 0; k < stride; ++k)
+          {
+            outRow[k] = static_cast<RealType>(sums[k]);
+          }
+        }
+      }
+    }
+    const typename RealImageType::PixelContainerPointer pixelContainer = image->GetPixelContainer();
+    image->SetPixelContainer(scratch->GetPixelContainer());
+    scratch->SetPixelContainer(pixelContainer);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::ComputePatchDistanceSums(
+  const NeighborhoodOffsetType & offset,
+  RealImageType *                distances,
+  RealImageType *                scratch) const
+{
+  const RegionType & region = this->GetTargetImageRegion();
+  const RealType *   residuals = this->m_ResidualImage->GetBufferPointer();
+  const auto         neighborOffset = this->m_ResidualImage->ComputeOffset(region.GetIndex() + offset) -
+                              this->m_ResidualImage->ComputeOffset(region.GetIndex());
+
+  // a pixel of a patch contributes to the distance only when it and its
+  // translation by the offset are both inside the target region
+  const RegionType & bufferRegion = distances->GetBufferedRegion();
+  const auto         lineLength = static_cast<IndexValueType>(bufferRegion.GetSize(0));
+  const auto         neighborBegin = region.GetIndex(0) - offset[0];
+  const auto         neighborEnd = region.GetUpperIndex()[0] - offset[0] + 1;
+  for (ImageScanlineIterator<RealImageType> it(distances, bufferRegion); !it.IsAtEnd(); it.NextLine())
+  {
+    const IndexType index = it.GetIndex();
+    RealType *      line = distances->GetBufferPointer() + distances->ComputeOffset(index);
+    std::fill(line, line + lineLength, NumericTraits<RealType>::ZeroValue());
+
+    IndexType beginIndex = index + offset;
+    beginIndex[0] = std::max(index[0], neighborBegin) + offset[0];
+    const IndexValueType end = std::min(index[0] + lineLength, neighborEnd);
+    if (!region.IsInside(beginIndex) || beginIndex[0] - offset[0] >= end)
+    {
+      continue;
+    }
+    const RealType * neighborResidual = residuals + this->m_ResidualImage->ComputeOffset(beginIndex);
+    const RealType * residual = neighborResidual - neighborOffset;
+    for (IndexValueType x = beginIndex[0] - offset[0]; x < end; ++x, ++residual, ++neighborResidual)
+    {
+      line[x - index[0]] = itk::Math::sqr(*neighborResidual - *residual);
+    }
+  }
+
+  this->ComputePatchSums(distances, scratch);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+template <typename TFunction>
+void
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::VisitWeights(
+  const RegionType &             centerRegion,
+  const NeighborhoodOffsetType & offset,
+  const RealImageType *          distances,
+  TFunction &&                   function) const
+{
+  const RegionType &             region = this->GetTargetImageRegion();
+  const NeighborhoodRadiusType & radius = this->GetNeighborhoodPatchRadius();
+  const RealType *               means = this->m_SearchMeanImage->GetBufferPointer();
+  const RealType *               variances = this->m_SearchVarianceImage->GetBufferPointer();
+  const RealType *               minimumDistances = this->m_MinimumDistanceImage->GetBufferPointer();
+  const auto neighborOffset = this->m_ResidualImage->ComputeOffset(region.GetIndex() + offset) -
+                              this->m_ResidualImage->ComputeOffset(region.GetIndex());
+
+  // the patch pixels are counted along the first dimension pixel by pixel,
+  // and along the other dimensions line by line
+  const IndexValueType countLower = region.GetIndex(0) + std::max<IndexValueType>(0, -offset[0]);
+  const IndexValueType countUpper = region.GetUpperIndex()[0] - std::max<IndexValueType>(0, offset[0]);
+  const auto           r = static_cast<IndexValueType>(radius[0]);
+  const auto           neighborBegin = region.GetIndex(0) - offset[0];
+  const auto           neighborEnd = region.GetUpperIndex()[0] - offset[0] + 1;
+  const auto           lineLength = static_cast<IndexValueType>(centerRegion.GetSize(0));
+
+  for (ImageScanlineConstIterator<RealImageType> it(this->m_ResidualImage, centerRegion); !it.IsAtEnd(); it.NextLine())
+  {
+    const IndexType index = it.GetIndex();
+    IndexType       beginIndex = index + offset;
+    beginIndex[0] = std::max(index[0], neighborBegin) + offset[0];
+    const IndexValueType end = std::min(index[0] + lineLength, neighborEnd);
+    if (!region.IsInside(beginIndex) || beginIndex[0] - offset[0] >= end)
+    {
+      continue;
+    }
+    beginIndex -= offset;
+    const RealType lineCount = this->CountPatchPixels(beginIndex, offset) /
+                               static_cast<RealType>(std::min(countUpper, beginIndex[0] + r) -
+                                                     std::max(countLower, beginIndex[0] - r) + 1);
+
+    OffsetValueType center = this->m_ResidualImage->ComputeOffset(beginIndex);
+    OffsetValueType distance = distances->ComputeOffset(beginIndex);
+    for (IndexValueType x = beginIndex[0]; x < end; ++x, ++center, ++distance)
+    {
+      const RealType        minimumDistance = minimumDistances[center];
+      const OffsetValueType neighbor = center + neighborOffset;
+      if (minimumDistance == NumericTraits<RealType>::ZeroValue() || !(variances[neighbor] > this->m_Epsilon) ||
+          !this->IsSimilarNeighbor(means[center], variances[center], means[neighbor], variances[neighbor]))
+      {
+        continue;
+      }
+      const RealType count =
+        lineCount * static_cast<RealType>(std::min(countUpper, x + r) - std::max(countLower, x - r) + 1);
+      const RealType averageDistance = distances->GetBufferPointer()[distance] / count;
+      if (averageDistance <= static_cast<RealType>(3.0) * minimumDistance)
+      {
+        function(center, distance, std::exp(-averageDistance / minimumDistance));
+      }
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::ComputeSumsOfWeights(
+  const RegionType & tile)
+{
+  const RegionType &    region = this->GetTargetImageRegion();
+  const MaskImageType * maskImage = this->GetMaskImage();
+
+  const RealType * means = this->m_SearchMeanImage->GetBufferPointer();
+  const RealType * variances = this->m_SearchVarianceImage->GetBufferPointer();
+  RealType *       minimumDistances = this->m_MinimumDistanceImage->GetBufferPointer();
+  RealType *       sumsOfWeights = this->m_SumOfWeightsImage->GetBufferPointer();
+  RealType *       maximumWeights = this->m_MaximumWeightImage->GetBufferPointer();
+
+  const NeighborhoodOffsetListType & searchOffsetList = this->GetNeighborhoodSearchOffsetList();
+  const NeighborhoodOffsetType       zeroOffset{};
+  const auto createImage = [&region](RegionType bufferRegion, const NeighborhoodRadiusType & pad) {
+    bufferRegion.PadByRadius(pad);
+    bufferRegion.Crop(region);
+    auto image = RealImageType::New();
+    image->SetRegions(bufferRegion);
+    image->Allocate();
+    return image;
+  };
+
+  // Mean squared residual of the patches around the search neighbors of the
+  // tile, from which the minimum distance of each center is taken
+  RegionType energyRegion = tile;
+  energyRegion.PadByRadius(this->GetNeighborhoodSearchRadius());
+  energyRegion.Crop(region);
+  const auto energies = createImage(energyRegion, this->GetNeighborhoodPatchRadius());
+  auto       scratch = createImage(energyRegion, this->GetNeighborhoodPatchRadius());
+  for (ImageRegionIterator<RealImageType> It(energies, energies->GetBufferedRegion()); !It.IsAtEnd(); ++It)
+  {
+    It.Set(itk::Math::sqr(this->m_ResidualImage->GetPixel(It.GetIndex())));
+  }
+  this->ComputePatchSums(energies, scratch);
+
+  for (ImageRegionConstIteratorWithIndex<RealImageType> It(this->m_ResidualImage, tile); !It.IsAtEnd(); ++It)
+  {
+    const IndexType       centerIndex = It.GetIndex();
+    const OffsetValueType center = this->m_ResidualImage->ComputeOffset(centerIndex);
+    minimumDistances[center] = NumericTraits<RealType>::ZeroValue();
+    sumsOfWeights[center] = NumericTraits<RealType>::ZeroValue();
+    maximumWeights[center] = NumericTraits<RealType>::ZeroValue();
+    if (!(variances[center] > this->m_Epsilon) ||
+        (maskImage && maskImage->GetPixel(centerIndex) == NumericTraits<MaskPixelType>::ZeroValue()))
+    {
+      continue;
+    }
+
+    RealType minimumDistance = NumericTraits<RealType>::max();
+    for (const NeighborhoodOffsetType & offset : searchOffsetList)
+    {
+      const IndexType neighborIndex = centerIndex + offset;
+      if (offset == zeroOffset || !region.IsInside(neighborIndex))
+      {
+        continue;
+      }
+      const OffsetValueType neighbor = this->m_ResidualImage->ComputeOffset(neighborIndex);
+      if (variances[neighbor] > this->m_Epsilon &&
+          this->IsSimilarNeighbor(means[center], variances[center], means[neighbor], variances[neighbor]))
+      {
+        const RealType averageDistance =
+          energies->GetPixel(neighborIndex) / this->CountPatchPixels(neighborIndex, zeroOffset);
+        minimumDistance = std::min(averageDistance, minimumDistance);
+      }
+    }
+    if (itk::Math::AlmostEquals(minimumDistance, NumericTraits<RealType>::ZeroValue()))
+    {
+      minimumDistance = NumericTraits<RealType>::OneValue();
+    }
+    minimumDistances[center] = minimumDistance;
+  }
+
+  // Sum of the weights of the search neighbors of each center
+  const auto distances = createImage(tile, this->GetNeighborhoodPatchRadius());
+  scratch = createImage(tile, this->GetNeighborhoodPatchRadius());
+  for (const NeighborhoodOffsetType & offset : searchOffsetList)
+  {
+    if (offset == zeroOffset)
+    {
+      continue;
+    }
+    this->ComputePatchDistanceSums(offset, distances, scratch);
+    this->VisitWeights(tile,
+                       offset,
+                       distances,
+                       [sumsOfWeights, maximumWeights](OffsetValueType center, OffsetValueType, RealType weight) {
+                         maximumWeights[center] = std::max(maximumWeights[center], weight);
+                         sumsOfWeights[center] += weight;
+                       });
+  }
+
+  // The center itself gets the maximum weight, and the pixels which are not
+  // filtered keep their value
+  for (ImageRegionConstIteratorWithIndex<RealImageType> It(this->m_ResidualImage, tile); !It.IsAtEnd(); ++It)
+  {
+    const OffsetValueType center = this->m_ResidualImage->ComputeOffset(It.GetIndex());
+    if (itk::Math::AlmostEquals(maximumWeights[center], NumericTraits<RealType>::ZeroValue()))
+    {
+      maximumWeights[center] = NumericTraits<RealType>::OneValue();
+    }
+    sumsOfWeights[center] += maximumWeights[center];
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::AggregatePatches(
+  const RegionType & tile)
+{
+  const RegionType &     region = this->GetTargetImageRegion();
+  const InputImageType * inputImage = this->GetInput();
+  OutputImageType *      outputImage = this->GetOutput();
+
+  const RealType * minimumDistances = this->m_MinimumDistanceImage->GetBufferPointer();
+  const RealType * sumsOfWeights = this->m_SumOfWeightsImage->GetBufferPointer();
+  const RealType * maximumWeights = this->m_MaximumWeightImage->GetBufferPointer();
+
+  const NeighborhoodOffsetListType & searchOffsetList = this->GetNeighborhoodSearchOffsetList();
+  const NeighborhoodRadiusType &     patchRadius = this->GetNeighborhoodPatchRadius();
+  const NeighborhoodOffsetType       zeroOffset{};
+
+  const auto intensityValue = [this](const InputPixelType pixel) {
+    const auto value = static_cast<RealType>(pixel);
+    return this->m_UseRicianNoiseModel ? itk::Math::sqr(value) : value;
+  };
+
+  // The weights are needed for the centers whose patches overlap the tile,
+  // and the distances of these centers for the pixels of their patches
+  RegionType bufferRegion = tile;
+  bufferRegion.PadByRadius(patchRadius);
+  bufferRegion.PadByRadius(patchRadius);
+  bufferRegion.Crop(region);
+  const auto createImage = [&bufferRegion]() {
+    auto image = RealImageType::New();
+    image->SetRegions(bufferRegion);
+    image->Allocate();
+    return image;
+  };
+  const auto distances = createImage();
+  const auto weights = createImage();
+  const auto scratch = createImage();
+
+  const auto            tileLineLength = static_cast<IndexValueType>(tile.GetSize(0));
+  std::vector<RealType> estimates(tile.GetNumberOfPixels(), NumericTraits<RealType>::ZeroValue());
+  for (const NeighborhoodOffsetType & offset : searchOffsetList)
+  {
+    if (offset == zeroOffset)
+    {
+      continue;
+    }
+    this->ComputePatchDistanceSums(offset, distances, scratch);
+
+    // the weight of each center for this search offset, divided by the sum
+    // of its weights
+    RealType * weightBuffer = weights->GetBufferPointer();
+    std::fill_n(weightBuffer, bufferRegion.GetNumberOfPixels(), NumericTraits<RealType>::ZeroValue());
+    this->VisitWeights(bufferRegion,
+                       offset,
+                       distances,
+                       [weightBuffer, sumsOfWeights](OffsetValueType center, OffsetValueType pixel, RealType weight) {
+                         weightBuffer[pixel] = weight / sumsOfWeights[center];
+                       });
+    this->ComputePatchSums(weights, scratch);
+
+    // each pixel of the tile receives the translated pixel from the patches
+    // of all the centers around it
+    weightBuffer = weights->GetBufferPointer();
+    const auto neighborBegin = region.GetIndex(0) - offset[0];
+    const auto neighborEnd = region.GetUpperIndex()[0] - offset[0] + 1;
+    RealType * estimate = estimates.data();
+    for (ImageScanlineConstIterator<RealImageType> it(weights, tile); !it.IsAtEnd();
+         it.NextLine(), estimate += tileLineLength)
+    {
+      const IndexType index = it.GetIndex();
+      IndexType       beginIndex = index + offset;
+      beginIndex[0] = std::max(index[0], neighborBegin) + offset[0];
+      const IndexValueType end = std::min(index[0] + tileLineLength, neighborEnd);
+      if (!region.IsInside(beginIndex) || beginIndex[0] - offset[0] >= end)
+      {
+        continue;
+      }
+      const InputPixelType * neighborPixel = inputImage->GetBufferPointer() + inputImage->ComputeOffset(beginIndex);
+      beginIndex -= offset;
+      const RealType * weight = weightBuffer + weights->ComputeOffset(beginIndex);
+      for (IndexValueType x = beginIndex[0]; x < end; ++x, ++weight, ++neighborPixel)
+      {
+        estimate[x - index[0]] += *weight * intensityValue(*neighborPixel);
+      }
+    }
+  }
+
+  // the centers contribute their own patches with their maximum weight
+  for (ImageRegionIteratorWithIndex<RealImageType> It(weights, bufferRegion); !It.IsAtEnd(); ++It)
+  {
+    const OffsetValueType center = this->m_ResidualImage->ComputeOffset(It.GetIndex());
+    It.Set(maximumWeights[center] / sumsOfWeights[center]);
+  }
+  this->ComputePatchSums(weights, scratch);
+
+  const NeighborhoodOffsetListType & patchOffsetList = this->GetNeighborhoodPatchOffsetList();
+
+  auto estimate = estimates.begin();
+  for (ImageRegionConstIteratorWithIndex<RealImageType> It(weights, tile); !It.IsAtEnd(); ++It, ++estimate)
+  {
+    const IndexType index = It.GetIndex();
+    *estimate += It.Get() * intensityValue(inputImage->GetPixel(index));
+    outputImage->SetPixel(index, static_cast<typename OutputImageType::PixelType>(*estimate));
+    this->m_ThreadContributionCountImage->SetPixel(index, this->CountPatchPixels(index, zeroOffset));
+
+    if (this->m_UseRicianNoiseModel)
+    {
+      // the bias is the minimum distance of the last filtered center, in
+      // scan order, whose patch contains the pixel
+      for (const NeighborhoodOffsetType & patchOffset : patchOffsetList)
+      {
+        const IndexType centerIndex = index - patchOffset;
+        if (!region.IsInside(centerIndex))
+        {
+          continue;
+        }
+        const RealType minimumDistance = minimumDistances[this->m_ResidualImage->ComputeOffset(centerIndex)];
+        if (minimumDistance != NumericTraits<RealType>::ZeroValue())
+        {
+          this->m_RicianBiasImage->SetPixel(index,
+                                            itk::Math::AlmostEquals(minimumDistance, NumericTraits<RealType>::max())
+                                              ? NumericTraits<RealType>::ZeroValue()
+                                              : minimumDistance);
+          break;
+        }
+      }
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>::ThreadedGenerateData(
@@ -186,18 +772,8 @@ AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>
           continue;
         }
 
-        const RealType meanRatio = meanCenterPixel / meanNeighborhoodPixel;
-        const RealType meanRatioInverse = (this->m_MaximumInputPixelIntensity - meanCenterPixel) /
-                                          (this->m_MaximumInputPixelIntensity - meanNeighborhoodPixel);
-
-        const RealType varianceRatio = varianceCenterPixel / varianceNeighborhoodPixel;
-
-        if (((meanRatio > this->m_MeanThreshold &&
-              meanRatio < itk::NumericTraits<RealType>::OneValue() / this->m_MeanThreshold) ||
-             (meanRatioInverse > this->m_MeanThreshold &&
-              meanRatioInverse < itk::NumericTraits<RealType>::OneValue() / this->m_MeanThreshold)) &&
-            varianceRatio > this->m_VarianceThreshold &&
-            varianceRatio < itk::NumericTraits<RealType>::OneValue() / this->m_VarianceThreshold)
+        if (this->IsSimilarNeighbor(
+              meanCenterPixel, varianceCenterPixel, meanNeighborhoodPixel, varianceNeighborhoodPixel))
         {
 
           RealType averageDistance = itk::NumericTraits<RealType>::ZeroValue();
@@ -274,18 +850,8 @@ AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>
           continue;
         }
 
-        const RealType meanRatio = meanCenterPixel / meanNeighborhoodPixel;
-        const RealType meanRatioInverse = (this->m_MaximumInputPixelIntensity - meanCenterPixel) /
-                                          (this->m_MaximumInputPixelIntensity - meanNeighborhoodPixel);
-
-        const RealType varianceRatio = varianceCenterPixel / varianceNeighborhoodPixel;
-
-        if (((meanRatio > this->m_MeanThreshold &&
-              meanRatio < itk::NumericTraits<RealType>::OneValue() / this->m_MeanThreshold) ||
-             (meanRatioInverse > this->m_MeanThreshold &&
-              meanRatioInverse < itk::NumericTraits<RealType>::OneValue() / this->m_MeanThreshold)) &&
-            varianceRatio > this->m_VarianceThreshold &&
-            varianceRatio < itk::NumericTraits<RealType>::OneValue() / this->m_VarianceThreshold)
+        if (this->IsSimilarNeighbor(
+              meanCenterPixel, varianceCenterPixel, meanNeighborhoodPixel, varianceNeighborhoodPixel))
         {
 
           RealType averageDistance = 0.0;
@@ -513,6 +1079,7 @@ AdaptiveNonLocalMeansDenoisingImageFilter<TInputImage, TOutputImage, TMaskImage>
   os << indent << "Mean threshold = " << this->m_MeanThreshold << std::endl;
   os << indent << "Variance threshold = " << this->m_VarianceThreshold << std::endl;
   os << indent << "Smoothing variance = " << this->m_SmoothingVariance << std::endl;
+  os << indent << "Use fast patch distances = " << this->m_UseFastPatchDistances << std::endl;
 
   os << indent
      << "Neighborhood radius for local mean and variance = " << this->m_NeighborhoodRadiusForLocalMeanAndVariance
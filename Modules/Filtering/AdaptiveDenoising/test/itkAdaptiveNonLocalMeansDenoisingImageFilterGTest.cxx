@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkAdaptiveNonLocalMeansDenoisingImageFilter.h"
+
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<float, Dimension>;
+using MaskImageType = itk::Image<unsigned char, Dimension>;
+using FilterType = itk::AdaptiveNonLocalMeansDenoisingImageFilter<ImageType, ImageType, MaskImageType>;
+
+// Piecewise constant blocks with Gaussian noise, and a few zero pixels
+ImageType::Pointer
+CreateNoisyImage()
+{
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size{ { 21, 18, 15 } };
+  image->SetRegions(size);
+  image->Allocate();
+
+  std::mt19937                    generator(42);
+  std::normal_distribution<float> noise(0.0f, 8.0f);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const float value = 100.0f + 50.0f * static_cast<float>((index[0] / 7 + index[1] / 6 + index[2] / 5) % 3);
+    it.Set(std::max(0.0f, value + noise(generator)));
+  }
+  image->SetPixel({ { 3, 4, 5 } }, 0.0f);
+  image->SetPixel({ { 10, 0, 7 } }, 0.0f);
+  return image;
+}
+
+ImageType::Pointer
+Denoise(const ImageType * image, const MaskImageType * mask, bool useRicianNoiseModel, bool useFastPatchDistances)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  if (mask)
+  {
+    filter->SetMaskImage(mask);
+  }
+  filter->SetUseRicianNoiseModel(useRicianNoiseModel);
+  filter->SetNeighborhoodPatchRadius(FilterType::NeighborhoodRadiusType::Filled(1));
+  filter->SetNeighborhoodSearchRadius(FilterType::NeighborhoodRadiusType::Filled(2));
+  filter->SetUseFastPatchDistances(useFastPatchDistances);
+  if (!useFastPatchDistances)
+  {
+    // the patches of neighboring work units overlap
+    filter->SetNumberOfWorkUnits(1);
+  }
+  filter->Update();
+  return filter->GetOutput();
+}
+
+void
+ExpectNearImages(const ImageType * expected, const ImageType * actual)
+{
+  ASSERT_EQ(actual->GetBufferedRegion(), expected->GetBufferedRegion());
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    ASSERT_NEAR(actual->GetPixel(it.GetIndex()), it.Get(), 1e-3f * std::abs(it.Get()) + 1e-3f)
+      << "at index " << it.GetIndex();
+  }
+}
+} // namespace
+
+
+// Checks that the patch distances computed with box sums give the same
+// output as the patch by patch computation.
+TEST(AdaptiveNonLocalMeansDenoisingImageFilter, FastPatchDistancesMatchDefault)
+{
+  const auto image = CreateNoisyImage();
+  for (const bool useRicianNoiseModel : { false, true })
+  {
+    const auto expected = Denoise(image, nullptr, useRicianNoiseModel, false);
+    const auto actual = Denoise(image, nullptr, useRicianNoiseModel, true);
+    ExpectNearImages(expected, actual);
+  }
+}
+
+
+// Checks the same with a mask, which leaves the pixels outside of it unfiltered.
+TEST(AdaptiveNonLocalMeansDenoisingImageFilter, FastPatchDistancesMatchDefaultWithMask)
+{
+  const auto image = CreateNoisyImage();
+
+  auto mask = MaskImageType::New();
+  mask->SetRegions(image->GetBufferedRegion());
+  mask->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<MaskImageType> it(mask, mask->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(it.GetIndex()[0] < 12 ? 1 : 0);
+  }
+
+  const auto expected = Denoise(image, mask, true, false);
+  const auto actual = Denoise(image, mask, true, true);
+  ExpectNearImages(expected, actual);
+}
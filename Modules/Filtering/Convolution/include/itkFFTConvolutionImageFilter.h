@@ -41,6 +41,22 @@ namespace itk
  * of the kernel image and treats them as identical to those in the
  * input image.
  *
+ * By default the whole requested region, padded by the kernel radius, is
+ * transformed at once, which needs several image sized buffers of complex
+ * values. When a BlockSize is set, the requested region is instead split in
+ * blocks which are convolved independently with the overlap-save method:
+ * each block is read with a margin of the kernel radius, transformed,
+ * multiplied by the kernel spectrum and transformed back, and the part of
+ * the result which is not affected by the circular wrap-around is written
+ * to the output. The kernel spectrum and the transform plans are computed
+ * once for all the blocks, and the blocks are processed one after the other
+ * with transforms which use all the threads, so the memory used depends on
+ * the block size instead of the image size. The BlockSize may also be
+ * computed from a CacheSize, so that the working set of a block fits in
+ * the caches of the cores.
+ * Together with a StreamingImageFilter, this allows to convolve images
+ * which do not fit in memory.
+ *
  * This code was adapted from the Insight Journal contribution
  * \cite Lehmann_2010_b.
  *
@@ -108,6 +124,31 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get the size of the blocks of the output which are convolved
+   * independently. A value of zero along a dimension means that the blocks
+   * span the whole requested region along this dimension. The blocks are
+   * enlarged so that, once padded by the kernel radius, their size is
+   * factorable by SizeGreatestPrimeFactor. The default is zero along all
+   * the dimensions, which convolves the requested region at once unless a
+   * CacheSize is set.
+   * Subclasses which reimplement GenerateData(), like the deconvolution
+   * filters, ignore this parameter. */
+  /** @ITKStartGrouping */
+  itkSetMacro(BlockSize, OutputSizeType);
+  itkGetConstReferenceMacro(BlockSize, OutputSizeType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the size, in bytes, of the cache of a core, used to compute
+   * the block size when BlockSize is zero along all the dimensions. The
+   * blocks are then chosen so that the buffers of a block transform fit in
+   * the caches of the cores used by the transform, which depends on the
+   * number of work units and on the kernel size. The default is zero, which
+   * disables the automatic block size. */
+  /** @ITKStartGrouping */
+  itkSetMacro(CacheSize, SizeValueType);
+  itkGetConstMacro(CacheSize, SizeValueType);
+  /** @ITKEndGrouping */
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -130,6 +171,28 @@ protected:
   void
   GenerateData() override;
 
+  /** Get the size of the blocks of the requested region, from the
+   * BlockSize or, if it is zero, from the CacheSize. A value of zero along
+   * a dimension means that the blocks span the requested region along this
+   * dimension. */
+  OutputSizeType
+  ComputeBlockSize() const;
+
+  /** Convolve the requested region block by block with the overlap-save
+   * method. Called by GenerateData() when ComputeBlockSize() is not zero. */
+  void
+  GenerateDataByBlocks(const OutputSizeType & requestedBlockSize);
+
+  /** Convolve the output block with the kernel spectrum. The tile, whose
+   * size is the transform size, is the input of fftFilter, which is the
+   * input of ifftFilter. */
+  void
+  ConvolveBlock(const OutputRegionType &         block,
+                InternalImageType *              tile,
+                FFTFilterType *                  fftFilter,
+                IFFTFilterType *                 ifftFilter,
+                const InternalComplexImageType * kernelSpectrum);
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -206,6 +269,8 @@ private:
   SizeValueType      m_SizeGreatestPrimeFactor{};
   InternalSizeType   m_FFTPadSize{ { 0 } };
   InternalRegionType m_PaddedInputRegion{};
+  OutputSizeType     m_BlockSize{ { 0 } };
+  SizeValueType      m_CacheSize{ 0 };
 };
 } // namespace itk
 
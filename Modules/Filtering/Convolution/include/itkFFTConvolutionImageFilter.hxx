@@ -25,11 +25,14 @@
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
 #include "itkFFTPadImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
 #include "itkRegionOfInterestImageFilter.h"
+#include "itkProgressReporter.h"
 
 namespace itk
 {
@@ -81,6 +84,16 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  const OutputSizeType blockSize = this->ComputeBlockSize();
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    if (blockSize[dim] > 0)
+    {
+      this->GenerateDataByBlocks(blockSize);
+      return;
+    }
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -111,6 +124,191 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::ComputeBlockSize() const
+  -> OutputSizeType
+{
+  const OutputSizeType requestedSize = this->GetOutput()->GetRequestedRegion().GetSize();
+  OutputSizeType       blockSize = m_BlockSize;
+
+  bool automatic = m_CacheSize > 0;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    automatic = automatic && m_BlockSize[dim] == 0;
+  }
+  if (automatic)
+  {
+    // A block transform needs about four real buffers of the size of the
+    // transform: the tile, its half spectrum, the kernel spectrum, and the
+    // convolved tile. The transforms of a block are shared by the work units,
+    // so the block may use the cache of each of them. The blocks are at
+    // least twice as large as the kernel, otherwise the overlap between the
+    // tiles would dominate the computation.
+    const KernelSizeType kernelRadius = this->GetKernelRadius();
+    const double         numberOfPixels =
+      static_cast<double>(m_CacheSize) * this->GetNumberOfWorkUnits() / (4.0 * sizeof(TInternalPrecision));
+    const auto side = static_cast<SizeValueType>(std::pow(numberOfPixels, 1.0 / ImageDimension));
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      blockSize[dim] = std::max(side, 4 * kernelRadius[dim] + 1) - 2 * kernelRadius[dim];
+    }
+  }
+
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    if (blockSize[dim] >= requestedSize[dim])
+    {
+      blockSize[dim] = 0;
+    }
+  }
+  return blockSize;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateDataByBlocks(
+  const OutputSizeType & requestedBlockSize)
+{
+  this->AllocateOutputs();
+
+  const OutputRegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
+  const KernelSizeType   kernelRadius = this->GetKernelRadius();
+
+  // All the blocks share the same transform size, so that the kernel
+  // spectrum and the transform plans are computed only once. The blocks are
+  // enlarged to make use of the padding required by the FFT.
+  InternalSizeType fftSize;
+  OutputSizeType   blockSize;
+  OutputSizeType   numberOfBlocks;
+  SizeValueType    totalNumberOfBlocks = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const SizeValueType requestedSize = requestedRegion.GetSize(dim);
+    const SizeValueType size = requestedBlockSize[dim] > 0 ? requestedBlockSize[dim] : requestedSize;
+    SizeValueType       paddedSize = size + 2 * kernelRadius[dim];
+    if (m_SizeGreatestPrimeFactor > 1)
+    {
+      while (Math::GreatestPrimeFactor(paddedSize) > m_SizeGreatestPrimeFactor)
+      {
+        ++paddedSize;
+      }
+    }
+    else if (m_SizeGreatestPrimeFactor == 1)
+    {
+      // make sure the output is even
+      paddedSize += paddedSize % 2;
+    }
+    fftSize[dim] = paddedSize;
+    blockSize[dim] = std::min(paddedSize - 2 * kernelRadius[dim], requestedSize);
+    numberOfBlocks[dim] = (requestedSize + blockSize[dim] - 1) / blockSize[dim];
+    totalNumberOfBlocks *= numberOfBlocks[dim];
+  }
+
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  m_PaddedInputRegion = InternalRegionType(fftSize);
+  InternalComplexImagePointerType kernelSpectrum = nullptr;
+  this->PrepareKernel(this->GetKernelImage(), kernelSpectrum, progress, 0.1f);
+
+  // The blocks are convolved one after the other, each with transforms
+  // which use all the threads. The same tile and transform filters are used
+  // for all the blocks, so their buffers are allocated, and the transforms
+  // planned, only once.
+  auto tile = InternalImageType::New();
+  tile->SetRegions(InternalRegionType(fftSize));
+  tile->Allocate();
+
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  fftFilter->SetInput(tile);
+
+  auto ifftFilter = IFFTFilterType::New();
+  ifftFilter->SetActualXDimensionIsOdd(fftSize[0] % 2 != 0);
+  ifftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  ifftFilter->SetInput(fftFilter->GetOutput());
+
+  ProgressReporter blockProgress(this, 0, totalNumberOfBlocks, 100, 0.1f, 0.9f);
+  for (SizeValueType blockNumber = 0; blockNumber < totalNumberOfBlocks; ++blockNumber)
+  {
+    OutputRegionType block;
+    SizeValueType    remainder = blockNumber;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const SizeValueType blockIndex = remainder % numberOfBlocks[dim];
+      remainder /= numberOfBlocks[dim];
+      const SizeValueType offset = blockIndex * blockSize[dim];
+      block.SetIndex(dim, requestedRegion.GetIndex(dim) + static_cast<IndexValueType>(offset));
+      block.SetSize(dim, std::min(blockSize[dim], requestedRegion.GetSize(dim) - offset));
+    }
+    this->ConvolveBlock(block, tile, fftFilter, ifftFilter, kernelSpectrum);
+    blockProgress.CompletedPixel();
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::ConvolveBlock(
+  const OutputRegionType &         block,
+  InternalImageType *              tile,
+  FFTFilterType *                  fftFilter,
+  IFFTFilterType *                 ifftFilter,
+  const InternalComplexImageType * kernelSpectrum)
+{
+  const InputImageType * input = this->GetInput();
+  const KernelSizeType   kernelRadius = this->GetKernelRadius();
+
+  // The tile starts at the kernel radius before the block. Only the part
+  // of the tile in the neighborhood of the block contributes to the block,
+  // the remaining FFT padding is set to zero.
+  InternalIndexType tileIndex;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    tileIndex[dim] = block.GetIndex(dim) - static_cast<IndexValueType>(kernelRadius[dim]);
+  }
+  tile->SetRegions(InternalRegionType(tileIndex, tile->GetBufferedRegion().GetSize()));
+  tile->FillBuffer(TInternalPrecision{});
+  tile->Modified();
+  InputRegionType neighborhood = block;
+  neighborhood.PadByRadius(kernelRadius);
+
+  InputRegionType inside = neighborhood;
+  if (inside.Crop(input->GetBufferedRegion()))
+  {
+    ImageAlgorithm::Copy(input, tile, inside, inside);
+  }
+  if (inside != neighborhood)
+  {
+    const BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+    for (ImageRegionIteratorWithIndex<InternalImageType> it(tile, neighborhood); !it.IsAtEnd(); ++it)
+    {
+      if (!inside.IsInside(it.GetIndex()))
+      {
+        it.Set(static_cast<TInternalPrecision>(boundaryCondition->GetPixel(it.GetIndex(), input)));
+      }
+    }
+  }
+
+  // The spectrum is multiplied in place, between the updates of the two
+  // transforms: the inverse transform runs again because the forward
+  // transform was updated.
+  fftFilter->Update();
+  InternalComplexImageType *  spectrum = fftFilter->GetOutput();
+  const SizeValueType         numberOfPixels = spectrum->GetBufferedRegion().GetNumberOfPixels();
+  InternalComplexType *       spectrumBuffer = spectrum->GetBufferPointer();
+  const InternalComplexType * kernelBuffer = kernelSpectrum->GetBufferPointer();
+  for (SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    spectrumBuffer[i] *= kernelBuffer[i];
+  }
+  ifftFilter->Update();
+
+  // The transforms keep the index of the tile, so the block is at the same
+  // place in the convolved tile and in the output.
+  ImageAlgorithm::Copy(ifftFilter->GetOutput(), this->GetOutput(), block, block);
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -515,6 +713,8 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+  os << indent << "CacheSize: " << m_CacheSize << std::endl;
 }
 
 } // namespace itk
@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "gtest/gtest.h"
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, unsigned int seed)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int value = seed;
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    // a deterministic pseudo random sequence
+    value = (value * 1103515245u + 12345u) % 2147483648u;
+    it.Set(static_cast<float>(value % 1000) / 1000.0f);
+  }
+  return image;
+}
+
+template <typename TImage>
+double
+MaximumDifference(const TImage * image1, const TImage * image2)
+{
+  double difference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image1, image1->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    difference = std::max(difference, static_cast<double>(std::abs(it.Get() - image2->GetPixel(it.GetIndex()))));
+  }
+  return difference;
+}
+
+// Exposes the block size computed by the filter.
+template <typename TImage>
+class BlockSizeFFTConvolutionImageFilter : public itk::FFTConvolutionImageFilter<TImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BlockSizeFFTConvolutionImageFilter);
+
+  using Self = BlockSizeFFTConvolutionImageFilter;
+  using Superclass = itk::FFTConvolutionImageFilter<TImage>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  using Superclass::ComputeBlockSize;
+
+protected:
+  BlockSizeFFTConvolutionImageFilter() = default;
+  ~BlockSizeFFTConvolutionImageFilter() override = default;
+};
+} // namespace
+
+TEST(FFTConvolutionImageFilter, BlocksMatchWholeRegion)
+{
+  using ImageType = itk::Image<float, 3>;
+  using FilterType = itk::FFTConvolutionImageFilter<ImageType>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 37, 29, 11 } }, 1);
+  const auto kernel = MakeImage<ImageType>(ImageType::SizeType{ { 7, 4, 3 } }, 2);
+
+  auto reference = FilterType::New();
+  reference->SetInput(image);
+  reference->SetKernelImage(kernel);
+  EXPECT_EQ(reference->GetBlockSize(), ImageType::SizeType::Filled(0));
+  reference->Update();
+
+  itk::ConstantBoundaryCondition<ImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(0.5f);
+  for (const bool constantBoundary : { false, true })
+  {
+    if (constantBoundary)
+    {
+      reference->SetBoundaryCondition(&constantBoundaryCondition);
+      reference->Update();
+    }
+    for (const auto & blockSize : { ImageType::SizeType{ { 8, 8, 8 } },
+                                    ImageType::SizeType{ { 5, 0, 3 } },
+                                    ImageType::SizeType{ { 1, 1, 1 } } })
+    {
+      auto filter = FilterType::New();
+      filter->SetInput(image);
+      filter->SetKernelImage(kernel);
+      if (constantBoundary)
+      {
+        filter->SetBoundaryCondition(&constantBoundaryCondition);
+      }
+      filter->SetBlockSize(blockSize);
+      filter->Update();
+      EXPECT_LT(MaximumDifference(reference->GetOutput(), filter->GetOutput()), 1e-4) << "BlockSize: " << blockSize;
+    }
+  }
+}
+
+TEST(FFTConvolutionImageFilter, BlocksStream)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::FFTConvolutionImageFilter<ImageType>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 93, 71 } }, 3);
+  const auto kernel = MakeImage<ImageType>(ImageType::SizeType{ { 15, 9 } }, 4);
+
+  auto reference = FilterType::New();
+  reference->SetInput(image);
+  reference->SetKernelImage(kernel);
+  reference->NormalizeOn();
+  reference->Update();
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetKernelImage(kernel);
+  filter->NormalizeOn();
+  filter->SetBlockSize(ImageType::SizeType{ { 20, 16 } });
+
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(filter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  streamer->Update();
+  EXPECT_LT(MaximumDifference(reference->GetOutput(), streamer->GetOutput()), 1e-5);
+}
+
+TEST(FFTConvolutionImageFilter, BlockSizeFromCacheSize)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = BlockSizeFFTConvolutionImageFilter<ImageType>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 200, 150 } }, 5);
+
+  for (const auto & kernelSize : { ImageType::SizeType{ { 9, 5 } }, ImageType::SizeType{ { 31, 3 } } })
+  {
+    const auto kernel = MakeImage<ImageType>(kernelSize, 6);
+
+    auto reference = FilterType::New();
+    reference->SetInput(image);
+    reference->SetKernelImage(kernel);
+    reference->SetNumberOfWorkUnits(2);
+    reference->Update();
+    EXPECT_EQ(reference->GetCacheSize(), 0u);
+    EXPECT_EQ(reference->ComputeBlockSize(), ImageType::SizeType::Filled(0));
+
+    // 16 KiB for each of the 2 work units hold 1024 pixels in each of the 4
+    // buffers of double, so the padded blocks are 32 pixels wide, or at least
+    // twice the kernel size.
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetKernelImage(kernel);
+    filter->SetNumberOfWorkUnits(2);
+    filter->SetCacheSize(16 * 1024);
+    filter->Update();
+    ImageType::SizeType expectedBlockSize;
+    for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+      const itk::SizeValueType radius = kernelSize[dim] / 2;
+      expectedBlockSize[dim] = std::max<itk::SizeValueType>(32, 4 * radius + 1) - 2 * radius;
+    }
+    EXPECT_EQ(filter->ComputeBlockSize(), expectedBlockSize);
+    EXPECT_LT(MaximumDifference(reference->GetOutput(), filter->GetOutput()), 1e-4) << "Kernel size: " << kernelSize;
+
+    // An explicit BlockSize takes precedence over the CacheSize, and the
+    // blocks never exceed the requested region.
+    filter->SetBlockSize(ImageType::SizeType{ { 500, 40 } });
+    filter->Update();
+    EXPECT_EQ(filter->ComputeBlockSize(), (ImageType::SizeType{ { 0, 40 } }));
+    EXPECT_LT(MaximumDifference(reference->GetOutput(), filter->GetOutput()), 1e-4) << "Kernel size: " << kernelSize;
+  }
+}
@@ -33,7 +33,9 @@
 
 #endif
 
+#include <memory>
 #include <mutex>
+#include <type_traits>
 
 namespace itk
 {
@@ -69,6 +71,8 @@ public:
   using PixelType = float;
   using ComplexType = fftwf_complex;
   using PlanType = fftwf_plan;
+  /** Plan shared by its users and the plan cache of FFTWGlobalConfiguration. */
+  using PlanPointer = std::shared_ptr<std::remove_pointer_t<PlanType>>;
   using Self = Proxy<float>;
 
   // FFTW works with any data size, but is optimized for size decomposition with prime factors up to 13.
@@ -386,6 +390,170 @@ public:
 #  endif
     fftwf_destroy_plan(p);
   }
+
+  /** Execute the plan on other arrays than the ones it was created with.
+   * The arrays must have the same alignment and placement. */
+  static void
+  Execute(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftwf_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftwf_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftwf_execute_dft(p, in, out);
+  }
+
+  /** Create a plan like Plan_dft_c2r(), Plan_dft_r2c() and Plan_dft(), or
+   * reuse the plan cached by FFTWGlobalConfiguration for the same transform.
+   * The plan must be executed with the new-array Execute(). It is destroyed
+   * when the returned pointer and the cache have both released it. */
+  static PlanPointer
+  AcquirePlan_dft_c2r(int           rank,
+                      const int *   n,
+                      ComplexType * in,
+                      PixelType *   out,
+                      unsigned int  flags,
+                      int           threads = 1,
+                      bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanKey key =
+      MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum::ComplexToReal, rank, n, 0, flags, threads, in, out);
+    auto plan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (plan == nullptr)
+    {
+      plan =
+        FFTWGlobalConfiguration::AddCachedPlan(key, Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput));
+    }
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(plan);
+#  else
+    return MakePlanPointer(Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput));
+#  endif
+  }
+  static PlanPointer
+  AcquirePlan_dft_r2c(int           rank,
+                      const int *   n,
+                      PixelType *   in,
+                      ComplexType * out,
+                      unsigned int  flags,
+                      int           threads = 1,
+                      bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanKey key =
+      MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum::RealToComplex, rank, n, 0, flags, threads, in, out);
+    auto plan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (plan == nullptr)
+    {
+      plan =
+        FFTWGlobalConfiguration::AddCachedPlan(key, Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput));
+    }
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(plan);
+#  else
+    return MakePlanPointer(Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput));
+#  endif
+  }
+  static PlanPointer
+  AcquirePlan_dft(int           rank,
+                  const int *   n,
+                  ComplexType * in,
+                  ComplexType * out,
+                  int           sign,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanKey key =
+      MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum::ComplexToComplex, rank, n, sign, flags, threads, in, out);
+    auto plan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (plan == nullptr)
+    {
+      plan =
+        FFTWGlobalConfiguration::AddCachedPlan(key, Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput));
+    }
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(plan);
+#  else
+    return MakePlanPointer(Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput));
+#  endif
+  }
+
+  /** Fill the plan cache, if it is enabled, with the plans of the transforms of the given size,
+   * using scratch arrays, so that the filters do not need to plan them. */
+  static void
+  WarmUpPlan_dft_c2r(int rank, const int * n, unsigned int flags, int threads = 1)
+  {
+    const SizeValueType realSize = TotalSize(rank, n);
+    std::unique_ptr<ComplexType[]> in(new ComplexType[realSize / n[rank - 1] * (n[rank - 1] / 2 + 1)]);
+    std::unique_ptr<PixelType[]>   out(new PixelType[realSize]);
+    AcquirePlan_dft_c2r(rank, n, in.get(), out.get(), flags, threads, true);
+  }
+  static void
+  WarmUpPlan_dft_r2c(int rank, const int * n, unsigned int flags, int threads = 1)
+  {
+    const SizeValueType            realSize = TotalSize(rank, n);
+    std::unique_ptr<PixelType[]>   in(new PixelType[realSize]);
+    std::unique_ptr<ComplexType[]> out(new ComplexType[realSize / n[rank - 1] * (n[rank - 1] / 2 + 1)]);
+    AcquirePlan_dft_r2c(rank, n, in.get(), out.get(), flags, threads, true);
+  }
+  static void
+  WarmUpPlan_dft(int rank, const int * n, int sign, unsigned int flags, int threads = 1)
+  {
+    const SizeValueType            size = TotalSize(rank, n);
+    std::unique_ptr<ComplexType[]> in(new ComplexType[size]);
+    std::unique_ptr<ComplexType[]> out(new ComplexType[size]);
+    AcquirePlan_dft(rank, n, in.get(), out.get(), sign, flags, threads, true);
+  }
+
+private:
+  static PlanPointer
+  MakePlanPointer(PlanType p)
+  {
+    return p == nullptr ? PlanPointer() : PlanPointer(p, DestroyPlan);
+  }
+
+  static SizeValueType
+  TotalSize(int rank, const int * n)
+  {
+    SizeValueType total = 1;
+    for (int i = 0; i < rank; ++i)
+    {
+      total *= n[i];
+    }
+    return total;
+  }
+
+public:
+#  ifndef ITK_USE_CUFFTW
+  /** Identify the transform planned with the given arguments, so that a plan
+   * can be reused for other arrays with the new-array Execute(). */
+  static FFTWGlobalConfiguration::PlanKey
+  MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum kind,
+              int                                   rank,
+              const int *                           n,
+              int                                   sign,
+              unsigned int                          flags,
+              int                                   threads,
+              void *                                in,
+              void *                                out)
+  {
+    return { sizeof(PixelType),
+             kind,
+             std::vector<int>(n, n + rank),
+             sign,
+             flags,
+             threads,
+             fftwf_alignment_of(static_cast<PixelType *>(in)),
+             fftwf_alignment_of(static_cast<PixelType *>(out)),
+             in == out };
+  }
+#  endif
 };
 
 #endif // ITK_USE_FFTWF
@@ -399,6 +567,8 @@ public:
   using PixelType = double;
   using ComplexType = fftw_complex;
   using PlanType = fftw_plan;
+  /** Plan shared by its users and the plan cache of FFTWGlobalConfiguration. */
+  using PlanPointer = std::shared_ptr<std::remove_pointer_t<PlanType>>;
   using Self = Proxy<double>;
 
   // FFTW works with any data size, but is optimized for size decomposition with prime factors up to 13.
@@ -715,6 +885,170 @@ public:
 #  endif
     fftw_destroy_plan(p);
   }
+
+  /** Execute the plan on other arrays than the ones it was created with.
+   * The arrays must have the same alignment and placement. */
+  static void
+  Execute(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftw_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftw_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftw_execute_dft(p, in, out);
+  }
+
+  /** Create a plan like Plan_dft_c2r(), Plan_dft_r2c() and Plan_dft(), or
+   * reuse the plan cached by FFTWGlobalConfiguration for the same transform.
+   * The plan must be executed with the new-array Execute(). It is destroyed
+   * when the returned pointer and the cache have both released it. */
+  static PlanPointer
+  AcquirePlan_dft_c2r(int           rank,
+                      const int *   n,
+                      ComplexType * in,
+                      PixelType *   out,
+                      unsigned int  flags,
+                      int           threads = 1,
+                      bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanKey key =
+      MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum::ComplexToReal, rank, n, 0, flags, threads, in, out);
+    auto plan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (plan == nullptr)
+    {
+      plan =
+        FFTWGlobalConfiguration::AddCachedPlan(key, Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput));
+    }
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(plan);
+#  else
+    return MakePlanPointer(Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput));
+#  endif
+  }
+  static PlanPointer
+  AcquirePlan_dft_r2c(int           rank,
+                      const int *   n,
+                      PixelType *   in,
+                      ComplexType * out,
+                      unsigned int  flags,
+                      int           threads = 1,
+                      bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanKey key =
+      MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum::RealToComplex, rank, n, 0, flags, threads, in, out);
+    auto plan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (plan == nullptr)
+    {
+      plan =
+        FFTWGlobalConfiguration::AddCachedPlan(key, Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput));
+    }
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(plan);
+#  else
+    return MakePlanPointer(Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput));
+#  endif
+  }
+  static PlanPointer
+  AcquirePlan_dft(int           rank,
+                  const int *   n,
+                  ComplexType * in,
+                  ComplexType * out,
+                  int           sign,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const FFTWGlobalConfiguration::PlanKey key =
+      MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum::ComplexToComplex, rank, n, sign, flags, threads, in, out);
+    auto plan = FFTWGlobalConfiguration::GetCachedPlan(key);
+    if (plan == nullptr)
+    {
+      plan =
+        FFTWGlobalConfiguration::AddCachedPlan(key, Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput));
+    }
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(plan);
+#  else
+    return MakePlanPointer(Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput));
+#  endif
+  }
+
+  /** Fill the plan cache, if it is enabled, with the plans of the transforms of the given size,
+   * using scratch arrays, so that the filters do not need to plan them. */
+  static void
+  WarmUpPlan_dft_c2r(int rank, const int * n, unsigned int flags, int threads = 1)
+  {
+    const SizeValueType realSize = TotalSize(rank, n);
+    std::unique_ptr<ComplexType[]> in(new ComplexType[realSize / n[rank - 1] * (n[rank - 1] / 2 + 1)]);
+    std::unique_ptr<PixelType[]>   out(new PixelType[realSize]);
+    AcquirePlan_dft_c2r(rank, n, in.get(), out.get(), flags, threads, true);
+  }
+  static void
+  WarmUpPlan_dft_r2c(int rank, const int * n, unsigned int flags, int threads = 1)
+  {
+    const SizeValueType            realSize = TotalSize(rank, n);
+    std::unique_ptr<PixelType[]>   in(new PixelType[realSize]);
+    std::unique_ptr<ComplexType[]> out(new ComplexType[realSize / n[rank - 1] * (n[rank - 1] / 2 + 1)]);
+    AcquirePlan_dft_r2c(rank, n, in.get(), out.get(), flags, threads, true);
+  }
+  static void
+  WarmUpPlan_dft(int rank, const int * n, int sign, unsigned int flags, int threads = 1)
+  {
+    const SizeValueType            size = TotalSize(rank, n);
+    std::unique_ptr<ComplexType[]> in(new ComplexType[size]);
+    std::unique_ptr<ComplexType[]> out(new ComplexType[size]);
+    AcquirePlan_dft(rank, n, in.get(), out.get(), sign, flags, threads, true);
+  }
+
+private:
+  static PlanPointer
+  MakePlanPointer(PlanType p)
+  {
+    return p == nullptr ? PlanPointer() : PlanPointer(p, DestroyPlan);
+  }
+
+  static SizeValueType
+  TotalSize(int rank, const int * n)
+  {
+    SizeValueType total = 1;
+    for (int i = 0; i < rank; ++i)
+    {
+      total *= n[i];
+    }
+    return total;
+  }
+
+public:
+#  ifndef ITK_USE_CUFFTW
+  /** Identify the transform planned with the given arguments, so that a plan
+   * can be reused for other arrays with the new-array Execute(). */
+  static FFTWGlobalConfiguration::PlanKey
+  MakePlanKey(FFTWGlobalConfiguration::PlanKindEnum kind,
+              int                                   rank,
+              const int *                           n,
+              int                                   sign,
+              unsigned int                          flags,
+              int                                   threads,
+              void *                                in,
+              void *                                out)
+  {
+    return { sizeof(PixelType),
+             kind,
+             std::vector<int>(n, n + rank),
+             sign,
+             flags,
+             threads,
+             fftw_alignment_of(static_cast<PixelType *>(in)),
+             fftw_alignment_of(static_cast<PixelType *>(out)),
+             in == out };
+  }
+#  endif
 };
 
 #endif
@@ -127,6 +127,16 @@ public:
 #endif
   }
   /** @ITKEndGrouping */
+
+  /** Plan ahead of time the forward and inverse transforms of the given sizes, with the global
+   * plan rigor and number of threads, so that the filters which transform images
+   * of these sizes reuse the plans cached by FFTWGlobalConfiguration.
+   *
+   * This has no effect if the plan cache is disabled, which is the default (see
+   * FFTWGlobalConfiguration::SetUsePlanCache()), or with ITK_USE_CUFFTW enabled. */
+  static void
+  WarmUpPlanCache(const std::vector<ImageSizeType> & sizes);
+
 protected:
   FFTWComplexToComplexFFTImageFilter();
   ~FFTWComplexToComplexFFTImageFilter() override = default;
@@ -22,6 +22,7 @@
 #include "itkMetaDataObject.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include "itkMultiThreaderBase.h"
 
 
 /*
@@ -75,10 +76,10 @@ FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGen
     transformDirection = -1;
   }
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = (typename FFTWProxyType::ComplexType *)input->GetBufferPointer();
-  auto *                           out = (typename FFTWProxyType::ComplexType *)output->GetBufferPointer();
-  int                              flags = m_PlanRigor;
+  typename FFTWProxyType::PlanPointer plan;
+  auto *                              in = (typename FFTWProxyType::ComplexType *)input->GetBufferPointer();
+  auto *                              out = (typename FFTWProxyType::ComplexType *)output->GetBufferPointer();
+  int                                 flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -93,11 +94,10 @@ FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGen
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan =
-    FFTWProxyType::Plan_dft(ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits());
+  plan = FFTWProxyType::AcquirePlan_dft(
+    ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits());
 
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::Execute(plan.get(), in, out);
 }
 
 
@@ -146,6 +146,30 @@ FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::PrintSelf(std::os
 #endif
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::WarmUpPlanCache(const std::vector<ImageSizeType> & sizes)
+{
+#ifndef ITK_USE_CUFFTW
+  for (const ImageSizeType & size : sizes)
+  {
+    int n[ImageDimension];
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      n[(ImageDimension - 1) - i] = size[i];
+    }
+    for (int transformDirection : { 1, -1 })
+    {
+      FFTWProxyType::WarmUpPlan_dft(ImageDimension,
+                                    n,
+                                    transformDirection,
+                                    FFTWGlobalConfiguration::GetPlanRigor() | FFTW_PRESERVE_INPUT,
+                                    MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+    }
+  }
+#endif
+}
+
 } // end namespace itk
 
 #endif // _itkFFTWComplexToComplexFFTImageFilter_hxx
@@ -91,9 +91,9 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   fftwOutput->SetRegions(fftwOutputRegion);
   fftwOutput->Allocate();
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  int                              flags = m_PlanRigor;
+  typename FFTWProxyType::PlanPointer plan;
+  auto *                              in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
+  int                                 flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -107,14 +107,10 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,
-                                     sizes,
-                                     in,
-                                     (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer(),
-                                     flags,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  auto * out = (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer();
+  plan = FFTWProxyType::AcquirePlan_dft_r2c(
+    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  FFTWProxyType::Execute(plan.get(), in, out);
 
   // Expand the half image to the full image size
   using HalfToFullFilterType = HalfToFullHermitianImageFilter<OutputImageType>;
@@ -157,6 +153,26 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GetSizeGreatestPrimeFactor
   return FFTWProxyType::GREATEST_PRIME_FACTOR;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::WarmUpPlanCache(const std::vector<InputSizeType> & sizes)
+{
+#ifndef ITK_USE_CUFFTW
+  for (const InputSizeType & size : sizes)
+  {
+    int n[ImageDimension];
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      n[(ImageDimension - 1) - i] = size[i];
+    }
+    FFTWProxyType::WarmUpPlan_dft_r2c(ImageDimension,
+                                      n,
+                                      FFTWGlobalConfiguration::GetPlanRigor() | FFTW_PRESERVE_INPUT,
+                                      MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  }
+#endif
+}
+
 } // namespace itk
 
 #endif //_itkFFTWForwardFFTImageFilter_hxx
@@ -35,6 +35,9 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <map>
+#  include <memory>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -56,6 +59,9 @@ struct FFTWGlobalConfigurationGlobals;
 //                             file to be generated.  If this is
 //                             set, then ITK_FFTW_WISDOM_CACHE_BASE
 //                             is ignored.
+// ITK_FFTW_PLAN_CACHE - Defines if the plans are kept in memory
+//                       and reused by all the FFTW filters of the
+//                       process.  (it is "Off" by default)
 //
 // The above behaviors can also be controlled by the application.
 //
@@ -346,6 +352,77 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /** The kinds of transforms which are planned by fftw::Proxy. */
+  enum class PlanKindEnum : uint8_t
+  {
+    ComplexToReal,
+    RealToComplex,
+    ComplexToComplex
+  };
+
+  /** Identifies the plans which are interchangeable with the new-array
+   * execute functions of FFTW: same precision, transform, sizes, sign,
+   * planner flags and number of threads, and arrays with the same
+   * alignment and placement. */
+  struct PlanKey
+  {
+    unsigned int     PixelSize;
+    PlanKindEnum     Kind;
+    std::vector<int> Sizes;
+    int              Sign;
+    unsigned int     Flags;
+    int              Threads;
+    int              InputAlignment;
+    int              OutputAlignment;
+    bool             InPlace;
+
+    bool
+    operator<(const PlanKey & other) const;
+
+    bool
+    operator==(const PlanKey & other) const;
+  };
+
+  /**
+   * \brief Set/Get the behavior of plan caching
+   *
+   * If true, the plans created by the FFTW filters are kept until the
+   * end of the process (or a call to ClearPlanCache()) and reused by all
+   * the filters which transform arrays of the same size, so the planning
+   * is done only once per size, type and direction. It is false by default.
+   * If the environmental variable "ITK_FFTW_PLAN_CACHE", is set,
+   * then the environmental setting overrides default settings.
+   */
+  static void
+  SetUsePlanCache(const bool v);
+  static bool
+  GetUsePlanCache();
+
+  /** Get the cached plan for the key, or an empty pointer if there is none. */
+  static std::shared_ptr<void>
+  GetCachedPlan(const PlanKey & key);
+
+  /** Take the ownership of a plan created for the key, and add it to the
+   * cache if the cache is enabled. The plan is destroyed when the cache
+   * and all the copies of the returned pointer have released it. If
+   * another thread cached a plan for the same key in the meantime, the
+   * returned pointer is the cached plan, and the given plan is destroyed. */
+  static std::shared_ptr<void>
+  AddCachedPlan(const PlanKey & key, void * plan);
+
+  /** Whether the plan is held by the cache. */
+  static bool
+  IsPlanCached(const void * plan);
+
+  /** Release the cached plans. The plans which are still in use by a
+   * transform are destroyed when the transform releases them. */
+  static void
+  ClearPlanCache();
+
+  /** Get the number of cached plans. */
+  static SizeValueType
+  GetPlanCacheSize();
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -370,7 +447,11 @@ private:
   int         m_PlanRigor{ 0 };
   bool        m_WriteWisdomCache{ false };
   bool        m_ReadWisdomCache{ true };
+  bool        m_UsePlanCache{ false };
   std::string m_WisdomCacheBase;
+
+  std::map<PlanKey, std::shared_ptr<void>> m_PlanCache;
+  std::map<const void *, PlanKey>           m_CachedPlanKeys;
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
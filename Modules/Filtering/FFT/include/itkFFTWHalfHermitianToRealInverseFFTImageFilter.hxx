@@ -88,21 +88,31 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
       return new typename FFTWProxyType::ComplexType[totalInputSize];
     }
   }();
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType *                   out = outputPtr->GetBufferPointer();
+  typename FFTWProxyType::PlanPointer plan;
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
-  plan = FFTWProxyType::Plan_dft_c2r(ImageDimension,
-                                     sizes,
-                                     in,
-                                     out,
-                                     m_PlanRigor,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                     !m_CanUseDestructiveAlgorithm);
+  const int threads = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+#ifndef ITK_USE_CUFFTW
+  // Keep the plan of the last update while the transform does not change, for
+  // example when the same filter transforms many blocks of the same size.
+  const FFTWGlobalConfiguration::PlanKey key = FFTWProxyType::MakePlanKey(
+    FFTWGlobalConfiguration::PlanKindEnum::ComplexToReal, ImageDimension, sizes, 0, m_PlanRigor, threads, in, out);
+  if (m_Plan == nullptr || !(key == m_PlanKey))
+  {
+    m_Plan = FFTWProxyType::AcquirePlan_dft_c2r(
+      ImageDimension, sizes, in, out, m_PlanRigor, threads, !m_CanUseDestructiveAlgorithm);
+    m_PlanKey = key;
+  }
+  plan = m_Plan;
+#else
+  plan = FFTWProxyType::AcquirePlan_dft_c2r(
+    ImageDimension, sizes, in, out, m_PlanRigor, threads, !m_CanUseDestructiveAlgorithm);
+#endif
   if (!m_CanUseDestructiveAlgorithm)
   {
     // complex<double> and double[2] types are compatible memory layouts.
@@ -111,10 +121,9 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
     std::copy_n(
       inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
   }
-  FFTWProxyType::Execute(plan);
+  FFTWProxyType::Execute(plan.get(), in, out);
 
   // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
   if (!m_CanUseDestructiveAlgorithm)
   {
     delete[] in;
@@ -166,5 +175,24 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::GetSize
   return FFTWProxyType::GREATEST_PRIME_FACTOR;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::WarmUpPlanCache(
+  const std::vector<OutputSizeType> & sizes)
+{
+#ifndef ITK_USE_CUFFTW
+  for (const OutputSizeType & size : sizes)
+  {
+    int n[ImageDimension];
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      n[(ImageDimension - 1) - i] = size[i];
+    }
+    FFTWProxyType::WarmUpPlan_dft_c2r(
+      ImageDimension, n, FFTWGlobalConfiguration::GetPlanRigor(), MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  }
+#endif
+}
+
 } // namespace itk
 #endif // _itkFFTWHalfHermitianToRealInverseFFTImageFilter_hxx
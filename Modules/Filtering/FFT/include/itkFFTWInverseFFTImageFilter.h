@@ -119,6 +119,15 @@ public:
   SizeValueType
   GetSizeGreatestPrimeFactor() const override;
 
+  /** Plan ahead of time the inverse transforms with outputs of the given sizes,
+   * with the global plan rigor and number of threads, so that the filters which
+   * transform images of these sizes reuse the plans cached by FFTWGlobalConfiguration.
+   *
+   * This has no effect if the plan cache is disabled, which is the default (see
+   * FFTWGlobalConfiguration::SetUsePlanCache()), or with ITK_USE_CUFFTW enabled. */
+  static void
+  WarmUpPlanCache(const std::vector<OutputSizeType> & sizes);
+
 protected:
   FFTWInverseFFTImageFilter();
   ~FFTWInverseFFTImageFilter() override = default;
@@ -82,8 +82,8 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
 
   auto * in = (typename FFTWProxyType::ComplexType *)fullToHalfFilter->GetOutput()->GetBufferPointer();
 
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType *                   out = outputPtr->GetBufferPointer();
+  typename FFTWProxyType::PlanPointer plan;
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -91,12 +91,9 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_c2r(
+  plan = FFTWProxyType::AcquirePlan_dft_c2r(
     ImageDimension, sizes, in, out, m_PlanRigor, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), false);
-  FFTWProxyType::Execute(plan);
-
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::Execute(plan.get(), in, out);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -132,5 +129,23 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::GetSizeGreatestPrimeFactor
   return FFTWProxyType::GREATEST_PRIME_FACTOR;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::WarmUpPlanCache(const std::vector<OutputSizeType> & sizes)
+{
+#ifndef ITK_USE_CUFFTW
+  for (const OutputSizeType & size : sizes)
+  {
+    int n[ImageDimension];
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      n[(ImageDimension - 1) - i] = size[i];
+    }
+    FFTWProxyType::WarmUpPlan_dft_c2r(
+      ImageDimension, n, FFTWGlobalConfiguration::GetPlanRigor(), MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  }
+#endif
+}
+
 } // namespace itk
 #endif // _itkFFTWInverseFFTImageFilter_hxx
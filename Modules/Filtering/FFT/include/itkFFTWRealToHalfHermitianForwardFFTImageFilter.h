@@ -116,6 +116,15 @@ public:
   SizeValueType
   GetSizeGreatestPrimeFactor() const override;
 
+  /** Plan ahead of time the forward transforms of the given sizes, with the global
+   * plan rigor and number of threads, so that the filters which transform images
+   * of these sizes reuse the plans cached by FFTWGlobalConfiguration.
+   *
+   * This has no effect if the plan cache is disabled, which is the default (see
+   * FFTWGlobalConfiguration::SetUsePlanCache()), or with ITK_USE_CUFFTW enabled. */
+  static void
+  WarmUpPlanCache(const std::vector<InputSizeType> & sizes);
+
 protected:
   FFTWRealToHalfHermitianForwardFFTImageFilter();
   ~FFTWRealToHalfHermitianForwardFFTImageFilter() override = default;
@@ -133,6 +142,12 @@ private:
   bool m_CanUseDestructiveAlgorithm{};
 
   int m_PlanRigor{};
+
+#ifndef ITK_USE_CUFFTW
+  /** The plan of the last update, reused while the transform does not change. */
+  typename FFTWProxyType::PlanPointer m_Plan{};
+  FFTWGlobalConfiguration::PlanKey    m_PlanKey{};
+#endif
 };
 
 
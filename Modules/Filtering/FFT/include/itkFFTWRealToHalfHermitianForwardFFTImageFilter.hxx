@@ -73,10 +73,10 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     totalOutputSize *= outputSize[i];
   }
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  auto *                           out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
-  int                              flags = m_PlanRigor;
+  typename FFTWProxyType::PlanPointer plan;
+  auto *                              in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
+  auto *                              out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
+  int                                 flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -90,10 +90,22 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(
-    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  const int threads = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+#ifndef ITK_USE_CUFFTW
+  // Keep the plan of the last update while the transform does not change, for
+  // example when the same filter transforms many blocks of the same size.
+  const FFTWGlobalConfiguration::PlanKey key = FFTWProxyType::MakePlanKey(
+    FFTWGlobalConfiguration::PlanKindEnum::RealToComplex, ImageDimension, sizes, 0, flags, threads, in, out);
+  if (m_Plan == nullptr || !(key == m_PlanKey))
+  {
+    m_Plan = FFTWProxyType::AcquirePlan_dft_r2c(ImageDimension, sizes, in, out, flags, threads);
+    m_PlanKey = key;
+  }
+  plan = m_Plan;
+#else
+  plan = FFTWProxyType::AcquirePlan_dft_r2c(ImageDimension, sizes, in, out, flags, threads);
+#endif
+  FFTWProxyType::Execute(plan.get(), in, out);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -127,6 +139,27 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GetSize
   return FFTWProxyType::GREATEST_PRIME_FACTOR;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::WarmUpPlanCache(
+  const std::vector<InputSizeType> & sizes)
+{
+#ifndef ITK_USE_CUFFTW
+  for (const InputSizeType & size : sizes)
+  {
+    int n[ImageDimension];
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      n[(ImageDimension - 1) - i] = size[i];
+    }
+    FFTWProxyType::WarmUpPlan_dft_r2c(ImageDimension,
+                                      n,
+                                      FFTWGlobalConfiguration::GetPlanRigor() | FFTW_PRESERVE_INPUT,
+                                      MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  }
+#endif
+}
+
 } // namespace itk
 
 #endif //_itkFFTWRealToHalfHermitianForwardFFTImageFilter_hxx
@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeComplexToComplexFFTImageFilter_h
+#define itkNativeComplexToComplexFFTImageFilter_h
+
+#include "itkComplexToComplexFFTImageFilter.h"
+#include "itkFFTImageFilterFactory.h"
+
+namespace itk
+{
+/**
+ * \class NativeComplexToComplexFFTImageFilter
+ *
+ * \brief Complex to complex Fast Fourier Transform built into ITK.
+ *
+ * The input image may have any size, but the transform is fastest when
+ * the size along each dimension has only 2, 3 and 5 as prime factors.
+ *
+ * \ingroup FourierTransform
+ * \ingroup MultiThreaded
+ * \ingroup ITKFFT
+ *
+ * \sa ComplexToComplexFFTImageFilter
+ * \sa NativeFFTCommon
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT NativeComplexToComplexFFTImageFilter
+  : public ComplexToComplexFFTImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(NativeComplexToComplexFFTImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = NativeComplexToComplexFFTImageFilter;
+  using Superclass = ComplexToComplexFFTImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using typename Superclass::ImageType;
+  using PixelType = typename ImageType::PixelType;
+  using typename Superclass::InputImageType;
+  using typename Superclass::OutputImageType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(NativeComplexToComplexFFTImageFilter);
+
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+protected:
+  NativeComplexToComplexFFTImageFilter() = default;
+  ~NativeComplexToComplexFFTImageFilter() override = default;
+
+  void
+  GenerateData() override;
+};
+
+template <>
+struct FFTImageFilterTraits<NativeComplexToComplexFFTImageFilter>
+{
+  template <typename TUnderlying>
+  using InputPixelType = std::complex<TUnderlying>;
+  template <typename TUnderlying>
+  using OutputPixelType = std::complex<TUnderlying>;
+  using FilterDimensions = std::integer_sequence<unsigned int, 4, 3, 2, 1>;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkNativeComplexToComplexFFTImageFilter.hxx"
+#endif
+
+#endif // itkNativeComplexToComplexFFTImageFilter_h
@@ -0,0 +1,68 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeComplexToComplexFFTImageFilter_hxx
+#define itkNativeComplexToComplexFFTImageFilter_hxx
+
+#include "itkNativeFFTCommon.h"
+#include "itkImageAlgorithm.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+void
+NativeComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const ImageType * input = this->GetInput();
+  ImageType *       output = this->GetOutput();
+
+  // We don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process.
+  const ProgressReporter progress(this, 0, 1);
+
+  this->AllocateOutputs();
+
+  const typename ImageType::RegionType bufferedRegion = input->GetBufferedRegion();
+  const typename ImageType::SizeType & imageSize = bufferedRegion.GetSize();
+
+  // Copy the input to the output, and we will work in place on the output.
+  ImageAlgorithm::Copy<ImageType, ImageType>(input, output, bufferedRegion, bufferedRegion);
+
+  // The inverse transform is normalized with the last dimension.
+  const bool inverse = this->GetTransformDirection() == Superclass::TransformDirectionEnum::INVERSE;
+  using ValueType = typename PixelType::value_type;
+  const auto scale =
+    static_cast<ValueType>(inverse ? 1.0 / static_cast<double>(bufferedRegion.GetNumberOfPixels()) : 1.0);
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    NativeFFTCommon::TransformAlongDimension(output->GetBufferPointer(),
+                                             imageSize,
+                                             d,
+                                             inverse,
+                                             d + 1 == ImageDimension ? scale : ValueType{ 1 },
+                                             multiThreader);
+  }
+}
+
+} // end namespace itk
+
+#endif // itkNativeComplexToComplexFFTImageFilter_hxx
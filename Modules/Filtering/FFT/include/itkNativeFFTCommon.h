@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTCommon_h
+#define itkNativeFFTCommon_h
+
+#include "itkIntTypes.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSize.h"
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ * \class NativeFFTCommon
+ * \brief Common routines of the FFT implementation built into ITK.
+ *
+ * The transforms are computed one dimension at a time. The lines along a
+ * dimension are transformed by batches of BatchSize lines, stored with their
+ * real and imaginary parts in separate arrays and the line index varying
+ * fastest, so that each butterfly operates on BatchSize contiguous values and
+ * is vectorized by the compiler. The batches are distributed on the threads
+ * of the given MultiThreaderBase.
+ *
+ * Any size is supported: the sizes are factorized in radix 2, 3, 4 and 5
+ * passes, a generic pass handles the other prime factors up to
+ * BLUESTEIN_PRIME_FACTOR, and the lengths with a larger prime factor are
+ * computed with Bluestein's algorithm as a convolution of 2, 3 and 5-smooth
+ * length.
+ *
+ * \ingroup ITKFFT
+ */
+struct NativeFFTCommon
+{
+  /** The transforms are fastest for sizes which have a prime factorization
+  consisting of 2's, 3's, and 5's. Other sizes are supported, so this is only
+  used to choose the size of padded images. */
+  static constexpr SizeValueType GREATEST_PRIME_FACTOR = 5;
+
+  /** Lines with a prime factor greater than this are transformed with
+  Bluestein's algorithm. */
+  static constexpr SizeValueType BLUESTEIN_PRIME_FACTOR = 31;
+
+  /** Number of lines transformed together. */
+  static constexpr unsigned int BatchSize = 16;
+
+  /** Discrete Fourier transform of BatchSize complex lines of a given
+  length. The element k of the line b is stored at k * BatchSize + b in the
+  arrays of the real and imaginary parts. The transforms are not normalized. */
+  template <typename TValue>
+  class LineTransform
+  {
+  public:
+    explicit LineTransform(SizeValueType length);
+
+    SizeValueType
+    GetLength() const
+    {
+      return m_Length;
+    }
+
+    /** Number of values of the work buffer passed to Transform(). */
+    SizeValueType
+    GetWorkSize() const;
+
+    /** Transform in place. The direct transform uses the exp(-2 pi i j k / n)
+    kernel, and the inverse transform its conjugate. */
+    void
+    Transform(TValue * real, TValue * imaginary, TValue * work, bool inverse) const;
+
+  private:
+    struct Pass
+    {
+      SizeValueType       Radix;
+      SizeValueType       L1;
+      SizeValueType       Ido;
+      std::vector<TValue> TwiddleReal;
+      std::vector<TValue> TwiddleImaginary;
+      std::vector<TValue> RootReal;
+      std::vector<TValue> RootImaginary;
+    };
+
+    void
+    ApplyPass(const Pass &   pass,
+              const TValue * inReal,
+              const TValue * inImaginary,
+              TValue *       outReal,
+              TValue *       outImaginary,
+              TValue         sign) const;
+
+    void
+    TransformBluestein(TValue * real, TValue * imaginary, TValue * work, bool inverse) const;
+
+    SizeValueType     m_Length;
+    std::vector<Pass> m_Passes;
+
+    /** Bluestein's algorithm: the chirp exp(i pi k^2 / n), and the normalized
+    Fourier transform of the convolution kernel. */
+    std::unique_ptr<LineTransform> m_Convolution;
+    std::vector<TValue>            m_ChirpReal;
+    std::vector<TValue>            m_ChirpImaginary;
+    std::vector<TValue>            m_KernelReal;
+    std::vector<TValue>            m_KernelImaginary;
+  };
+
+  /** Smallest size greater or equal to n which has no prime factor greater
+  than 5. */
+  static SizeValueType
+  ComputeSmoothSize(SizeValueType n)
+  {
+    for (;; ++n)
+    {
+      SizeValueType m = n;
+      for (const SizeValueType factor : { 2, 3, 5 })
+      {
+        while (m % factor == 0)
+        {
+          m /= factor;
+        }
+      }
+      if (m == 1)
+      {
+        return n;
+      }
+    }
+  }
+
+  /** Transform in place all the lines of a complex buffer along the given
+  dimension, and multiply the result by scale. */
+  template <typename TValue, unsigned int VDimension>
+  static void
+  TransformAlongDimension(std::complex<TValue> *    data,
+                          const Size<VDimension> & size,
+                          unsigned int              dimension,
+                          bool                      inverse,
+                          TValue                    scale,
+                          MultiThreaderBase *       multiThreader);
+
+  /** Forward transform of a real buffer of the given size, producing the non
+  redundant half of the Hermitian output, of size size[0] / 2 + 1 along the
+  first dimension. */
+  template <typename TValue, unsigned int VDimension>
+  static void
+  RealToHalfHermitian(const TValue *            input,
+                      std::complex<TValue> *    output,
+                      const Size<VDimension> & size,
+                      MultiThreaderBase *       multiThreader);
+
+  /** Inverse transform of the non redundant half of a Hermitian buffer,
+  producing a real buffer of the given size multiplied by scale. */
+  template <typename TValue, unsigned int VDimension>
+  static void
+  HalfHermitianToReal(const std::complex<TValue> * input,
+                      TValue *                     output,
+                      const Size<VDimension> &    size,
+                      TValue                       scale,
+                      MultiThreaderBase *          multiThreader);
+
+private:
+  /** Run function(first, last) on contiguous ranges of the batches covering
+  numberOfLines lines, in parallel. */
+  template <typename TFunction>
+  static void
+  ParallelizeBatches(SizeValueType numberOfLines, MultiThreaderBase * multiThreader, TFunction function);
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkNativeFFTCommon.hxx"
+#endif
+
+#endif // itkNativeFFTCommon_h
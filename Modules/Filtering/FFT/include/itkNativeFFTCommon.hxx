@@ -0,0 +1,657 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTCommon_hxx
+#define itkNativeFFTCommon_hxx
+
+#include "itkMath.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TValue>
+NativeFFTCommon::LineTransform<TValue>::LineTransform(SizeValueType length)
+  : m_Length(length)
+{
+  constexpr SizeValueType B = BatchSize;
+
+  // Factorize the length, with the radix 4 passes first.
+  std::vector<SizeValueType> factors;
+  SizeValueType              n = length;
+  while (n % 4 == 0 && n > 1)
+  {
+    factors.push_back(4);
+    n /= 4;
+  }
+  if (n % 2 == 0 && n > 1)
+  {
+    factors.push_back(2);
+    n /= 2;
+  }
+  for (SizeValueType p = 3; p * p <= n; p += 2)
+  {
+    while (n % p == 0)
+    {
+      factors.push_back(p);
+      n /= p;
+    }
+  }
+  if (n > 1)
+  {
+    factors.push_back(n);
+  }
+
+  if (!factors.empty() && *std::max_element(factors.begin(), factors.end()) > BLUESTEIN_PRIME_FACTOR)
+  {
+    // The transform is the product by the conjugate chirp of the circular
+    // convolution of the input multiplied by the conjugate chirp with the chirp.
+    const SizeValueType convolutionLength = ComputeSmoothSize(2 * length - 1);
+    m_Convolution = std::make_unique<LineTransform>(convolutionLength);
+    m_ChirpReal.resize(length);
+    m_ChirpImaginary.resize(length);
+    for (SizeValueType k = 0; k < length; ++k)
+    {
+      // Reduce k^2 modulo 2 n first, to keep the angle accurate.
+      const auto   square = static_cast<unsigned long long>(k) * k % (2 * static_cast<unsigned long long>(length));
+      const double angle = Math::pi * static_cast<double>(square) / static_cast<double>(length);
+      m_ChirpReal[k] = static_cast<TValue>(std::cos(angle));
+      m_ChirpImaginary[k] = static_cast<TValue>(std::sin(angle));
+    }
+
+    std::vector<TValue> kernel(2 * convolutionLength * B + m_Convolution->GetWorkSize(), TValue{});
+    TValue *            kernelReal = kernel.data();
+    TValue *            kernelImaginary = kernelReal + convolutionLength * B;
+    for (SizeValueType k = 0; k < length; ++k)
+    {
+      kernelReal[k * B] = m_ChirpReal[k];
+      kernelImaginary[k * B] = m_ChirpImaginary[k];
+      if (k > 0)
+      {
+        kernelReal[(convolutionLength - k) * B] = m_ChirpReal[k];
+        kernelImaginary[(convolutionLength - k) * B] = m_ChirpImaginary[k];
+      }
+    }
+    m_Convolution->Transform(kernelReal, kernelImaginary, kernelImaginary + convolutionLength * B, false);
+    m_KernelReal.resize(convolutionLength);
+    m_KernelImaginary.resize(convolutionLength);
+    for (SizeValueType k = 0; k < convolutionLength; ++k)
+    {
+      m_KernelReal[k] = kernelReal[k * B] / static_cast<TValue>(convolutionLength);
+      m_KernelImaginary[k] = kernelImaginary[k * B] / static_cast<TValue>(convolutionLength);
+    }
+    return;
+  }
+
+  SizeValueType l1 = 1;
+  for (const SizeValueType radix : factors)
+  {
+    Pass pass;
+    pass.Radix = radix;
+    pass.L1 = l1;
+    pass.Ido = length / (l1 * radix);
+    for (SizeValueType j = 1; j < radix; ++j)
+    {
+      for (SizeValueType i = 1; i < pass.Ido; ++i)
+      {
+        const double angle = 2.0 * Math::pi * static_cast<double>(j * l1 * i % length) / static_cast<double>(length);
+        pass.TwiddleReal.push_back(static_cast<TValue>(std::cos(angle)));
+        pass.TwiddleImaginary.push_back(static_cast<TValue>(std::sin(angle)));
+      }
+    }
+    if (radix > 5)
+    {
+      for (SizeValueType m = 0; m < radix; ++m)
+      {
+        const double angle = 2.0 * Math::pi * static_cast<double>(m) / static_cast<double>(radix);
+        pass.RootReal.push_back(static_cast<TValue>(std::cos(angle)));
+        pass.RootImaginary.push_back(static_cast<TValue>(std::sin(angle)));
+      }
+    }
+    m_Passes.push_back(std::move(pass));
+    l1 *= radix;
+  }
+}
+
+template <typename TValue>
+SizeValueType
+NativeFFTCommon::LineTransform<TValue>::GetWorkSize() const
+{
+  if (m_Convolution)
+  {
+    return 2 * m_Convolution->GetLength() * BatchSize + m_Convolution->GetWorkSize();
+  }
+  return 2 * m_Length * BatchSize;
+}
+
+template <typename TValue>
+void
+NativeFFTCommon::LineTransform<TValue>::Transform(TValue * real, TValue * imaginary, TValue * work, bool inverse) const
+{
+  if (m_Convolution)
+  {
+    this->TransformBluestein(real, imaginary, work, inverse);
+    return;
+  }
+
+  // The passes go back and forth between the lines and the work buffer.
+  const TValue sign = inverse ? 1 : -1;
+  TValue *     inReal = real;
+  TValue *     inImaginary = imaginary;
+  TValue *     outReal = work;
+  TValue *     outImaginary = work + m_Length * BatchSize;
+  for (const Pass & pass : m_Passes)
+  {
+    this->ApplyPass(pass, inReal, inImaginary, outReal, outImaginary, sign);
+    std::swap(inReal, outReal);
+    std::swap(inImaginary, outImaginary);
+  }
+  if (inReal != real)
+  {
+    std::copy(inReal, inReal + m_Length * BatchSize, real);
+    std::copy(inImaginary, inImaginary + m_Length * BatchSize, imaginary);
+  }
+}
+
+template <typename TValue>
+void
+NativeFFTCommon::LineTransform<TValue>::ApplyPass(const Pass &   pass,
+                                                  const TValue * inReal,
+                                                  const TValue * inImaginary,
+                                                  TValue *       outReal,
+                                                  TValue *       outImaginary,
+                                                  TValue         sign) const
+{
+  constexpr SizeValueType B = BatchSize;
+  const SizeValueType     radix = pass.Radix;
+  const SizeValueType     l1 = pass.L1;
+  const SizeValueType     ido = pass.Ido;
+  // Distance between the inputs, and between the outputs, of a butterfly.
+  const SizeValueType is = ido * B;
+  const SizeValueType os = ido * l1 * B;
+
+  // The butterflies write to a local block, which cannot alias the input.
+  TValue tr[BLUESTEIN_PRIME_FACTOR * B];
+  TValue ti[BLUESTEIN_PRIME_FACTOR * B];
+
+  for (SizeValueType k = 0; k < l1; ++k)
+  {
+    for (SizeValueType i = 0; i < ido; ++i)
+    {
+      const TValue * xr = inReal + (i + ido * radix * k) * B;
+      const TValue * xi = inImaginary + (i + ido * radix * k) * B;
+      TValue *       yr = outReal + (i + ido * k) * B;
+      TValue *       yi = outImaginary + (i + ido * k) * B;
+
+      switch (radix)
+      {
+        case 2:
+          for (SizeValueType b = 0; b < B; ++b)
+          {
+            const TValue ar = xr[b];
+            const TValue ai = xi[b];
+            const TValue br = xr[is + b];
+            const TValue bi = xi[is + b];
+            tr[b] = ar + br;
+            ti[b] = ai + bi;
+            tr[B + b] = ar - br;
+            ti[B + b] = ai - bi;
+          }
+          break;
+        case 3:
+        {
+          constexpr TValue c = -0.5;
+          const TValue     s = sign * static_cast<TValue>(0.86602540378443864676);
+          for (SizeValueType b = 0; b < B; ++b)
+          {
+            const TValue t1r = xr[is + b] + xr[2 * is + b];
+            const TValue t1i = xi[is + b] + xi[2 * is + b];
+            const TValue t2r = xr[is + b] - xr[2 * is + b];
+            const TValue t2i = xi[is + b] - xi[2 * is + b];
+            const TValue car = xr[b] + c * t1r;
+            const TValue cai = xi[b] + c * t1i;
+            tr[b] = xr[b] + t1r;
+            ti[b] = xi[b] + t1i;
+            tr[B + b] = car - s * t2i;
+            ti[B + b] = cai + s * t2r;
+            tr[2 * B + b] = car + s * t2i;
+            ti[2 * B + b] = cai - s * t2r;
+          }
+          break;
+        }
+        case 4:
+          for (SizeValueType b = 0; b < B; ++b)
+          {
+            const TValue t0r = xr[b] + xr[2 * is + b];
+            const TValue t0i = xi[b] + xi[2 * is + b];
+            const TValue t1r = xr[b] - xr[2 * is + b];
+            const TValue t1i = xi[b] - xi[2 * is + b];
+            const TValue t2r = xr[is + b] + xr[3 * is + b];
+            const TValue t2i = xi[is + b] + xi[3 * is + b];
+            const TValue t3r = sign * (xr[is + b] - xr[3 * is + b]);
+            const TValue t3i = sign * (xi[is + b] - xi[3 * is + b]);
+            tr[b] = t0r + t2r;
+            ti[b] = t0i + t2i;
+            tr[B + b] = t1r - t3i;
+            ti[B + b] = t1i + t3r;
+            tr[2 * B + b] = t0r - t2r;
+            ti[2 * B + b] = t0i - t2i;
+            tr[3 * B + b] = t1r + t3i;
+            ti[3 * B + b] = t1i - t3r;
+          }
+          break;
+        case 5:
+        {
+          constexpr TValue c1 = 0.3090169943749474241;
+          constexpr TValue c2 = -0.8090169943749474241;
+          const TValue     s1 = sign * static_cast<TValue>(0.95105651629515357212);
+          const TValue     s2 = sign * static_cast<TValue>(0.58778525229247312917);
+          for (SizeValueType b = 0; b < B; ++b)
+          {
+            const TValue t1r = xr[is + b] + xr[4 * is + b];
+            const TValue t1i = xi[is + b] + xi[4 * is + b];
+            const TValue t4r = xr[is + b] - xr[4 * is + b];
+            const TValue t4i = xi[is + b] - xi[4 * is + b];
+            const TValue t2r = xr[2 * is + b] + xr[3 * is + b];
+            const TValue t2i = xi[2 * is + b] + xi[3 * is + b];
+            const TValue t3r = xr[2 * is + b] - xr[3 * is + b];
+            const TValue t3i = xi[2 * is + b] - xi[3 * is + b];
+            tr[b] = xr[b] + t1r + t2r;
+            ti[b] = xi[b] + t1i + t2i;
+
+            TValue car = xr[b] + c1 * t1r + c2 * t2r;
+            TValue cai = xi[b] + c1 * t1i + c2 * t2i;
+            TValue cbr = -(s1 * t4i + s2 * t3i);
+            TValue cbi = s1 * t4r + s2 * t3r;
+            tr[B + b] = car + cbr;
+            ti[B + b] = cai + cbi;
+            tr[4 * B + b] = car - cbr;
+            ti[4 * B + b] = cai - cbi;
+
+            car = xr[b] + c2 * t1r + c1 * t2r;
+            cai = xi[b] + c2 * t1i + c1 * t2i;
+            cbr = -(s2 * t4i - s1 * t3i);
+            cbi = s2 * t4r - s1 * t3r;
+            tr[2 * B + b] = car + cbr;
+            ti[2 * B + b] = cai + cbi;
+            tr[3 * B + b] = car - cbr;
+            ti[3 * B + b] = cai - cbi;
+          }
+          break;
+        }
+        default:
+          // Direct evaluation of the discrete Fourier transform of the radix.
+          for (SizeValueType u = 0; u < radix; ++u)
+          {
+            TValue * pr = tr + u * B;
+            TValue * pi = ti + u * B;
+            std::copy(xr, xr + B, pr);
+            std::copy(xi, xi + B, pi);
+            for (SizeValueType q = 1; q < radix; ++q)
+            {
+              const TValue   wr = pass.RootReal[u * q % radix];
+              const TValue   wi = sign * pass.RootImaginary[u * q % radix];
+              const TValue * qr = xr + q * is;
+              const TValue * qi = xi + q * is;
+              for (SizeValueType b = 0; b < B; ++b)
+              {
+                pr[b] += qr[b] * wr - qi[b] * wi;
+                pi[b] += qr[b] * wi + qi[b] * wr;
+              }
+            }
+          }
+      }
+
+      // Multiply by the twiddle factors while storing the outputs.
+      for (SizeValueType u = 0; u < radix; ++u)
+      {
+        const TValue * sr = tr + u * B;
+        const TValue * si = ti + u * B;
+        TValue *       pr = yr + u * os;
+        TValue *       pi = yi + u * os;
+        if (i == 0 || u == 0)
+        {
+          std::copy(sr, sr + B, pr);
+          std::copy(si, si + B, pi);
+        }
+        else
+        {
+          const TValue wr = pass.TwiddleReal[(u - 1) * (ido - 1) + i - 1];
+          const TValue wi = sign * pass.TwiddleImaginary[(u - 1) * (ido - 1) + i - 1];
+          for (SizeValueType b = 0; b < B; ++b)
+          {
+            pr[b] = sr[b] * wr - si[b] * wi;
+            pi[b] = sr[b] * wi + si[b] * wr;
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename TValue>
+void
+NativeFFTCommon::LineTransform<TValue>::TransformBluestein(TValue * real,
+                                                           TValue * imaginary,
+                                                           TValue * work,
+                                                           bool     inverse) const
+{
+  constexpr SizeValueType B = BatchSize;
+  const SizeValueType     convolutionLength = m_Convolution->GetLength();
+  TValue *                ar = work;
+  TValue *                ai = work + convolutionLength * B;
+  TValue *                convolutionWork = ai + convolutionLength * B;
+
+  // The inverse transform is the conjugate of the direct transform of the
+  // conjugate.
+  const TValue conjugate = inverse ? -1 : 1;
+  for (SizeValueType k = 0; k < m_Length; ++k)
+  {
+    const TValue cr = m_ChirpReal[k];
+    const TValue ci = m_ChirpImaginary[k];
+    for (SizeValueType b = 0; b < B; ++b)
+    {
+      const TValue xr = real[k * B + b];
+      const TValue xi = conjugate * imaginary[k * B + b];
+      ar[k * B + b] = xr * cr + xi * ci;
+      ai[k * B + b] = xi * cr - xr * ci;
+    }
+  }
+  std::fill(ar + m_Length * B, ar + convolutionLength * B, TValue{});
+  std::fill(ai + m_Length * B, ai + convolutionLength * B, TValue{});
+
+  m_Convolution->Transform(ar, ai, convolutionWork, false);
+  for (SizeValueType k = 0; k < convolutionLength; ++k)
+  {
+    const TValue kr = m_KernelReal[k];
+    const TValue ki = m_KernelImaginary[k];
+    for (SizeValueType b = 0; b < B; ++b)
+    {
+      const TValue r = ar[k * B + b];
+      ar[k * B + b] = r * kr - ai[k * B + b] * ki;
+      ai[k * B + b] = r * ki + ai[k * B + b] * kr;
+    }
+  }
+  m_Convolution->Transform(ar, ai, convolutionWork, true);
+
+  for (SizeValueType k = 0; k < m_Length; ++k)
+  {
+    const TValue cr = m_ChirpReal[k];
+    const TValue ci = m_ChirpImaginary[k];
+    for (SizeValueType b = 0; b < B; ++b)
+    {
+      const TValue yr = ar[k * B + b];
+      const TValue yi = ai[k * B + b];
+      real[k * B + b] = yr * cr + yi * ci;
+      imaginary[k * B + b] = conjugate * (yi * cr - yr * ci);
+    }
+  }
+}
+
+template <typename TFunction>
+void
+NativeFFTCommon::ParallelizeBatches(SizeValueType numberOfLines, MultiThreaderBase * multiThreader, TFunction function)
+{
+  const SizeValueType numberOfBatches = (numberOfLines + BatchSize - 1) / BatchSize;
+  const SizeValueType numberOfChunks =
+    std::min(numberOfBatches, static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()));
+  if (numberOfChunks <= 1)
+  {
+    function(0, numberOfBatches);
+    return;
+  }
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [numberOfBatches, numberOfChunks, &function](SizeValueType chunk) {
+      function(chunk * numberOfBatches / numberOfChunks, (chunk + 1) * numberOfBatches / numberOfChunks);
+    },
+    nullptr);
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+NativeFFTCommon::TransformAlongDimension(std::complex<TValue> *    data,
+                                         const Size<VDimension> & size,
+                                         unsigned int              dimension,
+                                         bool                      inverse,
+                                         TValue                    scale,
+                                         MultiThreaderBase *       multiThreader)
+{
+  constexpr SizeValueType B = BatchSize;
+  const SizeValueType     length = size[dimension];
+  const SizeValueType     total = size.CalculateProductOfElements();
+  if (total == 0)
+  {
+    return;
+  }
+  SizeValueType stride = 1;
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    stride *= size[d];
+  }
+  const SizeValueType numberOfLines = total / length;
+
+  const LineTransform<TValue> transform(length);
+  auto *                      buffer = reinterpret_cast<TValue *>(data);
+
+  ParallelizeBatches(numberOfLines, multiThreader, [&](SizeValueType firstBatch, SizeValueType lastBatch) {
+    std::vector<TValue> lines(2 * length * B + transform.GetWorkSize(), TValue{});
+    TValue *            real = lines.data();
+    TValue *            imaginary = real + length * B;
+    TValue *            work = imaginary + length * B;
+    SizeValueType       starts[B];
+    for (SizeValueType batch = firstBatch; batch < lastBatch; ++batch)
+    {
+      const SizeValueType firstLine = batch * B;
+      const SizeValueType count = std::min(B, numberOfLines - firstLine);
+      for (SizeValueType b = 0; b < count; ++b)
+      {
+        const SizeValueType line = firstLine + b;
+        starts[b] = 2 * ((line / stride) * stride * length + line % stride);
+      }
+      if (count < B)
+      {
+        std::fill(real, real + 2 * length * B, TValue{});
+      }
+
+      for (SizeValueType k = 0; k < length; ++k)
+      {
+        const TValue * element = buffer + 2 * k * stride;
+        for (SizeValueType b = 0; b < count; ++b)
+        {
+          real[k * B + b] = element[starts[b]];
+          imaginary[k * B + b] = element[starts[b] + 1];
+        }
+      }
+      transform.Transform(real, imaginary, work, inverse);
+      for (SizeValueType k = 0; k < length; ++k)
+      {
+        TValue * element = buffer + 2 * k * stride;
+        for (SizeValueType b = 0; b < count; ++b)
+        {
+          element[starts[b]] = real[k * B + b] * scale;
+          element[starts[b] + 1] = imaginary[k * B + b] * scale;
+        }
+      }
+    }
+  });
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+NativeFFTCommon::RealToHalfHermitian(const TValue *            input,
+                                     std::complex<TValue> *    output,
+                                     const Size<VDimension> & size,
+                                     MultiThreaderBase *       multiThreader)
+{
+  constexpr SizeValueType B = BatchSize;
+  const SizeValueType     length = size[0];
+  const SizeValueType     halfLength = length / 2 + 1;
+  const SizeValueType     total = size.CalculateProductOfElements();
+  if (total == 0)
+  {
+    return;
+  }
+  const SizeValueType numberOfRows = total / length;
+  const SizeValueType numberOfPairs = (numberOfRows + 1) / 2;
+
+  // Two real rows x and y are transformed together as the complex row
+  // z = x + i y, and the transforms are then separated using their Hermitian
+  // symmetry: X_k = (Z_k + conj(Z_{n-k})) / 2, Y_k = (Z_k - conj(Z_{n-k})) / 2i.
+  const LineTransform<TValue> transform(length);
+  ParallelizeBatches(numberOfPairs, multiThreader, [&](SizeValueType firstBatch, SizeValueType lastBatch) {
+    std::vector<TValue> lines(2 * length * B + transform.GetWorkSize(), TValue{});
+    TValue *            real = lines.data();
+    TValue *            imaginary = real + length * B;
+    TValue *            work = imaginary + length * B;
+    for (SizeValueType batch = firstBatch; batch < lastBatch; ++batch)
+    {
+      const SizeValueType firstPair = batch * B;
+      const SizeValueType count = std::min(B, numberOfPairs - firstPair);
+      if (count < B)
+      {
+        std::fill(real, real + 2 * length * B, TValue{});
+      }
+      for (SizeValueType b = 0; b < count; ++b)
+      {
+        const SizeValueType row = 2 * (firstPair + b);
+        const TValue *      x = input + row * length;
+        for (SizeValueType k = 0; k < length; ++k)
+        {
+          real[k * B + b] = x[k];
+          imaginary[k * B + b] = row + 1 < numberOfRows ? x[length + k] : TValue{};
+        }
+      }
+      transform.Transform(real, imaginary, work, false);
+      for (SizeValueType b = 0; b < count; ++b)
+      {
+        const SizeValueType row = 2 * (firstPair + b);
+        std::complex<TValue> * x = output + row * halfLength;
+        for (SizeValueType k = 0; k < halfLength; ++k)
+        {
+          const SizeValueType j = (length - k) % length;
+          const TValue        ar = real[k * B + b];
+          const TValue        ai = imaginary[k * B + b];
+          const TValue        br = real[j * B + b];
+          const TValue        bi = imaginary[j * B + b];
+          x[k] = std::complex<TValue>((ar + br) / 2, (ai - bi) / 2);
+          if (row + 1 < numberOfRows)
+          {
+            x[halfLength + k] = std::complex<TValue>((ai + bi) / 2, (br - ar) / 2);
+          }
+        }
+      }
+    }
+  });
+
+  Size<VDimension> halfSize = size;
+  halfSize[0] = halfLength;
+  for (unsigned int d = 1; d < VDimension; ++d)
+  {
+    TransformAlongDimension(output, halfSize, d, false, TValue{ 1 }, multiThreader);
+  }
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+NativeFFTCommon::HalfHermitianToReal(const std::complex<TValue> * input,
+                                     TValue *                     output,
+                                     const Size<VDimension> &    size,
+                                     TValue                       scale,
+                                     MultiThreaderBase *          multiThreader)
+{
+  constexpr SizeValueType B = BatchSize;
+  const SizeValueType     length = size[0];
+  const SizeValueType     halfLength = length / 2 + 1;
+  const SizeValueType     total = size.CalculateProductOfElements();
+  if (total == 0)
+  {
+    return;
+  }
+  const SizeValueType numberOfRows = total / length;
+  const SizeValueType numberOfPairs = (numberOfRows + 1) / 2;
+
+  Size<VDimension> halfSize = size;
+  halfSize[0] = halfLength;
+  std::vector<std::complex<TValue>> spectrum(input, input + numberOfRows * halfLength);
+  for (unsigned int d = 1; d < VDimension; ++d)
+  {
+    TransformAlongDimension(spectrum.data(), halfSize, d, true, TValue{ 1 }, multiThreader);
+  }
+
+  // The rows X and Y of the spectrum are transformed together as the row
+  // Z = X + i Y, whose inverse transform has x as real part and y as
+  // imaginary part. As for real inputs, the imaginary parts of X_0 and
+  // X_{n/2} are ignored.
+  const LineTransform<TValue> transform(length);
+  ParallelizeBatches(numberOfPairs, multiThreader, [&](SizeValueType firstBatch, SizeValueType lastBatch) {
+    std::vector<TValue> lines(2 * length * B + transform.GetWorkSize(), TValue{});
+    TValue *            real = lines.data();
+    TValue *            imaginary = real + length * B;
+    TValue *            work = imaginary + length * B;
+    for (SizeValueType batch = firstBatch; batch < lastBatch; ++batch)
+    {
+      const SizeValueType firstPair = batch * B;
+      const SizeValueType count = std::min(B, numberOfPairs - firstPair);
+      if (count < B)
+      {
+        std::fill(real, real + 2 * length * B, TValue{});
+      }
+      for (SizeValueType b = 0; b < count; ++b)
+      {
+        const SizeValueType          row = 2 * (firstPair + b);
+        const bool                   hasSecondRow = row + 1 < numberOfRows;
+        const std::complex<TValue> * x = spectrum.data() + row * halfLength;
+        for (SizeValueType k = 0; k < halfLength; ++k)
+        {
+          const bool   isReal = k == 0 || 2 * k == length;
+          const TValue xr = x[k].real();
+          const TValue xi = isReal ? TValue{} : x[k].imag();
+          const TValue yr = hasSecondRow ? x[halfLength + k].real() : TValue{};
+          const TValue yi = hasSecondRow && !isReal ? x[halfLength + k].imag() : TValue{};
+          real[k * B + b] = xr - yi;
+          imaginary[k * B + b] = xi + yr;
+          if (k > 0 && length - k >= halfLength)
+          {
+            real[(length - k) * B + b] = xr + yi;
+            imaginary[(length - k) * B + b] = yr - xi;
+          }
+        }
+      }
+      transform.Transform(real, imaginary, work, true);
+      for (SizeValueType b = 0; b < count; ++b)
+      {
+        const SizeValueType row = 2 * (firstPair + b);
+        TValue *            x = output + row * length;
+        for (SizeValueType k = 0; k < length; ++k)
+        {
+          x[k] = real[k * B + b] * scale;
+          if (row + 1 < numberOfRows)
+          {
+            x[length + k] = imaginary[k * B + b] * scale;
+          }
+        }
+      }
+    }
+  });
+}
+
+} // namespace itk
+
+#endif // itkNativeFFTCommon_hxx
@@ -0,0 +1,71 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTImageFilterInitFactory_h
+#define itkNativeFFTImageFilterInitFactory_h
+#include "ITKFFTExport.h"
+
+#include "itkLightObject.h"
+
+namespace itk
+{
+/**
+ * \class NativeFFTImageFilterInitFactory
+ * \brief Initialize the factory of the FFT image filters built into ITK.
+ *
+ * The purpose of NativeFFTImageFilterInitFactory is to perform
+ * one-time registration of factory objects that handle
+ * creation of the FFT image filter classes built into ITK
+ * through the ITK object factory singleton mechanism.
+ *
+ * \ingroup ITKFFT
+ */
+class ITKFFT_EXPORT NativeFFTImageFilterInitFactory : public LightObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(NativeFFTImageFilterInitFactory);
+
+  /** Standard class type aliases. */
+  using Self = NativeFFTImageFilterInitFactory;
+  using Superclass = LightObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(NativeFFTImageFilterInitFactory);
+
+  /** Mimic factory interface for Python initialization  */
+  static void
+  RegisterOneFactory()
+  {
+    RegisterFactories();
+  }
+
+  /** Register all the factories of the built-in FFT filters */
+  static void
+  RegisterFactories();
+
+protected:
+  NativeFFTImageFilterInitFactory();
+  ~NativeFFTImageFilterInitFactory() override;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeHalfHermitianToRealInverseFFTImageFilter_h
+#define itkNativeHalfHermitianToRealInverseFFTImageFilter_h
+
+#include "itkHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkFFTImageFilterFactory.h"
+
+namespace itk
+{
+/**
+ * \class NativeHalfHermitianToRealInverseFFTImageFilter
+ *
+ * \brief Inverse Fast Fourier Transform built into ITK, taking the non
+ * redundant half of a Hermitian image as input.
+ *
+ * The output image may have any size, but the transform is fastest when
+ * the size along each dimension has only 2, 3 and 5 as prime factors.
+ * As for the other implementations, the size of the output along the first
+ * dimension is odd if ActualXDimensionIsOdd is set.
+ *
+ * \ingroup FourierTransform
+ * \ingroup MultiThreaded
+ * \ingroup ITKFFT
+ *
+ * \sa HalfHermitianToRealInverseFFTImageFilter
+ * \sa NativeFFTCommon
+ */
+template <typename TInputImage,
+          typename TOutputImage = Image<typename TInputImage::PixelType::value_type, TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT NativeHalfHermitianToRealInverseFFTImageFilter
+  : public HalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(NativeHalfHermitianToRealInverseFFTImageFilter);
+
+  /** Standard class type aliases. */
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputSizeType = typename OutputImageType::SizeType;
+
+  using Self = NativeHalfHermitianToRealInverseFFTImageFilter;
+  using Superclass = HalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(NativeHalfHermitianToRealInverseFFTImageFilter);
+
+  /** Extract the dimensionality of the images. They must be the
+   * same. */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+
+  [[nodiscard]] SizeValueType
+  GetSizeGreatestPrimeFactor() const override;
+
+  itkConceptMacro(ImageDimensionsMatchCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
+
+protected:
+  NativeHalfHermitianToRealInverseFFTImageFilter() = default;
+  ~NativeHalfHermitianToRealInverseFFTImageFilter() override = default;
+
+  void
+  GenerateData() override;
+};
+
+// Describe whether input/output are real- or complex-valued
+// for factory registration
+template <>
+struct FFTImageFilterTraits<NativeHalfHermitianToRealInverseFFTImageFilter>
+{
+  template <typename TUnderlying>
+  using InputPixelType = std::complex<TUnderlying>;
+  template <typename TUnderlying>
+  using OutputPixelType = TUnderlying;
+  using FilterDimensions = std::integer_sequence<unsigned int, 4, 3, 2, 1>;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkNativeHalfHermitianToRealInverseFFTImageFilter.hxx"
+#endif
+
+#endif // itkNativeHalfHermitianToRealInverseFFTImageFilter_h
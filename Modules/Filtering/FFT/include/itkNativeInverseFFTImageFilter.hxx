@@ -0,0 +1,74 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeInverseFFTImageFilter_hxx
+#define itkNativeInverseFFTImageFilter_hxx
+
+#include "itkNativeFFTCommon.h"
+#include "itkFullToHalfHermitianImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+void
+NativeInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  // Get pointers to the input and output.
+  const typename InputImageType::ConstPointer inputPtr = this->GetInput();
+  const typename OutputImageType::Pointer     outputPtr = this->GetOutput();
+
+  if (!inputPtr || !outputPtr)
+  {
+    return;
+  }
+
+  // We don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process.
+  const ProgressReporter progress(this, 0, 1);
+
+  // Allocate output buffer memory.
+  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+  outputPtr->Allocate();
+
+  const OutputSizeType outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+
+  // Cut the full complex image to just the portion needed by the transform.
+  using FullToHalfFilterType = FullToHalfHermitianImageFilter<InputImageType>;
+  auto fullToHalfFilter = FullToHalfFilterType::New();
+  fullToHalfFilter->SetInput(inputPtr);
+  fullToHalfFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  fullToHalfFilter->UpdateLargestPossibleRegion();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  const auto scale = static_cast<OutputPixelType>(1.0 / static_cast<double>(outputSize.CalculateProductOfElements()));
+  NativeFFTCommon::HalfHermitianToReal(
+    fullToHalfFilter->GetOutput()->GetBufferPointer(), outputPtr->GetBufferPointer(), outputSize, scale, multiThreader);
+}
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+NativeInverseFFTImageFilter<TInputImage, TOutputImage>::GetSizeGreatestPrimeFactor() const
+{
+  return NativeFFTCommon::GREATEST_PRIME_FACTOR;
+}
+
+} // namespace itk
+
+#endif // itkNativeInverseFFTImageFilter_hxx
@@ -2,13 +2,15 @@ set(
   DOCUMENTATION
   "This module provides interfaces to FFT
 implementations. In particular it provides the direct and inverse
-computations of Fast Fourier Transforms based on
-<a href=\"http://vxl.sourceforge.net/\">VXL</a> and
+computations of Fast Fourier Transforms based on an implementation
+built into ITK, on <a href=\"http://vxl.sourceforge.net/\">VXL</a> and on
 <a href=\"https://www.fftw.org\">FFTW</a>. Note that when using the FFTW
 implementation you must comply with the GPL license."
 )
 
-set(_fft_backends "FFTImageFilterInit::Vnl")
+# The built-in implementation is preferred to Vnl, which still provides the
+# 1D filters
+set(_fft_backends "FFTImageFilterInit::Native;FFTImageFilterInit::Vnl")
 if(ITK_USE_FFTWF OR ITK_USE_FFTWD)
   # Prepend so that FFTW constructor is preferred
   list(PREPEND _fft_backends "FFTImageFilterInit::FFTW")
@@ -39,6 +39,8 @@
 
 #  include "itkObjectFactory.h"
 
+#  include <tuple>
+
 namespace itk
 {
 
@@ -138,6 +140,29 @@ isDeclineString(std::string response)
   return false;
 }
 
+/** The plans are destroyed with the lock of the planner, which is given
+ * directly to the deleter so the plans can also be released while the
+ * singleton is destroyed. */
+static std::shared_ptr<void>
+makePlanPointer(void * plan, const unsigned int pixelSize, std::mutex & plannerMutex)
+{
+  return std::shared_ptr<void>(plan, [pixelSize, mutex = &plannerMutex](void * p) {
+    const std::lock_guard<std::mutex> lockGuard(*mutex);
+#  if defined(ITK_USE_FFTWF)
+    if (pixelSize == sizeof(float))
+    {
+      fftwf_destroy_plan(static_cast<fftwf_plan>(p));
+    }
+#  endif
+#  if defined(ITK_USE_FFTWD)
+    if (pixelSize == sizeof(double))
+    {
+      fftw_destroy_plan(static_cast<fftw_plan>(p));
+    }
+#  endif
+  });
+}
+
 itkGetGlobalSimpleMacro(FFTWGlobalConfiguration, FFTWGlobalConfigurationGlobals, PimplGlobals);
 
 FFTWGlobalConfigurationGlobals * FFTWGlobalConfiguration::m_PimplGlobals;
@@ -469,6 +494,13 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
     }
   }
 
+  {
+    // Plans are not cached by default
+    std::string plan_cache_env;
+    const bool  envITK_FFTW_PLAN_CACHEfound = itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE", plan_cache_env);
+    this->m_UsePlanCache = envITK_FFTW_PLAN_CACHEfound && !isDeclineString(plan_cache_env);
+  }
+
   if (this->m_ReadWisdomCache)
   {
     const std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -503,6 +535,9 @@ FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
     }
 #  endif
   }
+  // the plans must be destroyed before the cleanup of FFTW
+  this->m_CachedPlanKeys.clear();
+  this->m_PlanCache.clear();
 #  if defined(ITK_USE_FFTWF)
 #    if !defined(_WIN32) || defined(ITK_STATIC)
   // Cannot be called with shared libs on Windows because FFTW does not check
@@ -824,6 +859,108 @@ FFTWGlobalConfiguration::GetWisdomCacheBase()
   return GetInstance()->m_WisdomCacheBase;
 }
 
+bool
+FFTWGlobalConfiguration::PlanKey::operator<(const PlanKey & other) const
+{
+  return std::tie(PixelSize, Kind, Sizes, Sign, Flags, Threads, InputAlignment, OutputAlignment, InPlace) <
+         std::tie(other.PixelSize,
+                  other.Kind,
+                  other.Sizes,
+                  other.Sign,
+                  other.Flags,
+                  other.Threads,
+                  other.InputAlignment,
+                  other.OutputAlignment,
+                  other.InPlace);
+}
+
+bool
+FFTWGlobalConfiguration::PlanKey::operator==(const PlanKey & other) const
+{
+  return !(*this < other) && !(other < *this);
+}
+
+void
+FFTWGlobalConfiguration::SetUsePlanCache(const bool v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  GetInstance()->m_UsePlanCache = v;
+}
+
+bool
+FFTWGlobalConfiguration::GetUsePlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return GetInstance()->m_UsePlanCache;
+}
+
+std::shared_ptr<void>
+FFTWGlobalConfiguration::GetCachedPlan(const PlanKey & key)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_Mutex);
+  const auto                        it = instance->m_PlanCache.find(key);
+  return it == instance->m_PlanCache.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<void>
+FFTWGlobalConfiguration::AddCachedPlan(const PlanKey & key, void * plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if (plan == nullptr)
+  {
+    return nullptr;
+  }
+  Pointer instance = GetInstance();
+  // declared before the lock, so a plan which is not kept is destroyed after the unlock
+  const std::shared_ptr<void> planPointer = makePlanPointer(plan, key.PixelSize, instance->m_Mutex);
+  const std::lock_guard<std::mutex> lockGuard(instance->m_Mutex);
+  if (!instance->m_UsePlanCache)
+  {
+    return planPointer;
+  }
+  // another thread might have planned the same transform in the meantime
+  const auto inserted = instance->m_PlanCache.emplace(key, planPointer);
+  if (inserted.second)
+  {
+    instance->m_CachedPlanKeys.emplace(plan, key);
+  }
+  return inserted.first->second;
+}
+
+bool
+FFTWGlobalConfiguration::IsPlanCached(const void * plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_Mutex);
+  return instance->m_CachedPlanKeys.find(plan) != instance->m_CachedPlanKeys.end();
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                                  instance = GetInstance();
+  std::map<PlanKey, std::shared_ptr<void>> planCache;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_Mutex);
+    planCache.swap(instance->m_PlanCache);
+    instance->m_CachedPlanKeys.clear();
+  }
+  // the plans which are not in use are destroyed here, with the lock of the planner
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                           instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_Mutex);
+  return instance->m_PlanCache.size();
+}
+
 } // end namespace itk
 
 #endif
@@ -0,0 +1,58 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkNativeFFTImageFilterInitFactory.h"
+
+#include "itkNativeComplexToComplexFFTImageFilter.h"
+#include "itkNativeForwardFFTImageFilter.h"
+#include "itkNativeHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkNativeInverseFFTImageFilter.h"
+#include "itkNativeRealToHalfHermitianForwardFFTImageFilter.h"
+
+#include "itkCreateObjectFunction.h"
+#include "itkVersion.h"
+#include "itkObjectFactoryBase.h"
+
+namespace itk
+{
+NativeFFTImageFilterInitFactory::NativeFFTImageFilterInitFactory()
+{
+  NativeFFTImageFilterInitFactory::RegisterFactories();
+}
+
+NativeFFTImageFilterInitFactory::~NativeFFTImageFilterInitFactory() = default;
+
+void
+NativeFFTImageFilterInitFactory::RegisterFactories()
+{
+  FFTImageFilterFactory<NativeComplexToComplexFFTImageFilter>::RegisterOneFactory();
+  FFTImageFilterFactory<NativeForwardFFTImageFilter>::RegisterOneFactory();
+  FFTImageFilterFactory<NativeHalfHermitianToRealInverseFFTImageFilter>::RegisterOneFactory();
+  FFTImageFilterFactory<NativeInverseFFTImageFilter>::RegisterOneFactory();
+  FFTImageFilterFactory<NativeRealToHalfHermitianForwardFFTImageFilter>::RegisterOneFactory();
+}
+
+// Undocumented API used to register during static initialization.
+// DO NOT CALL DIRECTLY.
+// TODO CMake parsing currently does not allow "InitFactory"
+void ITKFFT_EXPORT
+NativeFFTImageFilterInitFactoryRegister__Private()
+{
+  NativeFFTImageFilterInitFactory::RegisterFactories();
+}
+
+} // end namespace itk
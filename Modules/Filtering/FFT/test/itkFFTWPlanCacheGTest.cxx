@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "gtest/gtest.h"
+#include "itkConfigure.h"
+
+#if defined(ITK_USE_FFTWF) || defined(ITK_USE_FFTWD)
+
+#  include "itkFFTWForwardFFTImageFilter.h"
+#  include "itkFFTWComplexToComplexFFTImageFilter.h"
+#  include "itkImageRegionIteratorWithIndex.h"
+#  include <algorithm>
+#  include <complex>
+#  include <memory>
+
+namespace
+{
+#  if defined(ITK_USE_FFTWF)
+using RealType = float;
+#  else
+using RealType = double;
+#  endif
+using RealImageType = itk::Image<RealType, 2>;
+using ComplexImageType = itk::Image<std::complex<RealType>, 2>;
+using ForwardType = itk::FFTWForwardFFTImageFilter<RealImageType, ComplexImageType>;
+using ComplexToComplexType = itk::FFTWComplexToComplexFFTImageFilter<ComplexImageType>;
+
+RealImageType::Pointer
+MakeImage(const RealImageType::SizeType & size)
+{
+  auto image = RealImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<RealImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<RealType>((it.GetIndex()[0] * 7 + it.GetIndex()[1] * 3) % 11));
+  }
+  return image;
+}
+
+ComplexImageType::Pointer
+Transform(const RealImageType * image)
+{
+  auto fft = ForwardType::New();
+  fft->SetInput(image);
+  fft->Update();
+  return fft->GetOutput();
+}
+} // namespace
+
+
+TEST(FFTWPlanCache, WarmUpAddsPlans)
+{
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(true);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  EXPECT_EQ(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 0u);
+
+  const RealImageType::SizeType size = { { 16, 12 } };
+  ForwardType::WarmUpPlanCache({ size });
+  EXPECT_EQ(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 1u);
+
+  // warming up the same size again reuses the cached plan
+  ForwardType::WarmUpPlanCache({ size });
+  EXPECT_EQ(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 1u);
+
+  // one plan per direction
+  ComplexToComplexType::WarmUpPlanCache({ size });
+  EXPECT_EQ(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 3u);
+
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  EXPECT_EQ(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 0u);
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(false);
+}
+
+
+TEST(FFTWPlanCache, DisabledCacheKeepsNoPlans)
+{
+  // the cache is disabled by default
+  EXPECT_FALSE(itk::FFTWGlobalConfiguration::GetUsePlanCache());
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  ForwardType::WarmUpPlanCache({ RealImageType::SizeType{ { 16, 12 } } });
+  Transform(MakeImage({ { 10, 6 } }));
+  EXPECT_EQ(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 0u);
+}
+
+
+TEST(FFTWPlanCache, AcquiredPlanOutlivesClearedCache)
+{
+  using ProxyType = itk::fftw::Proxy<RealType>;
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(true);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+
+  int                                             sizes[2] = { 12, 16 };
+  const std::unique_ptr<RealType[]>               in(new RealType[12 * 16]);
+  const std::unique_ptr<ProxyType::ComplexType[]> out(new ProxyType::ComplexType[12 * 9]);
+  const auto                                      plan =
+    ProxyType::AcquirePlan_dft_r2c(2, sizes, in.get(), out.get(), FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+  ASSERT_NE(plan, nullptr);
+  EXPECT_TRUE(itk::FFTWGlobalConfiguration::IsPlanCached(plan.get()));
+  EXPECT_EQ(
+    ProxyType::AcquirePlan_dft_r2c(2, sizes, in.get(), out.get(), FFTW_ESTIMATE | FFTW_PRESERVE_INPUT).get(),
+    plan.get());
+
+  // the plan is still usable after the cache released it
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  EXPECT_EQ(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 0u);
+  EXPECT_FALSE(itk::FFTWGlobalConfiguration::IsPlanCached(plan.get()));
+  std::fill_n(in.get(), 12 * 16, RealType{ 1 });
+  ProxyType::Execute(plan.get(), in.get(), out.get());
+  EXPECT_EQ(out[0][0], RealType{ 12 * 16 });
+  EXPECT_EQ(out[1][0], RealType{ 0 });
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(false);
+}
+
+
+TEST(FFTWPlanCache, CachedPlansGiveSameResults)
+{
+  const RealImageType::SizeType size = { { 18, 10 } };
+  const auto                    image = MakeImage(size);
+
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(false);
+  const auto expected = Transform(image);
+
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(true);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  ForwardType::WarmUpPlanCache({ size });
+  for (int i = 0; i < 3; ++i)
+  {
+    // a new input and output are allocated each time
+    const auto result = Transform(MakeImage(size));
+    itk::ImageRegionIteratorWithIndex<ComplexImageType> it(result, result->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      EXPECT_EQ(it.Get(), expected->GetPixel(it.GetIndex())) << it.GetIndex();
+    }
+  }
+  EXPECT_GE(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 1u);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(false);
+}
+
+#endif
@@ -0,0 +1,184 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "gtest/gtest.h"
+#include "itkNativeComplexToComplexFFTImageFilter.h"
+#include "itkNativeForwardFFTImageFilter.h"
+#include "itkNativeHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkNativeInverseFFTImageFilter.h"
+#include "itkNativeRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkVnlComplexToComplexFFTImageFilter.h"
+#include "itkVnlForwardFFTImageFilter.h"
+#include "itkVnlRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <complex>
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int value = 1;
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    // a deterministic pseudo random sequence
+    value = (value * 1103515245u + 12345u) % 2147483648u;
+    const double x = static_cast<double>(value % 1000) / 500.0 - 1.0;
+    if constexpr (itk::NumericTraits<typename TImage::PixelType>::IsComplex)
+    {
+      it.Set(typename TImage::PixelType(x, 1.0 - x * x));
+    }
+    else
+    {
+      it.Set(x);
+    }
+  }
+  return image;
+}
+
+template <typename TImage>
+double
+MaximumDifference(const TImage * image1, const TImage * image2)
+{
+  double difference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image1, image1->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    difference = std::max(difference, static_cast<double>(std::abs(it.Get() - image2->GetPixel(it.GetIndex()))));
+  }
+  return difference;
+}
+
+template <unsigned int VDimension>
+void
+CompareWithVnl(const itk::Size<VDimension> & size)
+{
+  using RealImageType = itk::Image<double, VDimension>;
+  using ComplexImageType = itk::Image<std::complex<double>, VDimension>;
+  const auto image = MakeImage<RealImageType>(size);
+
+  auto nativeForward = itk::NativeForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  nativeForward->SetInput(image);
+  nativeForward->Update();
+  auto vnlForward = itk::VnlForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  vnlForward->SetInput(image);
+  vnlForward->Update();
+  EXPECT_LT(MaximumDifference(nativeForward->GetOutput(), vnlForward->GetOutput()), 1e-9) << size;
+
+  auto nativeHalf = itk::NativeRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  nativeHalf->SetInput(image);
+  nativeHalf->Update();
+  auto vnlHalf = itk::VnlRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  vnlHalf->SetInput(image);
+  vnlHalf->Update();
+  EXPECT_LT(MaximumDifference(nativeHalf->GetOutput(), vnlHalf->GetOutput()), 1e-9) << size;
+
+  const auto complexImage = MakeImage<ComplexImageType>(size);
+  auto       nativeComplex = itk::NativeComplexToComplexFFTImageFilter<ComplexImageType>::New();
+  nativeComplex->SetInput(complexImage);
+  nativeComplex->Update();
+  auto vnlComplex = itk::VnlComplexToComplexFFTImageFilter<ComplexImageType>::New();
+  vnlComplex->SetInput(complexImage);
+  vnlComplex->Update();
+  EXPECT_LT(MaximumDifference(nativeComplex->GetOutput(), vnlComplex->GetOutput()), 1e-9) << size;
+}
+
+template <typename TValue, unsigned int VDimension>
+void
+CheckRoundTrips(const itk::Size<VDimension> & size, double tolerance)
+{
+  using RealImageType = itk::Image<TValue, VDimension>;
+  using ComplexImageType = itk::Image<std::complex<TValue>, VDimension>;
+  const auto image = MakeImage<RealImageType>(size);
+
+  auto forward = itk::NativeForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  forward->SetInput(image);
+  auto inverse = itk::NativeInverseFFTImageFilter<ComplexImageType, RealImageType>::New();
+  inverse->SetInput(forward->GetOutput());
+  inverse->Update();
+  EXPECT_LT(MaximumDifference(image.GetPointer(), inverse->GetOutput()), tolerance) << size;
+
+  auto halfForward = itk::NativeRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  halfForward->SetInput(image);
+  auto halfInverse = itk::NativeHalfHermitianToRealInverseFFTImageFilter<ComplexImageType, RealImageType>::New();
+  halfInverse->SetInput(halfForward->GetOutput());
+  halfInverse->SetActualXDimensionIsOdd(size[0] % 2 != 0);
+  halfInverse->Update();
+  EXPECT_LT(MaximumDifference(image.GetPointer(), halfInverse->GetOutput()), tolerance) << size;
+
+  using ComplexToComplexType = itk::NativeComplexToComplexFFTImageFilter<ComplexImageType>;
+  const auto complexImage = MakeImage<ComplexImageType>(size);
+  auto       complexForward = ComplexToComplexType::New();
+  complexForward->SetInput(complexImage);
+  auto complexInverse = ComplexToComplexType::New();
+  complexInverse->SetTransformDirection(ComplexToComplexType::TransformDirectionEnum::INVERSE);
+  complexInverse->SetInput(complexForward->GetOutput());
+  complexInverse->Update();
+  EXPECT_LT(MaximumDifference(complexImage.GetPointer(), complexInverse->GetOutput()), tolerance) << size;
+}
+} // namespace
+
+
+TEST(NativeFFT, MatchesVnl)
+{
+  CompareWithVnl(itk::Size<1>{ { 60 } });
+  CompareWithVnl(itk::Size<2>{ { 30, 20 } });
+  CompareWithVnl(itk::Size<2>{ { 9, 16 } });
+  CompareWithVnl(itk::Size<3>{ { 8, 5, 12 } });
+  CompareWithVnl(itk::Size<3>{ { 15, 4, 1 } });
+}
+
+
+TEST(NativeFFT, RoundTripsOfAnySize)
+{
+  // sizes with prime factors handled by the generic passes and by
+  // Bluestein's algorithm
+  CheckRoundTrips<double>(itk::Size<1>{ { 97 } }, 1e-12);
+  CheckRoundTrips<double>(itk::Size<2>{ { 7, 13 } }, 1e-12);
+  CheckRoundTrips<double>(itk::Size<2>{ { 37, 22 } }, 1e-12);
+  CheckRoundTrips<double>(itk::Size<3>{ { 11, 41, 3 } }, 1e-12);
+  CheckRoundTrips<float>(itk::Size<2>{ { 64, 49 } }, 1e-5);
+  CheckRoundTrips<float>(itk::Size<2>{ { 101, 3 } }, 1e-5);
+}
+
+
+TEST(NativeFFT, PrimeSizeMatchesDefinition)
+{
+  using ImageType = itk::Image<std::complex<double>, 1>;
+  const itk::Size<1> size{ { 43 } };
+  const auto         image = MakeImage<ImageType>(size);
+
+  auto filter = itk::NativeComplexToComplexFFTImageFilter<ImageType>::New();
+  filter->SetInput(image);
+  filter->Update();
+
+  for (itk::IndexValueType k = 0; k < 43; ++k)
+  {
+    std::complex<double> expected = 0.0;
+    for (itk::IndexValueType j = 0; j < 43; ++j)
+    {
+      const double angle = -2.0 * itk::Math::pi * static_cast<double>(j * k) / 43.0;
+      expected += image->GetPixel({ { j } }) * std::polar(1.0, angle);
+    }
+    EXPECT_LT(std::abs(filter->GetOutput()->GetPixel({ { k } }) - expected), 1e-10) << k;
+  }
+}
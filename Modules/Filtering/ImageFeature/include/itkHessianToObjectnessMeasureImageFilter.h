@@ -40,6 +40,9 @@ namespace itk
  * Additional information can be from in the Insight Journal:
  * https://doi.org/10.54294/urgadx
  *
+ * For 3D images, the eigen values of the Hessian pixels of each scanline are
+ * computed by batches with SymmetricEigenAnalysis3DBatch.
+ *
  * \author Luca Antiga Ph.D.  Medical Imaging Unit,
  *                            Bioengineering Department, Mario Negri Institute, Italy.
  *
@@ -136,6 +139,10 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Compute the objectness measure of a pixel from the eigen values of its
+   * Hessian. */
+  OutputPixelType
+  ComputeObjectnessMeasure(const EigenValueArrayType & eigenValues) const;
 
 private:
   // functor used to sort the eigenvalues are to be sorted
@@ -62,6 +62,19 @@ operator<<(std::ostream & out, const MultiScaleHessianBasedMeasureImageFilterEnu
  * The filter computes a second output image (accessed by the GetScalesOutput method)
  * containing the scales at which each pixel gave the best response.
  *
+ * By default the Hessian and the measure are computed over the whole image at
+ * each scale, which needs, besides the outputs, an image of Hessian pixels and
+ * an update buffer of doubles as large as the output. When a MemoryBudget is
+ * set, the output is instead computed block by block: each block of the input
+ * is extracted with a margin of BlockMarginInSigmas times the largest sigma,
+ * then all the scales are computed on it and only the best response of the
+ * block is kept. The blocks are as large as possible while the images used to
+ * process a block fit in the budget. The recursive Gaussian filters see the
+ * border of the margin instead of the border of the image, so the results
+ * differ slightly from the whole image computation away from the image
+ * borders. The precision of the Hessian is the one of THessianImage, a
+ * SymmetricSecondRankTensor of float halves its memory.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Generalizing vesselness with respect to dimensionality and shape"
@@ -209,6 +222,22 @@ public:
   itkGetConstMacro(GenerateHessianOutput, bool);
   itkBooleanMacro(GenerateHessianOutput);
   /** @ITKEndGrouping */
+
+  /** Set/Get the maximum memory, in bytes, used by the images which process a
+   * block, in addition to the outputs. Zero, the default, processes the whole
+   * image at once. */
+  /** @ITKStartGrouping */
+  itkSetMacro(MemoryBudget, uint64_t);
+  itkGetConstMacro(MemoryBudget, uint64_t);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the margin around the blocks, in multiples of the largest sigma.
+   * Defaults to 4. */
+  /** @ITKStartGrouping */
+  itkSetMacro(BlockMarginInSigmas, double);
+  itkGetConstMacro(BlockMarginInSigmas, double);
+  /** @ITKEndGrouping */
+
   /** This is overloaded to create the Scales and Hessian output images */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
 
@@ -229,15 +258,25 @@ protected:
   DataObjectPointer
   MakeOutput(DataObjectPointerArraySizeType idx) override;
 
+  /** Compute the output block by block, within the MemoryBudget. */
+  void
+  GenerateDataByBlocks();
+
 private:
+  /** Update the best response in the region of the update buffer. */
   void
   UpdateMaximumResponse(double sigma);
 
   double
   ComputeSigmaValue(int scaleLevel);
 
+  /** Allocate the update buffer over a region of the output. */
   void
-  AllocateUpdateBuffer();
+  AllocateUpdateBuffer(const OutputRegionType & region);
+
+  /** Write the region of the update buffer to the output. */
+  void
+  CopyUpdateBufferToOutput();
 
   bool m_NonNegativeHessianBasedMeasure{};
 
@@ -255,6 +294,9 @@ private:
 
   bool m_GenerateScalesOutput{};
   bool m_GenerateHessianOutput{};
+
+  uint64_t m_MemoryBudget{ 0 };
+  double   m_BlockMarginInSigmas{ 4.0 };
 };
 } // end namespace itk
 
@@ -18,8 +18,11 @@
 #ifndef itkMultiScaleHessianBasedMeasureImageFilter_hxx
 #define itkMultiScaleHessianBasedMeasureImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterMultidimensional.h"
 #include "itkMath.h"
+#include "itkTotalProgressReporter.h"
 
 /*
  *
@@ -84,7 +87,8 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 
 template <typename TInputImage, typename THessianImage, typename TOutputImage>
 void
-MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::AllocateUpdateBuffer()
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::AllocateUpdateBuffer(
+  const OutputRegionType & region)
 {
   /* The update buffer looks just like the output and holds the best response
      in the  objectness measure */
@@ -95,8 +99,8 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   // spacing and the largest region
   m_UpdateBuffer->CopyInformation(output);
 
-  m_UpdateBuffer->SetRequestedRegion(output->GetRequestedRegion());
-  m_UpdateBuffer->SetBufferedRegion(output->GetBufferedRegion());
+  m_UpdateBuffer->SetRequestedRegion(region);
+  m_UpdateBuffer->SetBufferedRegion(region);
   m_UpdateBuffer->Allocate();
 
   // Update buffer is used for > comparisons so make it really really small,
@@ -149,15 +153,21 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
     hessianImage->FillBuffer(zeroTensor);
   }
 
+  this->m_HessianFilter->SetNormalizeAcrossScale(true);
+
+  if (m_MemoryBudget > 0)
+  {
+    this->GenerateDataByBlocks();
+    return;
+  }
+
   // Allocate the buffer
-  AllocateUpdateBuffer();
+  AllocateUpdateBuffer(this->GetOutput()->GetBufferedRegion());
 
   const typename InputImageType::ConstPointer input = this->GetInput();
 
   this->m_HessianFilter->SetInput(input);
 
-  this->m_HessianFilter->SetNormalizeAcrossScale(true);
-
   // Create a process accumulator for tracking the progress of this
   // minipipeline
   auto progress = ProgressAccumulator::New();
@@ -185,10 +195,120 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
     this->UpdateMaximumResponse(sigma);
   }
 
+  this->CopyUpdateBufferToOutput();
+}
+
+template <typename TInputImage, typename THessianImage, typename TOutputImage>
+void
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::GenerateDataByBlocks()
+{
+  const InputImageType * input = this->GetInput();
+  const OutputRegionType outputRegion = this->GetOutput()->GetRequestedRegion();
+
+  // the blocks are extracted with a margin which covers most of the
+  // support of the largest Gaussian
+  double maximumSigma = 0.0;
+  for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
+  {
+    maximumSigma = std::max(maximumSigma, this->ComputeSigmaValue(scaleLevel));
+  }
+  typename InputImageType::SizeType margin;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    margin[dim] =
+      static_cast<SizeValueType>(std::ceil(m_BlockMarginInSigmas * maximumSigma / input->GetSpacing()[dim]));
+  }
+  const auto paddedBlock = [&input, &margin](OutputRegionType block) {
+    block.PadByRadius(margin);
+    block.Crop(input->GetLargestPossibleRegion());
+    return block;
+  };
+
+  // Approximate number of bytes used per pixel of a padded block: the
+  // extracted input, the intermediate images of the Hessian filter, the
+  // Hessian, the measure and the update buffer.
+  constexpr uint64_t bytesPerPixel =
+    sizeof(InputPixelType) + ImageDimension * sizeof(typename HessianFilterType::InternalRealType) +
+    sizeof(typename HessianImageType::PixelType) + sizeof(OutputPixelType) + sizeof(BufferValueType);
+
+  // Split the output in more and more blocks until the largest padded one
+  // fits in the budget
+  auto         splitter = ImageRegionSplitterMultidimensional::New();
+  unsigned int numberOfBlocks = 0;
+  for (unsigned int requestedNumberOfBlocks = 1;; requestedNumberOfBlocks *= 2)
+  {
+    const unsigned int previousNumberOfBlocks = numberOfBlocks;
+    numberOfBlocks = splitter->GetNumberOfSplits(outputRegion, requestedNumberOfBlocks);
+    uint64_t maximumBlockSize = 0;
+    for (unsigned int i = 0; i < numberOfBlocks; ++i)
+    {
+      OutputRegionType block = outputRegion;
+      splitter->GetSplit(i, numberOfBlocks, block);
+      maximumBlockSize = std::max<uint64_t>(maximumBlockSize, paddedBlock(block).GetNumberOfPixels());
+    }
+    if (maximumBlockSize * bytesPerPixel <= m_MemoryBudget)
+    {
+      break;
+    }
+    if (numberOfBlocks == previousNumberOfBlocks || requestedNumberOfBlocks > NumericTraits<unsigned int>::max() / 2)
+    {
+      itkExceptionMacro("MemoryBudget of " << m_MemoryBudget << " bytes is too small for blocks with a margin of "
+                                           << margin);
+    }
+  }
+  itkDebugMacro("Computing the measure in " << numberOfBlocks << " blocks");
+
+  auto extractedInput = InputImageType::New();
+  m_HessianFilter->SetInput(extractedInput);
+  m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
+
+  TotalProgressReporter progress(this, static_cast<SizeValueType>(numberOfBlocks) * m_NumberOfSigmaSteps);
+
+  for (unsigned int i = 0; i < numberOfBlocks; ++i)
+  {
+    OutputRegionType block = outputRegion;
+    splitter->GetSplit(i, numberOfBlocks, block);
+
+    const OutputRegionType extractedRegion = paddedBlock(block);
+    extractedInput->CopyInformation(input);
+    extractedInput->SetRegions(extractedRegion);
+    extractedInput->Allocate();
+    ImageAlgorithm::Copy(input, extractedInput.GetPointer(), extractedRegion, extractedRegion);
+    extractedInput->Modified();
+
+    AllocateUpdateBuffer(block);
+
+    for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
+    {
+      const double sigma = this->ComputeSigmaValue(scaleLevel);
+
+      m_HessianFilter->SetSigma(sigma);
+      m_HessianToMeasureFilter->GetOutput()->SetRequestedRegion(block);
+      m_HessianToMeasureFilter->Update();
+
+      this->UpdateMaximumResponse(sigma);
+      progress.CompletedPixel();
+    }
+
+    this->CopyUpdateBufferToOutput();
+  }
+
+  // Release the images of the last block, and let the next update of the
+  // measure filter request its largest possible region again
+  extractedInput->Initialize();
+  m_HessianFilter->GetOutput()->ReleaseData();
+  m_HessianToMeasureFilter->GetOutput()->ReleaseData();
+  m_HessianToMeasureFilter->GetOutput()->SetRequestedRegion(OutputRegionType());
+}
+
+template <typename TInputImage, typename THessianImage, typename TOutputImage>
+void
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::CopyUpdateBufferToOutput()
+{
   // Write out the best response to the output image
   // we can assume that the meta-data should match between these two
-  // image, therefore we iterate over the desired output region
-  const OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
+  // image, therefore we iterate over the region of the update buffer
+  const OutputRegionType outputRegion = m_UpdateBuffer->GetBufferedRegion();
   ImageRegionIterator    it(m_UpdateBuffer, outputRegion);
 
   ImageRegionIterator oit(this->GetOutput(), outputRegion);
@@ -209,8 +329,8 @@ void
 MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponse(double sigma)
 {
   // the meta-data should match between these images, therefore we
-  // iterate over the desired output region
-  const OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
+  // iterate over the region of the update buffer
+  const OutputRegionType outputRegion = m_UpdateBuffer->GetBufferedRegion();
 
   ImageRegionIterator oit(m_UpdateBuffer, outputRegion);
 
@@ -352,6 +472,8 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   os << indent << "NonNegativeHessianBasedMeasure:  " << m_NonNegativeHessianBasedMeasure << std::endl;
   os << indent << "GenerateScalesOutput: " << m_GenerateScalesOutput << std::endl;
   os << indent << "GenerateHessianOutput: " << m_GenerateHessianOutput << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "BlockMarginInSigmas: " << m_BlockMarginInSigmas << std::endl;
 }
 } // end namespace itk
 
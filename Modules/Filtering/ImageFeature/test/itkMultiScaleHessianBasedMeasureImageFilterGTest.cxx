@@ -0,0 +1,149 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkMultiScaleHessianBasedMeasureImageFilter.h"
+
+#include "itkHessianToObjectnessMeasureImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkSymmetricSecondRankTensor.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using InputImageType = itk::Image<float, Dimension>;
+using HessianImageType = itk::Image<itk::SymmetricSecondRankTensor<float, Dimension>, Dimension>;
+using OutputImageType = itk::Image<float, Dimension>;
+using FilterType = itk::MultiScaleHessianBasedMeasureImageFilter<InputImageType, HessianImageType, OutputImageType>;
+
+// Two bright tubes of different widths on a textured background
+InputImageType::Pointer
+CreateTubesImage()
+{
+  auto                           image = InputImageType::New();
+  const InputImageType::SizeType size{ { 48, 44, 40 } };
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const InputImageType::IndexType index = it.GetIndex();
+    const double                    dy = index[1] - 22.0 - 0.06 * index[0];
+    const double                    dz = index[2] - 18.0;
+    const double                    dx2 = index[0] - 16.0;
+    const double                    dz2 = index[2] - 10.0;
+    const double                    texture = ((7 * index[0] + 13 * index[1] + 31 * index[2]) % 17) * 0.5;
+    it.Set(static_cast<float>(100.0 * std::exp(-(dy * dy + dz * dz) / 8.0) +
+                              80.0 * std::exp(-(dx2 * dx2 + dz2 * dz2) / 2.0) + texture));
+  }
+  return image;
+}
+
+FilterType::Pointer
+CreateFilter(const InputImageType * input)
+{
+  using ObjectnessFilterType = itk::HessianToObjectnessMeasureImageFilter<HessianImageType, OutputImageType>;
+  auto objectnessFilter = ObjectnessFilterType::New();
+  objectnessFilter->SetBrightObject(true);
+  objectnessFilter->SetObjectDimension(1);
+
+  auto filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetHessianToMeasureFilter(objectnessFilter);
+  filter->SetSigmaMinimum(0.5);
+  filter->SetSigmaMaximum(3.0);
+  filter->SetNumberOfSigmaSteps(4);
+  filter->GenerateScalesOutputOn();
+  filter->GenerateHessianOutputOn();
+  return filter;
+}
+} // namespace
+
+
+// Checks that the measure computed by blocks within a memory budget matches
+// the measure computed on the whole image, up to the small error caused by
+// the finite margin of the blocks.
+TEST(MultiScaleHessianBasedMeasureImageFilter, BlocksMatchWholeImage)
+{
+  const auto input = CreateTubesImage();
+
+  const auto wholeFilter = CreateFilter(input);
+  wholeFilter->Update();
+  EXPECT_EQ(wholeFilter->GetMemoryBudget(), 0u);
+
+  const auto blockFilter = CreateFilter(input);
+  // about half of what the whole image needs, which requires several blocks
+  blockFilter->SetMemoryBudget(input->GetBufferedRegion().GetNumberOfPixels() * 24);
+  blockFilter->Update();
+
+  const OutputImageType *             expected = wholeFilter->GetOutput();
+  const OutputImageType *             actual = blockFilter->GetOutput();
+  const FilterType::ScalesImageType * expectedScales = wholeFilter->GetScalesOutput();
+  const FilterType::ScalesImageType * actualScales = blockFilter->GetScalesOutput();
+  const HessianImageType *            expectedHessian = wholeFilter->GetHessianOutput();
+  const HessianImageType *            actualHessian = blockFilter->GetHessianOutput();
+  ASSERT_EQ(actual->GetBufferedRegion(), expected->GetBufferedRegion());
+
+  float              maximum = 0.0f;
+  itk::SizeValueType numberOfDifferentScales = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(expected, expected->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    maximum = std::max(maximum, it.Get());
+    if (expectedScales->GetPixel(it.GetIndex()) != actualScales->GetPixel(it.GetIndex()))
+    {
+      ++numberOfDifferentScales;
+    }
+  }
+  ASSERT_GT(maximum, 1.0f);
+
+  const float tolerance = 1e-3f * maximum;
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(expected, expected->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const OutputImageType::IndexType index = it.GetIndex();
+    ASSERT_NEAR(actual->GetPixel(index), it.Get(), tolerance) << "at index " << index;
+    if (expectedScales->GetPixel(index) != actualScales->GetPixel(index))
+    {
+      continue;
+    }
+    for (unsigned int i = 0; i < HessianImageType::PixelType::InternalDimension; ++i)
+    {
+      ASSERT_NEAR(actualHessian->GetPixel(index)[i], expectedHessian->GetPixel(index)[i], 0.05f)
+        << "at index " << index;
+    }
+  }
+  // the selected scale, and so the Hessian, may only differ where the responses nearly tie
+  EXPECT_LT(numberOfDifferentScales, expected->GetBufferedRegion().GetNumberOfPixels() / 100);
+}
+
+
+// Checks that a memory budget which cannot hold a single padded pixel is reported.
+TEST(MultiScaleHessianBasedMeasureImageFilter, ThrowsWhenMemoryBudgetIsTooSmall)
+{
+  const auto input = CreateTubesImage();
+  const auto filter = CreateFilter(input);
+  filter->SetMemoryBudget(1024);
+  EXPECT_THROW(filter->Update(), itk::ExceptionObject);
+}
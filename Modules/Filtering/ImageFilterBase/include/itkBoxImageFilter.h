@@ -87,6 +87,11 @@ protected:
   void
   GenerateInputRequestedRegion() override;
 
+  /** The tiles of an ImageRegionSplitterCacheTiles are read with the radius
+   * of the box around them. */
+  Size<TOutputImage::ImageDimension>
+  GetTileHaloRadius() const override;
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
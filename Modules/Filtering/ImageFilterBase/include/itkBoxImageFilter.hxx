@@ -92,6 +92,18 @@ BoxImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
   throw e;
 }
 
+template <typename TInputImage, typename TOutputImage>
+auto
+BoxImageFilter<TInputImage, TOutputImage>::GetTileHaloRadius() const -> Size<TOutputImage::ImageDimension>
+{
+  Size<TOutputImage::ImageDimension> radius{};
+  for (unsigned int d = 0; d < std::min(ImageDimension, TOutputImage::ImageDimension); ++d)
+  {
+    radius[d] = m_Radius[d];
+  }
+  return radius;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 BoxImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -0,0 +1,128 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkColumnHistogramRankCalculator_h
+#define itkColumnHistogramRankCalculator_h
+
+#include "itkTotalProgressReporter.h"
+#include <cstdint>
+#include <type_traits>
+
+namespace itk
+{
+/** \class ColumnHistogramRankCalculator
+ * \brief Compute a rank of the values in a box neighborhood with column histograms.
+ *
+ * This is the median filtering algorithm of Perreault and Hebert,
+ * "Median Filtering in Constant Time", IEEE Transactions on Image
+ * Processing, 2007, extended to any rank and any dimension. A histogram of
+ * the neighborhood along all the dimensions but the first one is kept for
+ * each column of the image, and the histogram of the box neighborhood is
+ * the sum of the histograms of 2 * radius[0] + 1 consecutive columns. When
+ * moving along the first dimension, a column histogram is subtracted and
+ * another one is added; when moving to the next line, a row of pixels is
+ * removed from and added to the column histograms. The cost per pixel does
+ * not depend on the radius in 2D, and grows linearly with the radius in
+ * 3D, instead of quadratically for MovingHistogramImageFilter.
+ *
+ * The histograms have a bin per value between the minimum and the maximum
+ * of the neighborhoods, so only integer pixel types of 8 or 16 bits are
+ * supported. The bins are grouped in coarse bins: only the coarse
+ * histograms are summed for each pixel, and the fine bins of a coarse bin
+ * are updated when the rank falls in this coarse bin. The region is
+ * processed in chunks along the first dimension to keep the column
+ * histograms in a bounded amount of memory.
+ *
+ * The pixels outside the buffered region of the input are either
+ * replaced by the nearest pixel of the buffered region, like with
+ * ZeroFluxNeumannBoundaryCondition, or ignored, in which case the
+ * neighborhoods are cropped at the boundary.
+ *
+ * \sa MedianImageFilter, RankImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TInputImage, typename TOutputImage>
+struct ITK_TEMPLATE_EXPORT ColumnHistogramRankCalculator
+{
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+  using RegionType = typename TInputImage::RegionType;
+  using SizeType = typename TInputImage::SizeType;
+  using IndexType = typename TInputImage::IndexType;
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Whether the input pixel type can be processed. */
+  static constexpr bool IsPixelTypeSupported = std::is_integral_v<InputPixelType> &&
+                                               !std::is_same_v<InputPixelType, bool> && sizeof(InputPixelType) <= 2;
+
+  /** Whether the algorithm is expected to be faster than the selection of
+   * the rank in each neighborhood. The histograms of 16 bits pixels have
+   * much more bins, which only pays off for large neighborhoods. */
+  static bool
+  IsEfficientForRadius(const SizeType & radius)
+  {
+    SizeValueType neighborhoodSize = 1;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      neighborhoodSize *= 2 * radius[dim] + 1;
+    }
+    return neighborhoodSize >= (sizeof(InputPixelType) == 1 ? 9 : 64);
+  }
+
+  /** Maximum size in bytes of the column histograms of a call to Compute(). */
+  static constexpr SizeValueType MaximumHistogramMemory = SizeValueType{ 1 } << 24;
+
+  /** Write to the outputRegion of the output the value of the given rank,
+   * between 0 and 1, in the neighborhood of the given radius of each pixel
+   * of the input. The rank is selected like in Function::RankHistogram, so
+   * a rank of 0.5 gives the median of the odd sized neighborhoods. When
+   * cropNeighborhood is false, the pixels outside the buffered region of the
+   * input are replaced by the nearest pixel inside it. */
+  static void
+  Compute(const InputImageType &  input,
+          OutputImageType &       output,
+          const RegionType &      outputRegion,
+          const SizeType &        radius,
+          float                   rank,
+          bool                    cropNeighborhood,
+          TotalProgressReporter & progress);
+
+private:
+  using CountType = std::uint32_t;
+
+  static void
+  ComputeChunk(const InputImageType &  input,
+               OutputImageType &       output,
+               const RegionType &      outputRegion,
+               const SizeType &        radius,
+               float                   rank,
+               bool                    cropNeighborhood,
+               InputPixelType          minimum,
+               unsigned int            fineBits,
+               SizeValueType           numberOfCoarseBins,
+               TotalProgressReporter & progress);
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkColumnHistogramRankCalculator.hxx"
+#endif
+
+#endif
@@ -0,0 +1,331 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkColumnHistogramRankCalculator_hxx
+#define itkColumnHistogramRankCalculator_hxx
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkIndexRange.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+void
+ColumnHistogramRankCalculator<TInputImage, TOutputImage>::Compute(const InputImageType &  input,
+                                                                  OutputImageType &       output,
+                                                                  const RegionType &      outputRegion,
+                                                                  const SizeType &        radius,
+                                                                  float                   rank,
+                                                                  bool                    cropNeighborhood,
+                                                                  TotalProgressReporter & progress)
+{
+  static_assert(IsPixelTypeSupported, "Only the integer pixel types of 8 or 16 bits are supported.");
+
+  RegionType inputRegion = outputRegion;
+  inputRegion.PadByRadius(radius);
+  if (outputRegion.GetNumberOfPixels() == 0 || !inputRegion.Crop(input.GetBufferedRegion()))
+  {
+    return;
+  }
+
+  // The histograms only span the values found in the neighborhoods. The
+  // fine bins are grouped in coarse bins of about the square root of the
+  // number of bins.
+  InputPixelType minimum = NumericTraits<InputPixelType>::max();
+  InputPixelType maximum = NumericTraits<InputPixelType>::NonpositiveMin();
+  for (ImageRegionConstIterator<InputImageType> it(&input, inputRegion); !it.IsAtEnd(); ++it)
+  {
+    minimum = std::min(minimum, it.Get());
+    maximum = std::max(maximum, it.Get());
+  }
+  const auto numberOfBins =
+    static_cast<SizeValueType>(static_cast<OffsetValueType>(maximum) - static_cast<OffsetValueType>(minimum) + 1);
+  unsigned int fineBits = 0;
+  while ((SizeValueType{ 1 } << (2 * fineBits)) < numberOfBins)
+  {
+    ++fineBits;
+  }
+  const SizeValueType numberOfCoarseBins = ((numberOfBins - 1) >> fineBits) + 1;
+
+  // Process the region in chunks along the first dimension, so that the
+  // histograms of the columns of a chunk fit in MaximumHistogramMemory,
+  // unless the chunks would be narrower than the neighborhood.
+  const SizeValueType columnMemory = ((numberOfCoarseBins << fineBits) + numberOfCoarseBins) * sizeof(CountType);
+  const SizeValueType chunkSize =
+    std::max(MaximumHistogramMemory / columnMemory, 4 * radius[0] + 1) - 2 * radius[0];
+  const IndexValueType end = outputRegion.GetIndex(0) + static_cast<IndexValueType>(outputRegion.GetSize(0));
+  RegionType           chunk = outputRegion;
+  for (IndexValueType start = outputRegion.GetIndex(0); start < end; start += static_cast<IndexValueType>(chunkSize))
+  {
+    chunk.SetIndex(0, start);
+    chunk.SetSize(0, std::min(chunkSize, static_cast<SizeValueType>(end - start)));
+    ComputeChunk(
+      input, output, chunk, radius, rank, cropNeighborhood, minimum, fineBits, numberOfCoarseBins, progress);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ColumnHistogramRankCalculator<TInputImage, TOutputImage>::ComputeChunk(const InputImageType &  input,
+                                                                       OutputImageType &       output,
+                                                                       const RegionType &      outputRegion,
+                                                                       const SizeType &        radius,
+                                                                       float                   rank,
+                                                                       bool                    cropNeighborhood,
+                                                                       InputPixelType          minimum,
+                                                                       unsigned int            fineBits,
+                                                                       SizeValueType           numberOfCoarseBins,
+                                                                       TotalProgressReporter & progress)
+{
+  const RegionType &      bufferedRegion = input.GetBufferedRegion();
+  const IndexType         bufferIndex = bufferedRegion.GetIndex();
+  const OffsetValueType * offsetTable = input.GetOffsetTable();
+  const InputPixelType *  buffer = input.GetBufferPointer();
+  IndexType               bufferLast;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    bufferLast[dim] = bufferIndex[dim] + static_cast<IndexValueType>(bufferedRegion.GetSize(dim)) - 1;
+  }
+  const auto signedRadius = [&radius](unsigned int dim) { return static_cast<IndexValueType>(radius[dim]); };
+
+  // Call function(coordinate) for the neighbors of position along dim.
+  const auto forEachNeighbor = [&](unsigned int dim, IndexValueType position, auto && function) {
+    for (IndexValueType i = position - signedRadius(dim); i <= position + signedRadius(dim); ++i)
+    {
+      if (!cropNeighborhood || (i >= bufferIndex[dim] && i <= bufferLast[dim]))
+      {
+        function(std::clamp(i, bufferIndex[dim], bufferLast[dim]));
+      }
+    }
+  };
+  const auto numberOfNeighbors = [&](unsigned int dim, IndexValueType position) -> SizeValueType {
+    if (!cropNeighborhood)
+    {
+      return 2 * radius[dim] + 1;
+    }
+    return std::min(position + signedRadius(dim), bufferLast[dim]) -
+           std::max(position - signedRadius(dim), bufferIndex[dim]) + 1;
+  };
+  // Call function(coordinate, remove) for the neighbors which leave and enter
+  // the neighborhood along dim when moving from position - 1 to position.
+  const auto slide = [&](unsigned int dim, IndexValueType position, auto && function) {
+    const IndexValueType leaving = position - 1 - signedRadius(dim);
+    const IndexValueType entering = position + signedRadius(dim);
+    if (!cropNeighborhood || leaving >= bufferIndex[dim])
+    {
+      function(std::clamp(leaving, bufferIndex[dim], bufferLast[dim]), true);
+    }
+    if (!cropNeighborhood || entering <= bufferLast[dim])
+    {
+      function(std::clamp(entering, bufferIndex[dim], bufferLast[dim]), false);
+    }
+  };
+
+  const IndexValueType firstX = outputRegion.GetIndex(0);
+  const IndexValueType lastX = firstX + static_cast<IndexValueType>(outputRegion.GetSize(0)) - 1;
+  const IndexValueType firstColumn = std::max(firstX - signedRadius(0), bufferIndex[0]);
+  const IndexValueType lastColumn = std::min(lastX + signedRadius(0), bufferLast[0]);
+  const auto           numberOfColumns = static_cast<SizeValueType>(lastColumn - firstColumn + 1);
+  const SizeValueType  numberOfFineBins = numberOfCoarseBins << fineBits;
+  const SizeValueType  fineBinsPerCoarseBin = SizeValueType{ 1 } << fineBits;
+
+  std::vector<CountType>      columnCoarse(numberOfColumns * numberOfCoarseBins);
+  std::vector<CountType>      columnFine(numberOfColumns * numberOfFineBins);
+  std::vector<CountType>      kernelCoarse(numberOfCoarseBins);
+  std::vector<CountType>      kernelFine(numberOfFineBins);
+  std::vector<IndexValueType> fineUpdated(numberOfCoarseBins);
+  std::vector<OffsetValueType> planeOffsets;
+
+  // Add or remove the pixels of a row of the neighborhood, along the
+  // dimensions greater than 0, to the column histograms.
+  const auto updateColumns = [&](OffsetValueType rowOffset, bool remove) {
+    for (const OffsetValueType planeOffset : planeOffsets)
+    {
+      const InputPixelType * row = buffer + rowOffset + planeOffset + (firstColumn - bufferIndex[0]);
+      CountType *            coarse = columnCoarse.data();
+      CountType *            fine = columnFine.data();
+      for (SizeValueType column = 0; column < numberOfColumns;
+           ++column, coarse += numberOfCoarseBins, fine += numberOfFineBins)
+      {
+        const auto bin = static_cast<SizeValueType>(static_cast<OffsetValueType>(row[column]) - minimum);
+        if (remove)
+        {
+          --fine[bin];
+          --coarse[bin >> fineBits];
+        }
+        else
+        {
+          ++fine[bin];
+          ++coarse[bin >> fineBits];
+        }
+      }
+    }
+  };
+  const auto rowOffset = [&](IndexValueType coordinate) -> OffsetValueType {
+    if constexpr (ImageDimension > 1)
+    {
+      return (coordinate - bufferIndex[1]) * offsetTable[1];
+    }
+    return 0;
+  };
+  const auto updateKernelCoarse = [&](IndexValueType coordinate, bool remove) {
+    const CountType * column = columnCoarse.data() + (coordinate - firstColumn) * numberOfCoarseBins;
+    if (remove)
+    {
+      for (SizeValueType bin = 0; bin < numberOfCoarseBins; ++bin)
+      {
+        kernelCoarse[bin] -= column[bin];
+      }
+    }
+    else
+    {
+      for (SizeValueType bin = 0; bin < numberOfCoarseBins; ++bin)
+      {
+        kernelCoarse[bin] += column[bin];
+      }
+    }
+  };
+
+  ImageRegionIterator<OutputImageType> outputIt(&output, outputRegion);
+
+  RegionType planes = outputRegion;
+  for (unsigned int dim = 0; dim < std::min(ImageDimension, 2u); ++dim)
+  {
+    planes.SetSize(dim, 1);
+  }
+  for (const IndexType & plane : MakeIndexRange(planes))
+  {
+    // The offsets of the rows of the neighborhood along the dimensions
+    // greater than 1.
+    planeOffsets.assign(1, 0);
+    for (unsigned int dim = 2; dim < ImageDimension; ++dim)
+    {
+      std::vector<OffsetValueType> offsets;
+      forEachNeighbor(dim, plane[dim], [&](IndexValueType coordinate) {
+        for (const OffsetValueType offset : planeOffsets)
+        {
+          offsets.push_back(offset + (coordinate - bufferIndex[dim]) * offsetTable[dim]);
+        }
+      });
+      planeOffsets = std::move(offsets);
+    }
+
+    std::fill(columnCoarse.begin(), columnCoarse.end(), 0);
+    std::fill(columnFine.begin(), columnFine.end(), 0);
+    IndexValueType firstY = 0;
+    IndexValueType lastY = 0;
+    if constexpr (ImageDimension > 1)
+    {
+      firstY = plane[1];
+      lastY = firstY + static_cast<IndexValueType>(outputRegion.GetSize(1)) - 1;
+      forEachNeighbor(1, firstY, [&](IndexValueType coordinate) { updateColumns(rowOffset(coordinate), false); });
+    }
+    else
+    {
+      updateColumns(0, false);
+    }
+
+    for (IndexValueType y = firstY; y <= lastY; ++y)
+    {
+      SizeValueType columnSize = planeOffsets.size();
+      if constexpr (ImageDimension > 1)
+      {
+        if (y > firstY)
+        {
+          slide(1, y, [&](IndexValueType coordinate, bool remove) { updateColumns(rowOffset(coordinate), remove); });
+        }
+        columnSize *= numberOfNeighbors(1, y);
+      }
+
+      // The fine bins of the kernel histogram are only updated when the
+      // rank falls in their coarse bin.
+      std::fill(kernelCoarse.begin(), kernelCoarse.end(), 0);
+      std::fill(fineUpdated.begin(), fineUpdated.end(), std::numeric_limits<IndexValueType>::min());
+      forEachNeighbor(0, firstX, [&](IndexValueType coordinate) { updateKernelCoarse(coordinate, false); });
+
+      for (IndexValueType x = firstX; x <= lastX; ++x, ++outputIt)
+      {
+        if (x > firstX)
+        {
+          slide(0, x, updateKernelCoarse);
+        }
+        const SizeValueType numberOfPixels = columnSize * numberOfNeighbors(0, x);
+        const auto          target = static_cast<SizeValueType>(rank * static_cast<float>(numberOfPixels - 1)) + 1;
+
+        SizeValueType total = 0;
+        SizeValueType coarseBin = 0;
+        while (total + kernelCoarse[coarseBin] < target)
+        {
+          total += kernelCoarse[coarseBin];
+          ++coarseBin;
+        }
+
+        CountType * fine = kernelFine.data() + (coarseBin << fineBits);
+        const auto  updateKernelFine = [&](IndexValueType coordinate, bool remove) {
+          const CountType * column =
+            columnFine.data() + (coordinate - firstColumn) * numberOfFineBins + (coarseBin << fineBits);
+          if (remove)
+          {
+            for (SizeValueType bin = 0; bin < fineBinsPerCoarseBin; ++bin)
+            {
+              fine[bin] -= column[bin];
+            }
+          }
+          else
+          {
+            for (SizeValueType bin = 0; bin < fineBinsPerCoarseBin; ++bin)
+            {
+              fine[bin] += column[bin];
+            }
+          }
+        };
+        IndexValueType & updated = fineUpdated[coarseBin];
+        if (updated < x - signedRadius(0))
+        {
+          // cheaper to sum the columns again than to slide the window
+          std::fill_n(fine, fineBinsPerCoarseBin, 0);
+          forEachNeighbor(0, x, [&](IndexValueType coordinate) { updateKernelFine(coordinate, false); });
+        }
+        else
+        {
+          for (IndexValueType position = updated + 1; position <= x; ++position)
+          {
+            slide(0, position, updateKernelFine);
+          }
+        }
+        updated = x;
+
+        SizeValueType fineBin = 0;
+        while (total + fine[fineBin] < target)
+        {
+          total += fine[fineBin];
+          ++fineBin;
+        }
+        outputIt.Set(static_cast<OutputPixelType>(static_cast<OffsetValueType>(minimum) +
+                                                  static_cast<OffsetValueType>((coarseBin << fineBits) + fineBin)));
+      }
+      progress.Completed(outputRegion.GetSize(0));
+    }
+  }
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,224 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusedFunctorExpression_h
+#define itkFusedFunctorExpression_h
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+namespace itk::Functor::Fused
+{
+/** \class ExpressionBase
+ * \brief Base class of the nodes of a fused functor expression.
+ *
+ * A fused expression composes per-pixel functors at compile time. It is
+ * called with one pixel value of each input of a FusedFunctorImageFilter,
+ * and evaluates the whole chain of functors on these values, without
+ * intermediate images.
+ *
+ * \code
+ * namespace Fused = itk::Functor::Fused;
+ * itk::Functor::Clamp<float, float> clamp;
+ * clamp.SetBounds(0.0f, 1000.0f);
+ * const auto expression =
+ *   Fused::Apply(clamp, (Fused::Cast<float>(Fused::Input<0>()) + 100.0f) * 0.5f);
+ * \endcode
+ *
+ * \sa FusedFunctorImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+struct ExpressionBase
+{};
+
+template <typename T>
+constexpr bool IsExpression = std::is_base_of_v<ExpressionBase, T>;
+
+/** \class Input
+ * \brief The pixel value of the input number VIndex of the filter.
+ * \ingroup ITKImageFilterBase
+ */
+template <unsigned int VIndex>
+struct Input : ExpressionBase
+{
+  template <typename... TPixels>
+  constexpr decltype(auto)
+  operator()(const TPixels &... pixels) const
+  {
+    static_assert(VIndex < sizeof...(TPixels), "The expression uses more inputs than the filter has!");
+    return std::get<VIndex>(std::forward_as_tuple(pixels...));
+  }
+};
+
+/** \class Constant
+ * \brief A value which is the same for all the pixels.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TValue>
+class Constant : public ExpressionBase
+{
+public:
+  Constant() = default;
+  Constant(const TValue & value)
+    : m_Value(value)
+  {}
+
+  template <typename... TPixels>
+  constexpr const TValue &
+  operator()(const TPixels &...) const
+  {
+    return m_Value;
+  }
+
+private:
+  TValue m_Value{};
+};
+
+/** Wrap the values which are not expressions in a Constant. */
+template <typename T>
+using AsExpression = std::conditional_t<IsExpression<T>, T, Constant<T>>;
+
+/** \class Expression
+ * \brief Apply a functor to the values of its argument expressions.
+ *
+ * The functor is any function object, like the classes of the itk::Functor
+ * namespace, which can be called on the values of the arguments through a
+ * const reference.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFunctor, typename... TArguments>
+class Expression : public ExpressionBase
+{
+public:
+  using FunctorType = TFunctor;
+
+  Expression() = default;
+  Expression(const TFunctor & functor, const TArguments &... arguments)
+    : m_Functor(functor)
+    , m_Arguments(arguments...)
+  {}
+
+  template <typename... TPixels>
+  constexpr auto
+  operator()(const TPixels &... pixels) const
+  {
+    return std::apply(
+      [this, &pixels...](const TArguments &... arguments) { return m_Functor(arguments(pixels...)...); }, m_Arguments);
+  }
+
+  /** Get the functor, for example to change its parameters. */
+  /** @ITKStartGrouping */
+  FunctorType &
+  GetFunctor()
+  {
+    return m_Functor;
+  }
+  const FunctorType &
+  GetFunctor() const
+  {
+    return m_Functor;
+  }
+  /** @ITKEndGrouping */
+
+  /** Get the expression of the argument number VIndex. */
+  /** @ITKStartGrouping */
+  template <unsigned int VIndex>
+  auto &
+  GetArgument()
+  {
+    return std::get<VIndex>(m_Arguments);
+  }
+  template <unsigned int VIndex>
+  const auto &
+  GetArgument() const
+  {
+    return std::get<VIndex>(m_Arguments);
+  }
+  /** @ITKEndGrouping */
+
+private:
+  TFunctor                  m_Functor{};
+  std::tuple<TArguments...> m_Arguments{};
+};
+
+/** Return the expression applying functor to the arguments, which are
+ * expressions or constant values. */
+template <typename TFunctor, typename... TArguments>
+Expression<TFunctor, AsExpression<TArguments>...>
+Apply(const TFunctor & functor, const TArguments &... arguments)
+{
+  return Expression<TFunctor, AsExpression<TArguments>...>(functor, AsExpression<TArguments>(arguments)...);
+}
+
+/** \class StaticCast
+ * \brief Convert a value to TOutput with static_cast.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TOutput>
+struct StaticCast
+{
+  template <typename TInput>
+  constexpr TOutput
+  operator()(const TInput & value) const
+  {
+    return static_cast<TOutput>(value);
+  }
+};
+
+/** Return the expression converting the value of argument to TOutput. */
+template <typename TOutput, typename TArgument>
+auto
+Cast(const TArgument & argument)
+{
+  return Apply(StaticCast<TOutput>(), argument);
+}
+
+/** Arithmetic operators, when at least one of the operands is an
+ * expression. The usual arithmetic conversions apply to the values. */
+/** @ITKStartGrouping */
+template <typename T1, typename T2, typename = std::enable_if_t<IsExpression<T1> || IsExpression<T2>>>
+auto
+operator+(const T1 & expression1, const T2 & expression2)
+{
+  return Apply(std::plus<>(), expression1, expression2);
+}
+
+template <typename T1, typename T2, typename = std::enable_if_t<IsExpression<T1> || IsExpression<T2>>>
+auto
+operator-(const T1 & expression1, const T2 & expression2)
+{
+  return Apply(std::minus<>(), expression1, expression2);
+}
+
+template <typename T1, typename T2, typename = std::enable_if_t<IsExpression<T1> || IsExpression<T2>>>
+auto
+operator*(const T1 & expression1, const T2 & expression2)
+{
+  return Apply(std::multiplies<>(), expression1, expression2);
+}
+
+template <typename T1, typename T2, typename = std::enable_if_t<IsExpression<T1> || IsExpression<T2>>>
+auto
+operator/(const T1 & expression1, const T2 & expression2)
+{
+  return Apply(std::divides<>(), expression1, expression2);
+}
+/** @ITKEndGrouping */
+} // namespace itk::Functor::Fused
+
+#endif
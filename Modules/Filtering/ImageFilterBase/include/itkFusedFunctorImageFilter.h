@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusedFunctorImageFilter_h
+#define itkFusedFunctorImageFilter_h
+
+#include "itkImage.h"
+#include "itkInPlaceImageFilter.h"
+#include "itkFusedFunctorExpression.h"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace itk
+{
+/** \class FusedFunctorImageFilter
+ * \brief Evaluate a chain of per-pixel functors in a single pass.
+ *
+ * A chain of functor filters, like UnaryFunctorImageFilter or
+ * BinaryGeneratorImageFilter, reads and writes a whole image at each step,
+ * and allocates an intermediate image for each filter. This filter
+ * evaluates instead a fused expression, which composes the functors at
+ * compile time (see itk::Functor::Fused::Apply()), once for each output
+ * pixel: the values of the pixels of the inputs are read, all the functors
+ * are applied to them in registers, and the result is written to the
+ * output. Each line of the output region is processed by a loop over
+ * contiguous buffers, which the compiler can vectorize when the functors
+ * allow it.
+ *
+ * The first input is given by TInputImage, and the other ones by
+ * TAdditionalInputImages. The expression refers to the pixel values of the
+ * input number I with itk::Functor::Fused::Input<I>. All the images must be
+ * itk::Image, with the same dimension, and the inputs must occupy the same
+ * physical space.
+ *
+ * For example, the preprocessing chain Cast, ShiftScale, Clamp, Mask and
+ * Sigmoid becomes:
+ * \code
+ * namespace Fused = itk::Functor::Fused;
+ * itk::Functor::Clamp<float, float> clamp;
+ * clamp.SetBounds(0.0f, 2000.0f);
+ * itk::Functor::MaskInput<float, MaskPixelType, float> mask;
+ * itk::Functor::Sigmoid<float, float> sigmoid;
+ * const auto clamped = Fused::Apply(clamp, (Fused::Cast<float>(Fused::Input<0>()) + shift) * scale);
+ * const auto expression = Fused::Apply(sigmoid, Fused::Apply(mask, clamped, Fused::Input<1>()));
+ *
+ * using ExpressionType = std::remove_const_t<decltype(expression)>;
+ * using FilterType = itk::FusedFunctorImageFilter<ShortImageType, FloatImageType, ExpressionType, MaskImageType>;
+ * auto filter = FilterType::New();
+ * filter->SetExpression(expression);
+ * filter->SetInputs(image, maskImage);
+ * \endcode
+ *
+ * \sa UnaryFunctorImageFilter, BinaryGeneratorImageFilter, NaryFunctorImageFilter
+ * \ingroup IntensityImageFilters MultiThreaded
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TInputImage, typename TOutputImage, typename TExpression, typename... TAdditionalInputImages>
+class ITK_TEMPLATE_EXPORT FusedFunctorImageFilter : public InPlaceImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FusedFunctorImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = FusedFunctorImageFilter;
+  using Superclass = InPlaceImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(FusedFunctorImageFilter);
+
+  /** Some convenient type alias. */
+  using ExpressionType = TExpression;
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using OutputImagePixelType = typename OutputImageType::PixelType;
+
+  /** The type of the input number VIndex. */
+  template <unsigned int VIndex>
+  using NthInputImageType = std::tuple_element_t<VIndex, std::tuple<TInputImage, TAdditionalInputImages...>>;
+
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+  static constexpr unsigned int NumberOfInputImages = 1 + sizeof...(TAdditionalInputImages);
+
+  static_assert(((TAdditionalInputImages::ImageDimension == ImageDimension) && ... &&
+                 (TInputImage::ImageDimension == ImageDimension)),
+                "The inputs and the output must have the same dimension!");
+
+  /** Whether the image is an itk::Image, whose lines of pixels GenerateLines() accesses
+   * through pointers to the buffer. */
+  template <typename TImage>
+  static constexpr bool IsImage = std::is_base_of_v<Image<typename TImage::PixelType, TImage::ImageDimension>, TImage>;
+
+  static_assert((IsImage<TAdditionalInputImages> && ... && IsImage<TInputImage>) && IsImage<TOutputImage>,
+                "The inputs and the output must be itk::Image: VectorImage and ImageAdaptor are not supported!");
+
+  /** Set/Get the expression evaluated for each pixel. */
+  /** @ITKStartGrouping */
+  void
+  SetExpression(const ExpressionType & expression)
+  {
+    m_Expression = expression;
+    this->Modified();
+  }
+  const ExpressionType &
+  GetExpression() const
+  {
+    return m_Expression;
+  }
+  /** @ITKEndGrouping */
+
+  /** Connect all the inputs, in the order of their types. */
+  void
+  SetInputs(const TInputImage * input, const TAdditionalInputImages *... additionalInputs);
+
+protected:
+  FusedFunctorImageFilter();
+  ~FusedFunctorImageFilter() override = default;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  template <size_t... VIndices>
+  void
+  GenerateLines(const OutputImageRegionType & outputRegionForThread, std::index_sequence<VIndices...>);
+
+  template <typename... TPixels>
+  void
+  EvaluateLine(OutputImagePixelType * output, SizeValueType length, const TPixels *... inputs) const
+  {
+    for (SizeValueType i = 0; i < length; ++i)
+    {
+      output[i] = static_cast<OutputImagePixelType>(m_Expression(inputs[i]...));
+    }
+  }
+
+  ExpressionType m_Expression{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFusedFunctorImageFilter.hxx"
+#endif
+
+#endif
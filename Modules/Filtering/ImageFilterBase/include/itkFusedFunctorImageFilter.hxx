@@ -0,0 +1,100 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusedFunctorImageFilter_hxx
+#define itkFusedFunctorImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkTotalProgressReporter.h"
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage, typename TExpression, typename... TAdditionalInputImages>
+FusedFunctorImageFilter<TInputImage, TOutputImage, TExpression, TAdditionalInputImages...>::FusedFunctorImageFilter()
+{
+  this->SetNumberOfRequiredInputs(NumberOfInputImages);
+  this->InPlaceOff();
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TExpression, typename... TAdditionalInputImages>
+void
+FusedFunctorImageFilter<TInputImage, TOutputImage, TExpression, TAdditionalInputImages...>::SetInputs(
+  const TInputImage * input,
+  const TAdditionalInputImages *... additionalInputs)
+{
+  this->SetInput(input);
+  unsigned int index = 0;
+  (this->ProcessObject::SetNthInput(++index, const_cast<TAdditionalInputImages *>(additionalInputs)), ...);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TExpression, typename... TAdditionalInputImages>
+void
+FusedFunctorImageFilter<TInputImage, TOutputImage, TExpression, TAdditionalInputImages...>::
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  this->GenerateLines(outputRegionForThread, std::make_index_sequence<NumberOfInputImages>());
+}
+
+template <typename TInputImage, typename TOutputImage, typename TExpression, typename... TAdditionalInputImages>
+template <size_t... VIndices>
+void
+FusedFunctorImageFilter<TInputImage, TOutputImage, TExpression, TAdditionalInputImages...>::GenerateLines(
+  const OutputImageRegionType & outputRegionForThread,
+  std::index_sequence<VIndices...>)
+{
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+  if (lineLength == 0)
+  {
+    return;
+  }
+
+  TOutputImage * output = this->GetOutput();
+  const std::tuple<const NthInputImageType<VIndices> *...> inputs(
+    static_cast<const NthInputImageType<VIndices> *>(this->ProcessObject::GetInput(VIndices))...);
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  // the lines are evaluated on the buffers, as the pixels of a line are
+  // contiguous in all the images
+  ImageScanlineIterator<TOutputImage> outputIt(output, outputRegionForThread);
+  while (!outputIt.IsAtEnd())
+  {
+    const typename OutputImageRegionType::IndexType & index = outputIt.GetIndex();
+    this->EvaluateLine(
+      output->GetBufferPointer() + output->ComputeOffset(index),
+      lineLength,
+      (std::get<VIndices>(inputs)->GetBufferPointer() + std::get<VIndices>(inputs)->ComputeOffset(index))...);
+    progress.Completed(lineLength);
+    outputIt.NextLine();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TExpression, typename... TAdditionalInputImages>
+void
+FusedFunctorImageFilter<TInputImage, TOutputImage, TExpression, TAdditionalInputImages...>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfInputImages: " << NumberOfInputImages << std::endl;
+}
+} // end namespace itk
+
+#endif
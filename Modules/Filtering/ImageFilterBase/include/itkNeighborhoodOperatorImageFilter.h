@@ -172,6 +172,13 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** The tiles of an ImageRegionSplitterCacheTiles are read with the radius
+   * of the operator around them. */
+  Size<ImageDimension>
+  GetTileHaloRadius() const override
+  {
+    return m_Operator.GetRadius();
+  }
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override
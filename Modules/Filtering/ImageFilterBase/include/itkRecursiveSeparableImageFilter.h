@@ -41,6 +41,12 @@ namespace itk
  *
  * Further improvements of the algorithm are described in \cite farneback2006.
  *
+ * When the pixels are scalars, NumberOfBatchedLines lines are filtered
+ * together: their values are interleaved in the scratch buffers, so that
+ * the recursions run on all the lines at once in the vector registers, and
+ * the lines are adjacent in memory when the filter does not run along the
+ * first dimension.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -80,6 +86,9 @@ public:
   /** Type of the output image */
   using OutputImageType = TOutputImage;
 
+  /** Number of lines filtered together when the pixels are scalars. */
+  static constexpr unsigned int NumberOfBatchedLines = 8;
+
   /** Get the direction in which the filter is to be applied. */
   itkGetConstMacro(Direction, unsigned int);
 
@@ -136,6 +145,16 @@ protected:
   void
   FilterDataArray(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
 
+  /** Apply the Recursive Filter to NumberOfBatchedLines lines at once. The
+   * values of the lines are interleaved in the arrays: element i of line l
+   * is at i * NumberOfBatchedLines + l. */
+  void
+  FilterDataArrays(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
+
+  /** Filter the lines of the region by groups of NumberOfBatchedLines. */
+  void
+  FilterBatchesOfLines(const OutputImageRegionType & region);
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0{ 1.0 };
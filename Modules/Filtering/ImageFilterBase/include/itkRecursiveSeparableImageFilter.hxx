@@ -20,7 +20,11 @@
 
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkIndexRange.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include <algorithm>
+#include <array>
+#include <type_traits>
 
 namespace itk
 {
@@ -139,6 +143,87 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArrays(RealType * const       outs,
+                                                                           const RealType * const data,
+                                                                           RealType * const       scratch,
+                                                                           const SizeValueType    ln) const
+{
+  // Same computations as FilterDataArray(), where the index i of an
+  // element becomes i * B, and the loops over the lines are the innermost
+  // ones so that they are vectorized.
+  constexpr SizeValueType B = NumberOfBatchedLines;
+
+  /**
+   * Causal direction pass
+   */
+  for (SizeValueType l = 0; l < B; ++l)
+  {
+    RealType * const       o = outs;
+    const RealType * const d = data;
+    const RealType         outV1 = d[l];
+
+    MathEMAMAMAM(o[l], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(o[l + B], d[l + B], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(o[l + 2 * B], d[l + 2 * B], m_N0, d[l + B], m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(o[l + 3 * B], d[l + 3 * B], m_N0, d[l + 2 * B], m_N1, d[l + B], m_N2, outV1, m_N3);
+
+    MathSMAMAMAM(o[l], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(o[l + B], o[l], m_D1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(o[l + 2 * B], o[l + B], m_D1, o[l], m_D2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(o[l + 3 * B], o[l + 2 * B], m_D1, o[l + B], m_D2, o[l], m_D3, outV1, m_BN4);
+  }
+
+  for (SizeValueType i = 4 * B; i < ln * B; i += B)
+  {
+    for (SizeValueType l = i; l < i + B; ++l)
+    {
+      MathEMAMAMAM(outs[l], data[l], m_N0, data[l - B], m_N1, data[l - 2 * B], m_N2, data[l - 3 * B], m_N3);
+      MathSMAMAMAM(outs[l], outs[l - B], m_D1, outs[l - 2 * B], m_D2, outs[l - 3 * B], m_D3, outs[l - 4 * B], m_D4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass
+   */
+  const SizeValueType last = (ln - 1) * B;
+  for (SizeValueType l = last; l < last + B; ++l)
+  {
+    RealType * const       s = scratch;
+    const RealType * const d = data;
+    const RealType         outV2 = d[l];
+
+    MathEMAMAMAM(s[l], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(s[l - B], d[l], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(s[l - 2 * B], d[l - B], m_M1, d[l], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(s[l - 3 * B], d[l - 2 * B], m_M1, d[l - B], m_M2, d[l], m_M3, outV2, m_M4);
+
+    MathSMAMAMAM(s[l], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(s[l - B], s[l], m_D1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(s[l - 2 * B], s[l - B], m_D1, s[l], m_D2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(s[l - 3 * B], s[l - 2 * B], m_D1, s[l - B], m_D2, s[l], m_D3, outV2, m_BM4);
+  }
+
+  for (SizeValueType i = last - 3 * B; i > 0; i -= B)
+  {
+    for (SizeValueType l = i - B; l < i; ++l)
+    {
+      MathEMAMAMAM(scratch[l], data[l + B], m_M1, data[l + 2 * B], m_M2, data[l + 3 * B], m_M3, data[l + 4 * B], m_M4);
+      MathSMAMAMAM(
+        scratch[l], scratch[l + B], m_D1, scratch[l + 2 * B], m_D2, scratch[l + 3 * B], m_D3, scratch[l + 4 * B], m_D4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * B; ++i)
+  {
+    outs[i] += scratch[i];
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -237,6 +322,16 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
 {
   using OutputPixelType = typename TOutputImage::PixelType;
 
+  // The lines of scalar images are filtered by batches, with direct
+  // accesses to the buffers.
+  constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+  if constexpr (std::is_arithmetic_v<RealType> &&
+                std::is_same_v<TInputImage, Image<typename TInputImage::PixelType, ImageDimension>> &&
+                std::is_same_v<TOutputImage, Image<OutputPixelType, ImageDimension>>)
+  {
+    this->FilterBatchesOfLines(outputRegionForThread);
+    return;
+  }
 
   using RegionType = ImageRegion<TInputImage::ImageDimension>;
 
@@ -283,6 +378,68 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterBatchesOfLines(const OutputImageRegionType & region)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+  constexpr unsigned int B = NumberOfBatchedLines;
+
+  const TInputImage * inputImage = this->GetInputImage();
+  TOutputImage *      outputImage = this->GetOutput();
+
+  const SizeValueType   ln = region.GetSize(m_Direction);
+  const OffsetValueType inputStride = inputImage->GetOffsetTable()[m_Direction];
+  const OffsetValueType outputStride = outputImage->GetOffsetTable()[m_Direction];
+
+  const auto inps = make_unique_for_overwrite<RealType[]>(ln * B);
+  const auto outs = make_unique_for_overwrite<RealType[]>(ln * B);
+  const auto scratch = make_unique_for_overwrite<RealType[]>(ln * B);
+
+  // The consecutive lines of the iteration are adjacent along the first
+  // dimension, unless the filter runs along it. The last line is repeated
+  // to fill an incomplete batch.
+  std::array<const InputPixelType *, B> inputLines{};
+  std::array<OutputPixelType *, B>      outputLines{};
+  unsigned int                          numberOfLines = 0;
+  const auto                            filterLines = [&]() {
+    for (SizeValueType i = 0; i < ln; ++i)
+    {
+      for (unsigned int l = 0; l < B; ++l)
+      {
+        inps[i * B + l] = static_cast<RealType>(inputLines[std::min(l, numberOfLines - 1)][i * inputStride]);
+      }
+    }
+
+    this->FilterDataArrays(outs.get(), inps.get(), scratch.get(), ln);
+
+    for (SizeValueType i = 0; i < ln; ++i)
+    {
+      for (unsigned int l = 0; l < numberOfLines; ++l)
+      {
+        outputLines[l][i * outputStride] = static_cast<OutputPixelType>(outs[i * B + l]);
+      }
+    }
+    numberOfLines = 0;
+  };
+
+  OutputImageRegionType lineStarts = region;
+  lineStarts.SetSize(m_Direction, 1);
+  for (const auto & index : MakeIndexRange(lineStarts))
+  {
+    inputLines[numberOfLines] = inputImage->GetBufferPointer() + inputImage->ComputeOffset(index);
+    outputLines[numberOfLines] = outputImage->GetBufferPointer() + outputImage->ComputeOffset(index);
+    if (++numberOfLines == B)
+    {
+      filterLines();
+    }
+  }
+  if (numberOfLines > 0)
+  {
+    filterLines();
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
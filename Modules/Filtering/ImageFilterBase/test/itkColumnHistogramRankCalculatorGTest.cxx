@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkColumnHistogramRankCalculator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkGTest.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, unsigned int maximum)
+{
+  auto image = TImage::New();
+  auto index = TImage::IndexType::Filled(-2);
+  image->SetRegions(typename TImage::RegionType(index, size));
+  image->Allocate();
+  unsigned int value = 1;
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    // a deterministic pseudo random sequence
+    value = value * 1103515245u + 12345u;
+    it.Set(static_cast<typename TImage::PixelType>((value >> 8) % (maximum + 1)));
+  }
+  return image;
+}
+
+// Check the calculator against the sorted neighborhoods of all the pixels.
+template <typename TImage>
+void
+CheckRank(const TImage * image, unsigned int radius, float rank, bool cropNeighborhood)
+{
+  using CalculatorType = itk::ColumnHistogramRankCalculator<TImage, TImage>;
+  const auto region = image->GetBufferedRegion();
+  auto       output = TImage::New();
+  output->SetRegions(region);
+  output->Allocate();
+  itk::TotalProgressReporter progress(nullptr, region.GetNumberOfPixels());
+  CalculatorType::Compute(
+    *image, *output, region, TImage::SizeType::Filled(radius), rank, cropNeighborhood, progress);
+
+  unsigned int numberOfErrors = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(output, region); !it.IsAtEnd(); ++it)
+  {
+    std::vector<typename TImage::PixelType> values;
+    typename TImage::RegionType             neighborhood(it.GetIndex(), TImage::SizeType::Filled(1));
+    neighborhood.PadByRadius(radius);
+    for (const auto & index : itk::MakeIndexRange(neighborhood))
+    {
+      if (cropNeighborhood && !region.IsInside(index))
+      {
+        continue;
+      }
+      auto clamped = index;
+      for (unsigned int dim = 0; dim < TImage::ImageDimension; ++dim)
+      {
+        const auto last = region.GetIndex(dim) + static_cast<itk::IndexValueType>(region.GetSize(dim)) - 1;
+        clamped[dim] = std::clamp(index[dim], region.GetIndex(dim), last);
+      }
+      values.push_back(image->GetPixel(clamped));
+    }
+    std::sort(values.begin(), values.end());
+    numberOfErrors += it.Get() != values[static_cast<size_t>(rank * static_cast<float>(values.size() - 1))];
+  }
+  EXPECT_EQ(numberOfErrors, 0u) << "radius " << radius << ", rank " << rank << ", crop " << cropNeighborhood;
+}
+} // namespace
+
+TEST(ColumnHistogramRankCalculator, MatchesSortedNeighborhoods2D)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 41, 27 } }, 255);
+  for (const bool cropNeighborhood : { false, true })
+  {
+    CheckRank(image.GetPointer(), 1, 0.5f, cropNeighborhood);
+    CheckRank(image.GetPointer(), 4, 0.2f, cropNeighborhood);
+    CheckRank(image.GetPointer(), 30, 1.0f, cropNeighborhood);
+  }
+}
+
+TEST(ColumnHistogramRankCalculator, MatchesSortedNeighborhoods3D)
+{
+  using ImageType = itk::Image<short, 3>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 19, 13, 11 } }, 4095);
+  for (const bool cropNeighborhood : { false, true })
+  {
+    CheckRank(image.GetPointer(), 2, 0.5f, cropNeighborhood);
+    CheckRank(image.GetPointer(), 3, 0.0f, cropNeighborhood);
+  }
+}
+
+TEST(ColumnHistogramRankCalculator, ProcessesWideRangesInChunks)
+{
+  // The column histograms of 16 bits values over the whole range do not fit
+  // in MaximumHistogramMemory for this width.
+  using ImageType = itk::Image<unsigned short, 2>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 150, 9 } }, 65535);
+  CheckRank(image.GetPointer(), 3, 0.5f, false);
+  CheckRank(image.GetPointer(), 5, 0.7f, true);
+}
+
+TEST(ColumnHistogramRankCalculator, SupportedPixelTypes)
+{
+  const auto isSupported = [](auto pixel) {
+    using ImageType = itk::Image<decltype(pixel), 2>;
+    return itk::ColumnHistogramRankCalculator<ImageType, ImageType>::IsPixelTypeSupported;
+  };
+  EXPECT_TRUE(isSupported(static_cast<unsigned char>(0)));
+  EXPECT_TRUE(isSupported(static_cast<short>(0)));
+  EXPECT_FALSE(isSupported(0));
+  EXPECT_FALSE(isSupported(0.0f));
+  EXPECT_FALSE(isSupported(false));
+}
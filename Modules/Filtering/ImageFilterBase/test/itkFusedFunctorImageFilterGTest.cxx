@@ -0,0 +1,168 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFusedFunctorImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkMaskImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkSigmoidImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include <vector>
+
+#include "itkGTest.h"
+
+namespace
+{
+using ShortImageType = itk::Image<short, 3>;
+using MaskImageType = itk::Image<unsigned char, 3>;
+using FloatImageType = itk::Image<float, 3>;
+
+namespace Fused = itk::Functor::Fused;
+
+template <typename TImage>
+typename TImage::Pointer
+MakeRandomImage(int minimum, int maximum)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::RegionType(typename TImage::SizeType{ { 23, 17, 11 } }));
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(generator->GetIntegerVariate(maximum - minimum) + minimum));
+  }
+  return image;
+}
+} // namespace
+
+TEST(FusedFunctorImageFilter, EvaluatesArithmeticExpressions)
+{
+  const auto input = MakeRandomImage<ShortImageType>(-1000, 1000);
+
+  const auto expression = Fused::Cast<float>(Fused::Input<0>()) * 0.5f + 3.0f - Fused::Input<0>() / 4;
+  using ExpressionType = std::remove_const_t<decltype(expression)>;
+  using FilterType = itk::FusedFunctorImageFilter<ShortImageType, FloatImageType, ExpressionType>;
+  auto filter = FilterType::New();
+  filter->SetExpression(expression);
+  filter->SetInputs(input);
+  filter->Update();
+
+  itk::ImageRegionConstIterator<ShortImageType> inputIt(input, input->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FloatImageType> outputIt(filter->GetOutput(), input->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    const short value = inputIt.Get();
+    ASSERT_EQ(outputIt.Get(), static_cast<float>(value) * 0.5f + 3.0f - value / 4);
+  }
+}
+
+TEST(FusedFunctorImageFilter, MatchesChainOfFilters)
+{
+  constexpr float shift = 100.0f;
+  constexpr float scale = 0.5f;
+  const auto      input = MakeRandomImage<ShortImageType>(-1000, 3000);
+  const auto      mask = MakeRandomImage<MaskImageType>(0, 2);
+
+  // Cast -> ShiftScale -> Clamp -> Mask -> Sigmoid as a pipeline
+  auto cast = itk::CastImageFilter<ShortImageType, FloatImageType>::New();
+  cast->SetInput(input);
+  auto shiftScale = itk::ShiftScaleImageFilter<FloatImageType, FloatImageType>::New();
+  shiftScale->SetInput(cast->GetOutput());
+  shiftScale->SetShift(shift);
+  shiftScale->SetScale(scale);
+  auto clamp = itk::ClampImageFilter<FloatImageType, FloatImageType>::New();
+  clamp->SetInput(shiftScale->GetOutput());
+  clamp->SetBounds(0.0f, 1000.0f);
+  auto maskFilter = itk::MaskImageFilter<FloatImageType, MaskImageType, FloatImageType>::New();
+  maskFilter->SetInput(clamp->GetOutput());
+  maskFilter->SetMaskImage(mask);
+  maskFilter->SetOutsideValue(-50.0f);
+  auto sigmoid = itk::SigmoidImageFilter<FloatImageType, FloatImageType>::New();
+  sigmoid->SetInput(maskFilter->GetOutput());
+  sigmoid->SetAlpha(100.0);
+  sigmoid->SetBeta(300.0);
+  sigmoid->SetOutputMinimum(0.0f);
+  sigmoid->SetOutputMaximum(1.0f);
+  sigmoid->Update();
+
+  // and as a fused expression
+  itk::Functor::Clamp<float, float> clampFunctor;
+  clampFunctor.SetBounds(0.0f, 1000.0f);
+  itk::Functor::MaskInput<float, unsigned char, float> maskFunctor;
+  maskFunctor.SetOutsideValue(-50.0f);
+  itk::Functor::Sigmoid<float, float> sigmoidFunctor;
+  sigmoidFunctor.SetAlpha(100.0);
+  sigmoidFunctor.SetBeta(300.0);
+  sigmoidFunctor.SetOutputMinimum(0.0f);
+  sigmoidFunctor.SetOutputMaximum(1.0f);
+  const auto expression = Fused::Apply(
+    sigmoidFunctor,
+    Fused::Apply(maskFunctor,
+                 Fused::Apply(clampFunctor, (Fused::Cast<double>(Fused::Input<0>()) + shift) * scale),
+                 Fused::Input<1>()));
+
+  using ExpressionType = std::remove_const_t<decltype(expression)>;
+  using FilterType = itk::FusedFunctorImageFilter<ShortImageType, FloatImageType, ExpressionType, MaskImageType>;
+  auto filter = FilterType::New();
+  filter->SetExpression(expression);
+  filter->SetInputs(input, mask);
+  filter->Update();
+
+  itk::ImageRegionConstIterator<FloatImageType> expectedIt(sigmoid->GetOutput(), input->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FloatImageType> outputIt(filter->GetOutput(), input->GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++outputIt)
+  {
+    ASSERT_FLOAT_EQ(outputIt.Get(), expectedIt.Get()) << expectedIt.GetIndex();
+  }
+
+  // the parameters of the functors can be changed in place
+  auto changedExpression = filter->GetExpression();
+  changedExpression.GetFunctor().SetOutputMaximum(2.0f);
+  filter->SetExpression(changedExpression);
+  filter->Update();
+  const ShortImageType::IndexType index{ { 1, 2, 3 } };
+  EXPECT_FLOAT_EQ(filter->GetOutput()->GetPixel(index), 2.0f * sigmoid->GetOutput()->GetPixel(index));
+}
+
+TEST(FusedFunctorImageFilter, RunsInPlace)
+{
+  const auto          input = MakeRandomImage<FloatImageType>(-100, 100);
+  const auto          other = MakeRandomImage<ShortImageType>(0, 10);
+  const float * const buffer = input->GetBufferPointer();
+  const std::vector<float> values(buffer, buffer + input->GetBufferedRegion().GetNumberOfPixels());
+
+  const auto expression = Fused::Input<0>() * 2.0f - Fused::Input<1>();
+  using ExpressionType = std::remove_const_t<decltype(expression)>;
+  using FilterType = itk::FusedFunctorImageFilter<FloatImageType, FloatImageType, ExpressionType, ShortImageType>;
+  auto filter = FilterType::New();
+  filter->SetExpression(expression);
+  filter->SetInputs(input, other);
+  filter->InPlaceOn();
+  filter->Update();
+
+  const FloatImageType * output = filter->GetOutput();
+  EXPECT_EQ(output->GetBufferPointer(), buffer);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    ASSERT_EQ(output->GetBufferPointer()[i], values[i] * 2.0f - other->GetBufferPointer()[i]);
+  }
+}
@@ -19,14 +19,18 @@
 #define itkResampleImageFilter_h
 
 #include "itkFixedArray.h"
+#include "itkImage.h"
 #include "itkTransform.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageToImageFilter.h"
 #include "itkExtrapolateImageFunction.h"
 #include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 #include "itkSize.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
+#include <type_traits>
+#include <utility>
 
 
 namespace itk
@@ -71,6 +75,17 @@ namespace itk
  *
  * This filter is implemented as a multithreaded filter.  It provides a
  * DynamicThreadedGenerateData() method for its implementation.
+ *
+ * When the transform is linear, and the input and output images are
+ * Image's of scalars, resampling with exactly a LinearInterpolateImageFunction
+ * (in 1, 2 or 3 dimensions) or a NearestNeighborInterpolateImageFunction
+ * reads the input buffer directly for the part of each output scanline
+ * that maps inside the input buffer. The pixels are processed in blocks of
+ * independent computations that the compiler can vectorize, which give the
+ * same values as the interpolators. Other interpolators evaluate that part
+ * of the scanline in blocks with
+ * InterpolateImageFunction::EvaluateAtContinuousIndices(), which
+ * BSplineInterpolateImageFunction implements with cached partial sums.
  * \warning For multithreading, the TransformPoint method of the
  * user-designated coordinate transform must be threadsafe.
  *
@@ -278,6 +293,20 @@ public:
   itkBooleanMacro(UseReferenceImage);
   itkGetConstMacro(UseReferenceImage, bool);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether the interpolators which the scanline kernel does not
+   * compute itself, like BSplineInterpolateImageFunction, are given blocks of
+   * continuous indices through EvaluateAtContinuousIndices(). This is only
+   * done for the output scanlines which map along the first axis of the
+   * input image, e.g. with axis-aligned transforms, which is where
+   * BSplineInterpolateImageFunction reuses its partial sums. The results may
+   * then differ at rounding level from evaluating one pixel at a time, so it
+   * is Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseBatchedInterpolation, bool);
+  itkBooleanMacro(UseBatchedInterpolation);
+  itkGetConstMacro(UseBatchedInterpolation, bool);
+  /** @ITKEndGrouping */
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<PixelComponentType>));
 
 protected:
@@ -370,6 +399,63 @@ private:
   static PixelType
   CastPixelWithBoundsChecking(const TPixel value);
 
+  /** Interpolations that LinearThreadedGenerateData() computes with its
+   * scanline kernel, reading the input buffer directly, or passing blocks
+   * of continuous indices to the interpolator (Batched, only when
+   * UseBatchedInterpolation is On). */
+  enum class ScanlineKernelEnum : uint8_t
+  {
+    None,
+    Linear,
+    NearestNeighbor,
+    Batched
+  };
+
+  /** The scanline kernel requires images of scalars stored contiguously. */
+  static constexpr bool ImageTypesSupportScanlineKernel =
+    std::is_arithmetic_v<InputPixelType> && std::is_arithmetic_v<PixelType> &&
+    std::is_same_v<InputImageType, Image<InputPixelType, InputImageDimension>> &&
+    std::is_same_v<OutputImageType, Image<PixelType, OutputImageDimension>>;
+
+  using ContinuousInputVectorType = typename ContinuousInputIndexType::VectorType;
+
+  /** Maps the pixel at scanlineIndex of an output scanline to the input
+   * image, along the line from startIndex to startIndex +
+   * vectorFromStartIndex that this scanline maps to. */
+  static ContinuousInputIndexType
+  ComputeScanlineInputIndex(const ContinuousInputIndexType &  startIndex,
+                            const ContinuousInputVectorType & vectorFromStartIndex,
+                            IndexValueType                    firstIndex,
+                            double                            size,
+                            IndexValueType                    scanlineIndex);
+
+  /** Returns whether the interpolation at inputIndex only reads pixels
+   * of the input buffer, so that the scanline kernel can compute it. */
+  bool
+  IsInsideScanlineKernelDomain(const ContinuousInputIndexType & inputIndex) const;
+
+  /** Returns the span [first, last) of the output pixels from begin to end
+   * of a scanline that the scanline kernel can compute, which is
+   * contiguous because the scanline maps to a line. */
+  std::pair<IndexValueType, IndexValueType>
+  ComputeScanlineKernelSpan(const ContinuousInputIndexType &  startIndex,
+                            const ContinuousInputVectorType & vectorFromStartIndex,
+                            IndexValueType                    firstIndex,
+                            double                            size,
+                            IndexValueType                    begin,
+                            IndexValueType                    end) const;
+
+  /** Resamples the output pixels from begin to end of a scanline, all in
+   * the span of ComputeScanlineKernelSpan(), into outputBuffer. */
+  void
+  ScanlineKernelResample(const ContinuousInputIndexType &  startIndex,
+                         const ContinuousInputVectorType & vectorFromStartIndex,
+                         IndexValueType                    firstIndex,
+                         double                            size,
+                         IndexValueType                    begin,
+                         IndexValueType                    end,
+                         PixelType *                       outputBuffer) const;
+
   void
   InitializeTransform();
 
@@ -386,6 +472,9 @@ private:
   DirectionType   m_OutputDirection{};      // output image direction cosines
   IndexType       m_OutputStartIndex{};     // output image start index
   bool            m_UseReferenceImage{ false };
+  bool            m_UseBatchedInterpolation{ false };
+
+  ScanlineKernelEnum m_ScanlineKernel{ ScanlineKernelEnum::None }; // set by BeforeThreadedGenerateData()
 };
 } // end namespace itk
 
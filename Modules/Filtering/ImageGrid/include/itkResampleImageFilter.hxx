@@ -29,6 +29,7 @@
 
 #include <algorithm>   // For max.
 #include <type_traits> // For is_same.
+#include <typeinfo>
 #include "itkPrintHelper.h"
 
 namespace itk
@@ -181,6 +182,29 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       PixelConvertType::SetNthComponent(n, m_DefaultPixelValue, zeroComponent);
     }
   }
+
+  // The scanline kernel computes these exact interpolator types itself, and
+  // optionally passes blocks of continuous indices to the other interpolators
+  m_ScanlineKernel = ScanlineKernelEnum::None;
+  if constexpr (ImageTypesSupportScanlineKernel)
+  {
+    using NearestNeighborInterpolatorType =
+      NearestNeighborInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+
+    const InterpolatorType & interpolator = *m_Interpolator;
+    if (typeid(interpolator) == typeid(LinearInterpolatorType) && InputImageDimension <= 3)
+    {
+      m_ScanlineKernel = ScanlineKernelEnum::Linear;
+    }
+    else if (typeid(interpolator) == typeid(NearestNeighborInterpolatorType))
+    {
+      m_ScanlineKernel = ScanlineKernelEnum::NearestNeighbor;
+    }
+    else if (m_UseBatchedInterpolation)
+    {
+      m_ScanlineKernel = ScanlineKernelEnum::Batched;
+    }
+  }
 }
 
 template <typename TInputImage,
@@ -477,19 +501,86 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 
     IndexValueType scanlineIndex = computedIndex[0];
 
+    if constexpr (ImageTypesSupportScanlineKernel)
+    {
+      // The interpolators only gain from blocks of indices which vary along
+      // the first axis, and the others are evaluated one at a time as before
+      const auto isAlongFirstAxis = [&vectorFromStartIndex] {
+        for (unsigned int d = 1; d < InputImageDimension; ++d)
+        {
+          if (vectorFromStartIndex[d] != 0)
+          {
+            return false;
+          }
+        }
+        return true;
+      };
+      if (m_ScanlineKernel != ScanlineKernelEnum::None &&
+          (m_ScanlineKernel != ScanlineKernelEnum::Batched || isAlongFirstAxis()))
+      {
+        // Only the pixels before and after the span that maps inside the
+        // input buffer need the interpolator or the extrapolator
+        const IndexValueType begin = scanlineIndex;
+        const IndexValueType end = begin + static_cast<IndexValueType>(outputRegionForThread.GetSize(0));
+        PixelType * const    outputBuffer = &outIt.Value();
+
+        const auto resamplePixels = [&](const IndexValueType from, const IndexValueType to) {
+          for (IndexValueType i = from; i < to; ++i)
+          {
+            const ContinuousInputIndexType inputIndex =
+              Self::ComputeScanlineInputIndex(startIndex,
+                                              vectorFromStartIndex,
+                                              firstIndexValueOfLargestPossibleRegion,
+                                              firstSizeValueOfLargestPossibleRegion,
+                                              i);
+            if (m_Interpolator->IsInsideBuffer(inputIndex))
+            {
+              outputBuffer[i - begin] =
+                Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex));
+            }
+            else if (m_Extrapolator.IsNull())
+            {
+              outputBuffer[i - begin] = defaultValue;
+            }
+            else
+            {
+              outputBuffer[i - begin] =
+                Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex));
+            }
+          }
+        };
+
+        const auto [first, last] = this->ComputeScanlineKernelSpan(startIndex,
+                                                                   vectorFromStartIndex,
+                                                                   firstIndexValueOfLargestPossibleRegion,
+                                                                   firstSizeValueOfLargestPossibleRegion,
+                                                                   begin,
+                                                                   end);
+        resamplePixels(begin, first);
+        this->ScanlineKernelResample(startIndex,
+                                     vectorFromStartIndex,
+                                     firstIndexValueOfLargestPossibleRegion,
+                                     firstSizeValueOfLargestPossibleRegion,
+                                     first,
+                                     last,
+                                     outputBuffer + (first - begin));
+        resamplePixels(last, end);
+
+        outIt.GoToEndOfLine();
+        progress.Completed(outputRegionForThread.GetSize()[0]);
+        continue;
+      }
+    }
 
     while (!outIt.IsAtEndOfLine())
     {
-
       // Perform linear interpolation from startIndex, along vectorFromStartIndex
-      const double alpha =
-        (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
-
-      ContinuousInputIndexType inputIndex(startIndex);
-      for (unsigned int i = 0; i < InputImageDimension; ++i)
-      {
-        inputIndex[i] += alpha * vectorFromStartIndex[i];
-      }
+      const ContinuousInputIndexType inputIndex =
+        Self::ComputeScanlineInputIndex(startIndex,
+                                        vectorFromStartIndex,
+                                        firstIndexValueOfLargestPossibleRegion,
+                                        firstSizeValueOfLargestPossibleRegion,
+                                        scanlineIndex);
 
       // Evaluate input at right position and copy to the output
       if (m_Interpolator->IsInsideBuffer(inputIndex))
@@ -515,6 +606,288 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   }
 }
 
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+auto
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ComputeScanlineInputIndex(const ContinuousInputIndexType &  startIndex,
+                            const ContinuousInputVectorType & vectorFromStartIndex,
+                            const IndexValueType              firstIndex,
+                            const double                      size,
+                            const IndexValueType              scanlineIndex) -> ContinuousInputIndexType
+{
+  const double alpha = (scanlineIndex - firstIndex) / size;
+
+  ContinuousInputIndexType inputIndex(startIndex);
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    inputIndex[i] += alpha * vectorFromStartIndex[i];
+  }
+  return inputIndex;
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+bool
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  IsInsideScanlineKernelDomain(const ContinuousInputIndexType & inputIndex) const
+{
+  if (!m_Interpolator->IsInsideBuffer(inputIndex))
+  {
+    return false;
+  }
+  if (m_ScanlineKernel == ScanlineKernelEnum::Linear)
+  {
+    // The neighbors of linear interpolation, floor(x) and floor(x) + 1, have
+    // to be in the buffer, also when x is an index
+    const InputImageRegionType & bufferedRegion = this->GetInput()->GetBufferedRegion();
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      const IndexValueType start = bufferedRegion.GetIndex(d);
+      const IndexValueType last = start + static_cast<IndexValueType>(bufferedRegion.GetSize(d)) - 1;
+      if (!(inputIndex[d] >= start && inputIndex[d] < last))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+auto
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ComputeScanlineKernelSpan(const ContinuousInputIndexType &  startIndex,
+                            const ContinuousInputVectorType & vectorFromStartIndex,
+                            const IndexValueType              firstIndex,
+                            const double                      size,
+                            const IndexValueType              begin,
+                            const IndexValueType              end) const -> std::pair<IndexValueType, IndexValueType>
+{
+  const InputImageRegionType & bufferedRegion = this->GetInput()->GetBufferedRegion();
+
+  // Estimate the span by intersecting the line with the domain along each
+  // axis: the interval [start, last) of the buffered region for linear
+  // interpolation, and [start - 0.5, last + 0.5) for the other interpolations
+  const double margin = (m_ScanlineKernel == ScanlineKernelEnum::Linear) ? 0.0 : 0.5;
+  double       spanBegin = static_cast<double>(begin);
+  double       spanEnd = static_cast<double>(end);
+  for (unsigned int d = 0; d < InputImageDimension; ++d)
+  {
+    const double lower = bufferedRegion.GetIndex(d) - margin;
+    const double upper = bufferedRegion.GetIndex(d) + static_cast<double>(bufferedRegion.GetSize(d)) - 1.0 + margin;
+    const double origin = startIndex[d];
+    const double direction = vectorFromStartIndex[d];
+    if (direction == 0.0)
+    {
+      if (!(origin >= lower && origin < upper))
+      {
+        return { begin, begin };
+      }
+      continue;
+    }
+    const double scanlineIndex1 = firstIndex + (lower - origin) / direction * size;
+    const double scanlineIndex2 = firstIndex + (upper - origin) / direction * size;
+    spanBegin = std::max(spanBegin, std::ceil(std::min(scanlineIndex1, scanlineIndex2)));
+    spanEnd = std::min(spanEnd, std::floor(std::max(scanlineIndex1, scanlineIndex2)) + 1.0);
+  }
+  // Also when the line is not finite
+  if (!(spanBegin < spanEnd))
+  {
+    return { begin, begin };
+  }
+
+  // Rounding may put the estimated ends off by a pixel, so the ends are
+  // adjusted with the exact test of the pixels
+  const auto isInside = [&](const IndexValueType scanlineIndex) {
+    return this->IsInsideScanlineKernelDomain(
+      Self::ComputeScanlineInputIndex(startIndex, vectorFromStartIndex, firstIndex, size, scanlineIndex));
+  };
+  auto first = static_cast<IndexValueType>(spanBegin);
+  auto last = static_cast<IndexValueType>(spanEnd);
+  while (first < last && !isInside(first))
+  {
+    ++first;
+  }
+  while (first < last && !isInside(last - 1))
+  {
+    --last;
+  }
+  if (first == last)
+  {
+    return { begin, begin };
+  }
+  while (first > begin && isInside(first - 1))
+  {
+    --first;
+  }
+  while (last < end && isInside(last))
+  {
+    ++last;
+  }
+  return { first, last };
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ScanlineKernelResample(const ContinuousInputIndexType &  startIndex,
+                         const ContinuousInputVectorType & vectorFromStartIndex,
+                         const IndexValueType              firstIndex,
+                         const double                      size,
+                         const IndexValueType              begin,
+                         const IndexValueType              end,
+                         PixelType *                       outputBuffer) const
+{
+  using CoordinateType = TInterpolatorPrecisionType;
+  using RealType = typename NumericTraits<InputPixelType>::RealType;
+
+  if (m_ScanlineKernel == ScanlineKernelEnum::Batched)
+  {
+    // Number of continuous indices passed to the interpolator at once
+    constexpr IndexValueType batchLength = 64;
+
+    ContinuousInputIndexType              inputIndices[batchLength];
+    typename InterpolatorType::OutputType values[batchLength];
+    for (IndexValueType batchBegin = begin; batchBegin < end; batchBegin += batchLength)
+    {
+      const IndexValueType length = std::min(batchLength, end - batchBegin);
+      for (IndexValueType j = 0; j < length; ++j)
+      {
+        inputIndices[j] =
+          Self::ComputeScanlineInputIndex(startIndex, vectorFromStartIndex, firstIndex, size, batchBegin + j);
+      }
+      m_Interpolator->EvaluateAtContinuousIndices(inputIndices, values, static_cast<SizeValueType>(length));
+
+      PixelType * const batchOutput = outputBuffer + (batchBegin - begin);
+      for (IndexValueType j = 0; j < length; ++j)
+      {
+        batchOutput[j] = Self::CastPixelWithBoundsChecking(values[j]);
+      }
+    }
+    return;
+  }
+
+  // Number of pixels whose neighbors are gathered at once
+  constexpr IndexValueType blockLength = 16;
+
+  const InputImageType * const inputPtr = this->GetInput();
+  const InputPixelType * const inputBuffer = inputPtr->GetBufferPointer();
+  const auto &                 bufferStart = inputPtr->GetBufferedRegion().GetIndex();
+  const OffsetValueType *      offsetTable = inputPtr->GetOffsetTable();
+
+  OffsetValueType offsets[blockLength];
+  CoordinateType  distances[InputImageDimension][blockLength];
+  RealType        values[blockLength];
+
+  for (IndexValueType blockBegin = begin; blockBegin < end; blockBegin += blockLength)
+  {
+    const IndexValueType length = std::min(blockLength, end - blockBegin);
+
+    // The continuous indices are computed as by ComputeScanlineInputIndex(),
+    // one axis at a time for all the pixels of the block
+    std::fill_n(offsets, length, OffsetValueType{ 0 });
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      const CoordinateType origin = startIndex[d];
+      const CoordinateType direction = vectorFromStartIndex[d];
+      const OffsetValueType stride = offsetTable[d];
+      for (IndexValueType j = 0; j < length; ++j)
+      {
+        const double   alpha = (blockBegin + j - firstIndex) / size;
+        CoordinateType x = origin;
+        x += alpha * direction;
+        if (m_ScanlineKernel == ScanlineKernelEnum::Linear)
+        {
+          const IndexValueType base = Math::Floor<IndexValueType>(x);
+          distances[d][j] = x - static_cast<CoordinateType>(base);
+          offsets[j] += (base - bufferStart[d]) * stride;
+        }
+        else
+        {
+          offsets[j] += (Math::Round<IndexValueType>(x) - bufferStart[d]) * stride;
+        }
+      }
+    }
+
+    // Linear interpolation uses all the neighbors, with the operations of
+    // LinearInterpolateImageFunction, which skips those at a zero distance
+    // but gets the same values
+    if (m_ScanlineKernel == ScanlineKernelEnum::NearestNeighbor)
+    {
+      for (IndexValueType j = 0; j < length; ++j)
+      {
+        values[j] = static_cast<RealType>(inputBuffer[offsets[j]]);
+      }
+    }
+    else if constexpr (InputImageDimension == 1)
+    {
+      for (IndexValueType j = 0; j < length; ++j)
+      {
+        const InputPixelType * const pixel = inputBuffer + offsets[j];
+        const RealType               val0 = pixel[0];
+        const RealType               val1 = pixel[1];
+        values[j] = val0 + (val1 - val0) * distances[0][j];
+      }
+    }
+    else if constexpr (InputImageDimension == 2)
+    {
+      const OffsetValueType stride1 = offsetTable[1];
+      for (IndexValueType j = 0; j < length; ++j)
+      {
+        const InputPixelType * const pixel = inputBuffer + offsets[j];
+        const RealType               val00 = pixel[0];
+        const RealType               val10 = pixel[1];
+        const RealType               val01 = pixel[stride1];
+        const RealType               val11 = pixel[stride1 + 1];
+        const RealType               valx0 = val00 + (val10 - val00) * distances[0][j];
+        const RealType               valx1 = val01 + (val11 - val01) * distances[0][j];
+        values[j] = valx0 + (valx1 - valx0) * distances[1][j];
+      }
+    }
+    else if constexpr (InputImageDimension == 3)
+    {
+      const OffsetValueType stride1 = offsetTable[1];
+      const OffsetValueType stride2 = offsetTable[2];
+      for (IndexValueType j = 0; j < length; ++j)
+      {
+        const InputPixelType * const pixel = inputBuffer + offsets[j];
+        const RealType               val000 = pixel[0];
+        const RealType               val100 = pixel[1];
+        const RealType               val010 = pixel[stride1];
+        const RealType               val110 = pixel[stride1 + 1];
+        const RealType               val001 = pixel[stride2];
+        const RealType               val101 = pixel[stride2 + 1];
+        const RealType               val011 = pixel[stride2 + stride1];
+        const RealType               val111 = pixel[stride2 + stride1 + 1];
+        const RealType               valx00 = val000 + (val100 - val000) * distances[0][j];
+        const RealType               valx10 = val010 + (val110 - val010) * distances[0][j];
+        const RealType               valxx0 = valx00 + (valx10 - valx00) * distances[1][j];
+        const RealType               valx01 = val001 + (val101 - val001) * distances[0][j];
+        const RealType               valx11 = val011 + (val111 - val011) * distances[0][j];
+        const RealType               valxx1 = valx01 + (valx11 - valx01) * distances[1][j];
+        values[j] = valxx0 + (valxx1 - valxx0) * distances[2][j];
+      }
+    }
+
+    PixelType * const blockOutput = outputBuffer + (blockBegin - begin);
+    for (IndexValueType j = 0; j < length; ++j)
+    {
+      blockOutput[j] = Self::CastPixelWithBoundsChecking(static_cast<ComponentType>(values[j]));
+    }
+  }
+}
+
 template <typename TInputImage,
           typename TOutputImage,
           typename TInterpolatorPrecisionType,
@@ -669,6 +1042,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   os << indent << "Interpolator: " << m_Interpolator.GetPointer() << std::endl;
   os << indent << "Extrapolator: " << m_Extrapolator.GetPointer() << std::endl;
   itkPrintSelfBooleanMacro(UseReferenceImage);
+  itkPrintSelfBooleanMacro(UseBatchedInterpolation);
 }
 } // end namespace itk
 
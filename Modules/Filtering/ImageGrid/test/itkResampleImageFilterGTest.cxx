@@ -20,19 +20,24 @@
 #include "itkResampleImageFilter.h"
 
 #include "itkAffineTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
 #include "itkCastImageFilter.h"
 #include "itkGaussianInterpolateImageFunction.h"
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 #include "itkStreamingImageFilter.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
 
 // Standard C++ header files:
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <random>
+#include <type_traits>
 
 
 namespace
@@ -117,6 +122,169 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// Interpolators that are not exactly LinearInterpolateImageFunction or
+// NearestNeighborInterpolateImageFunction, so that ResampleImageFilter
+// evaluates them for each pixel instead of using its scanline kernel.
+template <typename TImage>
+class ReferenceLinearInterpolator : public itk::LinearInterpolateImageFunction<TImage>
+{
+public:
+  using Self = ReferenceLinearInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+};
+
+template <typename TImage>
+class ReferenceNearestNeighborInterpolator : public itk::NearestNeighborInterpolateImageFunction<TImage>
+{
+public:
+  using Self = ReferenceNearestNeighborInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+};
+
+// A BSpline interpolator that evaluates the continuous indices one at a time.
+template <typename TImage>
+class ReferenceBSplineInterpolator : public itk::BSplineInterpolateImageFunction<TImage>
+{
+public:
+  using Self = ReferenceBSplineInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+
+  using typename itk::BSplineInterpolateImageFunction<TImage>::ContinuousIndexType;
+  using typename itk::BSplineInterpolateImageFunction<TImage>::OutputType;
+
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              itk::SizeValueType          numberOfIndices) const override
+  {
+    itk::InterpolateImageFunction<TImage>::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+  }
+};
+
+
+// Tests that resampling with the scanline kernel of ResampleImageFilter
+// gives exactly the values of the interpolator, for affine transforms that
+// map the output image partially outside of the input image.
+template <typename TPixel, unsigned int VDimension>
+void
+Expect_scanline_kernel_gives_interpolator_values()
+{
+  using ImageType = itk::Image<TPixel, VDimension>;
+  using FilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+  using TransformType = itk::AffineTransform<double, VDimension>;
+
+  std::mt19937 randomNumberEngine(42);
+
+  auto                          input = ImageType::New();
+  typename ImageType::IndexType inputIndex;
+  typename ImageType::SizeType  inputSize;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    inputIndex[d] = static_cast<itk::IndexValueType>(d) - 2;
+    inputSize[d] = 13 - 2 * d;
+  }
+  input->SetRegions(typename ImageType::RegionType(inputIndex, inputSize));
+  input->Allocate();
+  std::uniform_real_distribution<double> valueDistribution(
+    std::max(static_cast<double>(std::numeric_limits<TPixel>::lowest()), -1.0e6),
+    std::min(static_cast<double>(std::numeric_limits<TPixel>::max()), 1.0e6));
+  for (itk::ImageRegionIterator<ImageType> it(input, input->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<TPixel>(valueDistribution(randomNumberEngine)));
+  }
+
+  std::vector<typename TransformType::Pointer> transforms;
+  // The identity and an integer translation map pixels onto pixels
+  transforms.push_back(TransformType::New());
+  transforms.push_back(TransformType::New());
+  transforms.back()->Translate(itk::MakeFilled<typename TransformType::OutputVectorType>(3.0));
+  std::uniform_real_distribution<double> matrixDistribution(-0.4, 0.4);
+  std::uniform_real_distribution<double> offsetDistribution(-4.0, 4.0);
+  for (int i = 0; i < 8; ++i)
+  {
+    auto                                     transform = TransformType::New();
+    typename TransformType::MatrixType       matrix;
+    typename TransformType::OutputVectorType translation;
+    for (unsigned int row = 0; row < VDimension; ++row)
+    {
+      for (unsigned int column = 0; column < VDimension; ++column)
+      {
+        matrix[row][column] = (row == column ? 1.0 : 0.0) + matrixDistribution(randomNumberEngine);
+      }
+      translation[row] = offsetDistribution(randomNumberEngine);
+    }
+    transform->SetMatrix(matrix);
+    transform->SetTranslation(translation);
+    transforms.push_back(transform);
+  }
+
+  const auto resample = [input](const TransformType *                     transform,
+                                typename FilterType::InterpolatorType * interpolator,
+                                bool                                    useBatchedInterpolation = false) {
+    const auto filter = FilterType::New();
+    filter->SetUseBatchedInterpolation(useBatchedInterpolation);
+    filter->SetInput(input);
+    filter->SetTransform(transform);
+    filter->SetInterpolator(interpolator);
+    filter->SetDefaultPixelValue(static_cast<TPixel>(7));
+    filter->SetOutputStartIndex(itk::MakeFilled<typename ImageType::IndexType>(-4));
+    filter->SetSize(itk::MakeFilled<typename ImageType::SizeType>(19));
+    filter->Update();
+    return typename ImageType::Pointer(filter->GetOutput());
+  };
+  const auto expectSamePixels = [](const ImageType * image1, const ImageType * image2) {
+    const itk::SizeValueType numberOfPixels = image1->GetBufferedRegion().GetNumberOfPixels();
+    EXPECT_TRUE(std::equal(image1->GetBufferPointer(),
+                           image1->GetBufferPointer() + numberOfPixels,
+                           image2->GetBufferPointer(),
+                           image2->GetBufferPointer() + image2->GetBufferedRegion().GetNumberOfPixels()));
+  };
+
+  for (const auto & transform : transforms)
+  {
+    expectSamePixels(resample(transform, itk::LinearInterpolateImageFunction<ImageType>::New()),
+                     resample(transform, ReferenceLinearInterpolator<ImageType>::New()));
+    expectSamePixels(resample(transform, itk::NearestNeighborInterpolateImageFunction<ImageType>::New()),
+                     resample(transform, ReferenceNearestNeighborInterpolator<ImageType>::New()));
+
+    for (const unsigned int splineOrder : { 1, 3 })
+    {
+      const auto interpolator = itk::BSplineInterpolateImageFunction<ImageType>::New();
+      const auto referenceInterpolator = ReferenceBSplineInterpolator<ImageType>::New();
+      interpolator->SetSplineOrder(splineOrder);
+      referenceInterpolator->SetSplineOrder(splineOrder);
+
+      // By default, every pixel is evaluated on its own, as before batched
+      // interpolation was added
+      const auto referenceImage = resample(transform, referenceInterpolator);
+      expectSamePixels(resample(transform, interpolator), referenceImage);
+      expectSamePixels(resample(transform, referenceInterpolator, true), referenceImage);
+
+      // BSplineInterpolateImageFunction sums the weighted coefficients in
+      // another order when it evaluates a block of indices, which it is only
+      // given for scanlines along the first axis
+      const auto image = resample(transform, interpolator, true);
+      if (VDimension > 1 && transform->GetMatrix() != TransformType::New()->GetMatrix())
+      {
+        expectSamePixels(image, referenceImage);
+      }
+      else if constexpr (std::is_floating_point_v<TPixel>)
+      {
+        for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+        {
+          EXPECT_NEAR(image->GetBufferPointer()[i],
+                      referenceImage->GetBufferPointer()[i],
+                      1e-5 * std::abs(referenceImage->GetBufferPointer()[i]) + 1e-5);
+        }
+      }
+    }
+  }
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -241,3 +409,16 @@ TEST(ResampleImageFilter, StreamingMatchesNonStreamedWithGaussianInterpolator)
   }
   EXPECT_EQ(itU.IsAtEnd(), itS.IsAtEnd());
 }
+
+
+TEST(ResampleImageFilter, ScanlineKernelGivesInterpolatorValues)
+{
+  Expect_scanline_kernel_gives_interpolator_values<unsigned char, 1>();
+  Expect_scanline_kernel_gives_interpolator_values<unsigned char, 2>();
+  Expect_scanline_kernel_gives_interpolator_values<short, 2>();
+  Expect_scanline_kernel_gives_interpolator_values<short, 3>();
+  Expect_scanline_kernel_gives_interpolator_values<float, 2>();
+  Expect_scanline_kernel_gives_interpolator_values<float, 3>();
+  Expect_scanline_kernel_gives_interpolator_values<double, 3>();
+  Expect_scanline_kernel_gives_interpolator_values<int, 4>();
+}
@@ -20,6 +20,8 @@
 
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkSymmetricEigenAnalysis.h"
+#include "itkSymmetricEigenAnalysis3DBatch.h"
+#include "itkSymmetricSecondRankTensor.h"
 #include "ITKImageIntensityExport.h"
 
 namespace itk
@@ -183,6 +185,19 @@ public:
       m_Calculator.SetOrderEigenValues(false);
     }
   }
+  [[nodiscard]] EigenValueOrderEnum
+  GetOrderEigenValuesBy() const
+  {
+    if (m_Calculator.GetOrderEigenMagnitudes())
+    {
+      return EigenValueOrderEnum::OrderByMagnitude;
+    }
+    if (m_Calculator.GetOrderEigenValues())
+    {
+      return EigenValueOrderEnum::OrderByValue;
+    }
+    return EigenValueOrderEnum::DoNotOrder;
+  }
 
 private:
   CalculatorType m_Calculator;
@@ -208,6 +223,10 @@ extern ITKImageIntensity_EXPORT std::ostream &
  * OrderByMagnitude:  |lambda_1| < |lambda_2| < .....
  * DoNotOrder:        Default order of eigen values obtained after QL method
  *
+ * When the pixels are 3x3 SymmetricSecondRankTensor and the eigen values are
+ * ordered, the pixels of each scanline are solved by batches with
+ * SymmetricEigenAnalysis3DBatch instead of one by one.
+ *
  * \ingroup IntensityImageFilters  MultiThreaded  TensorObjects
  *
  * \ingroup ITKImageIntensity
@@ -233,6 +252,7 @@ public:
   using ConstPointer = SmartPointer<const Self>;
 
   using typename Superclass::OutputImageType;
+  using typename Superclass::OutputImageRegionType;
   using OutputPixelType = typename TOutputImage::PixelType;
   using InputPixelType = typename TInputImage::PixelType;
   using InputValueType = typename InputPixelType::ValueType;
@@ -296,6 +316,9 @@ public:
 protected:
   SymmetricEigenAnalysisImageFilter() { this->SetDimension(TInputImage::ImageDimension); }
   ~SymmetricEigenAnalysisImageFilter() override = default;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 };
 
 /**
@@ -312,6 +335,10 @@ protected:
  * OrderByMagnitude:  |lambda_1| < |lambda_2| < .....
  * DoNotOrder:        Default order of eigen values obtained after QL method
  *
+ * When the pixels are 3x3 SymmetricSecondRankTensor, the pixels of each
+ * scanline are solved by batches with SymmetricEigenAnalysis3DBatch instead
+ * of one by one.
+ *
  * \ingroup IntensityImageFilters  MultiThreaded  TensorObjects
  *
  * \ingroup ITKImageIntensity
@@ -341,6 +368,7 @@ public:
   using ConstPointer = SmartPointer<const Self>;
 
   using typename Superclass::OutputImageType;
+  using typename Superclass::OutputImageRegionType;
   using OutputPixelType = typename TOutputImage::PixelType;
   using InputPixelType = typename TInputImage::PixelType;
   using InputValueType = typename InputPixelType::ValueType;
@@ -382,7 +410,14 @@ public:
 protected:
   SymmetricEigenAnalysisFixedDimensionImageFilter() = default;
   ~SymmetricEigenAnalysisFixedDimensionImageFilter() override = default;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 };
 } // end namespace itk
 
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSymmetricEigenAnalysisImageFilter.hxx"
+#endif
+
 #endif
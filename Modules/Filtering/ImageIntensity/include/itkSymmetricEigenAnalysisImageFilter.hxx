@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysisImageFilter_hxx
+#define itkSymmetricEigenAnalysisImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkTotalProgressReporter.h"
+
+#include <type_traits>
+
+namespace itk
+{
+namespace detail
+{
+/** Compute the eigen values of the 3x3 symmetric matrix pixels of a region,
+ * by batches along the scanlines. */
+template <typename TInputImage, typename TOutputImage>
+void
+ComputeEigenValuesOfScanlinesByBatches(const TInputImage *                       input,
+                                       const typename TInputImage::RegionType &  inputRegion,
+                                       TOutputImage *                            output,
+                                       const typename TOutputImage::RegionType & outputRegion,
+                                       SymmetricEigenAnalysis3DBatch<double> &   calculator,
+                                       TotalProgressReporter &                   progress)
+{
+  ImageScanlineConstIterator<TInputImage> it(input, inputRegion);
+  ImageScanlineIterator<TOutputImage>     oit(output, outputRegion);
+
+  while (!it.IsAtEnd())
+  {
+    while (!it.IsAtEndOfLine())
+    {
+      unsigned int numberOfPixels = 0;
+      for (; numberOfPixels < calculator.BatchSize && !it.IsAtEndOfLine(); ++numberOfPixels, ++it)
+      {
+        calculator.SetMatrix(numberOfPixels, it.Get());
+      }
+      calculator.ComputeEigenValues(numberOfPixels);
+      for (unsigned int i = 0; i < numberOfPixels; ++i, ++oit)
+      {
+        typename TOutputImage::PixelType eigenValues;
+        calculator.GetEigenValues(i, eigenValues);
+        oit.Set(eigenValues);
+      }
+    }
+    it.NextLine();
+    oit.NextLine();
+    progress.Completed(outputRegion.GetSize(0));
+  }
+}
+} // end namespace detail
+
+template <typename TInputImage, typename TOutputImage>
+void
+SymmetricEigenAnalysisImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  // the order of the eigen values computed without ordering is specific to
+  // the QL method, so that case is left to the functor
+  if constexpr (std::is_same_v<InputPixelType, SymmetricSecondRankTensor<InputValueType, 3>>)
+  {
+    const EigenValueOrderEnum order = this->GetOrderEigenValuesBy();
+    if (this->GetDimension() == 3 && order != EigenValueOrderEnum::DoNotOrder)
+    {
+      SymmetricEigenAnalysis3DBatch<double> calculator;
+      calculator.SetOrderEigenMagnitudes(order == EigenValueOrderEnum::OrderByMagnitude);
+
+      typename TInputImage::RegionType inputRegionForThread;
+      this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+      TotalProgressReporter progress(this, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels());
+      detail::ComputeEigenValuesOfScanlinesByBatches(
+        this->GetInput(), inputRegionForThread, this->GetOutput(), outputRegionForThread, calculator, progress);
+      return;
+    }
+  }
+  Superclass::DynamicThreadedGenerateData(outputRegionForThread);
+}
+
+template <unsigned int TMatrixDimension, typename TInputImage, typename TOutputImage>
+void
+SymmetricEigenAnalysisFixedDimensionImageFilter<TMatrixDimension, TInputImage, TOutputImage>::
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  if constexpr (TMatrixDimension == 3 && std::is_same_v<InputPixelType, SymmetricSecondRankTensor<InputValueType, 3>>)
+  {
+    // like SymmetricEigenAnalysisFixedDimension, the batch keeps the
+    // ascending order when the eigen values are not ordered
+    SymmetricEigenAnalysis3DBatch<double> calculator;
+    calculator.SetOrderEigenMagnitudes(this->GetFunctor().GetOrderEigenValuesBy() ==
+                                       EigenValueOrderEnum::OrderByMagnitude);
+
+    typename TInputImage::RegionType inputRegionForThread;
+    this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+    TotalProgressReporter progress(this, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels());
+    detail::ComputeEigenValuesOfScanlinesByBatches(
+      this->GetInput(), inputRegionForThread, this->GetOutput(), outputRegionForThread, calculator, progress);
+  }
+  else
+  {
+    Superclass::DynamicThreadedGenerateData(outputRegionForThread);
+  }
+}
+} // end namespace itk
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkConstShapedNeighborhoodIterator.h"
+#include <algorithm>
 #include <atomic>
 #include <deque>
 #include <functional>
@@ -130,7 +131,9 @@ protected:
 
   using LineMapType = std::vector<LineEncodingType>;
 
-  using UnionFindType = std::vector<InternalLabelType>;
+  /** The parent of each label. The sets are merged with atomic operations,
+   * so that the threads link the labels without locking. */
+  using UnionFindType = std::vector<std::atomic<InternalLabelType>>;
   using ConsecutiveVectorType = std::vector<OutputPixelType>;
 
   SizeValueType
@@ -149,32 +152,73 @@ protected:
     return linearIndex;
   }
 
+  /** Split [0, size) in consecutive chunks, one per work unit of the
+   * enclosing filter, and call func(chunk, first, last) on them in parallel. */
+  template <typename TFunction>
+  SizeValueType
+  ParallelizeChunks(SizeValueType size, TFunction func)
+  {
+    const SizeValueType numberOfChunks =
+      std::max<SizeValueType>(1, std::min<SizeValueType>(size, m_EnclosingFilter->GetNumberOfWorkUnits()));
+    m_EnclosingFilter->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [size, numberOfChunks, &func](SizeValueType chunk) {
+        func(chunk, size * chunk / numberOfChunks, size * (chunk + 1) / numberOfChunks);
+      },
+      nullptr);
+    return numberOfChunks;
+  }
+
   void
   InitUnion(InternalLabelType numberOfLabels)
   {
     m_UnionFind = UnionFindType(numberOfLabels + 1);
+    m_UnionFind[0].store(0, std::memory_order_relaxed);
+
+    // the runs are labeled in the order of the lines: count the runs of each
+    // chunk of lines, then label the chunks in parallel from the prefix sums
+    const auto                 lineCount = static_cast<SizeValueType>(m_LineMap.size());
+    std::vector<SizeValueType> firstLabels(m_EnclosingFilter->GetNumberOfWorkUnits() + 1, 0);
+    const auto countRuns = [this, &firstLabels](SizeValueType chunk, SizeValueType first, SizeValueType last) {
+      SizeValueType count = 0;
+      for (SizeValueType line = first; line < last; ++line)
+      {
+        count += static_cast<SizeValueType>(m_LineMap[line].size());
+      }
+      firstLabels[chunk + 1] = count;
+    };
+    const SizeValueType numberOfChunks = this->ParallelizeChunks(lineCount, countRuns);
 
-    const auto        MapBegin = m_LineMap.begin();
-    const auto        MapEnd = m_LineMap.end();
-    InternalLabelType label = 1;
-    for (typename LineMapType::iterator LineIt = MapBegin; LineIt != MapEnd; ++LineIt)
+    firstLabels[0] = 1;
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
     {
-      for (auto cIt = LineIt->begin(); cIt != LineIt->end(); ++cIt)
+      firstLabels[chunk + 1] += firstLabels[chunk];
+    }
+
+    const auto labelRuns = [this, &firstLabels](SizeValueType chunk, SizeValueType first, SizeValueType last) {
+      InternalLabelType label = firstLabels[chunk];
+      for (SizeValueType line = first; line < last; ++line)
       {
-        cIt->label = label;
-        m_UnionFind[label] = label;
-        ++label;
+        for (auto & run : m_LineMap[line])
+        {
+          run.label = label;
+          m_UnionFind[label].store(label, std::memory_order_relaxed);
+          ++label;
+        }
       }
-    }
+    };
+    this->ParallelizeChunks(lineCount, labelRuns);
   }
 
   InternalLabelType
-  LookupSet(const InternalLabelType label)
+  LookupSet(const InternalLabelType label) const
   {
     InternalLabelType l = label;
-    while (l != m_UnionFind[l])
+    for (InternalLabelType parent = m_UnionFind[l].load(std::memory_order_relaxed); l != parent;
+         parent = m_UnionFind[l].load(std::memory_order_relaxed))
     {
-      l = m_UnionFind[l]; // transitively sets equivalence
+      l = parent; // transitively sets equivalence
     }
     return l;
   }
@@ -182,46 +226,86 @@ protected:
   void
   LinkLabels(const InternalLabelType label1, const InternalLabelType label2)
   {
-    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
-    const InternalLabelType           E1 = this->LookupSet(label1);
-    const InternalLabelType           E2 = this->LookupSet(label2);
-
-    if (E1 < E2)
-    {
-      m_UnionFind[E2] = E1;
-    }
-    else
+    // The root of a set is always linked to a smaller root, so the root of
+    // each set is its smallest label, whatever the order of the links made
+    // by the threads. When another thread links the root first, the
+    // compare-and-swap fails and the roots are looked up again.
+    InternalLabelType E1 = label1;
+    InternalLabelType E2 = label2;
+    while (true)
     {
-      m_UnionFind[E1] = E2;
+      E1 = this->LookupSet(E1);
+      E2 = this->LookupSet(E2);
+      if (E1 == E2)
+      {
+        return;
+      }
+      if (E1 < E2)
+      {
+        std::swap(E1, E2);
+      }
+      InternalLabelType expected = E1;
+      if (m_UnionFind[E1].compare_exchange_weak(expected, E2, std::memory_order_relaxed))
+      {
+        return;
+      }
     }
   }
 
   SizeValueType
   CreateConsecutive(OutputPixelType backgroundValue)
   {
-    const size_t N = m_UnionFind.size();
+    const auto N = static_cast<SizeValueType>(m_UnionFind.size());
 
     m_Consecutive = ConsecutiveVectorType(N);
     m_Consecutive[0] = backgroundValue;
+    if (N < 2)
+    {
+      return 0;
+    }
 
-    OutputPixelType consecutiveLabel = 0;
-    SizeValueType   count = 0;
+    // flatten the sets, so that each label refers directly to its root, and
+    // count the roots of each chunk of labels
+    std::vector<SizeValueType> firstConsecutive(m_EnclosingFilter->GetNumberOfWorkUnits() + 1, 0);
+    const auto flattenSets = [this, &firstConsecutive](SizeValueType chunk, SizeValueType first, SizeValueType last) {
+      SizeValueType count = 0;
+      for (SizeValueType i = first + 1; i <= last; ++i)
+      {
+        const InternalLabelType root = this->LookupSet(i);
+        m_UnionFind[i].store(root, std::memory_order_relaxed);
+        count += (root == i);
+      }
+      firstConsecutive[chunk + 1] = count;
+    };
+    const SizeValueType numberOfChunks = this->ParallelizeChunks(N - 1, flattenSets);
 
-    for (size_t i = 1; i < N; ++i)
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
     {
-      const auto label = static_cast<size_t>(m_UnionFind[i]);
-      if (label == i)
+      firstConsecutive[chunk + 1] += firstConsecutive[chunk];
+    }
+
+    // the roots are numbered consecutively in increasing order, skipping
+    // the background value
+    const bool skipBackground =
+      NumericTraits<OutputPixelType>::IsNonnegative(backgroundValue) &&
+      static_cast<OutputPixelType>(static_cast<SizeValueType>(backgroundValue)) == backgroundValue;
+    const SizeValueType background = skipBackground ? static_cast<SizeValueType>(backgroundValue) : 0;
+
+    const auto numberRoots = [&](SizeValueType chunk, SizeValueType first, SizeValueType last) {
+      SizeValueType consecutive = firstConsecutive[chunk];
+      for (SizeValueType i = first + 1; i <= last; ++i)
       {
-        if (consecutiveLabel == backgroundValue)
+        if (m_UnionFind[i].load(std::memory_order_relaxed) == i)
         {
-          ++consecutiveLabel;
+          const SizeValueType consecutiveLabel =
+            (skipBackground && consecutive >= background) ? consecutive + 1 : consecutive;
+          m_Consecutive[i] = static_cast<OutputPixelType>(consecutiveLabel);
+          ++consecutive;
         }
-        m_Consecutive[label] = consecutiveLabel;
-        ++consecutiveLabel;
-        ++count;
       }
-    }
-    return count;
+    };
+    this->ParallelizeChunks(N - 1, numberRoots);
+    return firstConsecutive[numberOfChunks];
   }
 
   bool
@@ -460,14 +544,17 @@ protected:
   {
     const OffsetValueType linecount = m_LineMap.size();
     const WorkUnitData    wud = m_WorkUnitResults[workUnitResultsIndex];
+    SizeValueType         firstLine = wud.firstLine;
     SizeValueType         lastLine = wud.lastLine;
     if (!strictlyLess)
     {
+      // the other lines were compared in the strictly less pass
+      firstLine = wud.lastLine;
       ++lastLine;
       // make sure we are not wrapping around
       itkAssertInDebugAndIgnoreInReleaseMacro(lastLine >= wud.lastLine);
     }
-    for (SizeValueType thisIdx = wud.firstLine; thisIdx < lastLine; ++thisIdx)
+    for (SizeValueType thisIdx = firstLine; thisIdx < lastLine; ++thisIdx)
     {
       if (!m_LineMap[thisIdx].empty())
       {
@@ -31,6 +31,10 @@ namespace itk
  * LabelImageToLabelMapFilter converts a label image to a label collection image.
  * The labels are the same in the input and the output image.
  *
+ * With UseLineArenaOn(), the lines of all the label objects are stored in a
+ * single LabelObjectLineArena instead of a container per object, which avoids
+ * most of the memory allocations when the image has many labels.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -72,6 +76,7 @@ public:
   using OutputImagePixelType = typename OutputImageType::PixelType;
   using LabelObjectType = typename OutputImageType::LabelObjectType;
   using LengthType = typename LabelObjectType::LengthType;
+  using LineType = typename LabelObjectType::LineType;
 
   /** ImageDimension constants */
   static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
@@ -91,6 +96,20 @@ public:
   itkSetMacro(BackgroundValue, OutputImagePixelType);
   itkGetConstMacro(BackgroundValue, OutputImagePixelType);
   /** @ITKEndGrouping */
+
+  /**
+   * Set/Get whether the lines of the label objects are stored in a single
+   * LabelObjectLineArena, in the order of the labels, rather than in a
+   * container owned by each object. The label objects copy their lines out
+   * of the arena when they are modified, so the filters using the output
+   * are not affected by this setting. Defaults to false.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseLineArena, bool);
+  itkGetConstReferenceMacro(UseLineArena, bool);
+  itkBooleanMacro(UseLineArena);
+  /** @ITKEndGrouping */
+
   itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
 
 protected:
@@ -125,9 +144,18 @@ protected:
   AfterThreadedGenerateData() override;
 
 private:
+  /** Move the lines found by the threads to a single arena, and create the
+   * label objects referring to it. */
+  void
+  CreateLabelObjectsInLineArena();
+
   OutputImagePixelType m_BackgroundValue{};
+  bool                 m_UseLineArena{ false };
 
   typename std::vector<OutputImagePointer> m_TemporaryImages{};
+
+  /** The label and the line of the runs found by each thread, when using a line arena. */
+  std::vector<std::vector<std::pair<OutputImagePixelType, LineType>>> m_TemporaryRuns{};
 }; // end of class
 } // end namespace itk
 
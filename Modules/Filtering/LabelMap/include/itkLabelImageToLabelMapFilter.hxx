@@ -22,6 +22,9 @@
 #include "itkTotalProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
 #include "itkPrintHelper.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
 
 namespace itk
 {
@@ -59,6 +62,14 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelImageToLabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
+  if (m_UseLineArena)
+  {
+    // the runs found by the threads are only gathered in the output at the end
+    m_TemporaryRuns.resize(this->GetNumberOfWorkUnits());
+    this->GetOutput()->SetBackgroundValue(m_BackgroundValue);
+    return;
+  }
+
   // init the temp images - one per thread
   m_TemporaryImages.resize(this->GetNumberOfWorkUnits());
 
@@ -112,7 +123,14 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
           ++it;
         }
         // create the run length object to go in the vector
-        m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        if (m_UseLineArena)
+        {
+          m_TemporaryRuns[threadId].emplace_back(static_cast<OutputImagePixelType>(value), LineType(idx, length));
+        }
+        else
+        {
+          m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        }
       }
       else
       {
@@ -128,6 +146,12 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelImageToLabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
 {
+  if (m_UseLineArena)
+  {
+    this->CreateLabelObjectsInLineArena();
+    return;
+  }
+
   OutputImageType * output = this->GetOutput();
 
   // merge the lines from the temporary images in the output image
@@ -160,6 +184,81 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData
   m_TemporaryImages.clear();
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+LabelImageToLabelMapFilter<TInputImage, TOutputImage>::CreateLabelObjectsInLineArena()
+{
+  using LineArenaType = typename LabelObjectType::LineArenaType;
+
+  // find the labels and count their lines, with a hash table giving the
+  // position of each label in the flat tables of labels and line counts
+  std::unordered_map<OutputImagePixelType, SizeValueType> labelPositions;
+  std::vector<OutputImagePixelType>                       labels;
+  std::vector<SizeValueType>                              numberOfLines;
+  std::vector<SizeValueType>                              runPositions;
+  SizeValueType                                           numberOfRuns = 0;
+  for (const auto & runs : m_TemporaryRuns)
+  {
+    numberOfRuns += static_cast<SizeValueType>(runs.size());
+  }
+  runPositions.reserve(numberOfRuns);
+  for (const auto & runs : m_TemporaryRuns)
+  {
+    for (const auto & run : runs)
+    {
+      const auto [labelPosition, isNewLabel] =
+        labelPositions.try_emplace(run.first, static_cast<SizeValueType>(labels.size()));
+      if (isNewLabel)
+      {
+        labels.push_back(run.first);
+        numberOfLines.push_back(0);
+      }
+      ++numberOfLines[labelPosition->second];
+      runPositions.push_back(labelPosition->second);
+    }
+  }
+
+  // the lines of the objects are stored in the order of the labels
+  std::vector<SizeValueType> labelOrder(labels.size());
+  std::iota(labelOrder.begin(), labelOrder.end(), SizeValueType{ 0 });
+  std::sort(labelOrder.begin(), labelOrder.end(), [&labels](const SizeValueType a, const SizeValueType b) {
+    return labels[a] < labels[b];
+  });
+  std::vector<SizeValueType> firstLines(labels.size());
+  SizeValueType              firstLine = 0;
+  for (const SizeValueType labelPosition : labelOrder)
+  {
+    firstLines[labelPosition] = firstLine;
+    firstLine += numberOfLines[labelPosition];
+  }
+
+  // the threads processed consecutive regions, so the lines of each object
+  // stay in raster order, like those of the objects built without the arena
+  const auto arena = LineArenaType::New();
+  auto &     lines = arena->GetLineContainer();
+  lines.resize(numberOfRuns);
+  std::vector<SizeValueType> nextLines(firstLines);
+  auto                       runPosition = runPositions.cbegin();
+  for (auto & runs : m_TemporaryRuns)
+  {
+    for (const auto & run : runs)
+    {
+      lines[nextLines[*runPosition++]++] = run.second;
+    }
+    std::vector<std::pair<OutputImagePixelType, LineType>>().swap(runs);
+  }
+  m_TemporaryRuns.clear();
+
+  OutputImageType * output = this->GetOutput();
+  for (const SizeValueType labelPosition : labelOrder)
+  {
+    const auto labelObject = LabelObjectType::New();
+    labelObject->SetLabel(labels[labelPosition]);
+    labelObject->SetLineArena(arena, firstLines[labelPosition], numberOfLines[labelPosition]);
+    output->AddLabelObject(labelObject);
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 LabelImageToLabelMapFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -167,6 +266,7 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream &
   Superclass::PrintSelf(os, indent);
 
   print_helper::PrintNumericTrait(os, indent, "BackgroundValue", m_BackgroundValue);
+  itkPrintSelfBooleanMacro(UseLineArena);
 }
 } // end namespace itk
 #endif
@@ -127,6 +127,16 @@ public:
   itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
   itkBooleanMacro(ComputeOrientedBoundingBox);
   /** @ITKEndGrouping */
+  /**
+   * Set/Get whether the lines of the label objects are stored in a single
+   * LabelObjectLineArena. Default value is false.
+   * \sa LabelImageToLabelMapFilter::SetUseLineArena()
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseLineArena, bool);
+  itkGetConstReferenceMacro(UseLineArena, bool);
+  itkBooleanMacro(UseLineArena);
+  /** @ITKEndGrouping */
 
 protected:
   LabelImageToShapeLabelMapFilter();
@@ -153,6 +163,7 @@ private:
   bool                 m_ComputeFeretDiameter{};
   bool                 m_ComputePerimeter{};
   bool                 m_ComputeOrientedBoundingBox{};
+  bool                 m_UseLineArena{ false };
 }; // end of class
 } // end namespace itk
 
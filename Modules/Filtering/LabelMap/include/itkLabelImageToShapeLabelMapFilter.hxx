@@ -66,6 +66,7 @@ LabelImageToShapeLabelMapFilter<TInputImage, TOutputImage>::GenerateData()
   auto labelizer = LabelizerType::New();
   labelizer->SetInput(this->GetInput());
   labelizer->SetBackgroundValue(m_BackgroundValue);
+  labelizer->SetUseLineArena(m_UseLineArena);
   labelizer->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   progress->RegisterInternalFilter(labelizer, .5f);
 
@@ -92,6 +93,7 @@ LabelImageToShapeLabelMapFilter<TInputImage, TOutputImage>::PrintSelf(std::ostre
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
+  itkPrintSelfBooleanMacro(UseLineArena);
 }
 } // end namespace itk
 #endif
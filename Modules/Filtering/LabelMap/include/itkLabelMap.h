@@ -311,6 +311,17 @@ public:
   void
   Optimize();
 
+  /**
+   * Move the lines of all the label objects referenced in the LabelMap to a
+   * single LabelObjectLineArena, in the order of the labels. This releases the
+   * line containers of the objects and makes the traversal of the lines of
+   * the objects, as done by ShapeLabelMapFilter for example, cache friendly.
+   * The lines of an object are copied out of the arena the next time the
+   * object is modified.
+   */
+  void
+  PackLines();
+
   /**
    * \class ConstIterator
    * \brief A forward iterator over the LabelObjects of a LabelMap
@@ -370,7 +370,8 @@ LabelMap<TLabelObject>::AddLabelObject(LabelObjectType * labelObject)
 {
   itkAssertOrThrowMacro((labelObject != nullptr), "Input LabelObject can't be Null");
 
-  m_LabelObjectContainer[labelObject->GetLabel()] = labelObject;
+  // the hint makes the insertion of the labels in increasing order run in constant time
+  m_LabelObjectContainer.insert_or_assign(m_LabelObjectContainer.end(), labelObject->GetLabel(), labelObject);
   this->Modified();
 }
 
@@ -529,6 +530,34 @@ LabelMap<TLabelObject>::Optimize()
   this->Modified();
 }
 
+template <typename TLabelObject>
+void
+LabelMap<TLabelObject>::PackLines()
+{
+  using LineArenaType = typename LabelObjectType::LineArenaType;
+
+  SizeValueType numberOfLines = 0;
+  for (auto it = m_LabelObjectContainer.begin(); it != m_LabelObjectContainer.end(); ++it)
+  {
+    numberOfLines += it->second->GetNumberOfLines();
+  }
+
+  const auto arena = LineArenaType::New();
+  auto &     lines = arena->GetLineContainer();
+  lines.reserve(numberOfLines);
+  for (auto it = m_LabelObjectContainer.begin(); it != m_LabelObjectContainer.end(); ++it)
+  {
+    LabelObjectType * labelObject = it->second;
+    const auto        firstLine = static_cast<SizeValueType>(lines.size());
+    for (typename LabelObjectType::ConstLineIterator lit(labelObject); !lit.IsAtEnd(); ++lit)
+    {
+      lines.push_back(lit.GetLine());
+    }
+    labelObject->SetLineArena(arena, firstLine, static_cast<SizeValueType>(lines.size()) - firstLine);
+  }
+  this->Modified();
+}
+
 } // end namespace itk
 
 #endif
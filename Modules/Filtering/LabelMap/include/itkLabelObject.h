@@ -18,9 +18,10 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
+#include "itkLabelObjectLineArena.h"
 #include "itkWeakPointer.h"
 #include "itkObjectFactory.h"
 
@@ -43,6 +44,11 @@ namespace itk
  * All the subclasses of LabelObject have to reimplement the CopyAttributesFrom() and CopyAllFrom() method.
  * No need to reimplement CopyLinesFrom() since all derived class share the same type line data members.
  *
+ * The lines are either owned by the object, or stored in a LabelObjectLineArena
+ * shared with other objects (see SetLineArena()). The lines are copied out of
+ * the arena the first time the object is modified, so the methods of the
+ * class behave the same way with both storages.
+ *
  * The pixels locations belonging to the LabelObject can be obtained using:
    \code
    for(unsigned int pixelId = 0; pixelId < labelObject->Size(); pixelId++)
@@ -87,6 +93,7 @@ public:
   using LabelType = TLabel;
   using LineType = LabelObjectLine<VImageDimension>;
   using LengthType = typename LineType::LengthType;
+  using LineArenaType = LabelObjectLineArena<VImageDimension>;
   using AttributeType = unsigned int;
   using SizeValueType = itk::SizeValueType;
 
@@ -202,6 +209,25 @@ public:
   void
   Shift(OffsetType offset);
 
+  /**
+   * Use the \c numberOfLines lines of \c arena starting at \c firstLine as the
+   * lines of the object, instead of lines owned by the object. The arena is
+   * kept alive by the object, and the lines are copied out of the arena the
+   * first time the object is modified.
+   */
+  void
+  SetLineArena(const LineArenaType * arena, SizeValueType firstLine, SizeValueType numberOfLines);
+
+  /**
+   * Return the arena holding the lines of the object, or nullptr if the
+   * object owns its lines.
+   */
+  const LineArenaType *
+  GetLineArena() const
+  {
+    return m_LineArena.GetPointer();
+  }
+
   /**
    * \class ConstLineIterator
    * \brief A forward iterator over the lines of a LabelObject
@@ -213,8 +239,8 @@ public:
     ConstLineIterator() = default;
 
     ConstLineIterator(const Self * lo)
-      : m_Begin(lo->m_LineContainer.begin())
-      , m_End(lo->m_LineContainer.end())
+      : m_Begin(lo->GetLinesBegin())
+      , m_End(lo->GetLinesEnd())
     {
       m_Iterator = m_Begin;
     }
@@ -270,11 +296,9 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
-    using InternalIteratorType = typename LineContainerType::const_iterator;
-    InternalIteratorType m_Iterator;
-    InternalIteratorType m_Begin;
-    InternalIteratorType m_End;
+    const LineType * m_Iterator{};
+    const LineType * m_Begin{};
+    const LineType * m_End{};
   };
 
   /**
@@ -294,8 +318,8 @@ public:
     }
 
     ConstIndexIterator(const Self * lo)
-      : m_Begin(lo->m_LineContainer.begin())
-      , m_End(lo->m_LineContainer.end())
+      : m_Begin(lo->GetLinesBegin())
+      , m_End(lo->GetLinesEnd())
     {
       GoToBegin();
     }
@@ -360,8 +384,6 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
-    using InternalIteratorType = typename LineContainerType::const_iterator;
     void
     NextValidLine()
     {
@@ -376,10 +398,10 @@ public:
       }
     }
 
-    InternalIteratorType m_Iterator;
-    InternalIteratorType m_Begin;
-    InternalIteratorType m_End;
-    IndexType            m_Index;
+    const LineType * m_Iterator;
+    const LineType * m_Begin;
+    const LineType * m_End;
+    IndexType        m_Index;
   };
 
 protected:
@@ -388,10 +410,25 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  using LineContainerType = typename std::deque<LineType>;
+  using LineContainerType = typename std::vector<LineType>;
+
+  /** The lines of the object, in the arena or in m_LineContainer. */
+  /** @ITKStartGrouping */
+  const LineType *
+  GetLinesBegin() const;
+  const LineType *
+  GetLinesEnd() const;
+  /** @ITKEndGrouping */
+
+  /** Copy the lines out of the arena before the object is modified. */
+  void
+  DetachLinesFromArena();
 
-  LineContainerType m_LineContainer{};
-  LabelType         m_Label{};
+  LineContainerType                    m_LineContainer{};
+  typename LineArenaType::ConstPointer m_LineArena{};
+  SizeValueType                        m_FirstArenaLine{};
+  SizeValueType                        m_NumberOfArenaLines{};
+  LabelType                            m_Label{};
 };
 } // end namespace itk
 
@@ -82,9 +82,9 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::HasIndex(const IndexType & idx) const
 {
-  auto end = m_LineContainer.end();
+  const LineType * end = this->GetLinesEnd();
 
-  for (auto it = m_LineContainer.begin(); it != end; ++it)
+  for (const LineType * it = this->GetLinesBegin(); it != end; ++it)
   {
     if (it->HasIndex(idx))
     {
@@ -99,6 +99,8 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::RemoveIndex(const IndexType & idx)
 {
+  this->DetachLinesFromArena();
+
   auto it = m_LineContainer.begin();
 
   while (it != m_LineContainer.end())
@@ -153,6 +155,8 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::AddIndex(const IndexType & idx)
 {
+  this->DetachLinesFromArena();
+
   if (!m_LineContainer.empty())
   {
     // can we use the last line to add that index ?
@@ -186,6 +190,7 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::AddLine(const LineType & line)
 {
+  this->DetachLinesFromArena();
   m_LineContainer.push_back(line);
 }
 
@@ -193,6 +198,10 @@ template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetNumberOfLines() const -> SizeValueType
 {
+  if (m_LineArena)
+  {
+    return m_NumberOfArenaLines;
+  }
   return static_cast<LabelObject<TLabel, VImageDimension>::SizeValueType>(m_LineContainer.size());
 }
 
@@ -200,13 +209,14 @@ template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetLine(SizeValueType i) const -> const LineType &
 {
-  return m_LineContainer[i];
+  return this->GetLinesBegin()[i];
 }
 
 template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetLine(SizeValueType i) -> LineType &
 {
+  this->DetachLinesFromArena();
   return m_LineContainer[i];
 }
 
@@ -214,9 +224,10 @@ template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::Size() const -> SizeValueType
 {
-  int size = 0;
+  SizeValueType    size = 0;
+  const LineType * end = this->GetLinesEnd();
 
-  for (auto it = m_LineContainer.begin(); it != m_LineContainer.end(); ++it)
+  for (const LineType * it = this->GetLinesBegin(); it != end; ++it)
   {
     size += it->GetLength();
   }
@@ -227,7 +238,7 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::Empty() const
 {
-  return this->m_LineContainer.empty();
+  return this->GetNumberOfLines() == 0;
 }
 
 template <typename TLabel, unsigned int VImageDimension>
@@ -236,9 +247,9 @@ LabelObject<TLabel, VImageDimension>::GetIndex(SizeValueType offset) const -> In
 {
   SizeValueType o = offset;
 
-  auto it = this->m_LineContainer.begin();
+  const LineType * it = this->GetLinesBegin();
 
-  while (it != m_LineContainer.end())
+  while (it != this->GetLinesEnd())
   {
     const SizeValueType size = it->GetLength();
 
@@ -266,7 +277,7 @@ LabelObject<TLabel, VImageDimension>::CopyLinesFrom(const TSourceLabelObject * s
 {
   itkAssertOrThrowMacro((src != nullptr), "Null Pointer");
   // clear original lines and copy lines
-  m_LineContainer.clear();
+  this->Clear();
   for (size_t i = 0; i < src->GetNumberOfLines(); ++i)
   {
     this->AddLine(src->GetLine(static_cast<SizeValueType>(i)));
@@ -304,11 +315,11 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::Optimize()
 {
-  if (!m_LineContainer.empty())
+  if (!this->Empty())
   {
     // first copy the lines in another container and clear the current one
-    LineContainerType lineContainer = m_LineContainer;
-    m_LineContainer.clear();
+    LineContainerType lineContainer(this->GetLinesBegin(), this->GetLinesEnd());
+    this->Clear();
 
     // reorder the lines
     const typename Functor::LabelObjectLineComparator<LineType> comparator;
@@ -365,6 +376,7 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::Shift(OffsetType offset)
 {
+  this->DetachLinesFromArena();
   for (auto it = m_LineContainer.begin(); it != m_LineContainer.end(); ++it)
   {
     LineType & line = *it;
@@ -377,6 +389,54 @@ void
 LabelObject<TLabel, VImageDimension>::Clear()
 {
   m_LineContainer.clear();
+  m_LineArena = nullptr;
+  m_FirstArenaLine = 0;
+  m_NumberOfArenaLines = 0;
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+LabelObject<TLabel, VImageDimension>::SetLineArena(const LineArenaType * arena,
+                                                   SizeValueType         firstLine,
+                                                   SizeValueType         numberOfLines)
+{
+  itkAssertOrThrowMacro((arena != nullptr), "Null Pointer");
+  itkAssertOrThrowMacro((firstLine + numberOfLines <= arena->GetNumberOfLines()), "Lines out of the arena");
+  m_LineContainer.clear();
+  m_LineArena = arena;
+  m_FirstArenaLine = firstLine;
+  m_NumberOfArenaLines = numberOfLines;
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+LabelObject<TLabel, VImageDimension>::GetLinesBegin() const -> const LineType *
+{
+  if (m_LineArena)
+  {
+    return m_LineArena->GetLineContainer().data() + m_FirstArenaLine;
+  }
+  return m_LineContainer.data();
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+LabelObject<TLabel, VImageDimension>::GetLinesEnd() const -> const LineType *
+{
+  return this->GetLinesBegin() + this->GetNumberOfLines();
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+LabelObject<TLabel, VImageDimension>::DetachLinesFromArena()
+{
+  if (m_LineArena)
+  {
+    m_LineContainer.assign(this->GetLinesBegin(), this->GetLinesEnd());
+    m_LineArena = nullptr;
+    m_FirstArenaLine = 0;
+    m_NumberOfArenaLines = 0;
+  }
 }
 
 template <typename TLabel, unsigned int VImageDimension>
@@ -385,6 +445,9 @@ LabelObject<TLabel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "LineContainer: " << &m_LineContainer << std::endl;
+  itkPrintSelfObjectMacro(LineArena);
+  os << indent << "FirstArenaLine: " << m_FirstArenaLine << std::endl;
+  os << indent << "NumberOfArenaLines: " << m_NumberOfArenaLines << std::endl;
   print_helper::PrintNumericTrait(os, indent, "Label", m_Label);
 }
 } // end namespace itk
@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelObjectLineArena_h
+#define itkLabelObjectLineArena_h
+
+#include "itkLightObject.h"
+#include "itkLabelObjectLine.h"
+#include "itkObjectFactory.h"
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class LabelObjectLineArena
+ * \brief A single contiguous buffer holding the lines of many label objects.
+ *
+ * The lines of each LabelObject are usually stored in a container owned by
+ * the object. With a large number of objects, the many small allocations
+ * and the scattered lines dominate the time spent building and traversing a
+ * LabelMap. A LabelObjectLineArena stores the lines of all the objects of a
+ * LabelMap one after the other, and each LabelObject refers to the range of
+ * the arena holding its lines (see LabelObject::SetLineArena()).
+ *
+ * The lines of an arena are not meant to be modified once label objects
+ * refer to them: a LabelObject copies its lines out of the arena the first
+ * time it is modified.
+ *
+ * \sa LabelObject, LabelMap::PackLines()
+ * \ingroup DataRepresentation
+ * \ingroup ITKLabelMap
+ */
+template <unsigned int VImageDimension>
+class ITK_TEMPLATE_EXPORT LabelObjectLineArena : public LightObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(LabelObjectLineArena);
+
+  /** Standard class type aliases */
+  using Self = LabelObjectLineArena;
+  using Superclass = LightObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(LabelObjectLineArena);
+
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  using LineType = LabelObjectLine<VImageDimension>;
+  using LineContainerType = std::vector<LineType>;
+
+  /** Get the lines stored in the arena. */
+  /** @ITKStartGrouping */
+  LineContainerType &
+  GetLineContainer()
+  {
+    return m_LineContainer;
+  }
+  const LineContainerType &
+  GetLineContainer() const
+  {
+    return m_LineContainer;
+  }
+  /** @ITKEndGrouping */
+
+  SizeValueType
+  GetNumberOfLines() const
+  {
+    return static_cast<SizeValueType>(m_LineContainer.size());
+  }
+
+protected:
+  LabelObjectLineArena() = default;
+  ~LabelObjectLineArena() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "NumberOfLines: " << m_LineContainer.size() << std::endl;
+  }
+
+private:
+  LineContainerType m_LineContainer{};
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkLabelObjectLineArena.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelImageToShapeLabelMapFilter.h"
+#include "itkLabelMap.h"
+#include "itkLabelObject.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<unsigned short, Dimension>;
+using LabelObjectType = itk::LabelObject<unsigned short, Dimension>;
+using LabelMapType = itk::LabelMap<LabelObjectType>;
+using LineType = LabelObjectType::LineType;
+
+ImageType::Pointer
+MakeLabelImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 23, 17, 11 } });
+  image->Allocate();
+  std::mt19937                                  randomNumberEngine(42);
+  std::uniform_int_distribution<unsigned short> labelDistribution(0, 40);
+  std::uniform_int_distribution<int>            runDistribution(1, 6);
+  itk::ImageRegionIterator<ImageType>           it(image, image->GetBufferedRegion());
+  while (!it.IsAtEnd())
+  {
+    const unsigned short label = labelDistribution(randomNumberEngine);
+    for (int i = runDistribution(randomNumberEngine); i > 0 && !it.IsAtEnd(); --i, ++it)
+    {
+      it.Set(label);
+    }
+  }
+  return image;
+}
+
+template <typename TLabelMap>
+void
+ExpectSameLabelObjects(const TLabelMap * labelMap, const TLabelMap * expectedLabelMap)
+{
+  ASSERT_EQ(labelMap->GetNumberOfLabelObjects(), expectedLabelMap->GetNumberOfLabelObjects());
+  EXPECT_EQ(labelMap->GetBackgroundValue(), expectedLabelMap->GetBackgroundValue());
+  for (typename TLabelMap::ConstIterator it(expectedLabelMap); !it.IsAtEnd(); ++it)
+  {
+    const auto * expectedLabelObject = it.GetLabelObject();
+    ASSERT_TRUE(labelMap->HasLabel(it.GetLabel()));
+    const auto * labelObject = labelMap->GetLabelObject(it.GetLabel());
+    ASSERT_EQ(labelObject->GetNumberOfLines(), expectedLabelObject->GetNumberOfLines());
+    for (itk::SizeValueType i = 0; i < labelObject->GetNumberOfLines(); ++i)
+    {
+      EXPECT_EQ(labelObject->GetLine(i).GetIndex(), expectedLabelObject->GetLine(i).GetIndex());
+      EXPECT_EQ(labelObject->GetLine(i).GetLength(), expectedLabelObject->GetLine(i).GetLength());
+    }
+  }
+}
+} // namespace
+
+
+// Tests that a label object whose lines are in an arena behaves like one
+// owning its lines, and that modifying it leaves the arena unchanged.
+TEST(LabelObjectLineArena, LabelObjectUsesAndDetachesFromArena)
+{
+  const auto arena = LabelObjectType::LineArenaType::New();
+  arena->GetLineContainer() = { LineType(itk::MakeIndex(0, 0, 0), 3),
+                                LineType(itk::MakeIndex(2, 1, 0), 4),
+                                LineType(itk::MakeIndex(1, 2, 0), 2),
+                                LineType(itk::MakeIndex(5, 2, 1), 1) };
+  EXPECT_EQ(arena->GetNumberOfLines(), 4u);
+
+  const auto labelObject = LabelObjectType::New();
+  labelObject->SetLineArena(arena, 1, 2);
+  EXPECT_EQ(labelObject->GetLineArena(), arena.GetPointer());
+  EXPECT_EQ(labelObject->GetNumberOfLines(), 2u);
+  EXPECT_EQ(labelObject->Size(), 6u);
+  EXPECT_FALSE(labelObject->Empty());
+  EXPECT_TRUE(labelObject->HasIndex(itk::MakeIndex(5, 1, 0)));
+  EXPECT_FALSE(labelObject->HasIndex(itk::MakeIndex(0, 0, 0)));
+  EXPECT_EQ(labelObject->GetIndex(4), itk::MakeIndex(1, 2, 0));
+
+  itk::SizeValueType numberOfIndices = 0;
+  for (LabelObjectType::ConstIndexIterator it(labelObject); !it.IsAtEnd(); ++it)
+  {
+    EXPECT_EQ(it.GetIndex(), labelObject->GetIndex(numberOfIndices));
+    ++numberOfIndices;
+  }
+  EXPECT_EQ(numberOfIndices, 6u);
+
+  const auto otherLabelObject = LabelObjectType::New();
+  otherLabelObject->SetLineArena(arena, 0, 4);
+  EXPECT_EQ(otherLabelObject->GetLine(3).GetIndex(), itk::MakeIndex(5, 2, 1));
+
+  labelObject->AddIndex(itk::MakeIndex(6, 1, 0));
+  EXPECT_EQ(labelObject->GetLineArena(), nullptr);
+  EXPECT_EQ(labelObject->GetNumberOfLines(), 3u);
+  EXPECT_EQ(labelObject->Size(), 7u);
+  EXPECT_EQ(arena->GetLineContainer()[1].GetLength(), 4u);
+  EXPECT_EQ(otherLabelObject->Size(), 10u);
+
+  otherLabelObject->Shift(LabelObjectType::OffsetType{ { 1, 0, 0 } });
+  EXPECT_EQ(otherLabelObject->GetLine(0).GetIndex(), itk::MakeIndex(1, 0, 0));
+  EXPECT_EQ(arena->GetLineContainer()[0].GetIndex(), itk::MakeIndex(0, 0, 0));
+}
+
+
+// Tests that the label maps built with and without a line arena, and the
+// packed label map, have the same label objects, for several numbers of work units.
+TEST(LabelObjectLineArena, LabelImageToLabelMapFilterGivesSameLabelObjects)
+{
+  const auto image = MakeLabelImage();
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 8 })
+  {
+    using FilterType = itk::LabelImageToLabelMapFilter<ImageType, LabelMapType>;
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetBackgroundValue(0);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Update();
+    const LabelMapType::Pointer expectedLabelMap = filter->GetOutput();
+    expectedLabelMap->DisconnectPipeline();
+
+    auto arenaFilter = FilterType::New();
+    arenaFilter->SetInput(image);
+    arenaFilter->SetBackgroundValue(0);
+    arenaFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    arenaFilter->UseLineArenaOn();
+    arenaFilter->Update();
+    const LabelMapType * labelMap = arenaFilter->GetOutput();
+
+    const LabelObjectType::LineArenaType * arena = labelMap->GetNthLabelObject(0)->GetLineArena();
+    ASSERT_NE(arena, nullptr);
+    for (LabelMapType::ConstIterator it(labelMap); !it.IsAtEnd(); ++it)
+    {
+      EXPECT_EQ(it.GetLabelObject()->GetLineArena(), arena);
+    }
+    ExpectSameLabelObjects(labelMap, expectedLabelMap.GetPointer());
+
+    expectedLabelMap->PackLines();
+    ExpectSameLabelObjects(labelMap, expectedLabelMap.GetPointer());
+    EXPECT_NE(expectedLabelMap->GetNthLabelObject(0)->GetLineArena(), nullptr);
+  }
+}
+
+
+// Tests that the shape attributes do not depend on the storage of the lines.
+TEST(LabelObjectLineArena, LabelImageToShapeLabelMapFilterGivesSameAttributes)
+{
+  using FilterType = itk::LabelImageToShapeLabelMapFilter<ImageType>;
+  using ShapeLabelMapType = FilterType::OutputImageType;
+
+  const auto image = MakeLabelImage();
+
+  ShapeLabelMapType::Pointer outputs[2];
+  for (const bool useLineArena : { false, true })
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetBackgroundValue(0);
+    filter->SetUseLineArena(useLineArena);
+    filter->Update();
+    outputs[useLineArena] = filter->GetOutput();
+    outputs[useLineArena]->DisconnectPipeline();
+  }
+
+  ASSERT_EQ(outputs[1]->GetNumberOfLabelObjects(), outputs[0]->GetNumberOfLabelObjects());
+  for (ShapeLabelMapType::ConstIterator it(outputs[0]); !it.IsAtEnd(); ++it)
+  {
+    const auto * expectedLabelObject = it.GetLabelObject();
+    const auto * labelObject = outputs[1]->GetLabelObject(it.GetLabel());
+    EXPECT_EQ(labelObject->GetNumberOfPixels(), expectedLabelObject->GetNumberOfPixels());
+    EXPECT_EQ(labelObject->GetBoundingBox(), expectedLabelObject->GetBoundingBox());
+    EXPECT_EQ(labelObject->GetCentroid(), expectedLabelObject->GetCentroid());
+    EXPECT_EQ(labelObject->GetPerimeter(), expectedLabelObject->GetPerimeter());
+    EXPECT_EQ(labelObject->GetNumberOfPixelsOnBorder(), expectedLabelObject->GetNumberOfPixelsOnBorder());
+  }
+  ExpectSameLabelObjects(outputs[1].GetPointer(), outputs[0].GetPointer());
+}
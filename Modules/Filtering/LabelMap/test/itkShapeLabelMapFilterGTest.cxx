@@ -114,6 +114,9 @@ protected:
       auto computeOrientedBoundingBox = true;
       ITK_TEST_SET_GET_BOOLEAN(l2s, ComputeOrientedBoundingBox, computeOrientedBoundingBox);
 
+      auto useLineArena = true;
+      ITK_TEST_SET_GET_BOOLEAN(l2s, UseLineArena, useLineArena);
+
       return EXIT_SUCCESS;
     }
   };
@@ -51,6 +51,11 @@ namespace itk
  * values (zero or one). Only elements of the structuring element
  * having values > 0 are candidates for affecting the center pixel.
  *
+ * When the structuring element is a box and the pixels are integers of
+ * 8 or 16 bits, the rank is computed with ColumnHistogramRankCalculator
+ * instead, whose cost per pixel does not depend on the size of the
+ * boundary of the structuring element.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Efficient implementation of kernel filtering"
@@ -58,7 +63,7 @@ namespace itk
  * https://doi.org/10.54294/igq8fn
  *
  *
- * \sa MedianImageFilter
+ * \sa MedianImageFilter, ColumnHistogramRankCalculator
  *
  * \author Richard Beare
  * \ingroup ITKMathematicalMorphology
@@ -136,6 +141,9 @@ protected:
   void
   ConfigureHistogram(HistogramType & histogram) override;
 
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
 private:
   float m_Rank{};
 }; // end of class
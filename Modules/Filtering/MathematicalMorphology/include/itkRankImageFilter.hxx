@@ -18,12 +18,14 @@
 #ifndef itkRankImageFilter_hxx
 #define itkRankImageFilter_hxx
 
+#include "itkColumnHistogramRankCalculator.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
 
 #include "itkImageRegionIterator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include "itkPrintHelper.h"
@@ -51,6 +53,29 @@ RankImageFilter<TInputImage, TOutputImage, TKernel>::ConfigureHistogram(Histogra
   histogram.SetRank(m_Rank);
 }
 
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+void
+RankImageFilter<TInputImage, TOutputImage, TKernel>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  using RankCalculatorType = ColumnHistogramRankCalculator<InputImageType, OutputImageType>;
+  if constexpr (RankCalculatorType::IsPixelTypeSupported)
+  {
+    const KernelType & kernel = this->GetKernel();
+    if (RankCalculatorType::IsEfficientForRadius(this->GetRadius()) &&
+        std::all_of(kernel.Begin(), kernel.End(), [](const auto & value) { return value > 0; }))
+    {
+      // The neighborhoods are cropped at the boundary, like with the
+      // moving histograms.
+      TotalProgressReporter progress(this, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels());
+      RankCalculatorType::Compute(
+        *this->GetInput(), *this->GetOutput(), outputRegionForThread, this->GetRadius(), m_Rank, true, progress);
+      return;
+    }
+  }
+  Superclass::DynamicThreadedGenerateData(outputRegionForThread);
+}
+
 template <typename TInputImage, typename TOutputImage, typename TKernel>
 void
 RankImageFilter<TInputImage, TOutputImage, TKernel>::PrintSelf(std::ostream & os, Indent indent) const
@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLEBinaryThresholdImageFilter_h
+#define itkRLEBinaryThresholdImageFilter_h
+
+#include "itkBinaryThresholdImageFilter.h"
+#include "itkRLEUnaryFunctorImageFilter.h"
+
+namespace itk
+{
+/** \class RLEBinaryThresholdImageFilter
+ * \brief Binarize a RLEImage by thresholding.
+ *
+ * Equivalent to BinaryThresholdImageFilter, but each run is thresholded
+ * once, and the output is a compacted RLEImage. Pixels with values between
+ * LowerThreshold and UpperThreshold, inclusive, get the InsideValue, the
+ * other pixels get the OutsideValue.
+ *
+ * \sa BinaryThresholdImageFilter, RLEUnaryFunctorImageFilter
+ * \ingroup RLEImage
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT RLEBinaryThresholdImageFilter
+  : public RLEUnaryFunctorImageFilter<
+      TInputImage,
+      TOutputImage,
+      Functor::BinaryThreshold<typename TInputImage::PixelType, typename TOutputImage::PixelType>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RLEBinaryThresholdImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = RLEBinaryThresholdImageFilter;
+  using Superclass = RLEUnaryFunctorImageFilter<
+    TInputImage,
+    TOutputImage,
+    Functor::BinaryThreshold<typename TInputImage::PixelType, typename TOutputImage::PixelType>>;
+
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(RLEBinaryThresholdImageFilter);
+
+  /** Pixel types. */
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  /** Set/Get the "outside" pixel value. The default value
+   * NumericTraits<OutputPixelType>::ZeroValue(). */
+  /** @ITKStartGrouping */
+  itkSetMacro(OutsideValue, OutputPixelType);
+  itkGetConstReferenceMacro(OutsideValue, OutputPixelType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the "inside" pixel value. The default value
+   * NumericTraits<OutputPixelType>::max() */
+  /** @ITKStartGrouping */
+  itkSetMacro(InsideValue, OutputPixelType);
+  itkGetConstReferenceMacro(InsideValue, OutputPixelType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the thresholds. The default lower threshold is
+   * NumericTraits<InputPixelType>::NonpositiveMin(). The default upper
+   * threshold is NumericTraits<InputPixelType>::max(). */
+  /** @ITKStartGrouping */
+  itkSetMacro(LowerThreshold, InputPixelType);
+  itkGetConstReferenceMacro(LowerThreshold, InputPixelType);
+  itkSetMacro(UpperThreshold, InputPixelType);
+  itkGetConstReferenceMacro(UpperThreshold, InputPixelType);
+  /** @ITKEndGrouping */
+
+  itkConceptMacro(OutputEqualityComparableCheck, (Concept::EqualityComparable<OutputPixelType>));
+  itkConceptMacro(InputPixelTypeComparable, (Concept::Comparable<InputPixelType>));
+
+protected:
+  RLEBinaryThresholdImageFilter() = default;
+  ~RLEBinaryThresholdImageFilter() override = default;
+
+  /** Set the thresholds and the values of the functor. */
+  void
+  BeforeThreadedGenerateData() override
+  {
+    if (m_LowerThreshold > m_UpperThreshold)
+    {
+      itkExceptionMacro("Lower threshold cannot be greater than upper threshold.");
+    }
+    this->GetFunctor().SetLowerThreshold(m_LowerThreshold);
+    this->GetFunctor().SetUpperThreshold(m_UpperThreshold);
+    this->GetFunctor().SetInsideValue(m_InsideValue);
+    this->GetFunctor().SetOutsideValue(m_OutsideValue);
+  }
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override
+  {
+    Superclass::PrintSelf(os, indent);
+
+    os << indent << "OutsideValue: " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_OutsideValue)
+       << std::endl;
+    os << indent << "InsideValue: " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_InsideValue)
+       << std::endl;
+    os << indent
+       << "LowerThreshold: " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(m_LowerThreshold)
+       << std::endl;
+    os << indent
+       << "UpperThreshold: " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(m_UpperThreshold)
+       << std::endl;
+  }
+
+private:
+  InputPixelType  m_LowerThreshold{ NumericTraits<InputPixelType>::NonpositiveMin() };
+  InputPixelType  m_UpperThreshold{ NumericTraits<InputPixelType>::max() };
+  OutputPixelType m_InsideValue{ NumericTraits<OutputPixelType>::max() };
+  OutputPixelType m_OutsideValue{};
+};
+} // end namespace itk
+
+#endif // itkRLEBinaryThresholdImageFilter_h
@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLEChangeLabelImageFilter_h
+#define itkRLEChangeLabelImageFilter_h
+
+#include "itkChangeLabelImageFilter.h"
+#include "itkRLEUnaryFunctorImageFilter.h"
+
+namespace itk
+{
+/** \class RLEChangeLabelImageFilter
+ * \brief Change sets of labels of a RLEImage.
+ *
+ * Equivalent to ChangeLabelImageFilter, but the labels are changed once per
+ * run instead of once per pixel, and the output is a compacted RLEImage.
+ *
+ * \sa ChangeLabelImageFilter, RLEUnaryFunctorImageFilter
+ * \ingroup RLEImage
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT RLEChangeLabelImageFilter
+  : public RLEUnaryFunctorImageFilter<
+      TInputImage,
+      TOutputImage,
+      Functor::ChangeLabel<typename TInputImage::PixelType, typename TOutputImage::PixelType>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RLEChangeLabelImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = RLEChangeLabelImageFilter;
+  using Superclass =
+    RLEUnaryFunctorImageFilter<TInputImage,
+                               TOutputImage,
+                               Functor::ChangeLabel<typename TInputImage::PixelType, typename TOutputImage::PixelType>>;
+
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(RLEChangeLabelImageFilter);
+
+  /** Pixel types. */
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  /** Type of the change map to use for change requests */
+  using ChangeMapType = std::map<InputPixelType, OutputPixelType>;
+
+  /** Set up a change of a single label */
+  void
+  SetChange(const InputPixelType & original, const OutputPixelType & result)
+  {
+    if (this->GetFunctor().GetChange(original) != result)
+    {
+      this->GetFunctor().SetChange(original, result);
+      this->Modified();
+    }
+  }
+
+  /** Set the entire change map */
+  void
+  SetChangeMap(const ChangeMapType & changeMap)
+  {
+    this->GetFunctor().SetChangeMap(changeMap);
+    this->Modified();
+  }
+
+  /** Clears the entire change map */
+  void
+  ClearChangeMap()
+  {
+    this->GetFunctor().ClearChangeMap();
+    this->Modified();
+  }
+
+  itkConceptMacro(InputConvertibleToOutputCheck, (Concept::Convertible<InputPixelType, OutputPixelType>));
+  itkConceptMacro(PixelTypeComparable, (Concept::Comparable<InputPixelType>));
+
+protected:
+  RLEChangeLabelImageFilter() = default;
+  ~RLEChangeLabelImageFilter() override = default;
+};
+} // end namespace itk
+
+#endif // itkRLEChangeLabelImageFilter_h
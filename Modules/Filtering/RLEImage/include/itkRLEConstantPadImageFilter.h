@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLEConstantPadImageFilter_h
+#define itkRLEConstantPadImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkRLEImage.h"
+
+namespace itk
+{
+/** \class RLEConstantPadImageFilter
+ * \brief Increase the size of a RLEImage by padding with a constant value.
+ *
+ * Equivalent to ConstantPadImageFilter. Along the first axis, the padding
+ * is a run at each end of the lines, merged with the first and last runs of
+ * the input when they have the same value, and the padded lines along the
+ * other axes are a single run. A compacted input is not expanded, and the
+ * output is a compacted RLEImage.
+ *
+ * The input can be cropped with RegionOfInterestImageFilter, which has a
+ * specialization for RLEImage.
+ *
+ * \sa ConstantPadImageFilter, RLEImage
+ * \ingroup RLEImage
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT RLEConstantPadImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RLEConstantPadImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = RLEConstantPadImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(RLEConstantPadImageFilter);
+
+  /** Some type alias. */
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using OutputImagePixelType = typename TOutputImage::PixelType;
+  using OutputImageRegionType = typename TOutputImage::RegionType;
+  using OutputRLSegmentType = typename TOutputImage::RLSegment;
+  using OutputRLCounterType = typename TOutputImage::RLCounterType;
+  using SizeType = typename TInputImage::SizeType;
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Set/Get the padding added before and after the input along each axis. */
+  /** @ITKStartGrouping */
+  itkSetMacro(PadLowerBound, SizeType);
+  itkGetConstReferenceMacro(PadLowerBound, SizeType);
+  itkSetMacro(PadUpperBound, SizeType);
+  itkGetConstReferenceMacro(PadUpperBound, SizeType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the value of the padded pixels. Defaults to zero. */
+  /** @ITKStartGrouping */
+  itkSetMacro(Constant, OutputImagePixelType);
+  itkGetConstReferenceMacro(Constant, OutputImagePixelType);
+  /** @ITKEndGrouping */
+
+  itkConceptMacro(InputConvertibleToOutputCheck,
+                  (Concept::Convertible<typename TInputImage::PixelType, OutputImagePixelType>));
+  itkConceptMacro(SameDimensionCheck,
+                  (Concept::SameDimension<TInputImage::ImageDimension, TOutputImage::ImageDimension>));
+
+protected:
+  RLEConstantPadImageFilter();
+  ~RLEConstantPadImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The output is larger than the input. */
+  void
+  GenerateOutputInformation() override;
+
+  /** The whole input is needed, as the output is produced line by line. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+  /** Write the segments of a line of the output to outputSegments, unless it
+   * is nullptr, and return their number. */
+  SizeValueType
+  ProcessLine(SizeValueType lineNumber, OutputRLSegmentType * outputSegments) const;
+
+private:
+  SizeType             m_PadLowerBound{};
+  SizeType             m_PadUpperBound{};
+  OutputImagePixelType m_Constant{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRLEConstantPadImageFilter.hxx"
+#endif
+
+#endif // itkRLEConstantPadImageFilter_h
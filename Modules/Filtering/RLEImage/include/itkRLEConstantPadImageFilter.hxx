@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLEConstantPadImageFilter_hxx
+#define itkRLEConstantPadImageFilter_hxx
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+RLEConstantPadImageFilter<TInputImage, TOutputImage>::RLEConstantPadImageFilter()
+{
+  m_PadLowerBound.Fill(0);
+  m_PadUpperBound.Fill(0);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RLEConstantPadImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  // call the superclass' implementation of this method
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+  if (!input || !output)
+  {
+    return;
+  }
+
+  const typename InputImageType::RegionType & inputRegion = input->GetLargestPossibleRegion();
+  OutputImageRegionType                       outputRegion;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    outputRegion.SetSize(i, inputRegion.GetSize(i) + m_PadLowerBound[i] + m_PadUpperBound[i]);
+    outputRegion.SetIndex(i, inputRegion.GetIndex(i) - static_cast<OffsetValueType>(m_PadLowerBound[i]));
+  }
+  output->SetLargestPossibleRegion(outputRegion);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RLEConstantPadImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RLEConstantPadImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  // call the superclass' implementation of this method
+  Superclass::EnlargeOutputRequestedRegion(output);
+
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+RLEConstantPadImageFilter<TInputImage, TOutputImage>::ProcessLine(SizeValueType         lineNumber,
+                                                                  OutputRLSegmentType * outputSegments) const
+{
+  const InputImageType *                      input = this->GetInput();
+  const typename InputImageType::RegionType & inputRegion = input->GetBufferedRegion();
+  const OutputImageRegionType &               outputRegion = this->GetOutput()->GetBufferedRegion();
+
+  // index of the line in the input, if it is not in the padding
+  typename InputImageType::BufferType::IndexType lineIndex;
+  bool                                           isInputLine = true;
+  SizeValueType                                  remainder = lineNumber;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
+  {
+    const SizeValueType size = outputRegion.GetSize(d);
+    lineIndex[d - 1] = outputRegion.GetIndex(d) + static_cast<IndexValueType>(remainder % size);
+    remainder /= size;
+    isInputLine = isInputLine && lineIndex[d - 1] >= inputRegion.GetIndex(d) &&
+                  lineIndex[d - 1] < inputRegion.GetIndex(d) + static_cast<IndexValueType>(inputRegion.GetSize(d));
+  }
+
+  SizeValueType       numberOfSegments = 0;
+  OutputRLSegmentType segment(0, m_Constant);
+  const auto          append = [&](SizeValueType count, const OutputImagePixelType & value) {
+    if (count == 0)
+    {
+      return;
+    }
+    if (numberOfSegments > 0 && value == segment.second)
+    {
+      segment.first += static_cast<OutputRLCounterType>(count);
+      return;
+    }
+    if (numberOfSegments > 0 && outputSegments)
+    {
+      outputSegments[numberOfSegments - 1] = segment;
+    }
+    segment = OutputRLSegmentType(static_cast<OutputRLCounterType>(count), value);
+    ++numberOfSegments;
+  };
+
+  if (isInputLine)
+  {
+    append(m_PadLowerBound[0], m_Constant);
+    for (const auto & inputSegment : input->GetSegments(input->ComputeLineNumber(lineIndex)))
+    {
+      append(inputSegment.first, static_cast<OutputImagePixelType>(inputSegment.second));
+    }
+    append(m_PadUpperBound[0], m_Constant);
+  }
+  else
+  {
+    append(outputRegion.GetSize(0), m_Constant);
+  }
+  if (numberOfSegments > 0 && outputSegments)
+  {
+    outputSegments[numberOfSegments - 1] = segment;
+  }
+  return numberOfSegments;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RLEConstantPadImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  OutputImageType * output = this->GetOutput();
+
+  this->BeforeThreadedGenerateData();
+
+  itkAssertOrThrowMacro(output->GetLargestPossibleRegion().GetSize(0) <=
+                          SizeValueType(NumericTraits<OutputRLCounterType>::max()),
+                        "The counter type of the output is not large enough for the X dimension of the image!");
+  output->SetBufferedRegion(output->GetLargestPossibleRegion());
+  const SizeValueType numberOfLines = output->GetNumberOfLines();
+
+  // count the segments of each line, then write them at the offsets given
+  // by the prefix sums of the counts
+  MultiThreaderBase *        multiThreader = this->GetMultiThreader();
+  std::vector<SizeValueType> lineOffsets(numberOfLines + 1, 0);
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfLines,
+    [this, &lineOffsets](SizeValueType line) { lineOffsets[line + 1] = this->ProcessLine(line, nullptr); },
+    nullptr);
+  for (SizeValueType line = 0; line < numberOfLines; ++line)
+  {
+    lineOffsets[line + 1] += lineOffsets[line];
+  }
+
+  std::vector<OutputRLSegmentType> segments(lineOffsets[numberOfLines]);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfLines,
+    [this, &lineOffsets, &segments](SizeValueType line) {
+      this->ProcessLine(line, segments.data() + lineOffsets[line]);
+    },
+    this);
+
+  output->SetCompactedLines(std::move(segments), std::move(lineOffsets));
+
+  this->AfterThreadedGenerateData();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RLEConstantPadImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "PadLowerBound: " << m_PadLowerBound << std::endl;
+  os << indent << "PadUpperBound: " << m_PadUpperBound << std::endl;
+  os << indent << "Constant: " << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(m_Constant)
+     << std::endl;
+}
+} // end namespace itk
+
+#endif // itkRLEConstantPadImageFilter_hxx
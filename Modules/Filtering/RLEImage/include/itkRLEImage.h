@@ -20,6 +20,8 @@
 
 #include <itkImage.h>
 #include <itkImageBase.h>
+#include <atomic>
+#include <mutex>
 #include <utility> // std::pair
 #include <vector>
 
@@ -42,6 +44,17 @@ namespace itk
  *  Should same-valued segments be merged on the fly?
  *  On the fly merging usually provides better performance. Default: On.
  *
+ *  \par Compacted storage
+ *  By default, each line is a std::vector of segments. Compact() moves the
+ *  segments of all the lines to a single buffer, indexed by a table of line
+ *  offsets, which avoids an allocation per line. The lines of a compacted
+ *  image can be read with GetSegments(), and the run-length filters of this
+ *  module produce compacted images. Modifying the image, with SetPixel(), a
+ *  writing iterator or the non-const GetBuffer(), expands it back to one
+ *  vector per line, as does Expand(). Reading it with a const iterator
+ *  copies the lines to the vectors too, but keeps the compacted lines,
+ *  so a compacted input can be read by several threads in both ways.
+ *
  *  Acknowledgement:
  *  This work is supported by NIH grant R01 EB014346, "Continued development
  *  and maintenance of the ITK-SNAP 3D image segmentation software."
@@ -83,6 +96,44 @@ public:
   /** A Run-Length encoded line of pixels. */
   using RLLine = std::vector<RLSegment>;
 
+  /** The segments of a Run-Length encoded line, whatever the storage of the image. */
+  class RLSegmentRange
+  {
+  public:
+    RLSegmentRange(const RLSegment * first, const RLSegment * last)
+      : m_First(first)
+      , m_Last(last)
+    {}
+
+    const RLSegment *
+    begin() const
+    {
+      return m_First;
+    }
+
+    const RLSegment *
+    end() const
+    {
+      return m_Last;
+    }
+
+    std::size_t
+    size() const
+    {
+      return static_cast<std::size_t>(m_Last - m_First);
+    }
+
+    const RLSegment &
+    operator[](std::size_t i) const
+    {
+      return m_First[i];
+    }
+
+  private:
+    const RLSegment * m_First;
+    const RLSegment * m_Last;
+  };
+
   /** Internal Pixel representation. Used to maintain a uniform API
    * with Image Adaptors and allow to keep a particular internal
    * representation of data while showing a different external
@@ -142,6 +193,7 @@ public:
     Superclass::Initialize();
     m_OnTheFlyCleanup = true;
     m_Buffer = BufferType::New();
+    this->ReleaseCompactedLines();
   }
 
   /** Fill the image buffer with a value.  Be sure to call Allocate()
@@ -219,20 +271,74 @@ public:
   /** Typedef for the internally used buffer. */
   using BufferType = typename itk::Image<RLLine, VImageDimension - 1>;
 
-  /** We need to allow itk-style iterators to be constructed. */
+  /** We need to allow itk-style iterators to be constructed.
+   * A compacted image is expanded first, see Expand(). */
   typename BufferType::Pointer
   GetBuffer()
   {
+    this->Expand();
     return m_Buffer;
   }
 
-  /** We need to allow itk-style const iterators to be constructed. */
+  /** We need to allow itk-style const iterators to be constructed.
+   * The lines of a compacted image are copied to the buffer the first
+   * time, and the image stays compacted. */
   typename BufferType::ConstPointer
   GetBuffer() const
   {
+    this->CopyCompactedLinesToBuffer();
     return m_Buffer;
   }
 
+  /** Number of Run-Length lines in the buffered region. */
+  SizeValueType
+  GetNumberOfLines() const
+  {
+    const SizeValueType lineLength = this->GetBufferedRegion().GetSize(0);
+    return lineLength == 0 ? 0 : this->GetBufferedRegion().GetNumberOfPixels() / lineLength;
+  }
+
+  /** Number of the line at the given index of the internal buffer, in the
+   * order of the lines of the buffered region. */
+  SizeValueType
+  ComputeLineNumber(const typename BufferType::IndexType & lineIndex) const
+  {
+    return static_cast<SizeValueType>(m_Buffer->ComputeOffset(lineIndex));
+  }
+
+  /** Get the segments of a line, without expanding a compacted image.
+   * The range is invalidated when the image is expanded or modified, which
+   * only the non-const methods do. */
+  RLSegmentRange
+  GetSegments(SizeValueType lineNumber) const;
+
+  /** Move the segments of all the lines to a single buffer. Adjacent
+   * segments with the same value are merged. */
+  void
+  Compact();
+
+  /** Move the segments of a compacted image back to one vector per line.
+   * Called automatically before the image is modified. Like the other
+   * non-const methods, it must not be called while other threads read the
+   * image, e.g. a filter must expand its input before threading, if needed. */
+  void
+  Expand();
+
+  /** Is the image stored in compacted form? */
+  bool
+  GetCompacted() const
+  {
+    return m_Compacted.load(std::memory_order_acquire);
+  }
+
+  /** Set the lines of the image in compacted form. The regions must be set
+   * beforehand. The segments of line i are segments[lineOffsets[i]] to
+   * segments[lineOffsets[i + 1] - 1], so lineOffsets holds one element more
+   * than the number of lines. This is how the run-length filters allocate
+   * their output. */
+  void
+  SetCompactedLines(std::vector<RLSegment> segments, std::vector<SizeValueType> lineOffsets);
+
   /** Returns N-1-dimensional index, the remainder after 0-index is removed. */
   static inline typename BufferType::IndexType
   truncateIndex(const IndexType & index);
@@ -293,11 +399,29 @@ protected:
   void
   CleanUpLine(RLLine & line) const;
 
+  /** Free the compacted lines, leaving the image in expanded form. */
+  void
+  ReleaseCompactedLines();
+
+  /** Copy the lines of a compacted image to m_Buffer, once, for the const
+   * iterators. The compacted lines are kept. */
+  void
+  CopyCompactedLinesToBuffer() const;
+
 private:
   bool m_OnTheFlyCleanup{ true }; // should same-valued segments be merged on the fly
 
   /** Memory for the current buffer. */
   mutable typename BufferType::Pointer m_Buffer;
+
+  /** Memory for the compacted lines, used instead of m_Buffer when m_Compacted is true. */
+  std::vector<RLSegment>     m_CompactedSegments{};
+  std::vector<SizeValueType> m_LineOffsets{};
+  std::atomic<bool>          m_Compacted{ false };
+
+  /** Whether m_Buffer holds a copy of the compacted lines. */
+  mutable std::atomic<bool> m_CompactedLinesCopied{ false };
+  mutable std::mutex        m_ExpandMutex{};
 };
 } // namespace itk
 
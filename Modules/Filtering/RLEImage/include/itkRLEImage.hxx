@@ -49,6 +49,7 @@ RLEImage<TPixel, VImageDimension, CounterType>::Allocate(bool itkNotUsed(initial
                           itk::SizeValueType(std::numeric_limits<CounterType>::max()),
                         "CounterType is not large enough to support image's X dimension!");
   this->ComputeOffsetTable();
+  this->ReleaseCompactedLines();
   // SizeValueType num = static_cast<SizeValueType>(this->GetOffsetTable()[VImageDimension]);
   m_Buffer->Allocate(false);
   // if (initialize) //there is assumption that the image is fully formed after a call to allocate
@@ -65,7 +66,20 @@ void
 RLEImage<TPixel, VImageDimension, CounterType>::FillBuffer(const TPixel & value)
 {
   RLSegment segment(CounterType(this->GetBufferedRegion().GetSize(0)), value);
-  RLLine    line(1);
+  if (this->GetCompacted())
+  {
+    // a single segment per line, which keeps the image compacted
+    const SizeValueType numberOfLines = this->GetNumberOfLines();
+    m_CompactedSegments.assign(numberOfLines, segment);
+    for (SizeValueType i = 0; i <= numberOfLines; ++i)
+    {
+      m_LineOffsets[i] = i;
+    }
+    m_CompactedLinesCopied.store(false, std::memory_order_release);
+    m_Buffer->GetPixelContainer()->Initialize();
+    return;
+  }
+  RLLine line(1);
 
   line[0] = segment;
   m_Buffer->FillBuffer(line);
@@ -97,9 +111,9 @@ void
 RLEImage<TPixel, VImageDimension, CounterType>::CleanUp() const
 {
   assert(m_Buffer->GetBufferedRegion().GetNumberOfPixels() > 0);
-  if (this->GetLargestPossibleRegion().GetSize(0) == 0)
+  if (this->GetLargestPossibleRegion().GetSize(0) == 0 || this->GetCompacted())
   {
-    return;
+    return; // the compacted lines are always clean
   }
 
   itk::ImageRegionIterator<BufferType> it(m_Buffer, m_Buffer->GetBufferedRegion());
@@ -124,7 +138,9 @@ RLEImage<TPixel, VImageDimension, CounterType>::SetPixel(RLLine &         line,
   {
     return 0;
   }
-  else if (line[m_RealIndex].first == 1) // single pixel segment
+  // the line is one of m_Buffer, which holds a copy of the lines of a compacted image
+  this->Expand();
+  if (line[m_RealIndex].first == 1) // single pixel segment
   {
     line[m_RealIndex].second = value;
     if (m_OnTheFlyCleanup) // now see if we can merge it into adjacent segments
@@ -211,6 +227,7 @@ RLEImage<TPixel, VImageDimension, CounterType>::SetPixel(const IndexType & index
   // complete Run-Length Lines have to be buffered
   itkAssertOrThrowMacro(this->GetBufferedRegion().GetSize(0) == this->GetLargestPossibleRegion().GetSize(0),
                         "BufferedRegion must contain complete run-length lines!");
+  this->Expand();
   IndexValueType                 bri0 = this->GetBufferedRegion().GetIndex(0);
   typename BufferType::IndexType bi = truncateIndex(index);
   RLLine &                       line = m_Buffer->GetPixel(bi);
@@ -235,21 +252,144 @@ RLEImage<TPixel, VImageDimension, CounterType>::GetPixel(const IndexType & index
   // complete Run-Length Lines have to be buffered
   itkAssertOrThrowMacro(this->GetBufferedRegion().GetSize(0) == this->GetLargestPossibleRegion().GetSize(0),
                         "BufferedRegion must contain complete run-length lines!");
-  IndexValueType                 bri0 = this->GetBufferedRegion().GetIndex(0);
-  typename BufferType::IndexType bi = truncateIndex(index);
-  RLLine &                       line = m_Buffer->GetPixel(bi);
-  IndexValueType                 t = 0;
-  for (SizeValueType x = 0; x < line.size(); x++)
+  IndexValueType       bri0 = this->GetBufferedRegion().GetIndex(0);
+  const RLSegmentRange line = this->GetSegments(this->ComputeLineNumber(truncateIndex(index)));
+  IndexValueType       t = 0;
+  for (const RLSegment & segment : line)
   {
-    t += line[x].first;
+    t += segment.first;
     if (t > index[0] - bri0)
     {
-      return line[x].second;
+      return segment.second;
     }
   }
   throw itk::ExceptionObject(__FILE__, __LINE__, "Reached past the end of Run-Length line!", __FUNCTION__);
 } // >::GetPixel
 
+template <typename TPixel, unsigned int VImageDimension, typename CounterType>
+auto
+RLEImage<TPixel, VImageDimension, CounterType>::GetSegments(SizeValueType lineNumber) const -> RLSegmentRange
+{
+  if (this->GetCompacted())
+  {
+    const RLSegment * segments = m_CompactedSegments.data();
+    return RLSegmentRange(segments + m_LineOffsets[lineNumber], segments + m_LineOffsets[lineNumber + 1]);
+  }
+  const RLLine & line = m_Buffer->GetBufferPointer()[lineNumber];
+  return RLSegmentRange(line.data(), line.data() + line.size());
+}
+
+template <typename TPixel, unsigned int VImageDimension, typename CounterType>
+void
+RLEImage<TPixel, VImageDimension, CounterType>::Compact()
+{
+  if (this->GetCompacted())
+  {
+    return;
+  }
+  const SizeValueType numberOfLines = this->GetNumberOfLines();
+  const RLLine *      lines = m_Buffer->GetBufferPointer();
+
+  SizeValueType numberOfSegments = 0;
+  for (SizeValueType i = 0; i < numberOfLines; ++i)
+  {
+    numberOfSegments += lines[i].size();
+  }
+
+  std::vector<RLSegment>     segments;
+  std::vector<SizeValueType> lineOffsets(numberOfLines + 1, 0);
+  segments.reserve(numberOfSegments);
+  for (SizeValueType i = 0; i < numberOfLines; ++i)
+  {
+    for (const RLSegment & segment : lines[i])
+    {
+      if (segments.size() > lineOffsets[i] && segments.back().second == segment.second)
+      {
+        segments.back().first += segment.first;
+      }
+      else
+      {
+        segments.push_back(segment);
+      }
+    }
+    lineOffsets[i + 1] = segments.size();
+  }
+  this->SetCompactedLines(std::move(segments), std::move(lineOffsets));
+}
+
+template <typename TPixel, unsigned int VImageDimension, typename CounterType>
+void
+RLEImage<TPixel, VImageDimension, CounterType>::SetCompactedLines(std::vector<RLSegment>     segments,
+                                                                  std::vector<SizeValueType> lineOffsets)
+{
+  itkAssertOrThrowMacro(this->GetBufferedRegion().GetSize(0) == this->GetLargestPossibleRegion().GetSize(0),
+                        "BufferedRegion must contain complete run-length lines!");
+  itkAssertOrThrowMacro(lineOffsets.size() == this->GetNumberOfLines() + 1 && lineOffsets.back() == segments.size(),
+                        "The line offsets do not match the buffered region and the segments!");
+  this->ComputeOffsetTable();
+  m_CompactedSegments = std::move(segments);
+  m_LineOffsets = std::move(lineOffsets);
+  m_CompactedLinesCopied.store(false, std::memory_order_release);
+  m_Compacted.store(true, std::memory_order_release);
+
+  // release the lines, but keep the regions of the buffer
+  m_Buffer->GetPixelContainer()->Initialize();
+}
+
+template <typename TPixel, unsigned int VImageDimension, typename CounterType>
+void
+RLEImage<TPixel, VImageDimension, CounterType>::Expand()
+{
+  if (!this->GetCompacted())
+  {
+    return;
+  }
+  this->CopyCompactedLinesToBuffer();
+  const std::lock_guard<std::mutex> lockGuard(m_ExpandMutex);
+  if (this->GetCompacted())
+  {
+    // the lines of m_Buffer are kept, so the iterators on the image stay valid
+    this->ReleaseCompactedLines();
+  }
+}
+
+template <typename TPixel, unsigned int VImageDimension, typename CounterType>
+void
+RLEImage<TPixel, VImageDimension, CounterType>::CopyCompactedLinesToBuffer() const
+{
+  if (!this->GetCompacted() || m_CompactedLinesCopied.load(std::memory_order_acquire))
+  {
+    return;
+  }
+  // several threads might construct const iterators at the same time,
+  // while others read the compacted lines, which are left untouched
+  const std::lock_guard<std::mutex> lockGuard(m_ExpandMutex);
+  if (m_CompactedLinesCopied.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  m_Buffer->Allocate(false);
+  RLLine *            lines = m_Buffer->GetBufferPointer();
+  const SizeValueType numberOfLines = this->GetNumberOfLines();
+  const RLSegment *   segments = m_CompactedSegments.data();
+  for (SizeValueType i = 0; i < numberOfLines; ++i)
+  {
+    lines[i].assign(segments + m_LineOffsets[i], segments + m_LineOffsets[i + 1]);
+  }
+  m_CompactedLinesCopied.store(true, std::memory_order_release);
+}
+
+template <typename TPixel, unsigned int VImageDimension, typename CounterType>
+void
+RLEImage<TPixel, VImageDimension, CounterType>::ReleaseCompactedLines()
+{
+  m_Compacted.store(false, std::memory_order_release);
+  m_CompactedLinesCopied.store(false, std::memory_order_release);
+  std::vector<RLSegment>().swap(m_CompactedSegments);
+  std::vector<SizeValueType>().swap(m_LineOffsets);
+}
+
 template <typename TPixel, unsigned int VImageDimension, typename CounterType>
 void
 RLEImage<TPixel, VImageDimension, CounterType>::PrintSelf(std::ostream & os, itk::Indent indent) const
@@ -261,18 +401,26 @@ RLEImage<TPixel, VImageDimension, CounterType>::PrintSelf(std::ostream & os, itk
   itk::SizeValueType c = 0;
   itk::SizeValueType pixelCount = this->GetOffsetTable()[VImageDimension];
 
-  itk::ImageRegionConstIterator<BufferType> it(m_Buffer, m_Buffer->GetBufferedRegion());
-  while (!it.IsAtEnd())
+  itk::SizeValueType memUsed = 0;
+  if (this->GetCompacted())
   {
-    c += it.Get().capacity();
-    ++it;
+    c = m_CompactedSegments.capacity();
+    memUsed = c * sizeof(RLSegment) + m_LineOffsets.capacity() * sizeof(SizeValueType);
+  }
+  else
+  {
+    itk::ImageRegionConstIterator<BufferType> it(m_Buffer, m_Buffer->GetBufferedRegion());
+    while (!it.IsAtEnd())
+    {
+      c += it.Get().capacity();
+      ++it;
+    }
+    memUsed = c * sizeof(RLSegment) + sizeof(std::vector<RLLine>) * (pixelCount / this->GetOffsetTable()[1]);
   }
-
-  itk::SizeValueType memUsed =
-    c * sizeof(RLSegment) + sizeof(std::vector<RLLine>) * (pixelCount / this->GetOffsetTable()[1]);
   double cr = double(memUsed) / (pixelCount * sizeof(PixelType));
 
   os << indent << "OnTheFlyCleanup: " << (m_OnTheFlyCleanup ? "On" : "Off") << std::endl;
+  os << indent << "Compacted: " << (this->GetCompacted() ? "On" : "Off") << std::endl;
   os << indent << "RLSegment count: " << c << std::endl;
   int prec = os.precision(3);
   os << indent << "Compressed size in relation to original size: " << cr * 100 << "%" << std::endl;
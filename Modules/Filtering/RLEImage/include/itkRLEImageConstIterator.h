@@ -108,7 +108,7 @@ public:
   /** Copy Constructor. The copy constructor is provided to make sure the
    * handle to the image is properly reference counted. */
   ImageConstIterator(const Self & it)
-    : m_Buffer(const_cast<ImageType *>(it.GetImage())->GetBuffer())
+    : m_Buffer(it.m_Buffer)
   {
     m_RunLengthLine = it.m_RunLengthLine;
     m_Image = it.m_Image; // copy the smart pointer
@@ -124,7 +124,7 @@ public:
   /** Constructor establishes an iterator to walk a particular image and a
    * particular region of that image. */
   ImageConstIterator(const ImageType * ptr, const RegionType & region)
-    : m_Buffer(const_cast<ImageType *>(ptr)->GetBuffer())
+    : m_Buffer(const_cast<BufferType *>(ptr->GetBuffer().GetPointer()))
   {
     m_Image = ptr;
     SetRegion(region);
@@ -0,0 +1,168 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLELabelStatisticsImageFilter_h
+#define itkRLELabelStatisticsImageFilter_h
+
+#include "itkContinuousIndex.h"
+#include "itkImageSink.h"
+#include "itkRLEImage.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+/** \class RLELabelStatisticsImageFilter
+ * \brief Compute the number of pixels, the bounding box and the centroid of
+ * each label of a RLEImage.
+ *
+ * The statistics are accumulated once per run, from its length and its
+ * extent, instead of once per pixel. A compacted input is not expanded.
+ * All the values found in the image, including the background, are labels.
+ *
+ * \sa LabelStatisticsImageFilter, LabelShapeStatisticsImageFilter
+ * \ingroup RLEImage
+ */
+template <typename TInputImage>
+class ITK_TEMPLATE_EXPORT RLELabelStatisticsImageFilter : public ImageSink<TInputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RLELabelStatisticsImageFilter);
+
+  /** Standard Self type alias */
+  using Self = RLELabelStatisticsImageFilter;
+  using Superclass = ImageSink<TInputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(RLELabelStatisticsImageFilter);
+
+  /** Image related type alias. */
+  using InputImageType = TInputImage;
+  using LabelPixelType = typename TInputImage::PixelType;
+  using RegionType = typename TInputImage::RegionType;
+  using IndexType = typename TInputImage::IndexType;
+  using CentroidType = ContinuousIndex<double, TInputImage::ImageDimension>;
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Statistics of a label. */
+  class LabelStatistics
+  {
+  public:
+    LabelStatistics()
+    {
+      m_Minimum.Fill(NumericTraits<IndexValueType>::max());
+      m_Maximum.Fill(NumericTraits<IndexValueType>::NonpositiveMin());
+    }
+
+    SizeValueType m_Count{ 0 };
+    IndexType     m_Minimum;
+    IndexType     m_Maximum;
+    CentroidType  m_Sum{};
+  };
+
+  /** Type of the map used to store data per label */
+  using MapType = std::unordered_map<LabelPixelType, LabelStatistics>;
+  using ValidLabelValuesContainerType = std::vector<LabelPixelType>;
+
+  /** Does the specified label exist? Can only be called after a call
+   * a call to Update(). */
+  bool
+  HasLabel(LabelPixelType label) const
+  {
+    return m_LabelStatistics.find(label) != m_LabelStatistics.end();
+  }
+
+  /** Get the number of labels found in the image. */
+  [[nodiscard]] SizeValueType
+  GetNumberOfLabels() const
+  {
+    return static_cast<SizeValueType>(m_LabelStatistics.size());
+  }
+
+  /** Get the labels found in the image, in increasing order. */
+  [[nodiscard]] const ValidLabelValuesContainerType &
+  GetValidLabelValues() const
+  {
+    return m_ValidLabelValues;
+  }
+
+  /** Return the number of pixels of a label, or zero if it is not found. */
+  SizeValueType
+  GetCount(LabelPixelType label) const;
+
+  /** Return the smallest region containing the pixels of a label, or an
+   * empty region if it is not found. */
+  RegionType
+  GetBoundingBox(LabelPixelType label) const;
+
+  /** Return the mean index of the pixels of a label. */
+  CentroidType
+  GetCentroid(LabelPixelType label) const;
+
+  // Change the access from protected to public to expose streaming option, a using statement can not be used due to
+  // limitations of wrapping.
+  void
+  SetNumberOfStreamDivisions(const unsigned int n) override
+  {
+    Superclass::SetNumberOfStreamDivisions(n);
+  }
+  [[nodiscard]] unsigned int
+  GetNumberOfStreamDivisions() const override
+  {
+    return Superclass::GetNumberOfStreamDivisions();
+  }
+
+protected:
+  RLELabelStatisticsImageFilter() = default;
+  ~RLELabelStatisticsImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  BeforeStreamedGenerateData() override
+  {
+    this->AllocateOutputs();
+    m_LabelStatistics.clear();
+  }
+
+  /** Update the cached vector of valid labels. */
+  void
+  AfterStreamedGenerateData() override;
+
+  void
+  ThreadedStreamedGenerateData(const RegionType &) override;
+
+private:
+  MapType                       m_LabelStatistics{};
+  ValidLabelValuesContainerType m_ValidLabelValues{};
+
+  std::mutex m_Mutex{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRLELabelStatisticsImageFilter.hxx"
+#endif
+
+#endif // itkRLELabelStatisticsImageFilter_h
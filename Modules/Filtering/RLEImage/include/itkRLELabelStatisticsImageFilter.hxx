@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLELabelStatisticsImageFilter_hxx
+#define itkRLELabelStatisticsImageFilter_hxx
+
+#include "itkIndexRange.h"
+#include <algorithm> // For min, max and sort.
+
+namespace itk
+{
+template <typename TInputImage>
+void
+RLELabelStatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread)
+{
+  const InputImageType * input = this->GetInput();
+  const IndexValueType   bri0 = input->GetBufferedRegion().GetIndex(0);
+  const IndexValueType   first0 = regionForThread.GetIndex(0);
+  const IndexValueType   last0 = first0 + static_cast<IndexValueType>(regionForThread.GetSize(0));
+  if (first0 == last0)
+  {
+    return;
+  }
+
+  MapType localStatistics;
+  auto    mapIt = localStatistics.end();
+
+  IndexType index;
+  for (const auto & lineIndex : ImageRegionIndexRange<ImageDimension - 1>(regionForThread.Slice(0)))
+  {
+    for (unsigned int d = 1; d < ImageDimension; ++d)
+    {
+      index[d] = lineIndex[d - 1];
+    }
+
+    // clip the runs of the line to the region
+    IndexValueType start = bri0;
+    for (const auto & segment : input->GetSegments(input->ComputeLineNumber(lineIndex)))
+    {
+      const IndexValueType end = start + static_cast<IndexValueType>(segment.first);
+      const IndexValueType clippedStart = std::max(start, first0);
+      const IndexValueType clippedEnd = std::min(end, last0);
+      start = end;
+      if (clippedStart >= clippedEnd)
+      {
+        if (end >= last0)
+        {
+          break;
+        }
+        continue;
+      }
+
+      if (mapIt == localStatistics.end() || mapIt->first != segment.second)
+      {
+        mapIt = localStatistics.try_emplace(segment.second).first;
+      }
+      LabelStatistics & labelStats = mapIt->second;
+
+      const auto count = static_cast<SizeValueType>(clippedEnd - clippedStart);
+      labelStats.m_Count += count;
+      index[0] = clippedStart;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        labelStats.m_Minimum[d] = std::min(labelStats.m_Minimum[d], index[d]);
+        labelStats.m_Maximum[d] = std::max(labelStats.m_Maximum[d], index[d]);
+        labelStats.m_Sum[d] += static_cast<double>(count) * static_cast<double>(index[d]);
+      }
+      // the run covers [clippedStart, clippedEnd - 1] along the first axis
+      labelStats.m_Maximum[0] = std::max(labelStats.m_Maximum[0], clippedEnd - 1);
+      labelStats.m_Sum[0] += static_cast<double>(count) * static_cast<double>(count - 1) / 2.0;
+    }
+  }
+
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  for (auto & localValue : localStatistics)
+  {
+    auto labelIt = m_LabelStatistics.find(localValue.first);
+    if (labelIt == m_LabelStatistics.end())
+    {
+      m_LabelStatistics.emplace(localValue.first, localValue.second);
+      continue;
+    }
+    LabelStatistics & labelStats = labelIt->second;
+    labelStats.m_Count += localValue.second.m_Count;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      labelStats.m_Minimum[d] = std::min(labelStats.m_Minimum[d], localValue.second.m_Minimum[d]);
+      labelStats.m_Maximum[d] = std::max(labelStats.m_Maximum[d], localValue.second.m_Maximum[d]);
+      labelStats.m_Sum[d] += localValue.second.m_Sum[d];
+    }
+  }
+}
+
+template <typename TInputImage>
+void
+RLELabelStatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
+{
+  Superclass::AfterStreamedGenerateData();
+
+  m_ValidLabelValues.clear();
+  m_ValidLabelValues.reserve(m_LabelStatistics.size());
+  for (const auto & mapValue : m_LabelStatistics)
+  {
+    m_ValidLabelValues.push_back(mapValue.first);
+  }
+  std::sort(m_ValidLabelValues.begin(), m_ValidLabelValues.end());
+}
+
+template <typename TInputImage>
+SizeValueType
+RLELabelStatisticsImageFilter<TInputImage>::GetCount(LabelPixelType label) const
+{
+  const auto mapIt = m_LabelStatistics.find(label);
+  return mapIt == m_LabelStatistics.end() ? 0 : mapIt->second.m_Count;
+}
+
+template <typename TInputImage>
+auto
+RLELabelStatisticsImageFilter<TInputImage>::GetBoundingBox(LabelPixelType label) const -> RegionType
+{
+  RegionType region;
+  const auto mapIt = m_LabelStatistics.find(label);
+  if (mapIt != m_LabelStatistics.end())
+  {
+    region.SetIndex(mapIt->second.m_Minimum);
+    region.SetUpperIndex(mapIt->second.m_Maximum);
+  }
+  return region;
+}
+
+template <typename TInputImage>
+auto
+RLELabelStatisticsImageFilter<TInputImage>::GetCentroid(LabelPixelType label) const -> CentroidType
+{
+  CentroidType centroid{};
+  const auto   mapIt = m_LabelStatistics.find(label);
+  if (mapIt != m_LabelStatistics.end())
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      centroid[d] = mapIt->second.m_Sum[d] / static_cast<double>(mapIt->second.m_Count);
+    }
+  }
+  return centroid;
+}
+
+template <typename TInputImage>
+void
+RLELabelStatisticsImageFilter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of labels: " << m_LabelStatistics.size() << std::endl;
+}
+} // end namespace itk
+
+#endif // itkRLELabelStatisticsImageFilter_hxx
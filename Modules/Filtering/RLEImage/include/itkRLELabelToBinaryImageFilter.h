@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLELabelToBinaryImageFilter_h
+#define itkRLELabelToBinaryImageFilter_h
+
+#include "itkBinaryThresholdImageFilter.h"
+#include "itkRLEUnaryFunctorImageFilter.h"
+
+namespace itk
+{
+/** \class RLELabelToBinaryImageFilter
+ * \brief Convert a label RLEImage to a binary RLEImage.
+ *
+ * The pixels with the BackgroundValue get the OutputBackgroundValue, and
+ * all the labelled pixels get the ForegroundValue. Each run is converted
+ * once, adjacent runs of different labels are merged, and the output is a
+ * compacted RLEImage.
+ *
+ * \sa LabelMapToBinaryImageFilter, RLEBinaryThresholdImageFilter
+ * \ingroup RLEImage
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT RLELabelToBinaryImageFilter
+  : public RLEUnaryFunctorImageFilter<
+      TInputImage,
+      TOutputImage,
+      Functor::BinaryThreshold<typename TInputImage::PixelType, typename TOutputImage::PixelType>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RLELabelToBinaryImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = RLELabelToBinaryImageFilter;
+  using Superclass = RLEUnaryFunctorImageFilter<
+    TInputImage,
+    TOutputImage,
+    Functor::BinaryThreshold<typename TInputImage::PixelType, typename TOutputImage::PixelType>>;
+
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(RLELabelToBinaryImageFilter);
+
+  /** Pixel types. */
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  /** Set/Get the label of the background in the input image. Defaults to zero. */
+  /** @ITKStartGrouping */
+  itkSetMacro(BackgroundValue, InputPixelType);
+  itkGetConstReferenceMacro(BackgroundValue, InputPixelType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the value of the labelled pixels in the output image.
+   * Defaults to NumericTraits<OutputPixelType>::max(). */
+  /** @ITKStartGrouping */
+  itkSetMacro(ForegroundValue, OutputPixelType);
+  itkGetConstReferenceMacro(ForegroundValue, OutputPixelType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the value of the background pixels in the output image. Defaults to zero. */
+  /** @ITKStartGrouping */
+  itkSetMacro(OutputBackgroundValue, OutputPixelType);
+  itkGetConstReferenceMacro(OutputBackgroundValue, OutputPixelType);
+  /** @ITKEndGrouping */
+
+protected:
+  RLELabelToBinaryImageFilter() = default;
+  ~RLELabelToBinaryImageFilter() override = default;
+
+  /** The background is the single value inside the thresholds. */
+  void
+  BeforeThreadedGenerateData() override
+  {
+    this->GetFunctor().SetLowerThreshold(m_BackgroundValue);
+    this->GetFunctor().SetUpperThreshold(m_BackgroundValue);
+    this->GetFunctor().SetInsideValue(m_OutputBackgroundValue);
+    this->GetFunctor().SetOutsideValue(m_ForegroundValue);
+  }
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override
+  {
+    Superclass::PrintSelf(os, indent);
+
+    os << indent
+       << "BackgroundValue: " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(m_BackgroundValue)
+       << std::endl;
+    os << indent
+       << "ForegroundValue: " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_ForegroundValue)
+       << std::endl;
+    os << indent << "OutputBackgroundValue: "
+       << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_OutputBackgroundValue) << std::endl;
+  }
+
+private:
+  InputPixelType  m_BackgroundValue{};
+  OutputPixelType m_ForegroundValue{ NumericTraits<OutputPixelType>::max() };
+  OutputPixelType m_OutputBackgroundValue{};
+};
+} // end namespace itk
+
+#endif // itkRLELabelToBinaryImageFilter_h
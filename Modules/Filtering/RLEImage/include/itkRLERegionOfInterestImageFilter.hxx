@@ -21,6 +21,7 @@
 
 #include "itkImage.h"
 #include "itkImageAlgorithm.h"
+#include "itkIndexRange.h"
 #include "itkObjectFactory.h"
 #include "itkRegionOfInterestImageFilter.h"
 #include <typeinfo>
@@ -29,19 +30,25 @@ namespace itk
 {
 template <typename RLEImageTypeIn, typename RLEImageTypeOut>
 void
-copyImagePortion(ImageRegionConstIterator<typename RLEImageTypeIn::BufferType> iIt,
-                 ImageRegionIterator<typename RLEImageTypeOut::BufferType>     oIt,
-                 IndexValueType                                                start0,
-                 IndexValueType                                                end0)
+copyImagePortion(const RLEImageTypeIn *                                    in,
+                 const typename RLEImageTypeIn::BufferType::RegionType &   iReg,
+                 ImageRegionIterator<typename RLEImageTypeOut::BufferType> oIt,
+                 IndexValueType                                            start0,
+                 IndexValueType                                            end0)
 {
-  while (!oIt.IsAtEnd())
+  // the runs are counted from the beginning of the buffered lines
+  start0 -= in->GetBufferedRegion().GetIndex(0);
+  end0 -= in->GetBufferedRegion().GetIndex(0);
+
+  // the input lines are read without expanding a compacted input
+  for (const auto & lineIndex : ImageRegionIndexRange<RLEImageTypeIn::ImageDimension - 1>(iReg))
   {
     // determine begin and end iterator and copy range
     typename RLEImageTypeOut::RLLine & oLine = oIt.Value();
     oLine.clear();
-    const typename RLEImageTypeIn::RLLine & iLine = iIt.Value();
-    typename RLEImageTypeIn::RLCounterType  t = 0;
-    SizeValueType                           x = 0;
+    const typename RLEImageTypeIn::RLSegmentRange iLine = in->GetSegments(in->ComputeLineNumber(lineIndex));
+    typename RLEImageTypeIn::RLCounterType        t = 0;
+    SizeValueType                                 x = 0;
     // find start
     for (; x < iLine.size(); x++)
     {
@@ -58,7 +65,6 @@ copyImagePortion(ImageRegionConstIterator<typename RLEImageTypeIn::BufferType> i
     {
       oLine.push_back(
         typename RLEImageTypeOut::RLSegment(typename RLEImageTypeOut::RLCounterType(end0 - start0), iLine[x].second));
-      ++iIt;
       ++oIt;
       continue; // next line
     }
@@ -87,7 +93,6 @@ copyImagePortion(ImageRegionConstIterator<typename RLEImageTypeIn::BufferType> i
         typename RLEImageTypeOut::RLCounterType(end0 + iLine[x].first - t), iLine[x].second));
     }
 
-    ++iIt;
     ++oIt;
   }
 } // copyImagePortion
@@ -213,24 +218,22 @@ RegionOfInterestImageFilter<
   inputRegionForThread.SetIndex(start);
 
   bool copyLines = (in->GetLargestPossibleRegion().GetSize(0) == outRegion.GetSize(0));
-  typename ImageType::BufferType::RegionType               oReg = outRegion.Slice(0);
-  typename ImageType::BufferType::RegionType               iReg = inputRegionForThread.Slice(0);
-  ImageRegionConstIterator<typename ImageType::BufferType> iIt(in->GetBuffer(), iReg);
-  ImageRegionIterator<typename ImageType::BufferType>      oIt(out->GetBuffer(), oReg);
+  typename ImageType::BufferType::RegionType          oReg = outRegion.Slice(0);
+  typename ImageType::BufferType::RegionType          iReg = inputRegionForThread.Slice(0);
+  ImageRegionIterator<typename ImageType::BufferType> oIt(out->GetBuffer(), oReg);
 
   if (copyLines)
   {
-    while (!oIt.IsAtEnd())
+    for (const auto & lineIndex : ImageRegionIndexRange<VImageDimension - 1>(iReg))
     {
-      oIt.Set(iIt.Get());
-
-      ++iIt;
+      const typename ImageType::RLSegmentRange iLine = in->GetSegments(in->ComputeLineNumber(lineIndex));
+      oIt.Value().assign(iLine.begin(), iLine.end());
       ++oIt;
     }
   }
   else
   {
-    copyImagePortion<ImageType, ImageType>(iIt, oIt, start[0], end[0]);
+    copyImagePortion<ImageType, ImageType>(in, iReg, oIt, start[0], end[0]);
   }
 } // DynamicThreadedGenerateData
 
@@ -374,12 +377,11 @@ RegionOfInterestImageFilter<RLEImage<TPixelIn, VImageDimension, CounterTypeIn>,
   }
   inputRegionForThread.SetIndex(start);
 
-  typename RLEImageTypeIn::BufferType::RegionType               iReg = inputRegionForThread.Slice(0);
-  typename RLEImageTypeOut::BufferType::RegionType              oReg = outRegion.Slice(0);
-  ImageRegionConstIterator<typename RLEImageTypeIn::BufferType> iIt(in->GetBuffer(), iReg);
-  ImageRegionIterator<typename RLEImageTypeOut::BufferType>     oIt(out->GetBuffer(), oReg);
+  typename RLEImageTypeIn::BufferType::RegionType           iReg = inputRegionForThread.Slice(0);
+  typename RLEImageTypeOut::BufferType::RegionType          oReg = outRegion.Slice(0);
+  ImageRegionIterator<typename RLEImageTypeOut::BufferType> oIt(out->GetBuffer(), oReg);
 
-  copyImagePortion<RLEImageTypeIn, RLEImageTypeOut>(iIt, oIt, start[0], end[0]);
+  copyImagePortion<RLEImageTypeIn, RLEImageTypeOut>(in, iReg, oIt, start[0], end[0]);
 } // DynamicThreadedGenerateData
 
 template <typename TPixel, unsigned int VImageDimension, typename CounterType>
@@ -633,15 +635,19 @@ RegionOfInterestImageFilter<RLEImage<TPixel, VImageDimension, CounterType>, Imag
   }
   inputRegionForThread.SetIndex(start);
 
-  typename RLEImageType::BufferType::RegionType               iReg = inputRegionForThread.Slice(0);
-  ImageRegionConstIterator<typename RLEImageType::BufferType> iIt(in->GetBuffer(), iReg);
-  ImageRegionIterator<ImageType>                              oIt(out, outputRegionForThread);
+  typename RLEImageType::BufferType::RegionType iReg = inputRegionForThread.Slice(0);
+  ImageRegionIterator<ImageType>                oIt(out, outputRegionForThread);
+
+  // the runs are counted from the beginning of the buffered lines
+  start[0] -= in->GetBufferedRegion().GetIndex(0);
+  end[0] -= in->GetBufferedRegion().GetIndex(0);
 
-  while (!iIt.IsAtEnd())
+  // the input lines are read without expanding a compacted input
+  for (const auto & lineIndex : ImageRegionIndexRange<VImageDimension - 1>(iReg))
   {
-    const typename RLEImageType::RLLine & iLine = iIt.Value();
-    CounterType                           t = 0;
-    SizeValueType                         x = 0;
+    const typename RLEImageType::RLSegmentRange iLine = in->GetSegments(in->ComputeLineNumber(lineIndex));
+    CounterType                                 t = 0;
+    SizeValueType                               x = 0;
     // find start
     for (; x < iLine.size(); x++)
     {
@@ -660,7 +666,6 @@ RegionOfInterestImageFilter<RLEImage<TPixel, VImageDimension, CounterType>, Imag
         oIt.Set(iLine[x].second);
         ++oIt;
       }
-      ++iIt;
       continue; // next line
     }
     // else handle the beginning segment
@@ -689,7 +694,6 @@ RegionOfInterestImageFilter<RLEImage<TPixel, VImageDimension, CounterType>, Imag
       oIt.Set(iLine[x].second);
       ++oIt;
     }
-    ++iIt;
   }
 } // DynamicThreadedGenerateData
 } // end namespace itk
@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLEUnaryFunctorImageFilter_h
+#define itkRLEUnaryFunctorImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkRLEImage.h"
+
+namespace itk
+{
+/** \class RLEUnaryFunctorImageFilter
+ * \brief Apply a function to the values of the segments of a RLEImage.
+ *
+ * The function is evaluated once per segment instead of once per pixel,
+ * and the adjacent segments which get the same value are merged. The
+ * lines of the input are read with RLEImage::GetSegments(), so a compacted
+ * input is not expanded, and the output is a compacted RLEImage.
+ *
+ * The function is set with SetFunctor(), like for UnaryFunctorImageFilter.
+ * Subclasses which configure the functor from their own parameters do it
+ * in BeforeThreadedGenerateData().
+ *
+ * \sa UnaryFunctorImageFilter, RLEChangeLabelImageFilter, RLEBinaryThresholdImageFilter
+ * \ingroup RLEImage
+ */
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+class ITK_TEMPLATE_EXPORT RLEUnaryFunctorImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RLEUnaryFunctorImageFilter);
+
+  /** Standard class type alias. */
+  using Self = RLEUnaryFunctorImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(RLEUnaryFunctorImageFilter);
+
+  /** Some type alias. */
+  using FunctorType = TFunction;
+  using InputImageType = TInputImage;
+  using InputImagePixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputImagePixelType = typename OutputImageType::PixelType;
+  using InputRLSegmentType = typename InputImageType::RLSegment;
+  using OutputRLSegmentType = typename OutputImageType::RLSegment;
+  using OutputRLCounterType = typename OutputImageType::RLCounterType;
+
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+  /** Get the functor object.  The functor is returned by reference.
+   * (Functors do not have to derive from itk::LightObject, so they do
+   * not necessarily have a reference count. So we cannot return a
+   * SmartPointer.) */
+  /** @ITKStartGrouping */
+  FunctorType &
+  GetFunctor()
+  {
+    return m_Functor;
+  }
+  const FunctorType &
+  GetFunctor() const
+  {
+    return m_Functor;
+  }
+  /** @ITKEndGrouping */
+
+  /** Set the functor object.  This replaces the current Functor with a
+   * copy of the specified Functor. */
+  void
+  SetFunctor(const FunctorType & functor)
+  {
+    if (m_Functor != functor)
+    {
+      m_Functor = functor;
+      this->Modified();
+    }
+  }
+
+  itkConceptMacro(SameDimensionCheck,
+                  (Concept::SameDimension<TInputImage::ImageDimension, TOutputImage::ImageDimension>));
+
+protected:
+  RLEUnaryFunctorImageFilter() = default;
+  ~RLEUnaryFunctorImageFilter() override = default;
+
+  /** The whole input is needed, as the output is produced line by line. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+  /** Write the segments of a line of the output to outputSegments, unless it
+   * is nullptr, and return their number. */
+  SizeValueType
+  ProcessLine(SizeValueType lineNumber, OutputRLSegmentType * outputSegments) const;
+
+private:
+  FunctorType m_Functor{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRLEUnaryFunctorImageFilter.hxx"
+#endif
+
+#endif // itkRLEUnaryFunctorImageFilter_h
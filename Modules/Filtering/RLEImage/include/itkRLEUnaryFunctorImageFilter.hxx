@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRLEUnaryFunctorImageFilter_hxx
+#define itkRLEUnaryFunctorImageFilter_hxx
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+RLEUnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+RLEUnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  // call the superclass' implementation of this method
+  Superclass::EnlargeOutputRequestedRegion(output);
+
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+SizeValueType
+RLEUnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::ProcessLine(
+  SizeValueType         lineNumber,
+  OutputRLSegmentType * outputSegments) const
+{
+  SizeValueType numberOfSegments = 0;
+  OutputRLSegmentType segment(0, OutputImagePixelType{});
+  for (const InputRLSegmentType & inputSegment : this->GetInput()->GetSegments(lineNumber))
+  {
+    const OutputImagePixelType value = m_Functor(inputSegment.second);
+    if (numberOfSegments > 0 && value == segment.second)
+    {
+      // merge with the previous segment
+      segment.first += static_cast<OutputRLCounterType>(inputSegment.first);
+    }
+    else
+    {
+      if (numberOfSegments > 0 && outputSegments)
+      {
+        outputSegments[numberOfSegments - 1] = segment;
+      }
+      segment = OutputRLSegmentType(static_cast<OutputRLCounterType>(inputSegment.first), value);
+      ++numberOfSegments;
+    }
+  }
+  if (numberOfSegments > 0 && outputSegments)
+  {
+    outputSegments[numberOfSegments - 1] = segment;
+  }
+  return numberOfSegments;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+RLEUnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateData()
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  this->BeforeThreadedGenerateData();
+
+  itkAssertOrThrowMacro(input->GetLargestPossibleRegion().GetSize(0) <=
+                          SizeValueType(NumericTraits<OutputRLCounterType>::max()),
+                        "The counter type of the output is not large enough for the X dimension of the image!");
+  output->SetBufferedRegion(input->GetBufferedRegion());
+  const SizeValueType numberOfLines = input->GetNumberOfLines();
+
+  // count the segments of each line, then write them at the offsets given
+  // by the prefix sums of the counts
+  MultiThreaderBase *        multiThreader = this->GetMultiThreader();
+  std::vector<SizeValueType> lineOffsets(numberOfLines + 1, 0);
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfLines,
+    [this, &lineOffsets](SizeValueType line) { lineOffsets[line + 1] = this->ProcessLine(line, nullptr); },
+    nullptr);
+  for (SizeValueType line = 0; line < numberOfLines; ++line)
+  {
+    lineOffsets[line + 1] += lineOffsets[line];
+  }
+
+  std::vector<OutputRLSegmentType> segments(lineOffsets[numberOfLines]);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfLines,
+    [this, &lineOffsets, &segments](SizeValueType line) {
+      this->ProcessLine(line, segments.data() + lineOffsets[line]);
+    },
+    this);
+
+  output->SetCompactedLines(std::move(segments), std::move(lineOffsets));
+
+  this->AfterThreadedGenerateData();
+}
+} // end namespace itk
+
+#endif // itkRLEUnaryFunctorImageFilter_hxx
@@ -3,6 +3,8 @@ itk_module(
   ENABLE_SHARED
   DEPENDS
     ITKImageGrid
+    ITKImageLabel
+    ITKThresholding
   TEST_DEPENDS
     ITKTestKernel
   EXCLUDE_FROM_DEFAULT
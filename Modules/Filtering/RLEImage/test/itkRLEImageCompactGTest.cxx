@@ -0,0 +1,381 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageAlgorithm.h"
+#include "itkMultiThreaderBase.h"
+#include "itkRLEBinaryThresholdImageFilter.h"
+#include "itkRLEChangeLabelImageFilter.h"
+#include "itkRLEConstantPadImageFilter.h"
+#include "itkRLEImage.h"
+#include "itkRLELabelStatisticsImageFilter.h"
+#include "itkRLELabelToBinaryImageFilter.h"
+#include "itkRLERegionOfInterestImageFilter.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+
+// Checks the compacted storage of RLEImage and the run-length filters
+// against pixel-wise expectations.
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PixelType = short;
+using RLEType = itk::RLEImage<PixelType, Dimension>;
+using ImageType = itk::Image<PixelType, Dimension>;
+using BinaryRLEType = itk::RLEImage<unsigned char, Dimension>;
+
+RLEType::RegionType
+MakeRegion()
+{
+  RLEType::SizeType  size = { { 17, 5, 4 } };
+  RLEType::IndexType start = { { 2, -1, 3 } };
+  return RLEType::RegionType{ start, size };
+}
+
+PixelType
+LabelAt(const RLEType::IndexType & index)
+{
+  return static_cast<PixelType>((index[0] / 3 + index[1] * (index[2] % 2)) % 4);
+}
+
+RLEType::Pointer
+MakeLabelImage()
+{
+  const auto region = MakeRegion();
+
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(LabelAt(it.GetIndex()));
+  }
+
+  auto rle = RLEType::New();
+  rle->SetRegions(region);
+  rle->Allocate();
+  itk::ImageAlgorithm::Copy<ImageType, RLEType>(image.GetPointer(), rle.GetPointer(), region, region);
+  return rle;
+}
+
+// Read every pixel with GetPixel(), which does not expand a compacted image.
+template <typename TImage, typename TFunction>
+void
+ExpectPixels(const TImage * image, TFunction expected)
+{
+  const auto region = image->GetLargestPossibleRegion();
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    ASSERT_EQ(image->GetPixel(index), expected(index)) << "Mismatch at " << index;
+  }
+}
+} // namespace
+
+TEST(RLEImageCompact, CompactAndExpand)
+{
+  auto rle = MakeLabelImage();
+  EXPECT_FALSE(rle->GetCompacted());
+
+  rle->Compact();
+  EXPECT_TRUE(rle->GetCompacted());
+  EXPECT_EQ(rle->GetNumberOfLines(), 5u * 4u);
+  ExpectPixels(rle.GetPointer(), LabelAt);
+  EXPECT_TRUE(rle->GetCompacted());
+
+  // const iterators keep the image compacted
+  for (itk::ImageRegionConstIteratorWithIndex<RLEType> it(rle, rle->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), LabelAt(it.GetIndex())) << "Mismatch at " << it.GetIndex();
+  }
+  EXPECT_TRUE(rle->GetCompacted());
+
+  rle->Expand();
+  EXPECT_FALSE(rle->GetCompacted());
+  ExpectPixels(rle.GetPointer(), LabelAt);
+}
+
+TEST(RLEImageCompact, ConcurrentReadersKeepCompactedLines)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+  const RLEType * input = rle.GetPointer();
+  const auto      region = rle->GetLargestPossibleRegion();
+
+  // half of the work units read with const iterators, the others with GetSegments()
+  std::atomic<int> mismatches{ 0 };
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    16,
+    [input, region, &mismatches](itk::SizeValueType i) {
+      if (i % 2 == 0)
+      {
+        for (itk::ImageRegionConstIteratorWithIndex<RLEType> it(input, region); !it.IsAtEnd(); ++it)
+        {
+          mismatches += it.Get() != LabelAt(it.GetIndex());
+        }
+      }
+      else
+      {
+        for (itk::SizeValueType line = 0; line < input->GetNumberOfLines(); ++line)
+        {
+          itk::SizeValueType length = 0;
+          for (const auto & segment : input->GetSegments(line))
+          {
+            length += segment.first;
+          }
+          mismatches += length != region.GetSize(0);
+        }
+      }
+    },
+    nullptr);
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_TRUE(rle->GetCompacted());
+}
+
+TEST(RLEImageCompact, IteratorWritesExpand)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  const RLEType::IndexType changed = { { 5, 1, 4 } };
+  for (itk::ImageRegionIteratorWithIndex<RLEType> it(rle, rle->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.GetIndex() == changed)
+    {
+      it.Set(9);
+    }
+  }
+  EXPECT_FALSE(rle->GetCompacted());
+  ExpectPixels(rle.GetPointer(),
+               [&changed](const RLEType::IndexType & index) { return index == changed ? 9 : LabelAt(index); });
+}
+
+TEST(RLEImageCompact, SetPixelExpands)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  const RLEType::IndexType changed = { { 5, 1, 4 } };
+  rle->SetPixel(changed, 9);
+  EXPECT_FALSE(rle->GetCompacted());
+  ExpectPixels(rle.GetPointer(),
+               [&changed](const RLEType::IndexType & index) { return index == changed ? 9 : LabelAt(index); });
+}
+
+TEST(RLEImageCompact, FillBufferKeepsCompacted)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+  rle->FillBuffer(3);
+  EXPECT_TRUE(rle->GetCompacted());
+  for (itk::SizeValueType line = 0; line < rle->GetNumberOfLines(); ++line)
+  {
+    EXPECT_EQ(rle->GetSegments(line).size(), 1u);
+  }
+  ExpectPixels(rle.GetPointer(), [](const RLEType::IndexType &) { return 3; });
+}
+
+TEST(RLEImageCompact, ChangeLabel)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  using FilterType = itk::RLEChangeLabelImageFilter<RLEType>;
+  auto filter = FilterType::New();
+  filter->SetInput(rle);
+  filter->SetChange(1, 2);
+  filter->SetChange(3, 7);
+  filter->Update();
+
+  const std::map<PixelType, PixelType> changes = { { 1, 2 }, { 3, 7 } };
+  const RLEType *                      output = filter->GetOutput();
+  EXPECT_TRUE(output->GetCompacted());
+  EXPECT_TRUE(rle->GetCompacted());
+  ExpectPixels(output, [&changes](const RLEType::IndexType & index) {
+    const auto it = changes.find(LabelAt(index));
+    return it == changes.end() ? LabelAt(index) : it->second;
+  });
+
+  // adjacent runs which get the same label are merged
+  for (itk::SizeValueType line = 0; line < output->GetNumberOfLines(); ++line)
+  {
+    const auto segments = output->GetSegments(line);
+    for (std::size_t i = 1; i < segments.size(); ++i)
+    {
+      EXPECT_NE(segments[i - 1].second, segments[i].second);
+    }
+  }
+}
+
+TEST(RLEImageCompact, BinaryThreshold)
+{
+  auto rle = MakeLabelImage();
+
+  using FilterType = itk::RLEBinaryThresholdImageFilter<RLEType, BinaryRLEType>;
+  auto filter = FilterType::New();
+  filter->SetInput(rle);
+  filter->SetLowerThreshold(1);
+  filter->SetUpperThreshold(2);
+  filter->SetInsideValue(255);
+  filter->SetOutsideValue(0);
+  filter->Update();
+
+  ExpectPixels(filter->GetOutput(), [](const RLEType::IndexType & index) {
+    const PixelType label = LabelAt(index);
+    return static_cast<unsigned char>(label >= 1 && label <= 2 ? 255 : 0);
+  });
+}
+
+TEST(RLEImageCompact, LabelToBinary)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  using FilterType = itk::RLELabelToBinaryImageFilter<RLEType, BinaryRLEType>;
+  auto filter = FilterType::New();
+  filter->SetInput(rle);
+  filter->SetForegroundValue(1);
+  filter->Update();
+
+  ExpectPixels(filter->GetOutput(), [](const RLEType::IndexType & index) {
+    return static_cast<unsigned char>(LabelAt(index) != 0 ? 1 : 0);
+  });
+}
+
+TEST(RLEImageCompact, LabelStatistics)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  using FilterType = itk::RLELabelStatisticsImageFilter<RLEType>;
+  auto filter = FilterType::New();
+  filter->SetInput(rle);
+  filter->Update();
+  EXPECT_TRUE(rle->GetCompacted());
+
+  // pixel-wise reference
+  std::map<PixelType, itk::SizeValueType>       counts;
+  std::map<PixelType, FilterType::CentroidType> sums;
+  std::map<PixelType, RLEType::IndexType>       minima;
+  std::map<PixelType, RLEType::IndexType>       maxima;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(MakeRegion()))
+  {
+    const PixelType label = LabelAt(index);
+    if (counts[label]++ == 0)
+    {
+      sums[label].Fill(0.0);
+      minima[label] = index;
+      maxima[label] = index;
+    }
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      sums[label][d] += index[d];
+      minima[label][d] = std::min(minima[label][d], index[d]);
+      maxima[label][d] = std::max(maxima[label][d], index[d]);
+    }
+  }
+
+  ASSERT_EQ(filter->GetNumberOfLabels(), counts.size());
+  ASSERT_EQ(filter->GetValidLabelValues().size(), counts.size());
+  for (const auto & labelCount : counts)
+  {
+    const PixelType label = labelCount.first;
+    ASSERT_TRUE(filter->HasLabel(label));
+    EXPECT_EQ(filter->GetCount(label), labelCount.second);
+    EXPECT_EQ(filter->GetBoundingBox(label).GetIndex(), minima[label]);
+    EXPECT_EQ(filter->GetBoundingBox(label).GetUpperIndex(), maxima[label]);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      EXPECT_NEAR(filter->GetCentroid(label)[d], sums[label][d] / labelCount.second, 1e-9);
+    }
+  }
+  EXPECT_FALSE(filter->HasLabel(42));
+  EXPECT_EQ(filter->GetCount(42), 0u);
+}
+
+TEST(RLEImageCompact, ConstantPad)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  using FilterType = itk::RLEConstantPadImageFilter<RLEType>;
+  auto                    filter = FilterType::New();
+  const RLEType::SizeType lower = { { 2, 1, 0 } };
+  const RLEType::SizeType upper = { { 3, 0, 2 } };
+  filter->SetInput(rle);
+  filter->SetPadLowerBound(lower);
+  filter->SetPadUpperBound(upper);
+  filter->SetConstant(5);
+  filter->Update();
+
+  const RLEType * output = filter->GetOutput();
+  const auto      inputRegion = MakeRegion();
+  EXPECT_EQ(output->GetLargestPossibleRegion().GetSize(), (RLEType::SizeType{ { 22, 6, 6 } }));
+  EXPECT_EQ(output->GetLargestPossibleRegion().GetIndex(), (RLEType::IndexType{ { 0, -2, 3 } }));
+  EXPECT_TRUE(output->GetCompacted());
+  ExpectPixels(output, [&inputRegion](const RLEType::IndexType & index) {
+    return inputRegion.IsInside(index) ? LabelAt(index) : PixelType{ 5 };
+  });
+}
+
+TEST(RLEImageCompact, RegionOfInterestOfCompactedImage)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  using FilterType = itk::RegionOfInterestImageFilter<RLEType, RLEType>;
+  auto                      filter = FilterType::New();
+  const RLEType::RegionType roi({ { 4, 0, 4 } }, { { 9, 3, 2 } });
+  filter->SetInput(rle);
+  filter->SetRegionOfInterest(roi);
+  filter->Update();
+  EXPECT_TRUE(rle->GetCompacted());
+
+  const RLEType * output = filter->GetOutput();
+  const auto      outputRegion = output->GetLargestPossibleRegion();
+  EXPECT_EQ(outputRegion.GetSize(), roi.GetSize());
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(outputRegion))
+  {
+    const RLEType::IndexType inputIndex = index + (roi.GetIndex() - outputRegion.GetIndex());
+    ASSERT_EQ(output->GetPixel(index), LabelAt(inputIndex)) << "Mismatch at " << index;
+  }
+}
+
+TEST(RLEImageCompact, RegionOfInterestToImage)
+{
+  auto rle = MakeLabelImage();
+  rle->Compact();
+
+  using FilterType = itk::RegionOfInterestImageFilter<RLEType, ImageType>;
+  auto                      filter = FilterType::New();
+  const RLEType::RegionType roi({ { 3, -1, 5 } }, { { 12, 4, 2 } });
+  filter->SetInput(rle);
+  filter->SetRegionOfInterest(roi);
+  filter->Update();
+  EXPECT_TRUE(rle->GetCompacted());
+
+  const ImageType * output = filter->GetOutput();
+  const auto        outputRegion = output->GetLargestPossibleRegion();
+  EXPECT_EQ(outputRegion.GetSize(), roi.GetSize());
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(outputRegion))
+  {
+    const RLEType::IndexType inputIndex = index + (roi.GetIndex() - outputRegion.GetIndex());
+    ASSERT_EQ(output->GetPixel(index), LabelAt(inputIndex)) << "Mismatch at " << index;
+  }
+}
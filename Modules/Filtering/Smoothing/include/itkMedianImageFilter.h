@@ -36,7 +36,14 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * For the integer pixel types of 8 or 16 bits and large enough
+ * neighborhoods, the median is computed with ColumnHistogramRankCalculator,
+ * whose cost per pixel does not depend on the radius in 2D and grows only
+ * linearly with the radius in 3D. Otherwise the pixels of each
+ * neighborhood are partially sorted.
+ *
  * \sa Image
+ * \sa ColumnHistogramRankCalculator
  * \sa Neighborhood
  * \sa NeighborhoodOperator
  * \sa NeighborhoodIterator
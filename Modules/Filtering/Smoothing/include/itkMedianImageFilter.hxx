@@ -19,6 +19,7 @@
 #define itkMedianImageFilter_hxx
 
 #include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
+#include "itkColumnHistogramRankCalculator.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkImageRegionRange.h"
 #include "itkIndexRange.h"
@@ -50,6 +51,19 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 
   const auto radius = this->GetRadius();
 
+  using RankCalculatorType = ColumnHistogramRankCalculator<InputImageType, OutputImageType>;
+  if constexpr (RankCalculatorType::IsPixelTypeSupported)
+  {
+    if (RankCalculatorType::IsEfficientForRadius(radius))
+    {
+      // The pixels outside the image are replicated from the nearest pixel,
+      // like with the neighborhood ranges below.
+      TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+      RankCalculatorType::Compute(*input, *output, outputRegionForThread, radius, 0.5f, false, progress);
+      return;
+    }
+  }
+
   // Find the data-set boundary "faces" and the center non-boundary subregion.
   const auto calculatorResult =
     NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::Compute(*input, outputRegionForThread, radius);
@@ -15,6 +15,7 @@ itk_module(
     ITKImageSources
   TEST_DEPENDS
     ITKConvolution
+    ITKMathematicalMorphology
     ITKTestKernel
   DESCRIPTION "${DOCUMENTATION}"
 )
@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Benchmark of the main neighborhood filters with the default splitter, which
+// gives each work unit a slab along the slowest dimension, against
+// ImageRegionSplitterCacheTiles, which hands out cache sized tiles to the work
+// units dynamically. The outputs of both runs must be identical.
+
+#include "itkBasicDilateImageFilter.h"
+#include "itkBasicErodeImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionSplitterCacheTiles.h"
+#include "itkLaplacianOperator.h"
+#include "itkMeanImageFilter.h"
+#include "itkMedianImageFilter.h"
+#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkTimeProbesCollectorBase.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+
+ImageType::Pointer
+MakeInput(itk::SizeValueType edgeLength)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(edgeLength));
+  image->Allocate();
+  // Deterministic noise, so that the median and the morphology filters do
+  // not see large flat areas.
+  PixelType *              buffer = image->GetBufferPointer();
+  const itk::SizeValueType numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  unsigned int             state = 12345;
+  for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    state = state * 1664525u + 1013904223u;
+    buffer[i] = static_cast<PixelType>(state >> 16);
+  }
+  return image;
+}
+
+// Time the filter, whose neighborhood has the given radius, with both
+// splitters and check that they give the same output.
+template <typename TFilter>
+bool
+TimeFilter(TFilter *                                 filter,
+           const std::string &                       name,
+           const ImageType::SizeType &               radius,
+           unsigned int                              numberOfRuns,
+           const itk::ImageRegionSplitterCacheTiles * tileSplitter,
+           itk::TimeProbesCollectorBase &            collector)
+{
+  const ImageType::RegionType region = filter->GetInput()->GetLargestPossibleRegion();
+  const ImageType::SizeType   tileSize = tileSplitter->GetTileSize(region, radius);
+  std::cout << name << ": radius " << radius << ", tile size " << tileSize << ", "
+            << itk::ImageRegionSplitterCacheTiles::GetNumberOfTiles(region, tileSize) << " tiles" << std::endl;
+
+  ImageType::Pointer reference;
+  for (const bool tiled : { false, true })
+  {
+    itk::ImageSourceCommon::SetGlobalDefaultSplitter(tiled ? tileSplitter : nullptr);
+    const std::string probeName = name + (tiled ? " tiles" : " slabs");
+    for (unsigned int run = 0; run < numberOfRuns; ++run)
+    {
+      filter->Modified();
+      collector.Start(probeName.c_str());
+      filter->Update();
+      collector.Stop(probeName.c_str());
+    }
+    if (!tiled)
+    {
+      reference = filter->GetOutput();
+      reference->DisconnectPipeline();
+    }
+  }
+  itk::ImageSourceCommon::SetGlobalDefaultSplitter(nullptr);
+
+  const ImageType *        output = filter->GetOutput();
+  const itk::SizeValueType numberOfPixels = reference->GetBufferedRegion().GetNumberOfPixels();
+  if (output->GetBufferedRegion() != reference->GetBufferedRegion() ||
+      !std::equal(reference->GetBufferPointer(),
+                  reference->GetBufferPointer() + numberOfPixels,
+                  output->GetBufferPointer()))
+  {
+    std::cerr << "Result mismatch for " << name << '!' << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageRegionSplitterCacheTilesBenchmark(int argc, char * argv[])
+{
+  if (argc > 5)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv)
+              << " [edgeLength [numberOfRuns [numberOfThreads [cacheSize]]]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const itk::SizeValueType edgeLength = argc > 1 ? std::stoul(argv[1]) : 128;
+  const unsigned int       numberOfRuns = argc > 2 ? std::stoul(argv[2]) : 3;
+  if (argc > 3)
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(std::stoul(argv[3]));
+  }
+  auto tileSplitter = itk::ImageRegionSplitterCacheTiles::New();
+  if (argc > 4)
+  {
+    tileSplitter->SetCacheSize(std::stoul(argv[4]));
+  }
+  // Input and output pixels are read and written for each tile.
+  tileSplitter->SetBytesPerPixel(2 * sizeof(PixelType));
+
+  const ImageType::Pointer input = MakeInput(edgeLength);
+  std::cout << "Threads: " << itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() << std::endl;
+
+  itk::TimeProbesCollectorBase collector;
+  bool                         success = true;
+
+  using MeanFilterType = itk::MeanImageFilter<ImageType, ImageType>;
+  auto mean = MeanFilterType::New();
+  mean->SetInput(input);
+  mean->SetRadius(2);
+  success &= TimeFilter(mean.GetPointer(), "Mean", mean->GetRadius(), numberOfRuns, tileSplitter, collector);
+
+  using MedianFilterType = itk::MedianImageFilter<ImageType, ImageType>;
+  auto median = MedianFilterType::New();
+  median->SetInput(input);
+  median->SetRadius(1);
+  success &= TimeFilter(median.GetPointer(), "Median", median->GetRadius(), numberOfRuns, tileSplitter, collector);
+
+  using OperatorFilterType = itk::NeighborhoodOperatorImageFilter<ImageType, ImageType>;
+  itk::LaplacianOperator<PixelType, Dimension> laplacian;
+  laplacian.CreateOperator();
+  auto neighborhoodOperator = OperatorFilterType::New();
+  neighborhoodOperator->SetInput(input);
+  neighborhoodOperator->SetOperator(laplacian);
+  success &= TimeFilter(neighborhoodOperator.GetPointer(),
+                        "NeighborhoodOperator",
+                        neighborhoodOperator->GetOperator().GetRadius(),
+                        numberOfRuns,
+                        tileSplitter,
+                        collector);
+
+  using KernelType = itk::FlatStructuringElement<Dimension>;
+  auto ball = KernelType::Ball(KernelType::RadiusType::Filled(1));
+
+  using ErodeFilterType = itk::BasicErodeImageFilter<ImageType, ImageType, KernelType>;
+  auto erode = ErodeFilterType::New();
+  erode->SetInput(input);
+  erode->SetKernel(ball);
+  success &= TimeFilter(erode.GetPointer(), "Erode", erode->GetRadius(), numberOfRuns, tileSplitter, collector);
+
+  using DilateFilterType = itk::BasicDilateImageFilter<ImageType, ImageType, KernelType>;
+  auto dilate = DilateFilterType::New();
+  dilate->SetInput(input);
+  dilate->SetKernel(ball);
+  success &= TimeFilter(dilate.GetPointer(), "Dilate", dilate->GetRadius(), numberOfRuns, tileSplitter, collector);
+
+  collector.Report(std::cout);
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionSplitterCacheTiles.h"
+#include "itkMeanImageFilter.h"
+#include "itkNeighborhoodOperatorImageFilter.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// Checks that the neighborhood filters give the tiles of an
+// ImageRegionSplitterCacheTiles a halo of their radius, also when the output
+// requested region is the whole image, so that the input requested region is
+// not padded.
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<float, Dimension>;
+using RegionType = ImageType::RegionType;
+using SizeType = ImageType::SizeType;
+
+// Records the regions it is called for.
+template <typename TFilter>
+class RegionRecordingFilter : public TFilter
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RegionRecordingFilter);
+
+  using Self = RegionRecordingFilter;
+  using Superclass = TFilter;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  std::vector<RegionType> m_Regions;
+
+protected:
+  RegionRecordingFilter() = default;
+  ~RegionRecordingFilter() override = default;
+
+  void
+  DynamicThreadedGenerateData(const RegionType & region) override
+  {
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Regions.push_back(region);
+    }
+    Superclass::DynamicThreadedGenerateData(region);
+  }
+
+private:
+  std::mutex m_Mutex;
+};
+
+ImageType::Pointer
+MakeInput()
+{
+  auto image = ImageType::New();
+  image->SetRegions(SizeType{ { 48, 40, 36 } });
+  image->Allocate();
+  float *      buffer = image->GetBufferPointer();
+  unsigned int state = 12345;
+  for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+  {
+    state = state * 1664525u + 1013904223u;
+    buffer[i] = static_cast<float>(state >> 16);
+  }
+  return image;
+}
+
+// Runs the filter on the whole image with and without tiles, and checks the
+// tiles and the output.
+template <typename TFilter, typename TConfigure>
+void
+ExpectTilesWithHalo(const SizeType & radius, TConfigure configure)
+{
+  const auto input = MakeInput();
+  const auto region = input->GetLargestPossibleRegion();
+
+  const auto splitter = itk::ImageRegionSplitterCacheTiles::New();
+  splitter->SetCacheSize(32 * 1024);
+  splitter->SetBytesPerPixel(8);
+  const SizeType tileSize = splitter->GetTileSize(region, radius);
+  ASSERT_NE(tileSize, splitter->GetTileSize(region, SizeType{}));
+
+  const auto reference = TFilter::New();
+  configure(reference.GetPointer());
+  reference->SetInput(input);
+  reference->Update();
+
+  const auto filter = RegionRecordingFilter<TFilter>::New();
+  configure(filter.GetPointer());
+  filter->SetInput(input);
+  filter->SetImageRegionSplitter(splitter);
+  filter->SetNumberOfWorkUnits(2);
+  filter->Update();
+
+  EXPECT_EQ(input->GetRequestedRegion(), region);
+  const itk::SizeValueType numberOfTiles = itk::ImageRegionSplitterCacheTiles::GetNumberOfTiles(region, tileSize);
+  ASSERT_EQ(filter->m_Regions.size(), numberOfTiles);
+  for (itk::SizeValueType tile = 0; tile < numberOfTiles; ++tile)
+  {
+    const RegionType expectedTile = itk::ImageRegionSplitterCacheTiles::GetTile(tile, region, tileSize);
+    EXPECT_NE(std::find(filter->m_Regions.cbegin(), filter->m_Regions.cend(), expectedTile), filter->m_Regions.cend())
+      << "Missing tile " << expectedTile;
+  }
+
+  const itk::SizeValueType numberOfPixels = region.GetNumberOfPixels();
+  EXPECT_TRUE(std::equal(reference->GetOutput()->GetBufferPointer(),
+                         reference->GetOutput()->GetBufferPointer() + numberOfPixels,
+                         filter->GetOutput()->GetBufferPointer()));
+}
+} // namespace
+
+TEST(NeighborhoodFilterCacheTiles, BoxImageFilterTilesHaveTheRadiusAsHalo)
+{
+  using FilterType = itk::MeanImageFilter<ImageType, ImageType>;
+  ExpectTilesWithHalo<FilterType>(SizeType{ { 2, 2, 2 } }, [](FilterType * filter) { filter->SetRadius(2); });
+}
+
+TEST(NeighborhoodFilterCacheTiles, NeighborhoodOperatorImageFilterTilesHaveTheRadiusAsHalo)
+{
+  using FilterType = itk::NeighborhoodOperatorImageFilter<ImageType, ImageType>;
+  FilterType::OutputNeighborhoodType box;
+  box.SetRadius(SizeType{ { 2, 1, 2 } });
+  std::fill(box.Begin(), box.End(), 1.0f / static_cast<float>(box.Size()));
+  ExpectTilesWithHalo<FilterType>(box.GetRadius(), [&box](FilterType * filter) { filter->SetOperator(box); });
+}
@@ -0,0 +1,105 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkVector.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// The lines of scalar images are filtered by batches, those of vector
+// images one by one: the results must be the same.
+template <typename TScalarImage, typename TVectorImage>
+void
+CompareBatchedWithSingleLines(const TScalarImage *                      scalarImage,
+                              const TVectorImage *                      vectorImage,
+                              const typename TScalarImage::RegionType & requestedRegion,
+                              unsigned int                              direction,
+                              itk::GaussianOrderEnum                    order)
+{
+  auto scalarFilter = itk::RecursiveGaussianImageFilter<TScalarImage>::New();
+  scalarFilter->SetInput(scalarImage);
+  scalarFilter->SetDirection(direction);
+  scalarFilter->SetOrder(order);
+  scalarFilter->SetSigma(1.5);
+  scalarFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  scalarFilter->Update();
+
+  auto vectorFilter = itk::RecursiveGaussianImageFilter<TVectorImage>::New();
+  vectorFilter->SetInput(vectorImage);
+  vectorFilter->SetDirection(direction);
+  vectorFilter->SetOrder(order);
+  vectorFilter->SetSigma(1.5);
+  vectorFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  vectorFilter->Update();
+
+  double maximumDifference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TScalarImage> it(scalarFilter->GetOutput(), requestedRegion);
+       !it.IsAtEnd();
+       ++it)
+  {
+    maximumDifference = std::max(
+      maximumDifference, std::abs(double{ it.Get() } - vectorFilter->GetOutput()->GetPixel(it.GetIndex())[0]));
+  }
+  EXPECT_LT(maximumDifference, 1e-4) << "direction " << direction << ", order " << order;
+}
+} // namespace
+
+TEST(RecursiveGaussianImageFilter, BatchedLinesMatchSingleLines)
+{
+  constexpr unsigned int Dimension = 3;
+  using ScalarImageType = itk::Image<float, Dimension>;
+  using VectorImageType = itk::Image<itk::Vector<float, 1>, Dimension>;
+
+  const ScalarImageType::RegionType region(ScalarImageType::IndexType{ { -3, 2, 5 } },
+                                           ScalarImageType::SizeType{ { 13, 11, 7 } });
+  auto scalarImage = ScalarImageType::New();
+  scalarImage->SetRegions(region);
+  scalarImage->Allocate();
+  auto vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(region);
+  vectorImage->Allocate();
+  unsigned int value = 1;
+  for (itk::ImageRegionIteratorWithIndex<ScalarImageType> it(scalarImage, region); !it.IsAtEnd(); ++it)
+  {
+    // a deterministic pseudo random sequence
+    value = value * 1103515245u + 12345u;
+    it.Set(static_cast<float>((value >> 8) % 1000));
+    vectorImage->SetPixel(it.GetIndex(), itk::Vector<float, 1>(it.Get()));
+  }
+
+  // the number of lines of the requested region is not a multiple of the
+  // number of batched lines
+  ScalarImageType::RegionType requestedRegion = region;
+  requestedRegion.ShrinkByRadius(ScalarImageType::SizeType{ { 1, 2, 1 } });
+  for (const auto order :
+       { itk::GaussianOrderEnum::ZeroOrder, itk::GaussianOrderEnum::FirstOrder, itk::GaussianOrderEnum::SecondOrder })
+  {
+    for (unsigned int direction = 0; direction < Dimension; ++direction)
+    {
+      CompareBatchedWithSingleLines(scalarImage.GetPointer(), vectorImage.GetPointer(), region, direction, order);
+      CompareBatchedWithSingleLines(
+        scalarImage.GetPointer(), vectorImage.GetPointer(), requestedRegion, direction, order);
+    }
+  }
+}
@@ -269,6 +269,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the settings of this ImageIO too. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
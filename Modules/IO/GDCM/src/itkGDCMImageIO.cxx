@@ -1459,6 +1459,27 @@ GDCMImageIO::InternalSetCompressor(const std::string & _compressor)
   }
 }
 
+LightObject::Pointer
+GDCMImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_UIDPrefix = m_UIDPrefix;
+  rval->m_StudyInstanceUID = m_StudyInstanceUID;
+  rval->m_SeriesInstanceUID = m_SeriesInstanceUID;
+  rval->m_FrameOfReferenceInstanceUID = m_FrameOfReferenceInstanceUID;
+  rval->m_KeepOriginalUID = m_KeepOriginalUID;
+  rval->m_LoadPrivateTags = m_LoadPrivateTags;
+  rval->m_ReadYBRtoRGB = m_ReadYBRtoRGB;
+  rval->m_CompressionType = m_CompressionType;
+  return loPtr;
+}
+
 void
 GDCMImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
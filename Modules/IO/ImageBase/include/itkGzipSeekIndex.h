@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkGzipSeekIndex_h
+#define itkGzipSeekIndex_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class GzipSeekIndex
+ * \brief Random access to the uncompressed content of a gzip file.
+ *
+ * Reaching an offset in a gzip stream normally requires decompressing
+ * everything before it, which makes streamed reading of large compressed
+ * images quadratic in the file size. This class records access points
+ * about every Span bytes of uncompressed data, each with the 32 KiB of
+ * history needed to resume decompression there (as in the zran example
+ * of zlib), so that reading at any offset decompresses at most Span bytes
+ * ahead of the requested data.
+ *
+ * Building the index decompresses the whole file once. The index is then
+ * saved beside the file (see GetIndexFileName()) and reused as long as the
+ * size and modification time of the file do not change. Failing to save
+ * it, for instance in a read-only directory, is not an error.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT GzipSeekIndex : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(GzipSeekIndex);
+
+  /** Standard class type aliases. */
+  using Self = GzipSeekIndex;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(GzipSeekIndex);
+
+  /** A position in the compressed stream where decompression can resume. */
+  struct AccessPoint
+  {
+    /** Offset of the point in the uncompressed data. */
+    uint64_t m_UncompressedOffset{ 0 };
+    /** Offset of the first complete byte of the point in the file. */
+    uint64_t m_CompressedOffset{ 0 };
+    /** Number of bits of the preceding byte that belong to the point. */
+    int m_Bits{ 0 };
+    /** Length of the uncompressed history, at most 32 KiB. */
+    uint64_t m_WindowSize{ 0 };
+    /** The uncompressed history, itself compressed with zlib. */
+    std::vector<unsigned char> m_CompressedWindow{};
+  };
+
+  /** Set/Get the name of the file containing the gzip stream. */
+  /** @ITKStartGrouping */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+  /** @ITKEndGrouping */
+  /** Set/Get the offset of the gzip stream in the file, for compressed
+   * data following a header in the same file. Defaults to 0. */
+  /** @ITKStartGrouping */
+  itkSetMacro(CompressedDataOffset, uint64_t);
+  itkGetConstMacro(CompressedDataOffset, uint64_t);
+  /** @ITKEndGrouping */
+  /** Set/Get the uncompressed distance between access points of a newly
+   * built index. Smaller spans make seeks faster and the index larger.
+   * Defaults to 16 MiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(Span, uint64_t);
+  itkGetConstMacro(Span, uint64_t);
+  /** @ITKEndGrouping */
+  /** Set/Get whether the index is loaded from, and saved to, the index
+   * file beside the data file. On by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseIndexFile, bool);
+  itkGetConstMacro(UseIndexFile, bool);
+  itkBooleanMacro(UseIndexFile);
+  /** @ITKEndGrouping */
+
+  /** Loads the index file, or builds the index when there is no up to date
+   * index file. Throws an exception when the gzip stream is invalid. */
+  void
+  Update();
+
+  /** Get the size of the uncompressed data. Valid after Update(). */
+  itkGetConstMacro(UncompressedSize, uint64_t);
+
+  /** Get the access points, sorted by offset. Valid after Update(). */
+  const std::vector<AccessPoint> &
+  GetAccessPoints() const
+  {
+    return m_AccessPoints;
+  }
+
+  /** Returns the last access point before or at the uncompressed offset,
+   * or nullptr when decompression has to start at the beginning. */
+  const AccessPoint *
+  FindAccessPoint(uint64_t uncompressedOffset) const;
+
+  /** Returns the name of the index file saved beside the data file. */
+  static std::string
+  GetIndexFileName(const std::string & fileName);
+
+  /** Opens a stream over the uncompressed data, whose read position can be
+   * set anywhere with seekg(). Requires Update(). The stream keeps this
+   * index alive. */
+  std::unique_ptr<std::istream>
+  MakeInputStream() const;
+
+protected:
+  GzipSeekIndex() = default;
+  ~GzipSeekIndex() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  void
+  BuildIndex();
+
+  bool
+  ReadIndexFile(uint64_t fileSize, uint64_t fileTime);
+
+  void
+  WriteIndexFile(uint64_t fileSize, uint64_t fileTime) const;
+
+  std::string              m_FileName{};
+  uint64_t                 m_CompressedDataOffset{ 0 };
+  uint64_t                 m_Span{ 16 * 1024 * 1024 };
+  bool                     m_UseIndexFile{ true };
+  uint64_t                 m_UncompressedSize{ 0 };
+  std::vector<AccessPoint> m_AccessPoints{};
+};
+} // end namespace itk
+
+#endif // itkGzipSeekIndex_h
@@ -22,6 +22,7 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkImageIOBase.h"
+#include "itkMemoryMappedFile.h"
 #include "itkImageSource.h"
 #include "itkMacro.h"
 #include "itkImageRegion.h"
@@ -55,6 +56,17 @@ namespace itk
  * raw binary format) have no accepted suffix, so you will have to
  * manually create the ImageIO instance of the write type.
  *
+ * When UseMemoryMapping is on, and the ImageIO reports that the pixel data
+ * of the whole image is stored uncompressed and in the byte order of this
+ * machine (see ImageIOBase::GetMemoryMappablePixelData()), the output
+ * image is not read, but memory mapped from the file by a
+ * MemoryMappedImageContainer. Opening the largest files then takes no
+ * time, and only the pages of the file that are accessed take memory.
+ * The output image can be modified with the default copy-on-write
+ * MemoryMappingAccess, which never changes the file, but not with
+ * read-only access. Other files, and regions smaller than the whole
+ * image, are read as usual.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -121,6 +133,21 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether pixel data stored in the file as in memory is memory
+   * mapped rather than read. Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the access to memory mapped pixel data. Defaults to
+   * CopyOnWrite. */
+  /** @ITKStartGrouping */
+  itkSetEnumMacro(MemoryMappingAccess, MemoryMappedFileEnums::Access);
+  itkGetEnumMacro(MemoryMappingAccess, MemoryMappedFileEnums::Access);
+  /** @ITKEndGrouping */
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -164,8 +191,17 @@ protected:
   bool m_UseStreaming{};
 
 private:
+  /** Memory maps the pixel data of the file as the buffer of the output,
+   * when possible. Returns whether it did. */
+  bool
+  MemoryMapOutput();
+
   std::string m_ExceptionMessage{};
 
+  bool m_UseMemoryMapping{ false };
+
+  MemoryMappedFileEnums::Access m_MemoryMappingAccess{ MemoryMappedFileEnums::Access::CopyOnWrite };
+
   // The region that the ImageIO class will return when we ask to
   // produce the requested region.
   ImageIORegion m_ActualIORegion{};
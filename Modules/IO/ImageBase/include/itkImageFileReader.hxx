@@ -24,10 +24,12 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedImageContainer.h"
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
 #include <fstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -49,6 +51,8 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  itkPrintSelfBooleanMacro(UseMemoryMapping);
+  os << indent << "MemoryMappingAccess: " << m_MemoryMappingAccess << std::endl;
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -356,13 +360,6 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   const typename TOutputImage::Pointer output = this->GetOutput();
 
-  itkDebugMacro("ImageFileReader::GenerateData() \n"
-                << "Allocating the buffer with the EnlargedRequestedRegion \n"
-                << output->GetRequestedRegion() << '\n');
-
-  // allocated the output image to the size of the enlarge requested region
-  this->AllocateOutputs();
-
   // Test if the file exists and if it can be opened.
   // An exception will be thrown otherwise, since we can't
   // successfully read the file. We catch the exception because some
@@ -385,6 +382,30 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   itkDebugMacro("Setting imageIO IORegion to: " << m_ActualIORegion);
   m_ImageIO->SetIORegion(m_ActualIORegion);
 
+  if (m_UseMemoryMapping && this->MemoryMapOutput())
+  {
+    itkDebugMacro("Memory mapped the pixel data.");
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  // Do not read into the mapped pixel data of a previous update, which
+  // may be read-only
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using MemoryMappedContainerType =
+    MemoryMappedImageContainer<typename PixelContainerType::ElementIdentifier, typename PixelContainerType::Element>;
+  if (dynamic_cast<const MemoryMappedContainerType *>(output->GetPixelContainer()) != nullptr)
+  {
+    output->SetPixelContainer(PixelContainerType::New());
+  }
+
+  itkDebugMacro("ImageFileReader::GenerateData() \n"
+                << "Allocating the buffer with the EnlargedRequestedRegion \n"
+                << output->GetRequestedRegion() << '\n');
+
+  // allocated the output image to the size of the enlarge requested region
+  this->AllocateOutputs();
+
   // the size of the buffer is computed based on the actual number of
   // pixels to be read and the actual size of the pixels to be read
   // (as opposed to the sizes of the output)
@@ -441,6 +462,53 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MemoryMapOutput()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using ElementIdentifier = typename PixelContainerType::ElementIdentifier;
+  using Element = typename PixelContainerType::Element;
+
+  if constexpr (std::is_base_of_v<ImportImageContainer<ElementIdentifier, Element>, PixelContainerType>)
+  {
+    const typename TOutputImage::Pointer output = this->GetOutput();
+
+    // Only the whole image, stored with the pixel type of the output
+    const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+    const SizeValueType   numberOfBytes = m_ImageIO->GetImageSizeInBytes();
+    if (m_ImageIO->GetComponentType() != ioType ||
+        m_ImageIO->GetNumberOfComponents() != output->GetNumberOfComponentsPerPixel() ||
+        output->GetRequestedRegion() != output->GetLargestPossibleRegion() ||
+        static_cast<SizeValueType>(m_ImageIO->GetImageSizeInPixels()) !=
+          output->GetLargestPossibleRegion().GetNumberOfPixels() ||
+        numberOfBytes % sizeof(Element) != 0)
+    {
+      return false;
+    }
+
+    std::string   fileName;
+    SizeValueType offset = 0;
+    if (!m_ImageIO->GetMemoryMappablePixelData(fileName, offset) || offset % alignof(Element) != 0)
+    {
+      return false;
+    }
+
+    using MemoryMappedContainerType = MemoryMappedImageContainer<ElementIdentifier, Element>;
+    auto container = MemoryMappedContainerType::New();
+    container->MapFile(
+      fileName, offset, static_cast<ElementIdentifier>(numberOfBytes / sizeof(Element)), m_MemoryMappingAccess);
+
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->SetPixelContainer(container);
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
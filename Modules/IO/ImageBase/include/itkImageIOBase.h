@@ -518,6 +518,18 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine whether the pixel data of the whole image, as described by
+   * the last ReadImageInformation(), is stored in a single file as one
+   * contiguous block of uncompressed components in the byte order of this
+   * machine, so that it can be memory mapped instead of read with Read().
+   * If so, sets the name of the file holding the data and the position of
+   * its first byte. Default is false. */
+  virtual bool
+  GetMemoryMappablePixelData(std::string & itkNotUsed(fileName), SizeValueType & itkNotUsed(offset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -794,6 +806,13 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create an ImageIO of the same type with the same settings and image
+   * information, for instance to read several files concurrently. The
+   * subclasses which have settings of their own override it to copy them
+   * too. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
 
@@ -20,6 +20,7 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkSize.h"
+#include <exception>
 #include <vector>
 #include <string>
 #include "itkMetaDataDictionary.h"
@@ -184,6 +185,25 @@ public:
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
   /** @ITKEndGrouping */
+
+  /** Set/Get the maximum number of slices that are decoded concurrently.
+   *
+   * Files are decoded in batches of at most this many slices, each one
+   * directly into its section of the output buffer whenever possible. At
+   * most this many readers, and their temporary buffers when a slice cannot
+   * be decoded in place, are therefore alive at any time. The spacing
+   * checks, the MetaDataDictionaryArray and the progress are processed in
+   * file order after each batch, so the output does not depend on this
+   * setting. When an ImageIO has been set, every concurrently decoded slice
+   * uses its own Clone() of it, which has the same settings. ImageIO
+   * classes with settings of their own copy them in InternalClone().
+   *
+   * The default of 1 decodes the files one after the other. 0 uses the
+   * number of work units of this filter. */
+  /** @ITKStartGrouping */
+  itkSetMacro(NumberOfSlicesReadInParallel, unsigned int);
+  itkGetConstMacro(NumberOfSlicesReadInParallel, unsigned int);
+  /** @ITKEndGrouping */
 protected:
   ImageSeriesReader()
     : m_ImageIO(nullptr)
@@ -222,12 +242,30 @@ protected:
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
 
+  unsigned int m_NumberOfSlicesReadInParallel{ 1 };
+
 private:
   using ReaderType = ImageFileReader<TOutputImage>;
 
   int
   ComputeMovingDimensionIndex(ReaderType * reader);
 
+  /** What GenerateData needs to know about a slice once it has been read. */
+  struct SliceReadResult
+  {
+    bool                             m_Read{ false };
+    bool                             m_HasImageIO{ false };
+    typename TOutputImage::PointType m_Origin{};
+    MetaDataDictionary               m_Dictionary{};
+    std::exception_ptr               m_Exception{};
+  };
+
+  /** Read slice i (or only its information when it is outside of the
+   * requested region) into the output buffer. May be called concurrently
+   * for different slices. */
+  void
+  ReadSlice(int i, bool insideRequestedRegion, ImageIOBase * imageIO, SliceReadResult & result);
+
   /** Array of MetaDataDictionaries. This allows to hold information from the
    * ImageIO objects after reading every sub image in the series */
   DictionaryArrayType m_MetaDataDictionaryArray{};
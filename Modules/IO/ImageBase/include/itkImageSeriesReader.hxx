@@ -25,6 +25,7 @@
 #include "itkMath.h"
 #include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include <algorithm>
 #include <cstddef> // For ptrdiff_t.
 #include <iomanip>
 
@@ -39,6 +40,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "NumberOfSlicesReadInParallel: " << m_NumberOfSlicesReadInParallel << std::endl;
   os << indent << "FileNames:" << std::endl;
   for (const auto & fileName : m_FileNames)
   {
@@ -256,16 +258,17 @@ ImageSeriesReader<TOutputImage>::EnlargeOutputRequestedRegion(DataObject * outpu
 
 template <typename TOutputImage>
 void
-ImageSeriesReader<TOutputImage>::GenerateData()
+ImageSeriesReader<TOutputImage>::ReadSlice(int               i,
+                                           bool              insideRequestedRegion,
+                                           ImageIOBase *     imageIO,
+                                           SliceReadResult & result)
 {
   TOutputImage * output = this->GetOutput();
 
   const ImageRegionType requestedRegion = output->GetRequestedRegion();
-  const ImageRegionType largestRegion = output->GetLargestPossibleRegion();
-  ImageRegionType       sliceRegionToRequest = output->GetRequestedRegion();
-
-  // Each file must have the same size.
-  SizeType validSize = largestRegion.GetSize();
+  ImageRegionType       sliceRegionToRequest = requestedRegion;
+  SizeType              validSize = output->GetLargestPossibleRegion().GetSize();
+  IndexType             sliceStartIndex = requestedRegion.GetIndex();
 
   // If more than one file is being read, then the input dimension
   // will be less than the output dimension.  In this case, set
@@ -277,7 +280,128 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     validSize[this->m_NumberOfDimensionsInImage] = 1;
     sliceRegionToRequest.SetSize(this->m_NumberOfDimensionsInImage, 1);
     sliceRegionToRequest.SetIndex(this->m_NumberOfDimensionsInImage, 0);
+    sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+  }
+
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
+  const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
+
+  // configure reader
+  auto reader = ReaderType::New();
+  reader->SetFileName(m_FileNames[iFileName].c_str());
+
+  TOutputImage * readerOutput = reader->GetOutput();
+
+  if (imageIO)
+  {
+    reader->SetImageIO(imageIO);
   }
+  reader->SetUseStreaming(m_UseStreaming);
+  readerOutput->SetRequestedRegion(sliceRegionToRequest);
+
+  // update the data or info
+  if (!insideRequestedRegion)
+  {
+    reader->UpdateOutputInformation();
+  }
+  else
+  {
+    // read the meta data information
+    readerOutput->UpdateOutputInformation();
+
+    // propagate the requested region to determine what the region
+    // will actually be read
+    readerOutput->PropagateRequestedRegion();
+
+    // check that the size of each slice is the same
+    if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+    {
+      itkExceptionMacro("Size mismatch! The size of  "
+                        << m_FileNames[iFileName].c_str() << " is " << readerOutput->GetLargestPossibleRegion().GetSize()
+                        << " and does not match the required size " << validSize << " from file "
+                        << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+    }
+
+    // get the size of the region to be read
+    const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+
+    if (readSize == sliceRegionToRequest.GetSize())
+    {
+      // if the buffer of the ImageReader is going to match that of
+      // ourselves, then set the ImageReader's buffer to a section
+      // of ours
+
+      const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+      using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+      const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+
+      const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                      ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                      : 0;
+
+      const ptrdiff_t numberOfPixelComponentsUpToSlice =
+        numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+      const bool bufferDelete = false;
+
+      typename TOutputImage::InternalPixelType * outputSliceBuffer =
+        output->GetBufferPointer() + numberOfPixelComponentsUpToSlice;
+
+      if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+      {
+        // if the input image type is a vector image then the number
+        // of components needs to be set for the size
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer,
+          static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+          bufferDelete);
+      }
+      else
+      {
+        // otherwise the actual number of pixels needs to be passed
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+      }
+      readerOutput->UpdateOutputData();
+    }
+    else
+    {
+      // the read region isn't going to match exactly what we need
+      // to update to buffer created by the reader, then copy
+
+      reader->Update();
+
+      // output of buffer copy
+      ImageRegionType outRegion = requestedRegion;
+      outRegion.SetIndex(sliceStartIndex);
+
+      // set the moving dimension to a size of 1
+      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+      {
+        outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+      }
+
+      ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+    }
+  } // end !insideRequestedRegion
+
+  result.m_Origin = readerOutput->GetOrigin();
+  if (reader->GetImageIO())
+  {
+    result.m_HasImageIO = true;
+    // the dictionary is copy-on-write, keeping it is cheap
+    result.m_Dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+  }
+}
+
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::GenerateData()
+{
+  TOutputImage * output = this->GetOutput();
+
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
 
   // Allocate the output buffer
   output->SetBufferedRegion(requestedRegion);
@@ -294,9 +418,7 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   bool needToUpdateMetaDataDictionaryArray =
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
-  typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-  const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
 
   typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
   typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
@@ -305,175 +427,152 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
   m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
 
-  for (int i = 0; i != numberOfFiles; ++i)
-  {
+  const auto isInsideRequestedRegion = [this, &requestedRegion](int i) {
+    IndexType sliceStartIndex = requestedRegion.GetIndex();
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
       sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
     }
+    return requestedRegion.IsInside(sliceStartIndex);
+  };
+
+  // The slices are read in batches of up to batchSize files, concurrently
+  // when there is more than one. Whatever depends on the order of the files
+  // is done afterwards, sequentially and in file order.
+  int batchSize = static_cast<int>(m_NumberOfSlicesReadInParallel);
+  if (batchSize == 0)
+  {
+    batchSize = static_cast<int>(this->GetNumberOfWorkUnits());
+  }
+  batchSize = std::max(1, std::min(batchSize, numberOfFiles));
 
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
-
-    // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+  std::vector<SliceReadResult>      batch(static_cast<size_t>(batchSize));
+  std::vector<ImageIOBase::Pointer> imageIOs(static_cast<size_t>(batchSize), m_ImageIO);
+  if (batchSize > 1 && m_ImageIO)
+  {
+    // an ImageIO reads one file at a time
+    for (auto & imageIO : imageIOs)
     {
-      continue;
+      imageIO = dynamic_cast<ImageIOBase *>(m_ImageIO->Clone().GetPointer());
     }
+  }
 
-    // configure reader
-    auto reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
+  for (int batchStart = 0; batchStart < numberOfFiles; batchStart += batchSize)
+  {
+    const int batchEnd = std::min(batchStart + batchSize, numberOfFiles);
 
-    TOutputImage * readerOutput = reader->GetOutput();
+    const bool needAllSlices = needToUpdateMetaDataDictionaryArray;
+    const auto readSliceOfBatch = [&, batchStart, needAllSlices](SizeValueType b) {
+      const int         i = batchStart + static_cast<int>(b);
+      SliceReadResult & result = batch[b];
+      result = SliceReadResult();
 
-    if (m_ImageIO)
-    {
-      reader->SetImageIO(m_ImageIO);
-    }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
+      // check if we need this slice
+      const bool insideRequestedRegion = isInsideRequestedRegion(i);
+      if (!insideRequestedRegion && !needAllSlices)
+      {
+        return;
+      }
+      result.m_Read = true;
+      try
+      {
+        this->ReadSlice(i, insideRequestedRegion, imageIOs[b], result);
+      }
+      catch (...)
+      {
+        result.m_Exception = std::current_exception();
+      }
+    };
 
-    // update the data or info
-    if (!insideRequestedRegion)
+    if (batchEnd - batchStart == 1)
     {
-      reader->UpdateOutputInformation();
+      readSliceOfBatch(0);
     }
     else
     {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
-
-      // propagate the requested region to determine what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
-
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
-      {
-        itkExceptionMacro("Size mismatch! The size of  "
-                          << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
-      }
+      this->GetMultiThreader()->ParallelizeArray(0, batchEnd - batchStart, readSliceOfBatch, nullptr);
+    }
 
-      // get the size of the region to be read
-      const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+    for (int i = batchStart; i != batchEnd; ++i)
+    {
+      SliceReadResult & result = batch[i - batchStart];
+      const bool        insideRequestedRegion = isInsideRequestedRegion(i);
+      bool              nonUniformSampling = false;
+      double            spacingDeviation = 0.0;
 
-      if (readSize == sliceRegionToRequest.GetSize())
+      if (!result.m_Read)
       {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
-
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
-
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
-
-
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
-
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
-
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
-
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
-        }
-        else
+        // check if we need this slice, now that the meta data dictionary
+        // array may have to be updated after all
+        if (!needToUpdateMetaDataDictionaryArray)
         {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+          continue;
         }
-        readerOutput->UpdateOutputData();
+        result.m_Read = true;
+        this->ReadSlice(i, insideRequestedRegion, imageIOs[0], result);
       }
-      else
+      else if (result.m_Exception)
       {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
-
-        reader->Update();
-
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
-
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
-
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+        // report the failure of the first failing file, as a sequential read would
+        std::rethrow_exception(result.m_Exception);
       }
 
-      // verify that slice spacing is the expected one
-      // since we can be skipping some slices because they are outside of requested region
-      // I am using additional variable
-      if (prevSliceIsValid)
+      if (insideRequestedRegion)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
-        using SpacingScalarType = typename TOutputImage::SpacingValueType;
-        Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
-        for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
-        {
-          dirN[j] = static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
-        }
-        const SpacingScalarType dirNnorm = dirN.GetNorm();
-
-        if (this->m_SpacingDefined &&
-            !Math::AlmostEquals(
-              dirNnorm,
-              outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
+        // verify that slice spacing is the expected one
+        // since we can be skipping some slices because they are outside of requested region
+        // I am using additional variable
+        if (prevSliceIsValid)
         {
-          nonUniformSampling = true;
-          spacingDeviation = itk::Math::Absolute(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
-          if (spacingDeviation > maxSpacingDeviation)
+          const typename TOutputImage::PointType & sliceOrigin = result.m_Origin;
+          using SpacingScalarType = typename TOutputImage::SpacingValueType;
+          Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
+          for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
           {
-            maxSpacingDeviation = spacingDeviation;
+            dirN[j] =
+              static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
           }
+          const SpacingScalarType dirNnorm = dirN.GetNorm();
 
-          needToUpdateMetaDataDictionaryArray = true;
+          if (this->m_SpacingDefined &&
+              !Math::AlmostEquals(
+                dirNnorm,
+                outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
+          {
+            nonUniformSampling = true;
+            spacingDeviation = itk::Math::Absolute(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
+            if (spacingDeviation > maxSpacingDeviation)
+            {
+              maxSpacingDeviation = spacingDeviation;
+            }
+
+            needToUpdateMetaDataDictionaryArray = true;
+          }
+          prevSliceOrigin = sliceOrigin;
+        }
+        else
+        {
+          prevSliceOrigin = result.m_Origin;
+          prevSliceIsValid = true;
         }
-        prevSliceOrigin = sliceOrigin;
-      }
-      else
-      {
-        prevSliceOrigin = readerOutput->GetOrigin();
-        prevSliceIsValid = true;
-      }
 
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insideRequestedRegion
+        // report progress for read slices
+        progress.CompletedPixel();
+      } // end !insideRequestedRegion
 
-    // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
-    {
-      MetaDataDictionary newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
-      if (nonUniformSampling)
+      // Deep copy the MetaDataDictionary into the array
+      if (result.m_HasImageIO && needToUpdateMetaDataDictionaryArray)
       {
-        // slice-specific information
-        EncapsulateMetaData<double>(newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        MetaDataDictionary newDictionary = std::move(result.m_Dictionary);
+        if (nonUniformSampling)
+        {
+          // slice-specific information
+          EncapsulateMetaData<double>(newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        }
+        m_InternalMetaDataDictionaries.push_back(std::move(newDictionary));
       }
-      m_InternalMetaDataDictionaries.push_back(std::move(newDictionary));
-    }
-  } // end per slice loop
+    } // end per slice loop
+  }   // end per batch loop
 
   m_MetaDataDictionaryArray.clear();
   m_MetaDataDictionaryArray.reserve(m_InternalMetaDataDictionaries.size());
@@ -15,10 +15,14 @@ itk_module(
   ENABLE_SHARED
   DEPENDS
     ITKCommon
+  PRIVATE_DEPENDS
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
     ITKIOGDCM
     ITKIOMeta
+    ITKIONIFTI
     ITKImageIntensity
+    ITKZLIB
   DESCRIPTION "${DOCUMENTATION}"
 )
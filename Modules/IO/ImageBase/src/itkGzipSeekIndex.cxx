@@ -0,0 +1,569 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkGzipSeekIndex.h"
+
+#include "itk_zlib.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace itk
+{
+namespace
+{
+// Maximum distance of a deflate back reference
+constexpr uint64_t WindowSize{ 32768 };
+constexpr size_t   ChunkSize{ 65536 };
+
+constexpr char     IndexFileMagic[] = "ITKGZIDX";
+constexpr uint64_t IndexFileVersion{ 1 };
+
+void
+WriteValue(std::ostream & os, uint64_t value)
+{
+  char bytes[8];
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  os.write(bytes, 8);
+}
+
+bool
+ReadValue(std::istream & is, uint64_t & value)
+{
+  unsigned char bytes[8];
+  is.read(reinterpret_cast<char *>(bytes), 8);
+  value = 0;
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return !is.fail();
+}
+
+// Feeds a z_stream from a file.
+class CompressedInput
+{
+public:
+  explicit CompressedInput(const std::string & fileName)
+    : m_File(fileName, std::ios::in | std::ios::binary)
+    , m_Buffer(ChunkSize)
+  {}
+
+  bool
+  IsOpen() const
+  {
+    return m_File.is_open();
+  }
+
+  // Moves to a file offset, dropping the buffered input.
+  void
+  Seek(z_stream & stream, uint64_t offset)
+  {
+    m_File.clear();
+    m_File.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    stream.next_in = m_Buffer.data();
+    stream.avail_in = 0;
+  }
+
+  // Makes at least count bytes of input available, unless the file ends.
+  bool
+  Ensure(z_stream & stream, size_t count)
+  {
+    if (stream.avail_in >= count)
+    {
+      return true;
+    }
+    std::memmove(m_Buffer.data(), stream.next_in, stream.avail_in);
+    m_File.read(reinterpret_cast<char *>(m_Buffer.data()) + stream.avail_in,
+                static_cast<std::streamsize>(m_Buffer.size() - stream.avail_in));
+    stream.next_in = m_Buffer.data();
+    stream.avail_in += static_cast<uInt>(m_File.gcount());
+    return stream.avail_in >= count;
+  }
+
+private:
+  std::ifstream              m_File;
+  std::vector<unsigned char> m_Buffer;
+};
+
+// At the end of a gzip member, skips its trailer when inflating raw deflate
+// data, and prepares the stream for the next member, if any. Returns false
+// at the end of the data.
+bool
+StartNextMember(z_stream & stream, CompressedInput & input, bool & raw)
+{
+  if (raw)
+  {
+    // CRC-32 and size
+    if (!input.Ensure(stream, 8))
+    {
+      return false;
+    }
+    stream.next_in += 8;
+    stream.avail_in -= 8;
+  }
+  if (!input.Ensure(stream, 2) || stream.next_in[0] != 0x1f || stream.next_in[1] != 0x8b)
+  {
+    return false;
+  }
+  inflateReset2(&stream, 31);
+  raw = false;
+  return true;
+}
+
+class GzipSeekIndexStreamBuffer : public std::streambuf
+{
+public:
+  explicit GzipSeekIndexStreamBuffer(const GzipSeekIndex * index)
+    : m_Index(index)
+    , m_Input(index->GetFileName())
+    , m_Output(ChunkSize)
+  {
+    if (!m_Input.IsOpen())
+    {
+      itkGenericExceptionMacro("Cannot open " << index->GetFileName());
+    }
+    if (inflateInit2(&m_Stream, 31) != Z_OK)
+    {
+      itkGenericExceptionMacro("Cannot initialize zlib: " << (m_Stream.msg ? m_Stream.msg : ""));
+    }
+    this->Restart(nullptr);
+  }
+
+  ~GzipSeekIndexStreamBuffer() override { inflateEnd(&m_Stream); }
+
+  ITK_DISALLOW_COPY_AND_MOVE(GzipSeekIndexStreamBuffer);
+
+protected:
+  int_type
+  underflow() override
+  {
+    if (this->gptr() < this->egptr())
+    {
+      return traits_type::to_int_type(*this->gptr());
+    }
+    m_OutputOffset += static_cast<uint64_t>(this->egptr() - this->eback());
+    const size_t count = this->Inflate();
+    this->setg(m_Output.data(), m_Output.data(), m_Output.data() + count);
+    return count == 0 ? traits_type::eof() : traits_type::to_int_type(*this->gptr());
+  }
+
+  pos_type
+  seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+  {
+    if (direction == std::ios_base::cur)
+    {
+      offset += static_cast<off_type>(m_OutputOffset) + (this->gptr() - this->eback());
+    }
+    else if (direction == std::ios_base::end)
+    {
+      offset += static_cast<off_type>(m_Index->GetUncompressedSize());
+    }
+    return this->seekpos(pos_type(offset), which);
+  }
+
+  pos_type
+  seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    const auto offset = static_cast<off_type>(position);
+    if (!(which & std::ios_base::in) || offset < 0 || static_cast<uint64_t>(offset) > m_Index->GetUncompressedSize())
+    {
+      return pos_type(off_type(-1));
+    }
+    const auto target = static_cast<uint64_t>(offset);
+
+    // Resume from an access point, unless the target is a short way ahead
+    const GzipSeekIndex::AccessPoint * point = m_Index->FindAccessPoint(target);
+    const uint64_t                     bufferEnd = m_OutputOffset + static_cast<uint64_t>(this->egptr() - this->eback());
+    if (target < m_OutputOffset || (point != nullptr && point->m_UncompressedOffset > bufferEnd))
+    {
+      this->Restart(point);
+    }
+    while (target > m_OutputOffset + static_cast<uint64_t>(this->egptr() - this->eback()))
+    {
+      m_OutputOffset += static_cast<uint64_t>(this->egptr() - this->eback());
+      const size_t count = this->Inflate();
+      this->setg(m_Output.data(), m_Output.data(), m_Output.data() + count);
+      if (count == 0)
+      {
+        return pos_type(off_type(-1));
+      }
+    }
+    this->setg(this->eback(), this->eback() + (target - m_OutputOffset), this->egptr());
+    return position;
+  }
+
+private:
+  void
+  Restart(const GzipSeekIndex::AccessPoint * point)
+  {
+    if (point == nullptr)
+    {
+      inflateReset2(&m_Stream, 31);
+      m_Raw = false;
+      m_Input.Seek(m_Stream, m_Index->GetCompressedDataOffset());
+      m_OutputOffset = 0;
+    }
+    else
+    {
+      inflateReset2(&m_Stream, -MAX_WBITS);
+      m_Raw = true;
+      m_Input.Seek(m_Stream, point->m_CompressedOffset - (point->m_Bits ? 1 : 0));
+      if (point->m_Bits)
+      {
+        if (!m_Input.Ensure(m_Stream, 1))
+        {
+          itkGenericExceptionMacro("Unexpected end of " << m_Index->GetFileName());
+        }
+        const int byte = *m_Stream.next_in;
+        ++m_Stream.next_in;
+        --m_Stream.avail_in;
+        inflatePrime(&m_Stream, point->m_Bits, byte >> (8 - point->m_Bits));
+      }
+      if (point->m_WindowSize > 0)
+      {
+        std::vector<unsigned char> window(point->m_WindowSize);
+        uLongf                     windowSize = static_cast<uLongf>(window.size());
+        if (uncompress(window.data(),
+                       &windowSize,
+                       point->m_CompressedWindow.data(),
+                       static_cast<uLong>(point->m_CompressedWindow.size())) != Z_OK ||
+            windowSize != window.size() ||
+            inflateSetDictionary(&m_Stream, window.data(), static_cast<uInt>(windowSize)) != Z_OK)
+        {
+          itkGenericExceptionMacro("Invalid access point in the index of " << m_Index->GetFileName());
+        }
+      }
+      m_OutputOffset = point->m_UncompressedOffset;
+    }
+    m_EndOfData = false;
+    this->setg(m_Output.data(), m_Output.data(), m_Output.data());
+  }
+
+  // Inflates the next chunk of data into the output buffer.
+  size_t
+  Inflate()
+  {
+    m_Stream.next_out = reinterpret_cast<Bytef *>(m_Output.data());
+    m_Stream.avail_out = static_cast<uInt>(m_Output.size());
+    while (m_Stream.avail_out > 0 && !m_EndOfData)
+    {
+      if (m_Stream.avail_in == 0 && !m_Input.Ensure(m_Stream, 1))
+      {
+        itkGenericExceptionMacro("Unexpected end of " << m_Index->GetFileName());
+      }
+      const int result = inflate(&m_Stream, Z_NO_FLUSH);
+      if (result == Z_STREAM_END)
+      {
+        m_EndOfData = !StartNextMember(m_Stream, m_Input, m_Raw);
+      }
+      else if (result != Z_OK)
+      {
+        itkGenericExceptionMacro("Error inflating " << m_Index->GetFileName() << ": "
+                                                    << (m_Stream.msg ? m_Stream.msg : std::to_string(result)));
+      }
+    }
+    return m_Output.size() - m_Stream.avail_out;
+  }
+
+  GzipSeekIndex::ConstPointer m_Index;
+  CompressedInput             m_Input;
+  std::vector<char>           m_Output;
+  z_stream                    m_Stream{};
+  bool                        m_Raw{ false };
+  bool                        m_EndOfData{ false };
+  // Uncompressed offset of the start of the output buffer
+  uint64_t m_OutputOffset{ 0 };
+};
+
+class GzipSeekIndexInputStream : public std::istream
+{
+public:
+  explicit GzipSeekIndexInputStream(const GzipSeekIndex * index)
+    : std::istream(nullptr)
+    , m_Buffer(index)
+  {
+    this->rdbuf(&m_Buffer);
+  }
+
+private:
+  GzipSeekIndexStreamBuffer m_Buffer;
+};
+} // namespace
+
+void
+GzipSeekIndex::Update()
+{
+  if (!itksys::SystemTools::FileExists(m_FileName, true))
+  {
+    itkExceptionMacro("File does not exist: " << m_FileName);
+  }
+  const auto fileSize = static_cast<uint64_t>(itksys::SystemTools::FileLength(m_FileName));
+  const auto fileTime = static_cast<uint64_t>(itksys::SystemTools::ModifiedTime(m_FileName));
+
+  if (m_UseIndexFile && this->ReadIndexFile(fileSize, fileTime))
+  {
+    return;
+  }
+  this->BuildIndex();
+  if (m_UseIndexFile)
+  {
+    this->WriteIndexFile(fileSize, fileTime);
+  }
+}
+
+void
+GzipSeekIndex::BuildIndex()
+{
+  CompressedInput input(m_FileName);
+  if (!input.IsOpen())
+  {
+    itkExceptionMacro("Cannot open " << m_FileName);
+  }
+  z_stream stream{};
+  if (inflateInit2(&stream, 31) != Z_OK)
+  {
+    itkExceptionMacro("Cannot initialize zlib: " << (stream.msg ? stream.msg : ""));
+  }
+  input.Seek(stream, m_CompressedDataOffset);
+
+  // Circular buffer of the last uncompressed bytes
+  std::vector<unsigned char> window(WindowSize);
+  uint64_t                   totalIn = m_CompressedDataOffset;
+  uint64_t                   totalOut = 0;
+  uint64_t                   lastPoint = 0;
+  bool                       raw = false;
+  std::string                error;
+
+  m_AccessPoints.clear();
+  for (;;)
+  {
+    if (stream.avail_in == 0 && !input.Ensure(stream, 1))
+    {
+      error = "Unexpected end of the gzip stream";
+      break;
+    }
+    if (stream.avail_out == 0)
+    {
+      stream.next_out = window.data();
+      stream.avail_out = static_cast<uInt>(WindowSize);
+    }
+
+    // Stop at the end of each deflate block, where an access point can be set
+    totalIn += stream.avail_in;
+    totalOut += stream.avail_out;
+    const int result = inflate(&stream, Z_BLOCK);
+    totalIn -= stream.avail_in;
+    totalOut -= stream.avail_out;
+
+    if (result == Z_STREAM_END)
+    {
+      if (!StartNextMember(stream, input, raw))
+      {
+        break;
+      }
+      continue;
+    }
+    if (result != Z_OK)
+    {
+      error = stream.msg ? stream.msg : "inflate error " + std::to_string(result);
+      break;
+    }
+
+    // Between two blocks, but not after the last one of the member
+    if ((stream.data_type & 128) && !(stream.data_type & 64) && totalOut - lastPoint >= m_Span)
+    {
+      AccessPoint point;
+      point.m_UncompressedOffset = totalOut;
+      point.m_CompressedOffset = totalIn;
+      point.m_Bits = stream.data_type & 7;
+      point.m_WindowSize = std::min(totalOut, WindowSize);
+
+      // Unroll the circular buffer, then keep its valid end
+      std::vector<unsigned char> history(WindowSize);
+      const uInt                 left = stream.avail_out;
+      std::memcpy(history.data(), window.data() + WindowSize - left, left);
+      std::memcpy(history.data() + left, window.data(), WindowSize - left);
+
+      uLongf compressedSize = compressBound(static_cast<uLong>(point.m_WindowSize));
+      point.m_CompressedWindow.resize(compressedSize);
+      compress2(point.m_CompressedWindow.data(),
+                &compressedSize,
+                history.data() + WindowSize - point.m_WindowSize,
+                static_cast<uLong>(point.m_WindowSize),
+                Z_BEST_SPEED);
+      point.m_CompressedWindow.resize(compressedSize);
+
+      m_AccessPoints.push_back(std::move(point));
+      lastPoint = totalOut;
+    }
+  }
+  inflateEnd(&stream);
+
+  if (!error.empty())
+  {
+    m_AccessPoints.clear();
+    itkExceptionMacro("Cannot index " << m_FileName << ": " << error);
+  }
+  m_UncompressedSize = totalOut;
+}
+
+bool
+GzipSeekIndex::ReadIndexFile(uint64_t fileSize, uint64_t fileTime)
+{
+  std::ifstream file(GetIndexFileName(m_FileName), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  char     magic[8];
+  uint64_t version = 0;
+  uint64_t size = 0;
+  uint64_t time = 0;
+  uint64_t offset = 0;
+  uint64_t span = 0;
+  uint64_t uncompressedSize = 0;
+  uint64_t numberOfPoints = 0;
+  file.read(magic, 8);
+  if (file.fail() || std::memcmp(magic, IndexFileMagic, 8) != 0 || !ReadValue(file, version) ||
+      version != IndexFileVersion || !ReadValue(file, size) || size != fileSize || !ReadValue(file, time) ||
+      time != fileTime || !ReadValue(file, offset) || offset != m_CompressedDataOffset || !ReadValue(file, span) ||
+      span != m_Span || !ReadValue(file, uncompressedSize) || !ReadValue(file, numberOfPoints) ||
+      numberOfPoints > fileSize)
+  {
+    return false;
+  }
+
+  std::vector<AccessPoint> points(numberOfPoints);
+  for (auto & point : points)
+  {
+    uint64_t bits = 0;
+    uint64_t compressedWindowSize = 0;
+    if (!ReadValue(file, point.m_UncompressedOffset) || !ReadValue(file, point.m_CompressedOffset) ||
+        !ReadValue(file, bits) || bits > 7 || !ReadValue(file, point.m_WindowSize) ||
+        point.m_WindowSize > WindowSize || !ReadValue(file, compressedWindowSize) ||
+        compressedWindowSize > compressBound(WindowSize))
+    {
+      return false;
+    }
+    point.m_Bits = static_cast<int>(bits);
+    point.m_CompressedWindow.resize(compressedWindowSize);
+    file.read(reinterpret_cast<char *>(point.m_CompressedWindow.data()),
+              static_cast<std::streamsize>(compressedWindowSize));
+    if (file.fail())
+    {
+      return false;
+    }
+  }
+
+  m_UncompressedSize = uncompressedSize;
+  m_AccessPoints = std::move(points);
+  return true;
+}
+
+void
+GzipSeekIndex::WriteIndexFile(uint64_t fileSize, uint64_t fileTime) const
+{
+  // Write then rename, so that concurrent readers never see a partial index
+  const std::string indexFileName = GetIndexFileName(m_FileName);
+  const std::string temporaryFileName = indexFileName + '.' + std::to_string(reinterpret_cast<uintptr_t>(this));
+  {
+    std::ofstream file(temporaryFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      itkDebugMacro("Cannot write the index file " << indexFileName);
+      return;
+    }
+    file.write(IndexFileMagic, 8);
+    WriteValue(file, IndexFileVersion);
+    WriteValue(file, fileSize);
+    WriteValue(file, fileTime);
+    WriteValue(file, m_CompressedDataOffset);
+    WriteValue(file, m_Span);
+    WriteValue(file, m_UncompressedSize);
+    WriteValue(file, m_AccessPoints.size());
+    for (const auto & point : m_AccessPoints)
+    {
+      WriteValue(file, point.m_UncompressedOffset);
+      WriteValue(file, point.m_CompressedOffset);
+      WriteValue(file, static_cast<uint64_t>(point.m_Bits));
+      WriteValue(file, point.m_WindowSize);
+      WriteValue(file, point.m_CompressedWindow.size());
+      file.write(reinterpret_cast<const char *>(point.m_CompressedWindow.data()),
+                 static_cast<std::streamsize>(point.m_CompressedWindow.size()));
+    }
+    if (file.fail())
+    {
+      file.close();
+      itksys::SystemTools::RemoveFile(temporaryFileName);
+      itkDebugMacro("Cannot write the index file " << indexFileName);
+      return;
+    }
+  }
+  // Replaces an older index, which rename() does not do on Windows
+  if (std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0)
+  {
+    itksys::SystemTools::RemoveFile(indexFileName);
+    if (std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0)
+    {
+      itksys::SystemTools::RemoveFile(temporaryFileName);
+    }
+  }
+}
+
+const GzipSeekIndex::AccessPoint *
+GzipSeekIndex::FindAccessPoint(uint64_t uncompressedOffset) const
+{
+  const auto next = std::upper_bound(
+    m_AccessPoints.begin(), m_AccessPoints.end(), uncompressedOffset, [](uint64_t offset, const AccessPoint & point) {
+      return offset < point.m_UncompressedOffset;
+    });
+  return next == m_AccessPoints.begin() ? nullptr : &*(next - 1);
+}
+
+std::string
+GzipSeekIndex::GetIndexFileName(const std::string & fileName)
+{
+  return fileName + ".gzidx";
+}
+
+std::unique_ptr<std::istream>
+GzipSeekIndex::MakeInputStream() const
+{
+  return std::make_unique<GzipSeekIndexInputStream>(this);
+}
+
+void
+GzipSeekIndex::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "CompressedDataOffset: " << m_CompressedDataOffset << std::endl;
+  os << indent << "Span: " << m_Span << std::endl;
+  os << indent << "UseIndexFile: " << (m_UseIndexFile ? "On" : "Off") << std::endl;
+  os << indent << "UncompressedSize: " << m_UncompressedSize << std::endl;
+  os << indent << "NumberOfAccessPoints: " << m_AccessPoints.size() << std::endl;
+}
+} // end namespace itk
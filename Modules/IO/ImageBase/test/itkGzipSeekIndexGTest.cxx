@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGzipSeekIndex.h"
+#include "itkGTest.h"
+#include "itk_zlib.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+std::vector<char>
+Gzip(const char * data, size_t size)
+{
+  z_stream stream{};
+  EXPECT_EQ(deflateInit2(&stream, 6, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY), Z_OK);
+  std::vector<char> compressed(deflateBound(&stream, static_cast<uLong>(size)));
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+  stream.avail_in = static_cast<uInt>(size);
+  stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+  stream.avail_out = static_cast<uInt>(compressed.size());
+  EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+  return compressed;
+}
+
+struct ITKGzipSeekIndex : public ::testing::Test
+{
+  // A header followed by two gzip members
+  void
+  SetUp() override
+  {
+    m_Data.resize(3 * 1000 * 1000 + 17);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < m_Data.size(); ++i)
+    {
+      state = state * 1103515245u + 12345u;
+      // Compressible, but not too much
+      m_Data[i] = static_cast<char>((i % 97 < 60) ? (i / 1000) % 251 : (state >> 24));
+    }
+
+    m_FileName = std::string(TOSTRING(ITK_TEST_OUTPUT_DIR)) + "/GzipSeekIndex.dat.gz";
+    std::ofstream file(m_FileName, std::ios::binary);
+    file << std::string(HeaderSize, '#');
+    for (const auto & member : { Gzip(m_Data.data(), MemberSize), //
+                                 Gzip(m_Data.data() + MemberSize, m_Data.size() - MemberSize) })
+    {
+      file.write(member.data(), static_cast<std::streamsize>(member.size()));
+    }
+    file.close();
+    itksys::SystemTools::RemoveFile(itk::GzipSeekIndex::GetIndexFileName(m_FileName));
+  }
+
+  itk::GzipSeekIndex::Pointer
+  MakeIndex() const
+  {
+    auto index = itk::GzipSeekIndex::New();
+    index->SetFileName(m_FileName);
+    index->SetCompressedDataOffset(HeaderSize);
+    index->SetSpan(256 * 1024);
+    return index;
+  }
+
+  void
+  ExpectSameData(std::istream & stream, uint64_t offset, uint64_t size) const
+  {
+    stream.seekg(static_cast<std::streamoff>(offset));
+    ASSERT_TRUE(stream.good()) << "at " << offset;
+    std::vector<char> read(size);
+    stream.read(read.data(), static_cast<std::streamsize>(size));
+    ASSERT_EQ(stream.gcount(), static_cast<std::streamsize>(size)) << "at " << offset;
+    EXPECT_TRUE(std::equal(read.begin(), read.end(), m_Data.begin() + offset)) << "at " << offset;
+  }
+
+  void
+  ExpectRandomAccess(const itk::GzipSeekIndex * index) const
+  {
+    const auto stream = index->MakeInputStream();
+    // Forward and backward, within and across spans and members
+    const std::vector<uint64_t> offsets{ 0, 2900000, 1000000, MemberSize - 1000, 5, 1000100, 65530 };
+    for (const uint64_t offset : offsets)
+    {
+      ExpectSameData(*stream, offset, 2000);
+    }
+    ExpectSameData(*stream, m_Data.size() - 7, 7);
+
+    stream->seekg(0, std::ios::end);
+    EXPECT_EQ(static_cast<uint64_t>(stream->tellg()), m_Data.size());
+    EXPECT_EQ(stream->peek(), std::char_traits<char>::eof());
+  }
+
+  static constexpr size_t HeaderSize{ 100 };
+  static constexpr size_t MemberSize{ 2 * 1000 * 1000 };
+
+  std::vector<char> m_Data;
+  std::string       m_FileName;
+};
+
+} // namespace
+
+
+TEST_F(ITKGzipSeekIndex, BuildsSavesAndLoadsIndex)
+{
+  const auto index = MakeIndex();
+  ITK_GTEST_EXERCISE_BASIC_OBJECT_METHODS(index, GzipSeekIndex, Object);
+  EXPECT_TRUE(index->GetUseIndexFile());
+
+  index->Update();
+  EXPECT_EQ(index->GetUncompressedSize(), m_Data.size());
+  EXPECT_GE(index->GetAccessPoints().size(), 8u);
+  EXPECT_EQ(index->FindAccessPoint(0), nullptr);
+  EXPECT_TRUE(itksys::SystemTools::FileExists(itk::GzipSeekIndex::GetIndexFileName(m_FileName)));
+  ExpectRandomAccess(index);
+
+  const auto loaded = MakeIndex();
+  loaded->Update();
+  EXPECT_EQ(loaded->GetUncompressedSize(), m_Data.size());
+  ASSERT_EQ(loaded->GetAccessPoints().size(), index->GetAccessPoints().size());
+  for (size_t i = 0; i < index->GetAccessPoints().size(); ++i)
+  {
+    EXPECT_EQ(loaded->GetAccessPoints()[i].m_UncompressedOffset, index->GetAccessPoints()[i].m_UncompressedOffset);
+    EXPECT_EQ(loaded->GetAccessPoints()[i].m_CompressedOffset, index->GetAccessPoints()[i].m_CompressedOffset);
+    EXPECT_EQ(loaded->GetAccessPoints()[i].m_CompressedWindow, index->GetAccessPoints()[i].m_CompressedWindow);
+  }
+  ExpectRandomAccess(loaded);
+}
+
+
+TEST_F(ITKGzipSeekIndex, WithoutIndexFile)
+{
+  const auto index = MakeIndex();
+  index->UseIndexFileOff();
+  index->Update();
+  EXPECT_FALSE(itksys::SystemTools::FileExists(itk::GzipSeekIndex::GetIndexFileName(m_FileName)));
+  ExpectRandomAccess(index);
+}
+
+
+TEST_F(ITKGzipSeekIndex, RejectsInvalidData)
+{
+  const auto index = MakeIndex();
+  // The header is not gzip data
+  index->SetCompressedDataOffset(0);
+  EXPECT_THROW(index->Update(), itk::ExceptionObject);
+
+  index->SetFileName(m_FileName + ".missing");
+  EXPECT_THROW(index->Update(), itk::ExceptionObject);
+}
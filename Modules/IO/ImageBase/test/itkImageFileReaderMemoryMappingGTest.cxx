@@ -0,0 +1,207 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMemoryMappedImageContainer.h"
+#include "itkMetaImageIO.h"
+#include "itkVectorImage.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageFileReaderMemoryMapping : public ::testing::Test
+{
+  using ImageType = itk::Image<short, 3>;
+  using ContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, short>;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    m_Directory = std::string(TOSTRING(ITK_TEST_OUTPUT_DIR)) + "/";
+  }
+
+  static ImageType::Pointer
+  MakeImage()
+  {
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 31, 17, 9 } });
+    image->Allocate();
+    for (itk::SizeValueType i = 0; i < image->GetPixelContainer()->Size(); ++i)
+    {
+      image->GetBufferPointer()[i] = static_cast<short>(i * 7 - 3000);
+    }
+    return image;
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer
+  ReadMapped(const std::string & fileName, itk::MemoryMappedFileEnums::Access access)
+  {
+    auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    reader->UseMemoryMappingOn();
+    reader->SetMemoryMappingAccess(access);
+    reader->Update();
+    return reader->GetOutput();
+  }
+
+  static bool
+  IsMapped(const ImageType * image)
+  {
+    return dynamic_cast<const ContainerType *>(image->GetPixelContainer()) != nullptr;
+  }
+
+  static bool
+  HaveSamePixels(const ImageType * image1, const ImageType * image2)
+  {
+    return image1->GetBufferedRegion() == image2->GetBufferedRegion() &&
+           std::equal(image1->GetBufferPointer(),
+                      image1->GetBufferPointer() + image1->GetPixelContainer()->Size(),
+                      image2->GetBufferPointer());
+  }
+
+  std::string m_Directory;
+};
+
+} // namespace
+
+
+TEST_F(ITKImageFileReaderMemoryMapping, MapsFileRange)
+{
+  const std::string fileName = m_Directory + "MemoryMappedImageContainer.raw";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    file << "abcdef";
+    for (short value = 0; value < 1000; ++value)
+    {
+      file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+  }
+
+  auto container = ContainerType::New();
+  ITK_GTEST_EXERCISE_BASIC_OBJECT_METHODS(container, MemoryMappedImageContainer, ImportImageContainer);
+
+  // Not aligned, or beyond the end of the file
+  EXPECT_THROW(container->MapFile(fileName, 5, 10), itk::ExceptionObject);
+  EXPECT_THROW(container->MapFile(fileName, 6, 1001), itk::ExceptionObject);
+  EXPECT_EQ(container->GetMemoryMappedFile(), nullptr);
+
+  container->MapFile(fileName, 6, 1000, itk::MemoryMappedFileEnums::Access::CopyOnWrite);
+  ASSERT_NE(container->GetMemoryMappedFile(), nullptr);
+  EXPECT_EQ(container->Size(), 1000u);
+  EXPECT_FALSE(container->GetContainerManageMemory());
+  EXPECT_EQ((*container)[0], 0);
+  EXPECT_EQ((*container)[999], 999);
+
+  // Copy on write does not modify the file
+  (*container)[1] = -1;
+  EXPECT_EQ((*container)[1], -1);
+  auto readOnly = ContainerType::New();
+  readOnly->MapFile(fileName, 6, 1000, itk::MemoryMappedFileEnums::Access::ReadOnly);
+  EXPECT_EQ((*readOnly)[1], 1);
+
+  // Growing copies the elements and releases the mapping
+  container->Reserve(2000);
+  EXPECT_EQ(container->GetMemoryMappedFile(), nullptr);
+  EXPECT_TRUE(container->GetContainerManageMemory());
+  EXPECT_EQ((*container)[1], -1);
+  EXPECT_EQ((*container)[999], 999);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMapping, MapsUncompressedMetaImages)
+{
+  const auto image = MakeImage();
+
+  for (const std::string extension : { ".mha", ".mhd" })
+  {
+    const std::string fileName = m_Directory + "ImageFileReaderMemoryMapping" + extension;
+    itk::WriteImage(image, fileName);
+
+    for (const auto access : { itk::MemoryMappedFileEnums::Access::ReadOnly,
+                               itk::MemoryMappedFileEnums::Access::CopyOnWrite })
+    {
+      const auto mapped = ReadMapped<ImageType>(fileName, access);
+      EXPECT_TRUE(IsMapped(mapped)) << fileName;
+      EXPECT_TRUE(HaveSamePixels(mapped, image)) << fileName;
+    }
+
+    // Modifying a copy on write image leaves the file unchanged
+    const auto modified = ReadMapped<ImageType>(fileName, itk::MemoryMappedFileEnums::Access::CopyOnWrite);
+    modified->GetBufferPointer()[100] = 1;
+    EXPECT_TRUE(HaveSamePixels(itk::ReadImage<ImageType>(fileName), image)) << fileName;
+  }
+
+  // Vector images map components
+  using VectorImageType = itk::VectorImage<short, 3>;
+  const std::string fileName = m_Directory + "ImageFileReaderMemoryMapping.mha";
+  const auto        vectorImage = ReadMapped<VectorImageType>(fileName, itk::MemoryMappedFileEnums::Access::ReadOnly);
+  using MappedVectorContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, short>;
+  EXPECT_NE(dynamic_cast<const MappedVectorContainerType *>(vectorImage->GetPixelContainer()), nullptr);
+  EXPECT_EQ(vectorImage->GetBufferPointer()[123], image->GetBufferPointer()[123]);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMapping, ReadsWhatCannotBeMapped)
+{
+  const auto image = MakeImage();
+
+  // Compressed data
+  const std::string compressedFileName = m_Directory + "ImageFileReaderMemoryMappingCompressed.mha";
+  itk::WriteImage(image, compressedFileName, true);
+  const auto compressed = ReadMapped<ImageType>(compressedFileName, itk::MemoryMappedFileEnums::Access::ReadOnly);
+  EXPECT_FALSE(IsMapped(compressed));
+  EXPECT_TRUE(HaveSamePixels(compressed, image));
+
+  // Another pixel type
+  const std::string fileName = m_Directory + "ImageFileReaderMemoryMapping.mha";
+  itk::WriteImage(image, fileName);
+  using FloatImageType = itk::Image<float, 3>;
+  const auto converted = ReadMapped<FloatImageType>(fileName, itk::MemoryMappedFileEnums::Access::ReadOnly);
+  using MappedFloatContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, float>;
+  EXPECT_EQ(dynamic_cast<const MappedFloatContainerType *>(converted->GetPixelContainer()), nullptr);
+  EXPECT_EQ(converted->GetBufferPointer()[42], image->GetBufferPointer()[42]);
+
+  // A region of the image, read into a buffer that replaces the mapping
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  reader->SetMemoryMappingAccess(itk::MemoryMappedFileEnums::Access::ReadOnly);
+  reader->Update();
+  EXPECT_TRUE(IsMapped(reader->GetOutput()));
+  const ImageType::RegionType region({ { 2, 3, 4 } }, { { 10, 5, 3 } });
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Modified();
+  reader->Update();
+  EXPECT_FALSE(IsMapped(reader->GetOutput()));
+  EXPECT_EQ(reader->GetOutput()->GetBufferedRegion(), region);
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 5, 6, 5 } }), image->GetPixel({ { 5, 6, 5 } }));
+}
@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMetaImageIO.h"
+#include "itkNiftiImageIO.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#include <string>
+#include <vector>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageSeriesReaderParallel : public ::testing::Test
+{
+  using VolumeType = itk::Image<unsigned short, 3>;
+  using ReaderType = itk::ImageSeriesReader<VolumeType>;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  // Writes numberOfSlices slices, the one with index gap being displaced
+  // to create a non uniform sampling.
+  std::vector<std::string>
+  WriteSlices(const std::string & prefix, unsigned int numberOfSlices, unsigned int gap, unsigned int oddSizeSlice)
+  {
+    std::vector<std::string> fileNames;
+    for (unsigned int z = 0; z < numberOfSlices; ++z)
+    {
+      // Single slice volumes, so that the files carry the slice position
+      auto                       slice = VolumeType::New();
+      const VolumeType::SizeType size{ { z == oddSizeSlice ? 12u : 11u, 9, 1 } };
+      slice->SetRegions(size);
+      slice->SetOrigin(itk::MakePoint(1.0, -2.0, 2.5 * z + (z >= gap ? 1.0 : 0.0)));
+      slice->Allocate();
+      for (itk::SizeValueType p = 0; p < slice->GetPixelContainer()->Size(); ++p)
+      {
+        slice->GetBufferPointer()[p] = static_cast<unsigned short>(1000 * z + p);
+      }
+
+      fileNames.push_back(prefix + std::to_string(z) + ".mha");
+      auto writer = itk::ImageFileWriter<VolumeType>::New();
+      writer->SetInput(slice);
+      writer->SetFileName(fileNames.back());
+      writer->Update();
+    }
+    return fileNames;
+  }
+
+  static ReaderType::Pointer
+  MakeReader(const std::vector<std::string> & fileNames, unsigned int numberOfSlicesReadInParallel)
+  {
+    auto reader = ReaderType::New();
+    reader->SetFileNames(fileNames);
+    reader->SetNumberOfSlicesReadInParallel(numberOfSlicesReadInParallel);
+    return reader;
+  }
+
+  static void
+  ExpectSameImages(const VolumeType * expected, const VolumeType * actual)
+  {
+    ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+    EXPECT_EQ(expected->GetOrigin(), actual->GetOrigin());
+    EXPECT_EQ(expected->GetSpacing(), actual->GetSpacing());
+    itk::ImageRegionConstIterator<VolumeType> e(expected, expected->GetBufferedRegion());
+    itk::ImageRegionConstIterator<VolumeType> a(actual, actual->GetBufferedRegion());
+    for (; !e.IsAtEnd(); ++e, ++a)
+    {
+      ASSERT_EQ(e.Get(), a.Get()) << "at index " << e.GetIndex();
+    }
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKImageSeriesReaderParallel, SameResultAsSequentialRead)
+{
+  const auto fileNames = WriteSlices("ImageSeriesReaderParallel_", 11, 6, 11);
+
+  auto serial = MakeReader(fileNames, 1);
+  EXPECT_EQ(serial->GetNumberOfSlicesReadInParallel(), 1u);
+  serial->Update();
+  const ReaderType::DictionaryArrayType serialDictionaries = *serial->GetMetaDataDictionaryArray();
+  ASSERT_EQ(serialDictionaries.size(), fileNames.size());
+
+  for (const unsigned int numberOfSlicesReadInParallel : { 0u, 2u, 4u, 11u, 64u })
+  {
+    auto parallel = MakeReader(fileNames, numberOfSlicesReadInParallel);
+    parallel->Update();
+    ExpectSameImages(serial->GetOutput(), parallel->GetOutput());
+
+    // The dictionaries are in file order, with the same slice-specific entries
+    const ReaderType::DictionaryArrayType & dictionaries = *parallel->GetMetaDataDictionaryArray();
+    ASSERT_EQ(dictionaries.size(), serialDictionaries.size());
+    for (size_t i = 0; i < dictionaries.size(); ++i)
+    {
+      EXPECT_EQ(dictionaries[i]->GetKeys(), serialDictionaries[i]->GetKeys()) << "for slice " << i;
+      EXPECT_EQ(dictionaries[i]->HasKey("ITK_non_uniform_sampling_deviation"),
+                serialDictionaries[i]->HasKey("ITK_non_uniform_sampling_deviation"))
+        << "for slice " << i;
+    }
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderParallel, StreamedRegionWithImageIO)
+{
+  const auto fileNames = WriteSlices("ImageSeriesReaderParallelStreamed_", 9, 9, 9);
+
+  const VolumeType::RegionType region({ { 2, 1, 3 } }, { { 5, 6, 4 } });
+
+  auto serial = MakeReader(fileNames, 1);
+  serial->SetImageIO(itk::MetaImageIO::New());
+  serial->GetOutput()->SetRequestedRegion(region);
+  serial->Update();
+
+  auto parallel = MakeReader(fileNames, 3);
+  parallel->SetImageIO(itk::MetaImageIO::New());
+  parallel->GetOutput()->SetRequestedRegion(region);
+  parallel->Update();
+
+  ExpectSameImages(serial->GetOutput(), parallel->GetOutput());
+}
+
+
+TEST_F(ITKImageSeriesReaderParallel, ReportsFirstSizeMismatch)
+{
+  const auto fileNames = WriteSlices("ImageSeriesReaderParallelMismatch_", 8, 8, 5);
+
+  auto reader = MakeReader(fileNames, 4);
+  try
+  {
+    reader->Update();
+    FAIL() << "Expected a size mismatch exception";
+  }
+  catch (const itk::ExceptionObject & exception)
+  {
+    EXPECT_NE(std::string(exception.GetDescription()).find(fileNames[5]), std::string::npos)
+      << exception.GetDescription();
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderParallel, ReadsWithTheSettingsOfTheImageIO)
+{
+  // With ConvertRASVectors, NiftiImageIO negates the first two components
+  // of the vectors it reads.
+  using VectorVolumeType = itk::Image<itk::Vector<float, 3>, 3>;
+  std::vector<std::string> fileNames;
+  for (unsigned int z = 0; z < 6; ++z)
+  {
+    auto slice = VectorVolumeType::New();
+    slice->SetRegions(VectorVolumeType::SizeType{ { 4, 3, 1 } });
+    slice->SetOrigin(itk::MakePoint(0.0, 0.0, 1.5 * z));
+    slice->Allocate();
+    slice->FillBuffer(itk::MakeVector(1.0f, 2.0f, 3.0f + z));
+
+    fileNames.push_back("ImageSeriesReaderParallelVector_" + std::to_string(z) + ".nii");
+    auto writer = itk::ImageFileWriter<VectorVolumeType>::New();
+    writer->SetInput(slice);
+    writer->SetImageIO(itk::NiftiImageIO::New());
+    writer->SetFileName(fileNames.back());
+    writer->Update();
+  }
+
+  for (const unsigned int numberOfSlicesReadInParallel : { 1u, 3u })
+  {
+    auto imageIO = itk::NiftiImageIO::New();
+    imageIO->SetConvertRASVectors(true);
+    auto reader = itk::ImageSeriesReader<VectorVolumeType>::New();
+    reader->SetFileNames(fileNames);
+    reader->SetImageIO(imageIO);
+    reader->SetNumberOfSlicesReadInParallel(numberOfSlicesReadInParallel);
+    reader->Update();
+    for (unsigned int z = 0; z < fileNames.size(); ++z)
+    {
+      EXPECT_EQ(reader->GetOutput()->GetPixel({ { 1, 2, z } }), itk::MakeVector(-1.0f, -2.0f, 3.0f + z))
+        << "for slice " << z << " read " << numberOfSlicesReadInParallel << " at a time";
+    }
+  }
+}
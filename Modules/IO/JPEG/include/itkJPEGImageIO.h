@@ -119,6 +119,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the settings of this ImageIO too. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   WriteSlice(const std::string & fileName, const void * const buffer);
 
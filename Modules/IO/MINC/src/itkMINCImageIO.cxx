@@ -271,6 +271,20 @@ MINCImageIO::MINCImageIO()
 
 MINCImageIO::~MINCImageIO() { this->CloseVolume(); }
 
+LightObject::Pointer
+MINCImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_RAStoLPS = m_RAStoLPS;
+  return loPtr;
+}
+
 void
 MINCImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -21,6 +21,7 @@
 
 
 #include <fstream>
+#include <vector>
 #include "itkImageIOBase.h"
 #include "itkNumberToString.h"
 #include "itkSingletonMacro.h"
@@ -83,6 +84,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Returns true for uncompressed binary data in a single file, in the
+   * byte order of this machine. */
+  bool
+  GetMemoryMappablePixelData(std::string & fileName, SizeValueType & offset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -135,12 +141,13 @@ public:
                            const ImageIORegion & largestPossibleRegion) override;
 
   /** Determine if the ImageIO can stream reading from this
-   *  file. Only time cannot stream read/write is if compression is used.
+   *  file. Compressed data can only be streamed when it has been written
+   *  in blocks (see SetCompressedDataBlockSize()).
    *  CanRead must be called prior to this function. */
   bool
   CanStreamRead() override
   {
-    if (m_MetaImage.CompressedData())
+    if (m_MetaImage.CompressedData() && m_ReadCompressedDataBlockOffsets.empty())
     {
       return false;
     }
@@ -162,6 +169,19 @@ public:
     return true;
   }
 
+  /** Set/Get the number of uncompressed bytes per block of compressed
+   * data. Blocks are compressed and inflated by multiple threads, and
+   * their offsets are written in the header, so that streamed reads only
+   * inflate the blocks overlapping the requested region. The data remains
+   * a single zlib stream, readable by MetaIO readers unaware of blocks.
+   * Data that fits in a single block is compressed without blocks. The
+   * size may be enlarged for very large images, as the number of blocks
+   * is limited. Default is 0: compress without blocks. */
+  /** @ITKStartGrouping */
+  itkSetMacro(CompressedDataBlockSize, SizeValueType);
+  itkGetConstMacro(CompressedDataBlockSize, SizeValueType);
+  /** @ITKEndGrouping */
+
   /** Determining the subsampling factor in case
    *  we want a coarse version of the image/
    * \warning this is only used when streaming is on. */
@@ -191,6 +211,11 @@ protected:
   ~MetaImageIO() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Copy the settings of this ImageIO too. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   template <unsigned int VNRows, unsigned int VNColumns = VNRows>
   bool
   WriteMatrixInMetaData(std::ostringstream &       strs,
@@ -205,6 +230,20 @@ private:
 
   unsigned int m_SubSamplingFactor{};
 
+  /** Writes compressed data in blocks, see SetCompressedDataBlockSize(). */
+  void
+  WriteCompressedDataBlocks(const void * buffer);
+
+  /** Reads the m_IORegion of compressed data written in blocks. */
+  void
+  ReadCompressedDataBlocks(void * buffer);
+
+  SizeValueType m_CompressedDataBlockSize{ 0 };
+
+  /** Block layout of the compressed data of the file read, if any. */
+  SizeValueType              m_ReadCompressedDataBlockSize{ 0 };
+  std::vector<SizeValueType> m_ReadCompressedDataBlockOffsets{};
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
@@ -13,6 +13,8 @@ itk_module(
   DEPENDS
     ITKMetaIO
     ITKIOImageBase
+  PRIVATE_DEPENDS
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
     ITKSmoothing
@@ -18,15 +18,21 @@
 
 #include "itkMetaImageIO.h"
 #include "itkAnatomicalOrientation.h"
+#include "itkByteSwapper.h"
 #include "itkIOCommon.h"
 #include "itksys/SystemTools.hxx"
 #include "itkMath.h"
 #include "itkNumberToString.h"
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 #include "metaImageUtils.h"
+#include "itk_zlib.h"
 
+#include <algorithm>
+#include <functional>
 #include <set>
+#include <sstream>
 
 
 namespace itk
@@ -37,6 +43,110 @@ itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
 
 unsigned int * MetaImageIO::m_DefaultDoublePrecision;
 
+namespace
+{
+// Header fields describing compressed data written in blocks. The offsets of
+// the blocks are relative to the start of the compressed data.
+constexpr const char * CompressedDataBlockSizeField = "CompressedDataBlockSize";
+constexpr const char * CompressedDataBlockOffsetsField = "CompressedDataBlockOffsets";
+
+// MetaIO reads the offsets, as a single line, into a buffer of 32 KiB
+constexpr SizeValueType MaximumNumberOfCompressedDataBlocks = 2048;
+
+// zlib processes at most 4 GiB at once
+constexpr SizeValueType MaximumCompressedDataBlockSize = SizeValueType{ 1 } << 30;
+
+bool
+IsCompressedDataBlockField(const std::string & name)
+{
+  return name == CompressedDataBlockSizeField || name == CompressedDataBlockOffsetsField;
+}
+
+bool
+IsLocalDataFileName(const std::string & dataFileName)
+{
+  return dataFileName == "LOCAL" || dataFileName == "Local" || dataFileName == "local";
+}
+
+// Path of the data file of a MetaImage, which is relative to its header
+std::string
+GetDataFilePath(const std::string & headerFileName, const std::string & dataFileName)
+{
+  const std::string path = itksys::SystemTools::GetFilenamePath(headerFileName);
+  if (itksys::SystemTools::FileIsFullPath(dataFileName) || path.empty())
+  {
+    return dataFileName;
+  }
+  return path + '/' + dataFileName;
+}
+
+// Offset of the data following the header of a MetaImage file, -1 on failure
+std::streamoff
+GetLocalDataOffset(const std::string & fileName)
+{
+  std::ifstream stream(fileName.c_str(), std::ios::in | std::ios::binary);
+  MetaImage     header;
+  if (!header.ReadStream(0, &stream, false))
+  {
+    return -1;
+  }
+  return stream.tellg();
+}
+
+// Raw deflate of one block. All but the last block end with a full flush,
+// which byte-aligns the output and resets the dictionary, so that each block
+// can be inflated on its own.
+bool
+DeflateBlock(const unsigned char *        data,
+             SizeValueType                dataSize,
+             int                          compressionLevel,
+             bool                         lastBlock,
+             std::vector<unsigned char> & compressed)
+{
+  z_stream stream{};
+  if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+
+  // room for the empty stored block of the full flush as well
+  compressed.resize(deflateBound(&stream, static_cast<uLong>(dataSize)) + 16);
+  stream.next_in = const_cast<unsigned char *>(data);
+  stream.avail_in = static_cast<uInt>(dataSize);
+  stream.next_out = compressed.data();
+  stream.avail_out = static_cast<uInt>(compressed.size());
+
+  const int  result = deflate(&stream, lastBlock ? Z_FINISH : Z_FULL_FLUSH);
+  const bool success =
+    lastBlock ? result == Z_STREAM_END : (result == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+  compressed.resize(compressed.size() - stream.avail_out);
+  deflateEnd(&stream);
+  return success;
+}
+
+// Raw inflate of one block written by DeflateBlock()
+bool
+InflateBlock(const unsigned char * compressed,
+             SizeValueType         compressedSize,
+             unsigned char *       data,
+             SizeValueType         dataSize)
+{
+  z_stream stream{};
+  stream.next_in = const_cast<unsigned char *>(compressed);
+  stream.avail_in = static_cast<uInt>(compressedSize);
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+  {
+    return false;
+  }
+
+  stream.next_out = data;
+  stream.avail_out = static_cast<uInt>(dataSize);
+  const int result = inflate(&stream, Z_SYNC_FLUSH);
+  inflateEnd(&stream);
+  return (result == Z_OK || result == Z_STREAM_END || result == Z_BUF_ERROR) && stream.avail_out == 0;
+}
+} // namespace
+
 MetaImageIO::MetaImageIO()
   : m_SubSamplingFactor(1)
 {
@@ -66,12 +176,28 @@ MetaImageIO::MetaImageIO()
 
 MetaImageIO::~MetaImageIO() = default;
 
+LightObject::Pointer
+MetaImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_SubSamplingFactor = m_SubSamplingFactor;
+  rval->m_CompressedDataBlockSize = m_CompressedDataBlockSize;
+  return loPtr;
+}
+
 void
 MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << '\n';
+  os << indent << "CompressedDataBlockSize: " << m_CompressedDataBlockSize << '\n';
 }
 
 void
@@ -278,12 +404,37 @@ MetaImageIO::ReadImageInformation()
   //
   // save the metadatadictionary in the MetaImage header.
   // NOTE: The MetaIO library only supports typeless strings as metadata
+  m_ReadCompressedDataBlockSize = 0;
+  m_ReadCompressedDataBlockOffsets.clear();
   const int dictFields = m_MetaImage.GetNumberOfAdditionalReadFields();
   for (int f = 0; f < dictFields; ++f)
   {
     const std::string key(m_MetaImage.GetAdditionalReadFieldName(f));
     const std::string value(m_MetaImage.GetAdditionalReadFieldValue(f));
-    EncapsulateMetaData<std::string>(thisMetaDict, key, value);
+    if (key == CompressedDataBlockSizeField)
+    {
+      std::istringstream(value) >> m_ReadCompressedDataBlockSize;
+    }
+    else if (key == CompressedDataBlockOffsetsField)
+    {
+      std::istringstream valueStream(value);
+      for (SizeValueType offset = 0; valueStream >> offset;)
+      {
+        m_ReadCompressedDataBlockOffsets.push_back(offset);
+      }
+    }
+    else
+    {
+      EncapsulateMetaData<std::string>(thisMetaDict, key, value);
+    }
+  }
+  // The blocks are only read from a single, compressed data file
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  if (!m_MetaImage.BinaryData() || !m_MetaImage.CompressedData() || m_MetaImage.HeaderSize() != 0 ||
+      m_ReadCompressedDataBlockSize == 0 || dataFileName.compare(0, 4, "LIST") == 0 ||
+      dataFileName.find('%') != std::string::npos)
+  {
+    m_ReadCompressedDataBlockOffsets.clear();
   }
 
   //
@@ -308,6 +459,12 @@ MetaImageIO::Read(void * buffer)
 {
   const unsigned int nDims = this->GetNumberOfDimensions();
 
+  if (!m_ReadCompressedDataBlockOffsets.empty() && m_SubSamplingFactor == 1)
+  {
+    this->ReadCompressedDataBlocks(buffer);
+    return;
+  }
+
   // this will check to see if we are actually streaming
   // we initialize with the dimensions of the file, since if
   // largestRegion and ioRegion don't match, we'll use the streaming
@@ -360,6 +517,58 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::GetMemoryMappablePixelData(std::string & fileName, SizeValueType & offset)
+{
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  const bool        swapped = m_MetaImage.BinaryDataByteOrderMSB() != ByteSwapper<uint16_t>::SystemIsBigEndian();
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() || (this->GetComponentSize() > 1 && swapped) ||
+      dataFileName.compare(0, 4, "LIST") == 0 || dataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+
+  const bool local = IsLocalDataFileName(dataFileName);
+  fileName = local ? m_FileName : GetDataFilePath(m_FileName, dataFileName);
+  // MetaImage falls back to compressed .gz and .Z files
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    return false;
+  }
+
+  const SizeValueType fileSize = itksys::SystemTools::FileLength(fileName);
+  const SizeValueType dataSize = this->GetImageSizeInBytes();
+  const int           headerSize = m_MetaImage.HeaderSize();
+  if (headerSize > 0)
+  {
+    offset = static_cast<SizeValueType>(headerSize);
+  }
+  else if (headerSize == -1)
+  {
+    // The data is at the end of the file
+    if (fileSize < dataSize)
+    {
+      return false;
+    }
+    offset = fileSize - dataSize;
+  }
+  else if (local)
+  {
+    // The data follows the header
+    const std::streamoff position = GetLocalDataOffset(fileName);
+    if (position < 0)
+    {
+      return false;
+    }
+    offset = static_cast<SizeValueType>(position);
+  }
+  else
+  {
+    offset = 0;
+  }
+  return offset + dataSize <= fileSize;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -418,7 +627,7 @@ MetaImageIO::WriteImageInformation()
   const std::vector<std::string> keys = metaDict.GetKeys();
   for (auto & key : keys)
   {
-    if (key == ITK_ExperimentDate || key == ITK_VoxelUnits)
+    if (key == ITK_ExperimentDate || key == ITK_VoxelUnits || IsCompressedDataBlockField(key))
     {
       continue;
     }
@@ -717,6 +926,14 @@ MetaImageIO::Write(const void * buffer)
   m_MetaImage.CompressedData(m_UseCompression);
   m_MetaImage.CompressionLevel(this->GetCompressionLevel());
 
+  // Data that fits in a single block is compressed by MetaImage
+  const std::string   dataFileName = m_MetaImage.ElementDataFileName();
+  const SizeValueType dataSize = this->GetImageSizeInBytes();
+  const bool          compressedDataBlocks = m_UseCompression && binaryData && m_CompressedDataBlockSize > 0 &&
+                                    dataSize > m_CompressedDataBlockSize &&
+                                    dataFileName.compare(0, 4, "LIST") != 0 &&
+                                    dataFileName.find('%') == std::string::npos;
+
   // this is a check to see if we are actually streaming
   // we initialize with m_IORegion to match dimensions
   ImageIORegion largestRegion(m_IORegion);
@@ -749,6 +966,10 @@ MetaImageIO::Write(const void * buffer)
                                                        << "Reason: " << itksys::SystemTools::GetLastSystemError());
     }
   }
+  else if (compressedDataBlocks)
+  {
+    this->WriteCompressedDataBlocks(buffer);
+  }
   else
   {
     if (!m_MetaImage.Write(m_FileName.c_str()))
@@ -759,6 +980,282 @@ MetaImageIO::Write(const void * buffer)
   }
 }
 
+void
+MetaImageIO::ReadCompressedDataBlocks(void * buffer)
+{
+  const std::string    dataFileName = m_MetaImage.ElementDataFileName();
+  const bool           local = IsLocalDataFileName(dataFileName);
+  const std::string    fileName = local ? m_FileName : GetDataFilePath(m_FileName, dataFileName);
+  const std::streamoff dataOffset = local ? GetLocalDataOffset(fileName) : 0;
+  const SizeValueType  fileSize = itksys::SystemTools::FileLength(fileName);
+
+  const SizeValueType                dataSize = this->GetImageSizeInBytes();
+  const SizeValueType                blockSize = m_ReadCompressedDataBlockSize;
+  const std::vector<SizeValueType> & blockOffsets = m_ReadCompressedDataBlockOffsets;
+  const SizeValueType                numberOfBlocks = blockOffsets.size();
+  if (dataOffset < 0 || static_cast<SizeValueType>(dataOffset) >= fileSize ||
+      numberOfBlocks != (dataSize + blockSize - 1) / blockSize ||
+      std::adjacent_find(blockOffsets.cbegin(), blockOffsets.cend(), std::greater_equal<SizeValueType>()) !=
+        blockOffsets.cend() ||
+      blockOffsets.back() >= fileSize - dataOffset)
+  {
+    itkExceptionMacro("Invalid compressed data blocks in file: " << this->GetFileName());
+  }
+  const SizeValueType compressedDataSize = fileSize - dataOffset;
+
+  // Offsets of the lines of the region in the uncompressed data
+  const unsigned int         nDims = this->GetNumberOfDimensions();
+  const SizeValueType        pixelSize = this->GetPixelSize();
+  std::vector<SizeValueType> regionIndex(nDims, 0);
+  std::vector<SizeValueType> regionSize(nDims, 1);
+  std::vector<SizeValueType> strides(nDims);
+  SizeValueType              numberOfLines = 1;
+  for (unsigned int i = 0; i < nDims; ++i)
+  {
+    if (i < m_IORegion.GetImageDimension())
+    {
+      regionIndex[i] = static_cast<SizeValueType>(m_IORegion.GetIndex(i));
+      regionSize[i] = m_IORegion.GetSize(i);
+    }
+    strides[i] = (i == 0) ? pixelSize : strides[i - 1] * this->GetDimensions(i - 1);
+    numberOfLines *= (i == 0) ? 1 : regionSize[i];
+  }
+  const SizeValueType        lineSize = regionSize[0] * pixelSize;
+  std::vector<SizeValueType> lineOffsets(numberOfLines);
+  std::vector<SizeValueType> position(regionIndex);
+  for (auto & lineOffset : lineOffsets)
+  {
+    lineOffset = 0;
+    for (unsigned int i = 0; i < nDims; ++i)
+    {
+      lineOffset += position[i] * strides[i];
+    }
+    for (unsigned int i = 1; i < nDims && ++position[i] == regionIndex[i] + regionSize[i]; ++i)
+    {
+      position[i] = regionIndex[i];
+    }
+  }
+
+  // Only the blocks overlapping the lines are read and inflated
+  std::vector<char> neededBlocks(numberOfBlocks, 0);
+  for (const SizeValueType lineOffset : lineOffsets)
+  {
+    std::fill(neededBlocks.begin() + lineOffset / blockSize,
+              neededBlocks.begin() + (lineOffset + lineSize - 1) / blockSize + 1,
+              char{ 1 });
+  }
+  const auto          firstBlock = static_cast<SizeValueType>(std::find(neededBlocks.cbegin(), neededBlocks.cend(), 1) -
+                                                     neededBlocks.cbegin());
+  const SizeValueType lastBlock =
+    numberOfBlocks - 1 - static_cast<SizeValueType>(std::find(neededBlocks.crbegin(), neededBlocks.crend(), 1) -
+                                                    neededBlocks.crbegin());
+  const auto blockEnd = [&](SizeValueType block) {
+    return block + 1 < numberOfBlocks ? blockOffsets[block + 1] : compressedDataSize;
+  };
+
+  std::vector<unsigned char> compressedData(blockEnd(lastBlock) - blockOffsets[firstBlock]);
+  std::ifstream              file;
+  this->OpenFileForReading(file, fileName);
+  file.seekg(dataOffset + static_cast<std::streamoff>(blockOffsets[firstBlock]), std::ios::beg);
+  file.read(reinterpret_cast<char *>(compressedData.data()), static_cast<std::streamsize>(compressedData.size()));
+  if (!file)
+  {
+    itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  // The whole data is inflated in place
+  auto * const                            data = static_cast<unsigned char *>(buffer);
+  const bool                              wholeData = numberOfLines * lineSize == dataSize;
+  std::vector<std::vector<unsigned char>> blocks(wholeData ? 0 : numberOfBlocks);
+  std::vector<char>                       inflated(numberOfBlocks, 1);
+  MultiThreaderBase::New()->ParallelizeArray(
+    firstBlock,
+    lastBlock + 1,
+    [&](SizeValueType block) {
+      if (!neededBlocks[block])
+      {
+        return;
+      }
+      const SizeValueType size = std::min(blockSize, dataSize - block * blockSize);
+      unsigned char *     blockData = data + block * blockSize;
+      if (!wholeData)
+      {
+        blocks[block].resize(size);
+        blockData = blocks[block].data();
+      }
+      inflated[block] = InflateBlock(compressedData.data() + blockOffsets[block] - blockOffsets[firstBlock],
+                                     blockEnd(block) - blockOffsets[block],
+                                     blockData,
+                                     size);
+    },
+    nullptr);
+  if (std::find(inflated.cbegin(), inflated.cend(), 0) != inflated.cend())
+  {
+    itkExceptionMacro("Compressed data cannot be inflated: " << this->GetFileName());
+  }
+
+  if (!wholeData)
+  {
+    unsigned char * line = data;
+    for (const SizeValueType lineOffset : lineOffsets)
+    {
+      for (SizeValueType copied = 0; copied < lineSize;)
+      {
+        const SizeValueType block = (lineOffset + copied) / blockSize;
+        const SizeValueType offsetInBlock = lineOffset + copied - block * blockSize;
+        const SizeValueType count = std::min(lineSize - copied, blockSize - offsetInBlock);
+        std::copy_n(blocks[block].data() + offsetInBlock, count, line + copied);
+        copied += count;
+      }
+      line += lineSize;
+    }
+  }
+
+  m_MetaImage.ElementData(buffer);
+  m_MetaImage.ElementByteOrderFix(static_cast<std::streamoff>(numberOfLines * regionSize[0]));
+}
+
+void
+MetaImageIO::WriteCompressedDataBlocks(const void * buffer)
+{
+  const auto *        data = static_cast<const unsigned char *>(buffer);
+  const SizeValueType dataSize = this->GetImageSizeInBytes();
+  const SizeValueType blockSize = std::min(
+    std::max(m_CompressedDataBlockSize,
+             (dataSize + MaximumNumberOfCompressedDataBlocks - 1) / MaximumNumberOfCompressedDataBlocks),
+    MaximumCompressedDataBlockSize);
+  const SizeValueType numberOfBlocks = (dataSize + blockSize - 1) / blockSize;
+  if (numberOfBlocks > MaximumNumberOfCompressedDataBlocks)
+  {
+    itkExceptionMacro("Too much data to compress in blocks: " << this->GetFileName());
+  }
+
+  const int                               compressionLevel = this->GetCompressionLevel();
+  std::vector<std::vector<unsigned char>> blocks(numberOfBlocks);
+  std::vector<uLong>                      checksums(numberOfBlocks);
+  std::vector<char>                       deflated(numberOfBlocks, 0);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      const unsigned char * blockData = data + block * blockSize;
+      const SizeValueType   size = std::min(blockSize, dataSize - block * blockSize);
+      deflated[block] = DeflateBlock(blockData, size, compressionLevel, block + 1 == numberOfBlocks, blocks[block]);
+      checksums[block] = adler32(adler32(0L, Z_NULL, 0), blockData, static_cast<uInt>(size));
+    },
+    nullptr);
+  if (std::find(deflated.cbegin(), deflated.cend(), 0) != deflated.cend())
+  {
+    itkExceptionMacro("Data cannot be compressed: " << this->GetFileName());
+  }
+
+  // A zlib header (deflate with a 32 KiB window) and an Adler-32 trailer make
+  // the blocks a single zlib stream
+  const int     levelFlag = compressionLevel < 2 ? 0 : (compressionLevel < 6 ? 1 : (compressionLevel == 6 ? 2 : 3));
+  unsigned char zlibHeader[2] = { 0x78, static_cast<unsigned char>(levelFlag << 6) };
+  zlibHeader[1] += static_cast<unsigned char>((31 - (zlibHeader[0] * 256 + zlibHeader[1]) % 31) % 31);
+
+  std::ostringstream blockOffsets;
+  SizeValueType      compressedDataSize = sizeof(zlibHeader);
+  uLong              checksum = checksums[0];
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    if (block > 0)
+    {
+      blockOffsets << ' ';
+      checksum = adler32_combine(
+        checksum, checksums[block], static_cast<z_off_t>(std::min(blockSize, dataSize - block * blockSize)));
+    }
+    blockOffsets << compressedDataSize;
+    compressedDataSize += blocks[block].size();
+  }
+  const unsigned char zlibTrailer[4] = { static_cast<unsigned char>((checksum >> 24) & 0xff),
+                                         static_cast<unsigned char>((checksum >> 16) & 0xff),
+                                         static_cast<unsigned char>((checksum >> 8) & 0xff),
+                                         static_cast<unsigned char>(checksum & 0xff) };
+  compressedDataSize += sizeof(zlibTrailer);
+
+  const std::string blockSizeValue = std::to_string(blockSize);
+  const std::string blockOffsetsValue = blockOffsets.str();
+  m_MetaImage.AddUserField(CompressedDataBlockSizeField,
+                           MET_STRING,
+                           static_cast<int>(blockSizeValue.size()),
+                           blockSizeValue.c_str(),
+                           true,
+                           -1);
+  m_MetaImage.AddUserField(CompressedDataBlockOffsetsField,
+                           MET_STRING,
+                           static_cast<int>(blockOffsetsValue.size()),
+                           blockOffsetsValue.c_str(),
+                           true,
+                           -1);
+
+  // Same data file names as MetaImage::Write()
+  std::string dataFileName = m_MetaImage.ElementDataFileName();
+  const bool  userDataFileName = !dataFileName.empty();
+  if (!userDataFileName)
+  {
+    dataFileName = itksys::SystemTools::GetFilenameLastExtension(m_FileName) == ".mha"
+                     ? "LOCAL"
+                     : itksys::SystemTools::GetFilenameWithoutLastExtension(m_FileName) + ".zraw";
+  }
+  m_MetaImage.FileName(m_FileName.c_str());
+  m_MetaImage.ElementDataFileName(dataFileName.c_str());
+
+  // MetaImage compresses all the data whenever it writes the header of
+  // compressed data, so the header is written for uncompressed data, and its
+  // CompressedData field is then replaced.
+  std::ofstream file;
+  this->OpenFileForWriting(file, m_FileName);
+  m_MetaImage.CompressedData(false);
+  const bool headerWritten = m_MetaImage.WriteStream(&file, false);
+  m_MetaImage.CompressedData(true);
+  file.close();
+  // The fields of the metadata dictionary are added again by the next write
+  m_MetaImage.ClearUserFields();
+  if (!userDataFileName)
+  {
+    m_MetaImage.ElementDataFileName("");
+  }
+
+  std::string header;
+  if (headerWritten)
+  {
+    std::ifstream      headerFile(m_FileName.c_str(), std::ios::in | std::ios::binary);
+    std::ostringstream headerStream;
+    headerStream << headerFile.rdbuf();
+    header = headerStream.str();
+  }
+  const std::string            uncompressedField = "\nCompressedData = False\n";
+  const std::string::size_type fieldPosition = header.find(uncompressedField);
+  if (fieldPosition == std::string::npos)
+  {
+    itkExceptionMacro("File cannot be written: " << this->GetFileName());
+  }
+  header.replace(fieldPosition,
+                 uncompressedField.size(),
+                 "\nCompressedData = True\nCompressedDataSize = " + std::to_string(compressedDataSize) + '\n');
+  this->OpenFileForWriting(file, m_FileName);
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+  if (!IsLocalDataFileName(dataFileName))
+  {
+    this->OpenFileForWriting(file, GetDataFilePath(m_FileName, dataFileName));
+  }
+  file.write(reinterpret_cast<const char *>(zlibHeader), sizeof(zlibHeader));
+  for (const auto & block : blocks)
+  {
+    file.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size()));
+  }
+  file.write(reinterpret_cast<const char *>(zlibTrailer), sizeof(zlibTrailer));
+  if (!file)
+  {
+    itkExceptionMacro("File cannot be written: " << this->GetFileName() << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+}
+
 /** Given a requested region, determine what could be the region that we can
  * read from the file. This is called the streamable region, which will be
  * smaller than the LargestPossibleRegion and greater or equal to the
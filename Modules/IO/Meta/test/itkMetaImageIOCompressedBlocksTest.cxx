@@ -0,0 +1,220 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+#include "itk_zlib.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Writes and reads compressed MetaImages made of independently compressed
+// blocks, whole and streamed, and checks that the data remains a plain
+// zlib stream for readers that are unaware of the blocks.
+
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+Value(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>((index[0] * 7 + index[1] * 31 + index[2] * 101) % 3000 - 1000);
+}
+
+ImageType::Pointer
+MakeImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 61, 47, 33 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(Value(it.GetIndex()));
+  }
+  return image;
+}
+
+bool
+CheckRegion(const ImageType * image, const ImageType::RegionType & region)
+{
+  if (!image->GetBufferedRegion().IsInside(region))
+  {
+    std::cerr << "Buffered region " << image->GetBufferedRegion() << " does not contain " << region << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != Value(it.GetIndex()))
+    {
+      std::cerr << "Wrong value " << it.Get() << " at " << it.GetIndex() << ", expected " << Value(it.GetIndex())
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+ReadAndCheck(const std::string & fileName, bool expectStreaming)
+{
+  bool success = true;
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::MetaImageIO::New());
+  reader->Update();
+  success &= CheckRegion(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion());
+
+  reader->UpdateOutputInformation();
+  if (reader->GetImageIO()->CanStreamRead() != expectStreaming)
+  {
+    std::cerr << "CanStreamRead() is not " << expectStreaming << " for " << fileName << std::endl;
+    success = false;
+  }
+  if (reader->GetImageIO()->GetMetaDataDictionary().HasKey("CompressedDataBlockOffsets"))
+  {
+    std::cerr << "The block offsets are in the metadata dictionary of " << fileName << std::endl;
+    success = false;
+  }
+
+  // Regions read backward in the file
+  const ImageType::RegionType regions[] = { ImageType::RegionType({ { 3, 20, 25 } }, { { 40, 9, 6 } }),
+                                            ImageType::RegionType({ { 0, 0, 4 } }, { { 61, 47, 2 } }),
+                                            ImageType::RegionType({ { 60, 46, 0 } }, { { 1, 1, 1 } }) };
+  for (const auto & region : regions)
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Modified();
+    reader->Update();
+    success &= CheckRegion(reader->GetOutput(), region);
+    if (expectStreaming && reader->GetOutput()->GetBufferedRegion() != region)
+    {
+      std::cerr << "Read " << reader->GetOutput()->GetBufferedRegion() << " instead of " << region << std::endl;
+      success = false;
+    }
+  }
+  return success;
+}
+
+// Checks the compressed data size in the header of a .mha file, and inflates
+// its data as a single zlib stream, which is what readers unaware of the
+// blocks do.
+bool
+InflateAsSingleStream(const std::string & fileName, const ImageType * image)
+{
+  std::ifstream     file(fileName, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const std::string lastField = "ElementDataFile = LOCAL\n";
+  const size_t      dataStart = content.find(lastField) + lastField.size();
+
+  const std::string compressedFields =
+    "\nCompressedData = True\nCompressedDataSize = " + std::to_string(content.size() - dataStart) + '\n';
+  if (content.substr(0, dataStart).find(compressedFields) == std::string::npos)
+  {
+    std::cerr << "The header of " << fileName << " does not give the size of the compressed data" << std::endl;
+    return false;
+  }
+
+  const uLongf               expectedSize = image->GetPixelContainer()->Size() * sizeof(PixelType);
+  uLongf                     size = expectedSize;
+  std::vector<unsigned char> inflated(size);
+  const int                  result = uncompress(inflated.data(),
+                                &size,
+                                reinterpret_cast<const Bytef *>(content.data() + dataStart),
+                                static_cast<uLong>(content.size() - dataStart));
+  if (result != Z_OK || size != expectedSize ||
+      std::memcmp(inflated.data(), image->GetBufferPointer(), static_cast<size_t>(size)) != 0)
+  {
+    std::cerr << "zlib could not inflate the data of " << fileName << " (" << result << ")" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkMetaImageIOCompressedBlocksTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  const auto image = MakeImage();
+  auto       io = itk::MetaImageIO::New();
+  ITK_TEST_EXPECT_EQUAL(io->GetCompressedDataBlockSize(), 0);
+  io->SetCompressedDataBlockSize(4096);
+  ITK_TEST_SET_GET_VALUE(4096, io->GetCompressedDataBlockSize());
+
+  bool success = true;
+
+  const auto write = [&image](const std::string & fileName, itk::SizeValueType blockSize) {
+    auto writerIO = itk::MetaImageIO::New();
+    writerIO->SetCompressedDataBlockSize(blockSize);
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetImageIO(writerIO);
+    writer->SetFileName(fileName);
+    writer->UseCompressionOn();
+    writer->Update();
+  };
+
+  // Blocks much smaller than a slice, and not aligned with the lines
+  const std::string blocksFileName = directory + "/MetaImageIOCompressedBlocks.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(write(blocksFileName, 1000));
+  ITK_TRY_EXPECT_NO_EXCEPTION(success &= ReadAndCheck(blocksFileName, true));
+  success &= InflateAsSingleStream(blocksFileName, image);
+
+  // Data that fits in a single block is written without blocks
+  const std::string singleBlockFileName = directory + "/MetaImageIOCompressedSingleBlock.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(write(singleBlockFileName, 1 << 30));
+  ITK_TRY_EXPECT_NO_EXCEPTION(success &= ReadAndCheck(singleBlockFileName, false));
+  success &= InflateAsSingleStream(singleBlockFileName, image);
+
+  // Separate data file
+  const std::string separateFileName = directory + "/MetaImageIOCompressedBlocks.mhd";
+  ITK_TRY_EXPECT_NO_EXCEPTION(write(separateFileName, 4096));
+  ITK_TRY_EXPECT_NO_EXCEPTION(success &= ReadAndCheck(separateFileName, true));
+
+  // Without blocks, as written by earlier versions
+  const std::string legacyFileName = directory + "/MetaImageIOCompressedWithoutBlocks.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(write(legacyFileName, 0));
+  ITK_TRY_EXPECT_NO_EXCEPTION(success &= ReadAndCheck(legacyFileName, false));
+  success &= InflateAsSingleStream(legacyFileName, image);
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
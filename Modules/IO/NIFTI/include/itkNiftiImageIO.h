@@ -24,6 +24,7 @@
 #include <fstream>
 #include <memory>
 #include "itkImageIOBase.h"
+#include "itkGzipSeekIndex.h"
 
 
 namespace itk
@@ -183,7 +184,9 @@ public:
   Write(const void * buffer) override;
 
   /** Calculate the region of the image that can be efficiently read
-   *  in response to a given requested region. */
+   *  in response to a given requested region. Regions of gzip compressed
+   *  files are read through a GzipSeekIndex, which is built on the first
+   *  such read and saved beside the file. */
   ImageIORegion
   GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
 
@@ -245,6 +248,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the settings of this ImageIO too. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual bool
   GetUseLegacyModeForTwoFileWriting() const
   {
@@ -294,6 +301,9 @@ private:
 
   bool m_SFORM_Permissive{ false };
   bool m_SFORM_Corrected{ false };
+
+  // Kept for the next regions read from the same compressed file
+  GzipSeekIndex::Pointer m_GzipSeekIndex{};
 };
 
 
@@ -28,6 +28,9 @@
 #include "itksys/SystemTools.hxx"
 #include "itksys/SystemInformation.hxx"
 
+#include <algorithm>
+#include <cmath>
+
 namespace itk
 {
 
@@ -197,6 +200,25 @@ NiftiImageIO::NiftiImageIO()
 
 NiftiImageIO::~NiftiImageIO() = default;
 
+LightObject::Pointer
+NiftiImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_RescaleSlope = m_RescaleSlope;
+  rval->m_RescaleIntercept = m_RescaleIntercept;
+  rval->m_LegacyAnalyze75Mode = m_LegacyAnalyze75Mode;
+  rval->m_ConvertRASVectors = m_ConvertRASVectors;
+  rval->m_ConvertRASDisplacementVectors = m_ConvertRASDisplacementVectors;
+  rval->m_SFORM_Permissive = m_SFORM_Permissive;
+  return loPtr;
+}
+
 void
 NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -211,6 +233,7 @@ NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "OnDiskComponentType: " << m_OnDiskComponentType << std::endl;
   os << indent << "LegacyAnalyze75Mode: " << m_LegacyAnalyze75Mode << std::endl;
   os << indent << "SFORM permissive: " << (m_SFORM_Permissive ? "On" : "Off") << std::endl;
+  itkPrintSelfObjectMacro(GzipSeekIndex);
 }
 
 bool
@@ -286,6 +309,83 @@ ConvertRASToFromLPS_XYZTC(TBuffer * buffer, size_t size)
     buffer[i] *= -1;
   }
 }
+
+// Reads a region of the data of nim from a seekable stream over its
+// uncompressed image file, with the same layout, byte swapping and
+// non-finite value fixing as nifti_read_subregion_image. Returns nullptr
+// on failure, or a buffer to be released with free().
+void *
+ReadSubregion(std::istream & stream, const nifti_image * nim, const int origin[7], const int size[7])
+{
+  size_t strides[7];
+  strides[0] = nim->nbyper;
+  for (int i = 1; i < 7; ++i)
+  {
+    strides[i] = strides[i - 1] * static_cast<size_t>(i <= nim->ndim ? nim->dim[i] : 1);
+  }
+  size_t totalSize = nim->nbyper;
+  for (int i = 0; i < 7; ++i)
+  {
+    totalSize *= static_cast<size_t>(size[i]);
+  }
+  auto * data = static_cast<char *>(malloc(totalSize));
+  if (data == nullptr)
+  {
+    return nullptr;
+  }
+
+  // Read a row at a time
+  const auto rowSize = static_cast<std::streamsize>(size[0]) * nim->nbyper;
+  int        index[7];
+  std::copy_n(origin, 7, index);
+  for (char * row = data; row < data + totalSize; row += rowSize)
+  {
+    std::streamoff offset = nim->iname_offset;
+    for (int i = 0; i < 7; ++i)
+    {
+      offset += static_cast<std::streamoff>(index[i] * strides[i]);
+    }
+    stream.seekg(offset, std::ios::beg);
+    stream.read(row, rowSize);
+    if (stream.gcount() != rowSize)
+    {
+      free(data);
+      return nullptr;
+    }
+    for (int i = 1; i < 7 && ++index[i] == origin[i] + size[i]; ++i)
+    {
+      index[i] = origin[i];
+    }
+  }
+
+  if (nim->swapsize > 1 && nim->byteorder != nifti_short_order())
+  {
+    nifti_swap_Nbytes(totalSize / nim->swapsize, nim->swapsize, data);
+  }
+  const auto zeroNonFiniteValues = [totalSize](auto * values) {
+    for (size_t i = 0; i < totalSize / sizeof(*values); ++i)
+    {
+      if (!std::isfinite(values[i]))
+      {
+        values[i] = 0;
+      }
+    }
+  };
+  switch (nim->datatype)
+  {
+    case NIFTI_TYPE_FLOAT32:
+    case NIFTI_TYPE_COMPLEX64:
+      zeroNonFiniteValues(reinterpret_cast<float *>(data));
+      break;
+    case NIFTI_TYPE_FLOAT64:
+    case NIFTI_TYPE_COMPLEX128:
+      zeroNonFiniteValues(reinterpret_cast<double *>(data));
+      break;
+    default:
+      break;
+  }
+  return data;
+}
 } // namespace
 
 void
@@ -360,6 +460,24 @@ NiftiImageIO::Read(void * buffer)
       }
       data = m_Holder->ptr->data;
     }
+    else if (nifti_is_gzfile(m_Holder->ptr->iname))
+    {
+      // nifti_read_subregion_image would decompress the file from its
+      // start up to the region
+      if (m_GzipSeekIndex.IsNull() || m_GzipSeekIndex->GetFileName() != m_Holder->ptr->iname)
+      {
+        auto index = GzipSeekIndex::New();
+        index->SetFileName(m_Holder->ptr->iname);
+        index->Update();
+        m_GzipSeekIndex = index;
+      }
+      const std::unique_ptr<std::istream> stream = m_GzipSeekIndex->MakeInputStream();
+      data = ReadSubregion(*stream, m_Holder->ptr.get(), _origin, _size);
+      if (data == nullptr)
+      {
+        itkExceptionMacro("Reading a region of the compressed data failed for file: " << this->GetFileName());
+      }
+    }
     else
     {
       // read in a subregion
@@ -452,12 +570,13 @@ NiftiImageIO::Read(void * buffer)
   {
     // otherwise nifti is x y z t vec l m 0, itk is
     // vec x y z t l m o
+    // The dimensions are those of the region that was read
     const auto * niftibuf = static_cast<const char *>(data);
     auto *       itkbuf = static_cast<char *>(buffer);
-    const size_t rowdist = m_Holder->ptr->dim[1];
-    const size_t slicedist = rowdist * m_Holder->ptr->dim[2];
-    const size_t volumedist = slicedist * m_Holder->ptr->dim[3];
-    const size_t seriesdist = volumedist * m_Holder->ptr->dim[4];
+    const size_t rowdist = _size[0];
+    const size_t slicedist = rowdist * _size[1];
+    const size_t volumedist = slicedist * _size[2];
+    const size_t seriesdist = volumedist * _size[3];
     //
     // as per ITK bug 0007485
     // NIfTI is lower triangular, ITK is upper triangular.
@@ -475,13 +594,13 @@ NiftiImageIO::Read(void * buffer)
         vecOrder[i] = i;
       }
     }
-    for (int t = 0; t < m_Holder->ptr->dim[4]; ++t)
+    for (int t = 0; t < _size[3]; ++t)
     {
-      for (int z = 0; z < m_Holder->ptr->dim[3]; ++z)
+      for (int z = 0; z < _size[2]; ++z)
       {
-        for (int y = 0; y < m_Holder->ptr->dim[2]; ++y)
+        for (int y = 0; y < _size[1]; ++y)
         {
-          for (int x = 0; x < m_Holder->ptr->dim[1]; ++x)
+          for (int x = 0; x < _size[0]; ++x)
           {
             for (unsigned int c = 0; c < numComponents; ++c)
             {
@@ -774,6 +893,7 @@ NiftiImageIO::ReadImageInformation()
     }
   }
 
+  m_GzipSeekIndex = nullptr;
   m_Holder->ptr.reset(nifti_image_read(this->GetFileName(), false));
   if (m_Holder->ptr == nullptr)
   {
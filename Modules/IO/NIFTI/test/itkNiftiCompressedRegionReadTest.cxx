@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGzipSeekIndex.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNiftiImageIO.h"
+#include "itkTestingMacros.h"
+#include "itkVector.h"
+#include "itksys/SystemTools.hxx"
+
+#include <string>
+
+// Reads regions of gzip compressed NIfTI files, which go through a
+// GzipSeekIndex, and compares them with the written images.
+
+namespace
+{
+template <typename T>
+T
+MakePixel(double value)
+{
+  return static_cast<T>(value);
+}
+
+template <>
+itk::Vector<float, 2>
+MakePixel(double value)
+{
+  return itk::MakeVector(static_cast<float>(value), static_cast<float>(value) + 0.5f);
+}
+
+template <typename TImage>
+bool
+ReadRegionsAndCompare(const TImage * image, const std::string & fileName)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::NiftiImageIO::New());
+
+  using RegionType = typename TImage::RegionType;
+  const RegionType regions[] = { RegionType({ { 4, 9, 12 } }, { { 20, 6, 5 } }),
+                                 RegionType({ { 0, 0, 2 } }, { { 33, 21, 1 } }),
+                                 RegionType({ { 32, 20, 0 } }, { { 1, 1, 1 } }),
+                                 RegionType({ { 1, 2, 3 } }, { { 31, 18, 14 } }) };
+  for (const auto & region : regions)
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Update();
+    const TImage * output = reader->GetOutput();
+    if (output->GetBufferedRegion() != region)
+    {
+      std::cerr << "Read " << output->GetBufferedRegion() << " instead of " << region << " from " << fileName
+                << std::endl;
+      return false;
+    }
+    for (itk::ImageRegionConstIteratorWithIndex<TImage> it(output, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != image->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Wrong value " << it.Get() << " at " << it.GetIndex() << " in " << fileName << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename TImage>
+bool
+WriteAndReadRegions(const std::string & fileName)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 33, 21, 17 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(MakePixel<typename TImage::PixelType>((index[0] * 7 + index[1] * 41 + index[2] * 900) % 20000 - 9000));
+  }
+  itk::WriteImage(image, fileName, true);
+  itksys::SystemTools::RemoveFile(itk::GzipSeekIndex::GetIndexFileName(fileName));
+
+  bool success = ReadRegionsAndCompare(image.GetPointer(), fileName);
+  if (!itksys::SystemTools::FileExists(itk::GzipSeekIndex::GetIndexFileName(fileName)))
+  {
+    std::cerr << "No index was saved for " << fileName << std::endl;
+    success = false;
+  }
+  // Again, with the saved index
+  success &= ReadRegionsAndCompare(image.GetPointer(), fileName);
+  return success;
+}
+} // namespace
+
+int
+itkNiftiCompressedRegionReadTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  using ScalarImageType = itk::Image<short, 3>;
+  using VectorImageType = itk::Image<itk::Vector<float, 2>, 3>;
+
+  bool success = true;
+  ITK_TRY_EXPECT_NO_EXCEPTION(
+    success &= WriteAndReadRegions<ScalarImageType>(directory + "/NiftiCompressedRegionRead.nii.gz"));
+  ITK_TRY_EXPECT_NO_EXCEPTION(
+    success &= WriteAndReadRegions<VectorImageType>(directory + "/NiftiCompressedRegionReadVector.nii.gz"));
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -20,7 +20,8 @@
 #include "ITKIONRRDExport.h"
 
 
-#include "itkImageIOBase.h"
+#include "itkStreamingImageIOBase.h"
+#include "itkGzipSeekIndex.h"
 #include <fstream>
 
 struct NrrdEncoding_t;
@@ -85,17 +86,23 @@ using AxesReorderEnum = NrrdImageIOEnums::AxesReorder;
  * requires NRRD0004; and so on.  No explicit version switch is
  * required on the ITK side.
  *
+ * Regions smaller than the image are read without loading the whole
+ * volume when the data is in a single file with the "raw" or "gzip"
+ * encoding and the pixel components are on the fastest axis. Raw data is
+ * read with seeks, and gzip data through a GzipSeekIndex, which is built
+ * on the first streamed read and saved beside the data file.
+ *
  *  \ingroup IOFilters
  * \ingroup ITKIONRRD
  */
-class ITKIONRRD_EXPORT NrrdImageIO : public ImageIOBase
+class ITKIONRRD_EXPORT NrrdImageIO : public StreamingImageIOBase
 {
 public:
   ITK_DISALLOW_COPY_AND_MOVE(NrrdImageIO);
 
   /** Standard class type aliases. */
   using Self = NrrdImageIO;
-  using Superclass = ImageIOBase;
+  using Superclass = StreamingImageIOBase;
   using Pointer = SmartPointer<Self>;
 
   /** Method for creation through the object factory. */
@@ -125,6 +132,23 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Returns true when the file last passed to ReadImageInformation()
+   * supports streamed reading, see the class documentation. */
+  bool
+  CanStreamRead() override;
+
+  /** Returns true for raw encoded data that can be read streamed, in the
+   * byte order of this machine. */
+  bool
+  GetMemoryMappablePixelData(std::string & fileName, SizeValueType & offset) override;
+
+  /** Streamed writing is not supported. */
+  bool
+  CanStreamWrite() override
+  {
+    return false;
+  }
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
@@ -212,6 +236,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the settings of this ImageIO too. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalSetCompressor(const std::string & _compressor) override;
 
@@ -223,9 +251,30 @@ protected:
   IOComponentEnum
   NrrdToITKComponentType(const int) const;
 
+  /** Returns the offset of the data in the data file, or in the
+   * uncompressed stream for gzip encoded data. */
+  SizeType
+  GetHeaderSize() const override;
+
   const NrrdEncoding_t * m_NrrdCompressionEncoding{ nullptr };
 
   AxesReorderEnum m_AxesReorder{ AxesReorderEnum::UseAnyRangeAxisAsPixel };
+
+private:
+  /** Reads the IORegion through seeks in the data file. */
+  void
+  StreamRead(void * buffer);
+
+  /** Location of the data, found by ReadImageInformation() */
+  bool          m_StreamableRead{ false };
+  bool          m_GzipEncoded{ false };
+  std::string   m_DataFileName{};
+  SizeType      m_DataPosition{ 0 };
+  SizeType      m_CompressedDataPosition{ 0 };
+  bool          m_DataAtEnd{ false };
+  SizeValueType m_BytesAfterData{ 0 };
+
+  GzipSeekIndex::Pointer m_GzipSeekIndex{};
 };
 } // end namespace itk
 
@@ -19,6 +19,7 @@
 #include "itkNrrdImageIO.h"
 #include "NrrdIO.h"
 
+#include "itkByteSwapper.h"
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
 #include "itkFloatingPointExceptions.h"
@@ -368,12 +369,34 @@ NrrdImageIO::SupportsDimension(unsigned long dim)
   return dim <= NRRD_DIM_MAX - 1;
 }
 
+LightObject::Pointer
+NrrdImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_AxesReorder = m_AxesReorder;
+  return loPtr;
+}
+
 void
 NrrdImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
 
   os << indent << "NrrdCompressionEncoding: " << m_NrrdCompressionEncoding << std::endl;
+  os << indent << "StreamableRead: " << (m_StreamableRead ? "On" : "Off") << std::endl;
+  os << indent << "GzipEncoded: " << (m_GzipEncoded ? "On" : "Off") << std::endl;
+  os << indent << "DataFileName: " << m_DataFileName << std::endl;
+  os << indent << "DataPosition: " << m_DataPosition << std::endl;
+  os << indent << "CompressedDataPosition: " << m_CompressedDataPosition << std::endl;
+  os << indent << "DataAtEnd: " << (m_DataAtEnd ? "On" : "Off") << std::endl;
+  os << indent << "BytesAfterData: " << m_BytesAfterData << std::endl;
+  itkPrintSelfObjectMacro(GzipSeekIndex);
 }
 
 void
@@ -595,6 +618,9 @@ NrrdImageIO::ReadImageInformation()
     // this is the mechanism by which we tell nrrdLoad to read
     // just the header, and none of the data
     nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+    // and to leave the data file open at the data, to locate it for
+    // streamed reading
+    nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
     if (nrrdLoad(nrrd, this->GetFileName(), nio) != 0)
     {
       char * err = biffGetDone(NRRD);
@@ -1054,12 +1080,55 @@ NrrdImageIO::ReadImageInformation()
       EncapsulateMetaData<std::vector<std::vector<double>>>(thisDic, key, msrFrame);
     }
 
+    // Streamed reading requires the data of the image region to be in
+    // the file order, in a single raw or gzip file
+    m_StreamableRead = false;
+    m_GzipSeekIndex = nullptr;
+    const long dataFilePosition = nio->dataFile ? ftell(nio->dataFile) : -1;
+    if (dataFilePosition >= 0 && !nio->dataFNFormat && nrrdIoDataFNNumber(nio) == 1 && !needPermutation &&
+        this->GetPixelType() != IOPixelEnum::SYMMETRICSECONDRANKTENSOR &&
+        (nio->encoding == nrrdEncodingRaw || (nio->encoding == nrrdEncodingGzip && nio->dataFSkipArr->len == 0)))
+    {
+      if (nio->dataFNArr->len == 0)
+      {
+        m_DataFileName = this->GetFileName();
+      }
+      else
+      {
+        // Relative to the header, as in nrrdLoad()
+        const char * dataFileName = nio->dataFN[0];
+        m_DataFileName = (dataFileName[0] != '/' && dataFileName[1] != ':' && airStrlen(nio->path))
+                           ? std::string(nio->path) + '/' + dataFileName
+                           : std::string(dataFileName);
+      }
+      m_GzipEncoded = (nio->encoding == nrrdEncodingGzip);
+      if (m_GzipEncoded)
+      {
+        // The byte skip applies to the uncompressed data, a negative one
+        // giving the number of bytes after the data
+        m_CompressedDataPosition = static_cast<SizeType>(dataFilePosition);
+        m_DataAtEnd = nio->byteSkip < 0;
+        m_DataPosition = m_DataAtEnd ? 0 : static_cast<SizeType>(nio->byteSkip);
+        m_BytesAfterData = m_DataAtEnd ? static_cast<SizeValueType>(-nio->byteSkip - 1) : 0;
+      }
+      else
+      {
+        m_CompressedDataPosition = 0;
+        m_DataAtEnd = false;
+        m_DataPosition = static_cast<SizeType>(dataFilePosition);
+        m_BytesAfterData = 0;
+      }
+      m_StreamableRead = true;
+    }
+
+    nio->dataFile = airFclose(nio->dataFile);
     nrrd = nrrdNix(nrrd);
     nio = nrrdIoStateNix(nio);
   }
   catch (...)
   {
     // clean up from an exception
+    nio->dataFile = airFclose(nio->dataFile);
     nrrd = nrrdNix(nrrd);
     nio = nrrdIoStateNix(nio);
 
@@ -1068,9 +1137,111 @@ NrrdImageIO::ReadImageInformation()
   }
 }
 
+bool
+NrrdImageIO::CanStreamRead()
+{
+  return m_StreamableRead;
+}
+
+bool
+NrrdImageIO::GetMemoryMappablePixelData(std::string & fileName, SizeValueType & offset)
+{
+  const IOByteOrderEnum systemByteOrder =
+    ByteSwapper<uint16_t>::SystemIsBigEndian() ? IOByteOrderEnum::BigEndian : IOByteOrderEnum::LittleEndian;
+  if (!m_StreamableRead || m_GzipEncoded || (this->GetComponentSize() > 1 && this->GetByteOrder() != systemByteOrder))
+  {
+    return false;
+  }
+
+  fileName = m_DataFileName;
+  offset = m_DataPosition;
+  return true;
+}
+
+NrrdImageIO::SizeType
+NrrdImageIO::GetHeaderSize() const
+{
+  return m_DataPosition;
+}
+
+namespace
+{
+template <typename T>
+void
+SwapRangeFromFileByteOrder(IOByteOrderEnum byteOrder, void * buffer, SizeValueType numberOfComponents)
+{
+  if (byteOrder == IOByteOrderEnum::BigEndian)
+  {
+    ByteSwapper<T>::SwapRangeFromSystemToBigEndian(static_cast<T *>(buffer), numberOfComponents);
+  }
+  else if (byteOrder == IOByteOrderEnum::LittleEndian)
+  {
+    ByteSwapper<T>::SwapRangeFromSystemToLittleEndian(static_cast<T *>(buffer), numberOfComponents);
+  }
+}
+} // namespace
+
+void
+NrrdImageIO::StreamRead(void * buffer)
+{
+  if (m_GzipEncoded)
+  {
+    // The index is kept for the next regions of the same file
+    if (m_GzipSeekIndex.IsNull())
+    {
+      auto index = GzipSeekIndex::New();
+      index->SetFileName(m_DataFileName);
+      index->SetCompressedDataOffset(m_CompressedDataPosition);
+      index->Update();
+      m_GzipSeekIndex = index;
+    }
+    if (m_DataAtEnd)
+    {
+      const SizeType dataSize = this->GetImageSizeInBytes();
+      if (m_GzipSeekIndex->GetUncompressedSize() < dataSize + m_BytesAfterData)
+      {
+        itkExceptionMacro("Read: Not enough data in " << m_DataFileName);
+      }
+      m_DataPosition = m_GzipSeekIndex->GetUncompressedSize() - dataSize - m_BytesAfterData;
+    }
+    const std::unique_ptr<std::istream> stream = m_GzipSeekIndex->MakeInputStream();
+    this->StreamReadBufferAsBinary(*stream, buffer);
+  }
+  else
+  {
+    std::ifstream file;
+    this->OpenFileForReading(file, m_DataFileName);
+    this->StreamReadBufferAsBinary(file, buffer);
+  }
+
+  const SizeValueType numberOfComponents = this->GetIORegion().GetNumberOfPixels() * this->GetNumberOfComponents();
+  switch (this->GetComponentSize())
+  {
+    case 1:
+      break;
+    case 2:
+      SwapRangeFromFileByteOrder<uint16_t>(this->GetByteOrder(), buffer, numberOfComponents);
+      break;
+    case 4:
+      SwapRangeFromFileByteOrder<uint32_t>(this->GetByteOrder(), buffer, numberOfComponents);
+      break;
+    case 8:
+      SwapRangeFromFileByteOrder<uint64_t>(this->GetByteOrder(), buffer, numberOfComponents);
+      break;
+    default:
+      itkExceptionMacro("Read: Unknown component size " << this->GetComponentSize());
+  }
+}
+
 void
 NrrdImageIO::Read(void * buffer)
 {
+  if (this->CanStreamRead() && this->RequestedToStream())
+  {
+    this->StreamRead(buffer);
+    return;
+  }
+
   Nrrd * nrrd = nrrdNew();
   bool   nrrdAllocated;
 
@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkByteSwapper.h"
+#include "itkGzipSeekIndex.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNrrdImageIO.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+#include <string>
+
+// Reads regions of raw and gzip encoded NRRD files, and checks that only
+// the requested regions are read.
+
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+Value(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>((index[0] * 3 + index[1] * 50 + index[2] * 1500) % 30000 - 15000);
+}
+
+bool
+ReadRegions(const std::string & fileName)
+{
+  auto io = itk::NrrdImageIO::New();
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(io);
+  reader->UpdateOutputInformation();
+  if (!io->CanStreamRead())
+  {
+    std::cerr << "Cannot stream read " << fileName << std::endl;
+    return false;
+  }
+
+  // Regions read backward in the file, then the whole image
+  const ImageType::RegionType regions[] = { ImageType::RegionType({ { 5, 11, 14 } }, { { 30, 7, 5 } }),
+                                            ImageType::RegionType({ { 0, 0, 3 } }, { { 40, 30, 1 } }),
+                                            ImageType::RegionType({ { 39, 29, 0 } }, { { 1, 1, 1 } }),
+                                            reader->GetOutput()->GetLargestPossibleRegion() };
+  for (const auto & region : regions)
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Update();
+    const ImageType * image = reader->GetOutput();
+    if (image->GetBufferedRegion() != region)
+    {
+      std::cerr << "Read " << image->GetBufferedRegion() << " instead of " << region << " from " << fileName
+                << std::endl;
+      return false;
+    }
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != Value(it.GetIndex()))
+      {
+        std::cerr << "Wrong value " << it.Get() << " at " << it.GetIndex() << " in " << fileName << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkNrrdImageIOStreamingReadTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 40, 30, 20 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(Value(it.GetIndex()));
+  }
+
+  bool success = true;
+
+  // Attached and detached headers, raw and gzip encoded
+  for (const std::string extension : { ".nrrd", ".nhdr" })
+  {
+    for (const bool compress : { false, true })
+    {
+      const std::string fileName =
+        directory + "/NrrdImageIOStreamingRead" + (compress ? "Gzip" : "Raw") + extension;
+      ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, fileName, compress));
+      const std::string dataFileName = extension == ".nrrd"
+                                         ? fileName
+                                         : directory + "/NrrdImageIOStreamingRead" + (compress ? "Gzip" : "Raw") +
+                                             (compress ? ".raw.gz" : ".raw");
+      itksys::SystemTools::RemoveFile(itk::GzipSeekIndex::GetIndexFileName(dataFileName));
+
+      ITK_TRY_EXPECT_NO_EXCEPTION(success &= ReadRegions(fileName));
+
+      if (compress && !itksys::SystemTools::FileExists(itk::GzipSeekIndex::GetIndexFileName(dataFileName)))
+      {
+        std::cerr << "No index was saved for " << dataFileName << std::endl;
+        success = false;
+      }
+      // Again, with the saved index
+      ITK_TRY_EXPECT_NO_EXCEPTION(success &= ReadRegions(fileName));
+    }
+  }
+
+  // Big endian data at the end of a separate file
+  {
+    const std::string dataFileName = directory + "/NrrdImageIOStreamingReadBigEndian.raw";
+    std::ofstream     data(dataFileName, std::ios::binary);
+    data << "Some bytes before the data";
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      PixelType value = it.Get();
+      itk::ByteSwapper<PixelType>::SwapFromSystemToBigEndian(&value);
+      data.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+    data.close();
+
+    const std::string fileName = directory + "/NrrdImageIOStreamingReadBigEndian.nhdr";
+    std::ofstream     header(fileName);
+    header << "NRRD0004\n"
+           << "type: short\n"
+           << "dimension: 3\n"
+           << "sizes: 40 30 20\n"
+           << "encoding: raw\n"
+           << "endian: big\n"
+           << "byte skip: -1\n"
+           << "data file: NrrdImageIOStreamingReadBigEndian.raw\n";
+    header.close();
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(success &= ReadRegions(fileName));
+  }
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -122,6 +122,10 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Returns true for binary files in the byte order of this machine. */
+  bool
+  GetMemoryMappablePixelData(std::string & fileName, SizeValueType & offset) override;
+
   /** Set/Get the Data mask. */
   /** @ITKStartGrouping */
   itkGetConstReferenceMacro(ImageMask, unsigned short);
@@ -164,6 +168,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the settings of this ImageIO too. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   // void ComputeInternalFileName(unsigned long slice);
 
 private:
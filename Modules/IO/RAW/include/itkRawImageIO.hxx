@@ -19,6 +19,7 @@
 #define itkRawImageIO_hxx
 
 #include "itkIntTypes.h"
+#include "itkByteSwapper.h"
 
 
 namespace itk
@@ -65,6 +66,24 @@ RawImageIO<TPixel, VImageDimension>::RawImageIO()
   m_FileType = IOFileEnum::Binary;
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+LightObject::Pointer
+RawImageIO<TPixel, VImageDimension>::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_FileDimensionality = m_FileDimensionality;
+  rval->m_ManualHeaderSize = m_ManualHeaderSize;
+  rval->m_HeaderSize = m_HeaderSize;
+  rval->m_ImageMask = m_ImageMask;
+  return loPtr;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void
 RawImageIO<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
@@ -160,6 +179,23 @@ RawImageIO<TPixel, VImageDimension>::Read(void * buffer)
   ReadRawBytesAfterSwapping(componentType, buffer, m_ByteOrder, numberOfComponents);
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+bool
+RawImageIO<TPixel, VImageDimension>::GetMemoryMappablePixelData(std::string & fileName, SizeValueType & offset)
+{
+  const IOByteOrderEnum systemByteOrder =
+    ByteSwapper<uint16_t>::SystemIsBigEndian() ? IOByteOrderEnum::BigEndian : IOByteOrderEnum::LittleEndian;
+  if (m_FileType != IOFileEnum::Binary || (this->GetComponentSize() > 1 && m_ByteOrder != systemByteOrder))
+  {
+    return false;
+  }
+
+  this->ComputeStrides();
+  fileName = m_FileName;
+  offset = this->GetHeaderSize();
+  return true;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 bool
 RawImageIO<TPixel, VImageDimension>::CanWriteFile(const char * fname)
@@ -62,6 +62,12 @@ namespace itk
  * Once the PDF's have been constructed, the mutual information
  * is obtained by double summing over the discrete PDF values.
  *
+ * For transforms without local support, the derivatives of the joint PDF
+ * with respect to the transform parameters are stored by default. Their
+ * memory grows with the number of parameters, see
+ * SetUseExplicitPDFDerivatives() for a method that is better suited to
+ * transforms with many parameters, such as BSplineTransform.
+ *
  * \warning Local-support transforms are not yet supported. If used,
  * an exception is thrown during Initialize().
  *
@@ -147,6 +153,33 @@ public:
   itkGetConstReferenceMacro(NumberOfHistogramBins, SizeValueType);
   /** @ITKEndGrouping */
 
+  /** Select the method used to compute the derivatives with respect to the
+   * parameters of transforms without local support. Transforms with local
+   * support, such as displacement fields, are not affected.
+   *
+   * UseExplicitPDFDerivatives = True (the default) computes the derivatives
+   * of each bin of the joint PDF with respect to each parameter, and then
+   * weights them by a bin-specific factor. The derivatives are stored in an
+   * array of (number of histogram bins)^2 times the number of parameters,
+   * and each thread buffers its contributions in an array of the number of
+   * parameters times a few hundred. This is well suited to transforms with a
+   * small number of parameters.
+   *
+   * UseExplicitPDFDerivatives = False processes the samples twice. The first
+   * pass computes the joint PDF and the weights of its bins, and the second
+   * pass multiplies the derivative of the Parzen window of each sample by
+   * these weights and accumulates the contributions to the parameters in a
+   * derivative array per thread. Only the parameters in the support of the
+   * sample are visited when the moving transform is a cubic
+   * BSplineBaseTransform. The memory needed is the number of parameters
+   * per thread, which is well suited to transforms with a large number of
+   * parameters, such as BSplineTransform. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseExplicitPDFDerivatives, bool);
+  itkGetConstReferenceMacro(UseExplicitPDFDerivatives, bool);
+  itkBooleanMacro(UseExplicitPDFDerivatives);
+  /** @ITKEndGrouping */
+
   void
   Initialize() override;
 
@@ -213,6 +246,19 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Run the threaded processing a second time to compute the derivatives,
+   * when they are computed without the explicit PDF derivatives. */
+  void
+  GetValueAndDerivativeExecute() const override;
+
+  /** Whether the derivatives are computed in a second pass over the samples,
+   * see SetUseExplicitPDFDerivatives(). */
+  [[nodiscard]] bool
+  ComputesImplicitPDFDerivatives() const
+  {
+    return this->GetComputeDerivative() && !this->HasLocalSupport() && !this->m_UseExplicitPDFDerivatives;
+  }
+
   using JointPDFIndexType = typename JointPDFType::IndexType;
   using JointPDFValueType = typename JointPDFType::PixelType;
   using JointPDFRegionType = typename JointPDFType::RegionType;
@@ -359,6 +405,13 @@ protected:
    * For local-support transforms only. */
   mutable std::vector<DerivativeType> m_LocalDerivativeByParzenBin{};
 
+  /** The derivative accumulated by each thread in the second pass, when
+   * the explicit PDF derivatives are not used. */
+  std::vector<DerivativeType> m_ThreaderDerivatives{};
+
+  bool         m_UseExplicitPDFDerivatives{ true };
+  mutable bool m_ImplicitDerivativesSecondPass{ false };
+
 private:
   /** Perform the final step in computing results */
   virtual void
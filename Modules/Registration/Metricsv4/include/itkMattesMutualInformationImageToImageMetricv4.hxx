@@ -338,7 +338,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) && this->m_UseExplicitPDFDerivatives)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
@@ -445,7 +445,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
 
           if (this->GetComputeDerivative())
           {
-            if (!this->HasLocalSupport())
+            if (!this->HasLocalSupport() && this->m_UseExplicitPDFDerivatives)
             {
               // Collect global derivative contributions
               const JointPDFValueType * derivPtr = this->m_JointPDFDerivatives->GetBufferPointer() +
@@ -463,7 +463,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
             else
             {
               // Collect the pRatio per pdf indices.
-              // Will be applied subsequently to local-support derivative
+              // Will be applied subsequently to local-support derivative,
+              // or in the second pass over the samples
               const OffsetValueType index = movingIndex + (fixedIndex * this->m_NumberOfHistogramBins);
               this->m_PRatioArray[index] = pRatio * nFactor;
             }
@@ -555,6 +556,34 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(UseExplicitPDFDerivatives);
+}
+
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::GetValueAndDerivativeExecute() const
+{
+  // The first pass computes the joint PDF, the value, and the pRatio of the bins
+  this->m_ImplicitDerivativesSecondPass = false;
+  Superclass::GetValueAndDerivativeExecute();
+
+  if (this->ComputesImplicitPDFDerivatives())
+  {
+    // The second pass accumulates the derivative, with the same samples
+    this->m_ImplicitDerivativesSecondPass = true;
+    Superclass::GetValueAndDerivativeExecute();
+    this->m_ImplicitDerivativesSecondPass = false;
+  }
 }
 
 template <typename TFixedImage,
@@ -19,6 +19,7 @@
 #define itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_h
 
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreader.h"
+#include "itkBSplineBaseTransform.h"
 
 #include <mutex>
 
@@ -86,6 +87,12 @@ public:
 
   using JacobianType = typename TMattesMutualInformationMetric::JacobianType;
 
+  /** Cubic BSpline transforms, whose Jacobian is only evaluated over the
+   * support of each sample when the explicit PDF derivatives are not used. */
+  using BSplineTransformType = BSplineBaseTransform<typename MovingTransformType::ParametersValueType,
+                                                    TMattesMutualInformationMetric::MovingImageDimension,
+                                                    3>;
+
 protected:
   MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader()
     : m_MattesAssociate(nullptr)
@@ -120,10 +127,24 @@ protected:
                                              const PDFValueType &            cubicBSplineDerivativeValue,
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
+  /** Accumulate the derivative contribution of a sample in the second pass,
+   * when the explicit PDF derivatives are not used. The derivatives of the
+   * Parzen window of the four affected bins are weighted by the pRatio of
+   * the bins, starting at \c pRatioPtr. */
+  virtual void
+  ComputeImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                const MovingImageGradientType & movingImageGradient,
+                                const PDFValueType &            movingImageParzenWindowArg,
+                                const PDFValueType *            pRatioPtr,
+                                const ThreadIdType              threadId) const;
+
 private:
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
   TMattesMutualInformationMetric * m_MattesAssociate{};
+
+  /** The moving transform, when it is a cubic BSpline transform. */
+  const BSplineTransformType * m_BSplineMovingTransform{};
 };
 
 } // end namespace itk
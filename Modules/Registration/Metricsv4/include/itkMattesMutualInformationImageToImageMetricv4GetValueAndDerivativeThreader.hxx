@@ -44,6 +44,21 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     itkExceptionStringMacro("Dynamic casting of associate pointer failed.");
   }
 
+  if (this->m_MattesAssociate->m_ImplicitDerivativesSecondPass)
+  {
+    // The joint PDF and the pRatio of the first pass are kept, only the
+    // derivatives accumulated by the threads are reset.
+    this->m_MattesAssociate->m_ThreaderDerivatives.resize(this->GetNumberOfWorkUnitsUsed());
+    for (auto & threaderDerivative : this->m_MattesAssociate->m_ThreaderDerivatives)
+    {
+      threaderDerivative.SetSize(this->GetCachedNumberOfLocalParameters());
+      threaderDerivative.Fill(DerivativeValueType{});
+    }
+    this->m_BSplineMovingTransform =
+      dynamic_cast<const BSplineTransformType *>(this->m_MattesAssociate->m_MovingTransform.GetPointer());
+    return;
+  }
+
   /* Porting: these next blocks of code are from MattesMutualImageToImageMetric::Initialize */
 
   /*
@@ -157,7 +172,22 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       this->m_MattesAssociate->m_LocalDerivativeByParzenBin[n].Fill(DerivativeValueType{});
     }
   }
-  if (this->m_MattesAssociate->GetComputeDerivative() && !this->m_MattesAssociate->HasLocalSupport())
+  if (this->m_MattesAssociate->ComputesImplicitPDFDerivatives())
+  {
+    // Only the pRatio of the bins is needed, the derivatives are
+    // accumulated in a second pass over the samples.
+    this->m_MattesAssociate->m_PRatioArray.assign(
+      this->m_MattesAssociate->m_NumberOfHistogramBins * this->m_MattesAssociate->m_NumberOfHistogramBins, 0.0);
+    this->m_MattesAssociate->m_JointPdfIndex1DArray.clear();
+    this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
+    this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
+  }
+  else
+  {
+    this->m_MattesAssociate->m_ThreaderDerivatives.clear();
+  }
+  if (this->m_MattesAssociate->GetComputeDerivative() && !this->m_MattesAssociate->HasLocalSupport() &&
+      this->m_MattesAssociate->m_UseExplicitPDFDerivatives)
   {
     // Don't need this with global transforms
     this->m_MattesAssociate->m_PRatioArray.clear();
@@ -229,7 +259,9 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
                                                 DerivativeType &,
                                                 const ThreadIdType threadId) const
 {
-  const bool doComputeDerivative = this->m_MattesAssociate->GetComputeDerivative();
+  // With implicit PDF derivatives, the first pass only computes the joint PDF
+  const bool doComputeDerivative =
+    this->m_MattesAssociate->GetComputeDerivative() && !this->m_MattesAssociate->ComputesImplicitPDFDerivatives();
   /**
    * Compute this sample's contribution to the marginal
    *   and joint distributions.
@@ -269,6 +301,20 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   const OffsetValueType fixedImageParzenWindowIndex =
     this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
 
+  if (this->m_MattesAssociate->m_ImplicitDerivativesSecondPass)
+  {
+    const PDFValueType * pRatioPtr = this->m_MattesAssociate->m_PRatioArray.data() +
+                                     (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins) +
+                                     pdfMovingIndex;
+    this->ComputeImplicitPDFDerivatives(virtualPoint,
+                                        movingImageGradient,
+                                        static_cast<PDFValueType>(pdfMovingIndex) - movingImageParzenWindowTerm,
+                                        pRatioPtr,
+                                        threadId);
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+    return false;
+  }
+
   // Since a zero-order BSpline (box car) kernel is used for
   // the fixed image marginal pdf, we need only increment the
   // fixedImageParzenWindowIndex by value of 1.0.
@@ -410,6 +456,71 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomain
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                         TImageToImageMetric,
+                                                                         TMattesMutualInformationMetric>::
+  ComputeImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                const MovingImageGradientType & movingImageGradient,
+                                const PDFValueType &            movingImageParzenWindowArg,
+                                const PDFValueType *            pRatioPtr,
+                                const ThreadIdType              threadId) const
+{
+  // The derivatives of the cubic Parzen window at the four affected bins,
+  // weighted by the pRatio of the bins, reduce to a single weight for
+  // the sample.
+  PDFValueType sampleWeight = 0.0;
+  for (unsigned int bin = 0; bin < 4; ++bin)
+  {
+    sampleWeight += pRatioPtr[bin] * CubicBSplineDerivativeFunctionType::FastEvaluate(
+                                       movingImageParzenWindowArg + static_cast<PDFValueType>(bin));
+  }
+  if (sampleWeight == 0.0)
+  {
+    return;
+  }
+
+  DerivativeValueType * const derivative = this->m_MattesAssociate->m_ThreaderDerivatives[threadId].data_block();
+  if (this->m_BSplineMovingTransform != nullptr)
+  {
+    // The Jacobian is only nonzero for the coefficients in the support of
+    // the point, with the same weight along each dimension.
+    typename BSplineTransformType::WeightsType             weights;
+    typename BSplineTransformType::ParameterIndexArrayType indices;
+    this->m_BSplineMovingTransform->ComputeJacobianFromBSplineWeightsWithRespectToPosition(
+      virtualPoint, weights, indices);
+    const NumberOfParametersType parametersPerDimension =
+      this->m_BSplineMovingTransform->GetNumberOfParametersPerDimension();
+    for (unsigned int dim = 0; dim < BSplineTransformType::SpaceDimension; ++dim)
+    {
+      const PDFValueType    weightedGradient = sampleWeight * movingImageGradient[dim];
+      DerivativeValueType * dimensionDerivative = derivative + dim * parametersPerDimension;
+      for (unsigned int mu = 0; mu < BSplineTransformType::NumberOfWeights; ++mu)
+      {
+        dimensionDerivative[indices[mu]] += weightedGradient * weights[mu];
+      }
+    }
+  }
+  else
+  {
+    JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+    JacobianType & jacobianPositional =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+    this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+      virtualPoint, jacobian, jacobianPositional);
+    for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement; ++mu)
+    {
+      PDFValueType innerProduct = 0.0;
+      for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+      {
+        innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+      }
+      derivative[mu] += sampleWeight * innerProduct;
+    }
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 void
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -417,6 +528,28 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   TImageToImageMetric,
   TMattesMutualInformationMetric>::AfterThreadedExecution()
 {
+  if (this->m_MattesAssociate->m_ImplicitDerivativesSecondPass)
+  {
+    // Sum the derivatives of the threads into the result, with the
+    // parameters split across the threads.
+    const std::vector<DerivativeType> & threaderDerivatives = this->m_MattesAssociate->m_ThreaderDerivatives;
+    DerivativeType &                    derivativeResult = *(this->m_MattesAssociate->m_DerivativeResult);
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      this->GetCachedNumberOfLocalParameters(),
+      [&threaderDerivatives, &derivativeResult](SizeValueType parameter) {
+        DerivativeValueType sum{};
+        for (const DerivativeType & threaderDerivative : threaderDerivatives)
+        {
+          sum += threaderDerivative[parameter];
+        }
+        // The pRatio includes the normalization, see ComputeResults()
+        derivativeResult[parameter] -= sum;
+      },
+      nullptr);
+    return;
+  }
+
   const ThreadIdType localNumberOfWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
   /* Store the number of valid points in the enclosing class
    * m_NumberOfValidPoints by collecting the valid points per thread.
@@ -433,7 +566,8 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   /* Post-processing that is common the GetValue and GetValueAndDerivative */
   this->m_MattesAssociate->GetValueCommonAfterThreadedExecution();
 
-  if (this->m_MattesAssociate->GetComputeDerivative() && (!this->m_MattesAssociate->HasLocalSupport()))
+  if (this->m_MattesAssociate->GetComputeDerivative() && (!this->m_MattesAssociate->HasLocalSupport()) &&
+      this->m_MattesAssociate->m_UseExplicitPDFDerivatives)
   {
     // This entire block of code is used to accumulate the per-thread buffers
     // into 1 thread.
@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/**
+ * Compares the value and the derivative computed with and without the
+ * explicit PDF derivatives, for a transform whose Jacobian is evaluated
+ * densely (AffineTransform) and for a transform whose Jacobian is only
+ * evaluated over the support of each sample (BSplineTransform), with
+ * dense and sparse sampling.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+ImageType::Pointer
+MakeImage(const double shift)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 48, 40 } });
+  image->SetSpacing(itk::MakeVector(1.5, 2.0));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 24.0 + shift;
+    const double y = it.GetIndex()[1] - 20.0 - 0.5 * shift;
+    it.Set(200.0 * std::exp(-(x * x + 2.0 * y * y) / 300.0) + 30.0 * std::sin(0.2 * x));
+  }
+  return image;
+}
+
+bool
+CompareExplicitAndImplicitDerivatives(MetricType::MovingTransformType * transform,
+                                      const bool                        useSampling,
+                                      const char *                      description)
+{
+  const auto fixedImage = MakeImage(0.0);
+  const auto movingImage = MakeImage(3.0);
+
+  MetricType::MeasureType    values[2];
+  MetricType::DerivativeType derivatives[2];
+  for (const bool useExplicitPDFDerivatives : { true, false })
+  {
+    auto metric = MetricType::New();
+    metric->SetFixedImage(fixedImage);
+    metric->SetMovingImage(movingImage);
+    metric->SetMovingTransform(transform);
+    metric->SetNumberOfHistogramBins(32);
+    metric->SetUseExplicitPDFDerivatives(useExplicitPDFDerivatives);
+    if (useSampling)
+    {
+      auto         pointSet = MetricType::FixedSampledPointSetType::New();
+      unsigned int count = 0;
+      for (itk::ImageRegionIteratorWithIndex<ImageType> it(fixedImage, fixedImage->GetBufferedRegion()); !it.IsAtEnd();
+           ++it)
+      {
+        if (count % 3 == 0)
+        {
+          MetricType::FixedSampledPointSetType::PointType point;
+          fixedImage->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+          pointSet->SetPoint(count / 3, point);
+        }
+        ++count;
+      }
+      metric->SetFixedSampledPointSet(pointSet);
+      metric->SetUseSampledPointSet(true);
+    }
+    metric->Initialize();
+
+    const int i = useExplicitPDFDerivatives ? 0 : 1;
+    metric->GetValueAndDerivative(values[i], derivatives[i]);
+
+    // The value alone is computed in a single pass
+    if (itk::Math::NotAlmostEquals(metric->GetValue(), values[i]))
+    {
+      std::cerr << "GetValue() " << metric->GetValue() << " differs from GetValueAndDerivative() " << values[i]
+                << " for " << description << std::endl;
+      return false;
+    }
+  }
+
+  if (std::abs(values[0] - values[1]) > 1e-12 * std::abs(values[0]))
+  {
+    std::cerr << "The values " << values[0] << " and " << values[1] << " differ for " << description << std::endl;
+    return false;
+  }
+  double maximumDerivative = 0.0;
+  for (const auto derivative : derivatives[0])
+  {
+    maximumDerivative = std::max(maximumDerivative, std::abs(derivative));
+  }
+  if (maximumDerivative == 0.0)
+  {
+    std::cerr << "The derivative is zero for " << description << std::endl;
+    return false;
+  }
+  for (unsigned int p = 0; p < derivatives[0].Size(); ++p)
+  {
+    if (std::abs(derivatives[0][p] - derivatives[1][p]) > 1e-9 * maximumDerivative)
+    {
+      std::cerr << "The derivatives " << derivatives[0][p] << " and " << derivatives[1][p] << " of parameter " << p
+                << " differ for " << description << std::endl;
+      return false;
+    }
+  }
+  std::cout << "Same values and derivatives for " << description << std::endl;
+  return true;
+}
+} // namespace
+
+
+int
+itkMattesMutualInformationImageToImageMetricv4ImplicitDerivativesTest(int, char *[])
+{
+  auto metric = MetricType::New();
+  ITK_TEST_SET_GET_BOOLEAN(metric, UseExplicitPDFDerivatives, false);
+  ITK_TEST_SET_GET_BOOLEAN(metric, UseExplicitPDFDerivatives, true);
+
+  const auto image = MakeImage(0.0);
+
+  auto affineTransform = itk::AffineTransform<double, Dimension>::New();
+  auto affineParameters = affineTransform->GetParameters();
+  affineParameters[0] = 1.02;
+  affineParameters[1] = 0.03;
+  affineParameters[4] = -1.5;
+  affineParameters[5] = 2.0;
+  affineTransform->SetParameters(affineParameters);
+
+  using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+  auto bsplineTransform = BSplineTransformType::New();
+  bsplineTransform->SetTransformDomainOrigin(image->GetOrigin());
+  bsplineTransform->SetTransformDomainDirection(image->GetDirection());
+  BSplineTransformType::PhysicalDimensionsType physicalDimensions;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    physicalDimensions[d] = image->GetSpacing()[d] * (image->GetLargestPossibleRegion().GetSize()[d] - 1);
+  }
+  bsplineTransform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  bsplineTransform->SetTransformDomainMeshSize(BSplineTransformType::MeshSizeType::Filled(5));
+  auto bsplineParameters = bsplineTransform->GetParameters();
+  for (unsigned int p = 0; p < bsplineParameters.Size(); ++p)
+  {
+    bsplineParameters[p] = 2.0 * std::sin(0.7 * p);
+  }
+  bsplineTransform->SetParameters(bsplineParameters);
+
+  bool success = true;
+  for (const bool useSampling : { false, true })
+  {
+    success &= CompareExplicitAndImplicitDerivatives(
+      affineTransform, useSampling, useSampling ? "an affine transform with sampling" : "an affine transform");
+    success &= CompareExplicitAndImplicitDerivatives(
+      bsplineTransform, useSampling, useSampling ? "a BSpline transform with sampling" : "a BSpline transform");
+  }
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -39,6 +39,11 @@ namespace itk
  * For example, char's default accumulation type is short,
  * but int might be preferred for montages with large overlaps of input tiles.
  *
+ * The filter supports streaming, e.g. with StreamingImageFilter or the
+ * NumberOfStreamDivisions of ImageFileWriter. Of each input tile, only the part
+ * which maps into the output's requested region (padded by the radius of the
+ * interpolator) is requested from the upstream pipeline or read from the file.
+ *
  * \author Dženan Zukić, dzenan.zukic@kitware.com
  *
  * \ingroup Montage
@@ -190,6 +195,10 @@ protected:
   void
   GenerateOutputInformation() override;
 
+  /** Requests from each input tile only the part needed for the output's requested region. */
+  void
+  GenerateInputRequestedRegion() override;
+
   using Superclass::MakeOutput;
 
   /** Make a DataObject of the correct type to be used as the specified output. */
@@ -204,6 +213,11 @@ protected:
   ImageConstPointer
   GetImage(TileIndexType nDIndex, RegionType wantedRegion);
 
+  /** The part of the tile with the given largest possible region which is needed
+   * to resample the output's requested region. It is empty if the tile does not contribute. */
+  RegionType
+  RequestedTileRegion(SizeValueType linearIndex, const RegionType & tileLargest);
+
   /** A set of linear indices of input tiles which contribute to this region. */
   using ContributingTiles = std::set<SizeValueType>;
 
@@ -232,6 +246,7 @@ protected:
 private:
   bool      m_CropToFill = false;       // crop to avoid background filling?
   PixelType m_Background = PixelType(); // default background value (not covered by any input tile)
+  SizeType  m_InterpolationRadius;      // pixels around a continuous index accessed by the interpolator
 
   std::vector<TransformConstPointer> m_Transforms;
   std::vector<ImagePointer>         m_Tiles; // metadata/image storage (if filenames are given instead of actual images)
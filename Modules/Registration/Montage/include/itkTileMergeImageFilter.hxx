@@ -33,6 +33,7 @@ template <typename TImageType, typename TPixelAccumulateType, typename TInterpol
 TileMergeImageFilter<TImageType, TPixelAccumulateType, TInterpolator>::TileMergeImageFilter()
 {
   this->SetMontageSize(this->m_MontageSize); // initialize the rest of arrays
+  m_InterpolationRadius = TInterpolator::New()->GetRadius();
 
   // required for GenerateOutputInformation to be called
   this->SetNthOutput(0, this->MakeOutput(0).GetPointer());
@@ -45,6 +46,7 @@ TileMergeImageFilter<TImageType, TPixelAccumulateType, TInterpolator>::PrintSelf
   Superclass::PrintSelf(os, indent);
   os << indent << "CropToFill: " << (m_CropToFill ? "Yes" : "No") << std::endl;
   os << indent << "Background: " << m_Background << std::endl;
+  os << indent << "InterpolationRadius: " << m_InterpolationRadius << std::endl;
   os << indent << "RegionsSize: " << m_Regions.size() << std::endl;
 
   auto nullCount = std::count(m_Transforms.begin(), m_Transforms.end(), nullptr);
@@ -228,30 +230,82 @@ TileMergeImageFilter<TImageType, TPixelAccumulateType, TInterpolator>::DistanceF
 }
 
 
+template <typename TImageType, typename TPixelAccumulateType, typename TInterpolator>
+auto
+TileMergeImageFilter<TImageType, TPixelAccumulateType, TInterpolator>::RequestedTileRegion(
+  SizeValueType      linearIndex,
+  const RegionType & tileLargest) -> RegionType
+{
+  RegionType region = m_InputMappings[linearIndex];
+  if (!region.Crop(this->GetOutput()->GetRequestedRegion()))
+  {
+    RegionType reg0;
+    reg0.SetIndex(tileLargest.GetIndex());
+    return reg0; // this tile does not contribute to the requested region
+  }
+
+  // map from output's index space into tile's index space
+  region.SetIndex(region.GetIndex() + (tileLargest.GetIndex() - m_InputMappings[linearIndex].GetIndex()));
+  // tile positions are rounded in ConstructRegion, so interpolation can reach a bit further
+  region.PadByRadius(m_InterpolationRadius);
+  region.Crop(tileLargest);
+  return region;
+}
+
 template <typename TImageType, typename TPixelAccumulateType, typename TInterpolator>
 typename TImageType::ConstPointer
 TileMergeImageFilter<TImageType, TPixelAccumulateType, TInterpolator>::GetImage(TileIndexType nDIndex,
                                                                                 RegionType    wantedRegion)
 {
-  SizeValueType linearIndex = this->nDIndexToLinearIndex(nDIndex);
-
-  ImagePointer                outputImage = this->GetOutput();
-  RegionType                  reqR = outputImage->GetRequestedRegion();
+  SizeValueType               linearIndex = this->nDIndexToLinearIndex(nDIndex);
   std::lock_guard<std::mutex> lockGuard(this->m_TileReadLocks[linearIndex]);
+  bool                        onlyMetadata = (wantedRegion.GetNumberOfPixels() == 0);
   if (m_Tiles[linearIndex].IsNotNull())
   {
-    RegionType r = m_Tiles[linearIndex]->GetBufferedRegion();
-    if (r.Crop(reqR) && r.IsInside(wantedRegion))
+    if (onlyMetadata || m_Tiles[linearIndex]->GetBufferedRegion().IsInside(wantedRegion))
     {
       return m_Tiles[linearIndex];
     }
   }
+  else if (!onlyMetadata) // we need the largest possible region to determine the region to read
+  {
+    RegionType reg0;
+    m_Tiles[linearIndex] = Superclass::template GetImageHelper<ImageType>(nDIndex, true, reg0);
+  }
 
-  bool onlyMetadata = (wantedRegion.GetNumberOfPixels() == 0);
-  m_Tiles[linearIndex] = Superclass::template GetImageHelper<ImageType>(nDIndex, onlyMetadata, reqR);
+  RegionType regionToRead = wantedRegion;
+  if (!onlyMetadata)
+  {
+    // read everything the output's requested region needs from this tile at once
+    regionToRead = this->RequestedTileRegion(linearIndex, m_Tiles[linearIndex]->GetLargestPossibleRegion());
+    if (!regionToRead.IsInside(wantedRegion))
+    {
+      regionToRead = wantedRegion;
+    }
+  }
+  m_Tiles[linearIndex] = Superclass::template GetImageHelper<ImageType>(nDIndex, onlyMetadata, regionToRead);
   return m_Tiles[linearIndex];
 }
 
+template <typename TImageType, typename TPixelAccumulateType, typename TInterpolator>
+void
+TileMergeImageFilter<TImageType, TPixelAccumulateType, TInterpolator>::GenerateInputRequestedRegion()
+{
+  for (SizeValueType i = 0; i < this->m_LinearMontageSize; i++)
+  {
+    DataObject * input = this->GetInput(i);
+    if (input == nullptr || std::equal_to<const void *>{}(input, this->m_Dummy.GetPointer()))
+    {
+      continue; // this tile is read from a file
+    }
+    auto * image = dynamic_cast<ImageBase<ImageDimension> *>(input);
+    if (image != nullptr)
+    {
+      image->SetRequestedRegion(this->RequestedTileRegion(i, image->GetLargestPossibleRegion()));
+    }
+  }
+}
+
 template <typename TImageType, typename TPixelAccumulateType, typename TInterpolator>
 void
 TileMergeImageFilter<TImageType, TPixelAccumulateType, TInterpolator>::GenerateOutputInformation()
@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <deque>
+#include <list>
 #include <mutex>
 #include <vector>
 
@@ -42,6 +43,12 @@ namespace itk
  *
  * Take a look a documentation of parameters, most influential of which is PositionTolerance.
  *
+ * The tiles are registered in the order of their linear index, so the registrations
+ * sweep the mosaic along its last dimension. A tile and its FFT are released as soon as
+ * the registrations with all its neighbors are done, which keeps only about one row
+ * (2D) or one slice (3D) of tiles in memory. FFTCacheSize further bounds the number of
+ * FFTs kept in memory when CropToOverlap is off.
+ *
  * \author Dženan Zukić, dzenan.zukic@kitware.com
  *
  * \ingroup Montage
@@ -155,6 +162,14 @@ public:
   itkSetMacro(CropToOverlap, bool);
   itkGetConstMacro(CropToOverlap, bool);
 
+  /** Set/Get the maximum number of tile FFTs kept in memory.
+   * The FFTs are only cached when CropToOverlap is false. When the limit is
+   * reached, the least recently used FFT is evicted, and computed again if it
+   * is needed later. A limit smaller than the number of tiles along the first
+   * dimension causes such recomputations. Zero (the default) means no limit. */
+  itkSetMacro(FFTCacheSize, SizeValueType);
+  itkGetConstMacro(FFTCacheSize, SizeValueType);
+
   /** Set/Get obligatory padding.
    * If set, padding of this many pixels is added on both beginning and end
    * sides of each dimension of the image. Default value of 8 is usually fine. */
@@ -190,7 +205,7 @@ public:
   SetInputTile(SizeValueType linearIndex, ImageType * image)
   {
     this->SetNthInput(linearIndex, image);
-    m_FFTCache[linearIndex] = nullptr;
+    this->ReleaseFFT(linearIndex);
     m_Tiles[linearIndex] = nullptr;
   }
   void
@@ -285,10 +300,16 @@ protected:
   void
   RegisterPair(TileIndexType fixed, TileIndexType moving);
 
-  /** If possible, removes from memory tile with index smaller by 1 along all dimensions. */
+  /** Removes from memory the tiles whose registrations are all done
+   * once the registrations of finishedTile are done. */
   void
   ReleaseMemory(TileIndexType finishedTile);
 
+  /** The last tile, in registration order, which is registered to the given tile.
+   * It is the given tile itself if it is registered to no later tile. */
+  TileIndexType
+  LastDependentTile(TileIndexType tile) const;
+
   /** Accesses output, sets a transform to it, and updates progress. */
   void
   WriteOutTransform(TileIndexType index, TranslationOffset offset);
@@ -312,6 +333,15 @@ protected:
   void
   OptimizeTiles();
 
+  /** FFT cache accessors, to be called with m_MemberProtector locked.
+   * They maintain the least recently used order used for eviction. */
+  FFTConstPointer
+  GetCachedFFT(SizeValueType linearIndex);
+  void
+  CacheFFT(SizeValueType linearIndex, FFTConstPointer fft);
+  void
+  ReleaseFFT(SizeValueType linearIndex);
+
   std::deque<std::mutex> m_TileReadLocks; // to avoid reading the same tile by more than one thread in parallel
   // deque is not reallocated when resized, so no mutex moving causing a crash
 
@@ -328,6 +358,7 @@ private:
   float         m_RelativeThreshold = 3.0;
   SizeValueType m_PositionTolerance = 0;
   bool          m_CropToOverlap = true;
+  SizeValueType m_FFTCacheSize = 0;
   SizeType      m_ObligatoryPadding;
 
   std::mutex m_MemberProtector; // to prevent concurrent access to non-thread-safe internal member variables
@@ -336,6 +367,7 @@ private:
 
   std::vector<std::string>       m_Filenames;
   std::vector<FFTConstPointer>   m_FFTCache;
+  std::list<SizeValueType>       m_FFTCacheOrder; // linear indices of cached FFTs, most recently used first
   std::vector<ImagePointer>      m_Tiles; // metadata/image storage (if filenames are given instead of actual images)
   std::vector<OffsetVector>      m_TransformCandidates; // to adjacent tiles
   std::vector<ConfidencesType>   m_CandidateConfidences;
@@ -88,6 +88,7 @@ TileMontage<TImageType, TCoordinate>::PrintSelf(std::ostream & os, Indent indent
   nullCount = std::count(m_FFTCache.begin(), m_FFTCache.end(), nullptr);
   os << indent << "FFTCache (filled/capacity): " << m_FFTCache.size() - nullCount << "/" << m_FFTCache.size()
      << std::endl;
+  os << indent << "FFTCacheSize: " << m_FFTCacheSize << std::endl;
 
   os << indent << "MinInner: " << m_MinInner << std::endl;
   os << indent << "MaxInner: " << m_MaxInner << std::endl;
@@ -112,6 +113,7 @@ TileMontage<TImageType, TCoordinate>::SetMontageSize(SizeType montageSize)
     m_TileReadLocks.resize(m_LinearMontageSize);
     m_Filenames.resize(m_LinearMontageSize);
     m_FFTCache.resize(m_LinearMontageSize);
+    m_FFTCacheOrder.clear();
     m_Tiles.resize(m_LinearMontageSize);
     m_CurrentAdjustments.resize(m_LinearMontageSize);
     m_TileReliabilities.resize(m_LinearMontageSize);
@@ -134,7 +136,9 @@ TileMontage<TImageType, TCoordinate>::GetImageHelper(TileIndexType nDIndex, bool
   {
     // construct new metadata so adjustments do not modify the original input
     result = TImageToRead::New();
-    result->SetRegions(input->GetBufferedRegion());
+    result->SetLargestPossibleRegion(input->GetLargestPossibleRegion()); // input might be streamed
+    result->SetBufferedRegion(input->GetBufferedRegion());
+    result->SetRequestedRegion(input->GetBufferedRegion());
     result->SetOrigin(input->GetOrigin());
     result->SetSpacing(input->GetSpacing());
     result->SetDirection(input->GetDirection());
@@ -270,8 +274,8 @@ TileMontage<TImageType, TCoordinate>::RegisterPair(TileIndexType fixed, TileInde
   // scoping the lock
   {
     std::lock_guard<std::mutex> lock(m_MemberProtector);
-    m_PCM->SetFixedImageFFT(m_FFTCache[lFixedInd]);   // maybe null
-    m_PCM->SetMovingImageFFT(m_FFTCache[lMovingInd]); // maybe null
+    m_PCM->SetFixedImageFFT(this->GetCachedFFT(lFixedInd));   // maybe null
+    m_PCM->SetMovingImageFFT(this->GetCachedFFT(lMovingInd)); // maybe null
   }
   // m_PCM->DebugOn();
   m_PCM->Update();
@@ -279,8 +283,8 @@ TileMontage<TImageType, TCoordinate>::RegisterPair(TileIndexType fixed, TileInde
   if (!m_CropToOverlap)
   {
     std::lock_guard<std::mutex> lock(m_MemberProtector);
-    m_FFTCache[lFixedInd] = m_PCM->GetFixedImageFFT();   // certainly not null
-    m_FFTCache[lMovingInd] = m_PCM->GetMovingImageFFT(); // certrainly not null
+    this->CacheFFT(lFixedInd, m_PCM->GetFixedImageFFT());   // certainly not null
+    this->CacheFFT(lMovingInd, m_PCM->GetMovingImageFFT()); // certrainly not null
   }
 
   const typename PCMType::OffsetVector & offsets = m_PCM->GetOffsets();
@@ -317,41 +321,99 @@ TileMontage<TImageType, TCoordinate>::RegisterPair(TileIndexType fixed, TileInde
   }
 }
 
+template <typename TImageType, typename TCoordinate>
+auto
+TileMontage<TImageType, TCoordinate>::LastDependentTile(TileIndexType tile) const -> TileIndexType
+{
+  // tile + 1 along the slowest dimension which has a next tile is registered last
+  for (int d = ImageDimension - 1; d >= 0; d--)
+  {
+    if (tile[d] + 1 < m_MontageSize[d])
+    {
+      ++tile[d];
+      break;
+    }
+  }
+  return tile;
+}
+
 template <typename TImageType, typename TCoordinate>
 void
 TileMontage<TImageType, TCoordinate>::ReleaseMemory(TileIndexType finishedTile)
 {
-  TileIndexType oldIndex;
-  bool          releaseTile = true;
+  // the tiles registered last to finishedTile are itself and its predecessors along each dimension
+  std::vector<TileIndexType> candidates(1, finishedTile);
   for (unsigned dim = 0; dim < ImageDimension; dim++)
   {
     if (finishedTile[dim] > 0)
     {
-      oldIndex[dim] = finishedTile[dim] - 1;
-    }
-    else
-    {
-      releaseTile = false;
+      TileIndexType oldIndex = finishedTile;
+      --oldIndex[dim];
+      candidates.push_back(oldIndex);
     }
   }
-  if (releaseTile)
+
+  RegionType                  reg0;
+  std::lock_guard<std::mutex> lock(m_MemberProtector);
+  for (const TileIndexType & oldIndex : candidates)
   {
-    SizeValueType               linearIndex = this->nDIndexToLinearIndex(oldIndex);
-    std::lock_guard<std::mutex> lock(m_MemberProtector);
-    m_FFTCache[linearIndex] = nullptr;
+    if (this->LastDependentTile(oldIndex) != finishedTile)
+    {
+      continue; // a later tile still needs to be registered to this one
+    }
+    SizeValueType linearIndex = this->nDIndexToLinearIndex(oldIndex);
+    this->ReleaseFFT(linearIndex);
     if (!m_Filenames[linearIndex].empty()) // release the input image too
     {
       this->SetInputTile(oldIndex, m_Dummy);
     }
     if (m_Tiles[linearIndex])
     {
-      RegionType reg0;
       m_Tiles[linearIndex]->SetBufferedRegion(reg0);
       m_Tiles[linearIndex]->Allocate(false);
     }
   }
 }
 
+template <typename TImageType, typename TCoordinate>
+auto
+TileMontage<TImageType, TCoordinate>::GetCachedFFT(SizeValueType linearIndex) -> FFTConstPointer
+{
+  if (m_FFTCache[linearIndex].IsNotNull())
+  {
+    // move to the front of the least recently used order
+    auto it = std::find(m_FFTCacheOrder.begin(), m_FFTCacheOrder.end(), linearIndex);
+    m_FFTCacheOrder.splice(m_FFTCacheOrder.begin(), m_FFTCacheOrder, it);
+  }
+  return m_FFTCache[linearIndex];
+}
+
+template <typename TImageType, typename TCoordinate>
+void
+TileMontage<TImageType, TCoordinate>::CacheFFT(SizeValueType linearIndex, FFTConstPointer fft)
+{
+  this->ReleaseFFT(linearIndex);
+  m_FFTCache[linearIndex] = fft;
+  m_FFTCacheOrder.push_front(linearIndex);
+  while (m_FFTCacheSize > 0 && m_FFTCacheOrder.size() > m_FFTCacheSize)
+  {
+    // the registrations which still use the evicted FFT hold a reference to it
+    m_FFTCache[m_FFTCacheOrder.back()] = nullptr;
+    m_FFTCacheOrder.pop_back();
+  }
+}
+
+template <typename TImageType, typename TCoordinate>
+void
+TileMontage<TImageType, TCoordinate>::ReleaseFFT(SizeValueType linearIndex)
+{
+  if (m_FFTCache[linearIndex].IsNotNull())
+  {
+    m_FFTCache[linearIndex] = nullptr;
+    m_FFTCacheOrder.remove(linearIndex);
+  }
+}
+
 template <typename TImageType, typename TCoordinate>
 void
 TileMontage<TImageType, TCoordinate>::WriteOutTransform(TileIndexType index, TranslationOffset offset)
@@ -795,7 +857,7 @@ TileMontage<TImageType, TCoordinate>::GenerateData()
   {
     TileIndexType tileIndex = this->LinearIndexTonDIndex(i);
     WriteOutTransform(tileIndex, m_CurrentAdjustments[i]);
-    m_FFTCache[i] = nullptr;
+    this->ReleaseFFT(i);
     if (!m_Filenames[i].empty()) // release the input image too
     {
       this->SetInputTile(tileIndex, m_Dummy);
@@ -73,6 +73,8 @@ itkMontageGenericTests(int, char ** const)
   mtF->SetTileTransform(ind1, nullptr);
   mtF->SetTileTransform(ind2, nullptr);
   ITK_TEST_SET_GET_BOOLEAN(mtF, CropToFill, true);
+  tmD->SetFFTCacheSize(3);
+  ITK_TEST_SET_GET_VALUE(3, tmD->GetFFTCacheSize());
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkTileMergeImageFilter.h"
+#include "itkTileMontage.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Registers and merges a synthetic 3x3 montage, cut with known shifts from a
+// random image, and checks that bounding the FFT cache does not change the
+// registration, and that streaming the merge, of tiles in memory or in files,
+// does not change the mosaic.
+int
+itkMontageStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  constexpr unsigned Dimension = 2;
+  using PixelType = unsigned short;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using MontageType = itk::TileMontage<ImageType>;
+  using MergerType = itk::TileMergeImageFilter<ImageType>;
+  using TileIndexType = MontageType::TileIndexType;
+  using OffsetType = MontageType::TransformType::OutputVectorType;
+
+  constexpr unsigned           tileSize = 80;
+  constexpr unsigned           stageStep = 64;
+  constexpr int                maxShift = 3;
+  constexpr unsigned           montageSize = 3;
+  constexpr itk::SizeValueType linearMontageSize = montageSize * montageSize;
+
+  // The scene: gaussian blobs of random sizes and brightness, plus noise which
+  // sharpens the phase correlation peaks.
+  constexpr unsigned sceneSize = (montageSize - 1) * stageStep + tileSize + 2 * maxShift;
+  auto               scene = ImageType::New();
+  scene->SetRegions(ImageType::RegionType(ImageType::SizeType{ { sceneSize, sceneSize } }));
+  scene->Allocate(true);
+
+  std::mt19937                     randomEngine(42);
+  std::uniform_real_distribution<> position(0.0, sceneSize);
+  std::uniform_real_distribution<> sigma(2.0, 6.0);
+  std::uniform_real_distribution<> amplitude(100.0, 1000.0);
+  std::vector<double>              sceneValues(sceneSize * sceneSize, 0.0);
+  for (unsigned blob = 0; blob < 400; ++blob)
+  {
+    const double x0 = position(randomEngine);
+    const double y0 = position(randomEngine);
+    const double s = sigma(randomEngine);
+    const double a = amplitude(randomEngine);
+    for (unsigned y = 0; y < sceneSize; ++y)
+    {
+      for (unsigned x = 0; x < sceneSize; ++x)
+      {
+        const double r2 = (x - x0) * (x - x0) + (y - y0) * (y - y0);
+        sceneValues[y * sceneSize + x] += a * std::exp(-r2 / (2 * s * s));
+      }
+    }
+  }
+  std::uniform_real_distribution<> noise(0.0, 500.0);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(scene, scene->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double value = sceneValues[it.GetIndex()[1] * sceneSize + it.GetIndex()[0]] + noise(randomEngine);
+    it.Set(static_cast<PixelType>(std::min(value, 65535.0)));
+  }
+
+  // Each tile is placed at its stage position, but its pixels are taken at a
+  // random shift from it, which the registration has to find.
+  std::uniform_int_distribution<> shift(-maxShift, maxShift);
+  std::vector<ImageType::Pointer> tiles(linearMontageSize);
+  std::vector<OffsetType>         shifts(linearMontageSize);
+  std::vector<std::string>        tileFilenames(linearMontageSize);
+  for (itk::SizeValueType t = 0; t < linearMontageSize; ++t)
+  {
+    const TileIndexType  tileIndex{ { t % montageSize, t / montageSize } };
+    ImageType::IndexType start;
+    ImageType::PointType origin;
+    for (unsigned d = 0; d < Dimension; ++d)
+    {
+      const int tileShift = (t == 0) ? 0 : shift(randomEngine);
+      shifts[t][d] = tileShift;
+      origin[d] = tileIndex[d] * stageStep;
+      start[d] = tileIndex[d] * stageStep + maxShift + tileShift;
+    }
+
+    tiles[t] = ImageType::New();
+    tiles[t]->SetRegions(ImageType::RegionType(ImageType::SizeType{ { tileSize, tileSize } }));
+    tiles[t]->SetOrigin(origin);
+    tiles[t]->Allocate();
+    const ImageType::RegionType              sceneRegion(start, tiles[t]->GetBufferedRegion().GetSize());
+    itk::ImageRegionConstIterator<ImageType> sceneIt(scene, sceneRegion);
+    for (itk::ImageRegionIterator<ImageType> it(tiles[t], tiles[t]->GetBufferedRegion()); !it.IsAtEnd();
+         ++it, ++sceneIt)
+    {
+      it.Set(sceneIt.Get());
+    }
+
+    // MetaImage files can be read by parts.
+    tileFilenames[t] = outputDirectory + "/itkMontageStreamingTestTile" + std::to_string(t) + ".mha";
+    ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(tiles[t], tileFilenames[t]));
+  }
+
+  const auto registerTiles = [&](itk::SizeValueType fftCacheSize) {
+    auto montage = MontageType::New();
+    montage->SetMontageSize({ montageSize, montageSize });
+    montage->SetCropToOverlap(false); // FFTs are only cached without cropping
+    montage->SetFFTCacheSize(fftCacheSize);
+    for (itk::SizeValueType t = 0; t < linearMontageSize; ++t)
+    {
+      montage->SetInputTile(t, tiles[t]);
+    }
+    montage->Update();
+    return montage;
+  };
+
+  MontageType::Pointer unboundedMontage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(unboundedMontage = registerTiles(0));
+  // Smaller than a row of tiles, so FFTs are evicted and computed again.
+  MontageType::Pointer boundedMontage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(boundedMontage = registerTiles(1));
+
+  int testStatus = EXIT_SUCCESS;
+  for (itk::SizeValueType t = 0; t < linearMontageSize; ++t)
+  {
+    const TileIndexType tileIndex{ { t % montageSize, t / montageSize } };
+    const OffsetType    unboundedOffset = unboundedMontage->GetOutputTransform(tileIndex)->GetOffset();
+    const OffsetType    boundedOffset = boundedMontage->GetOutputTransform(tileIndex)->GetOffset();
+    std::cout << "Tile " << tileIndex << ": shift " << shifts[t] << ", offset " << unboundedOffset << std::endl;
+    ITK_TEST_EXPECT_EQUAL_STATUS_VALUE(boundedOffset, unboundedOffset, testStatus);
+    for (unsigned d = 0; d < Dimension; ++d)
+    {
+      ITK_TEST_EXPECT_TRUE_STATUS_VALUE(std::abs(unboundedOffset[d] + shifts[t][d]) <= 1.0, testStatus);
+    }
+  }
+
+  const auto makeMerger = [&](bool tilesFromFiles) {
+    auto merger = MergerType::New();
+    merger->SetMontageSize({ montageSize, montageSize });
+    for (itk::SizeValueType t = 0; t < linearMontageSize; ++t)
+    {
+      const TileIndexType tileIndex{ { t % montageSize, t / montageSize } };
+      if (tilesFromFiles)
+      {
+        merger->SetInputTile(tileIndex, tileFilenames[t]);
+      }
+      else
+      {
+        merger->SetInputTile(tileIndex, tiles[t]);
+      }
+      merger->SetTileTransform(tileIndex, unboundedMontage->GetOutputTransform(tileIndex));
+    }
+    return merger;
+  };
+
+  const auto merger = makeMerger(false);
+  ITK_TRY_EXPECT_NO_EXCEPTION(merger->Update());
+  const ImageType * const mosaic = merger->GetOutput();
+
+  using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+  for (const bool tilesFromFiles : { false, true })
+  {
+    for (const unsigned numberOfDivisions : { 2u, 3u, 7u })
+    {
+      const std::string description = std::string("Mosaic streamed with ") + std::to_string(numberOfDivisions) +
+                                      " divisions from tiles in " + (tilesFromFiles ? "files" : "memory");
+      const auto streamedMerger = makeMerger(tilesFromFiles);
+      auto       streamer = StreamerType::New();
+      streamer->SetInput(streamedMerger->GetOutput());
+      streamer->SetNumberOfStreamDivisions(numberOfDivisions);
+      ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+      const ImageType * const streamedMosaic = streamer->GetOutput();
+
+      ITK_TEST_EXPECT_EQUAL_STATUS_VALUE(streamedMosaic->GetOrigin(), mosaic->GetOrigin(), testStatus);
+      if (streamedMosaic->GetBufferedRegion() != mosaic->GetBufferedRegion())
+      {
+        std::cerr << description << " has buffered region " << streamedMosaic->GetBufferedRegion() << " instead of "
+                  << mosaic->GetBufferedRegion() << std::endl;
+        testStatus = EXIT_FAILURE;
+        continue;
+      }
+
+      itk::SizeValueType                       numberOfDifferences = 0;
+      itk::ImageRegionConstIterator<ImageType> streamedIt(streamedMosaic, mosaic->GetBufferedRegion());
+      for (itk::ImageRegionConstIterator<ImageType> it(mosaic, mosaic->GetBufferedRegion()); !it.IsAtEnd();
+           ++it, ++streamedIt)
+      {
+        numberOfDifferences += (it.Get() != streamedIt.Get());
+      }
+      if (numberOfDifferences > 0)
+      {
+        std::cerr << description << " differs from the unstreamed one in " << numberOfDifferences << " pixels"
+                  << std::endl;
+        testStatus = EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
@@ -199,7 +199,7 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::DynamicThr
         ++inLineIt;
       }
     }
-    this->m_LineMap[lineId] = thisLine;
+    this->m_LineMap[lineId] = std::move(thisLine);
     ++lineId;
   }
 
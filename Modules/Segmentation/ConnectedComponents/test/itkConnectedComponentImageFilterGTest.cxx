@@ -23,8 +23,12 @@ using itk::print_helper::operator<<;
 #include "itkGTest.h"
 #include "itkImage.h"
 #include "itkConnectedComponentImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 
 #include <bitset>
+#include <queue>
+#include <random>
 
 namespace
 {
@@ -50,6 +54,80 @@ CreateTestImageA()
 
   return image;
 }
+
+itk::Image<unsigned char, 3>::Pointer
+CreateRandomMask()
+{
+  using ImageType = itk::Image<unsigned char, 3>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(itk::MakeSize(37u, 29u, 23u)));
+  image->Allocate();
+
+  std::mt19937                        randomNumberEngine(1);
+  std::bernoulli_distribution         foregroundDistribution(0.3);
+  itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(foregroundDistribution(randomNumberEngine) ? 1 : 0);
+  }
+  return image;
+}
+
+// Labels the components with a flood fill, numbering them in the raster
+// order of their first pixel.
+itk::Image<unsigned int, 3>::Pointer
+FloodFillComponents(const itk::Image<unsigned char, 3> * mask, bool fullyConnected)
+{
+  using MaskImageType = itk::Image<unsigned char, 3>;
+  using LabelImageType = itk::Image<unsigned int, 3>;
+  using IndexType = LabelImageType::IndexType;
+  const auto region = mask->GetLargestPossibleRegion();
+
+  auto labels = LabelImageType::New();
+  labels->SetRegions(region);
+  labels->AllocateInitialized();
+
+  unsigned int                                          numberOfComponents = 0;
+  itk::ImageRegionConstIteratorWithIndex<MaskImageType> it(mask, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() == 0 || labels->GetPixel(it.GetIndex()) != 0)
+    {
+      continue;
+    }
+    ++numberOfComponents;
+    std::queue<IndexType> front;
+    front.push(it.GetIndex());
+    labels->SetPixel(it.GetIndex(), numberOfComponents);
+    while (!front.empty())
+    {
+      const IndexType index = front.front();
+      front.pop();
+      for (int dz = -1; dz <= 1; ++dz)
+      {
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+          for (int dx = -1; dx <= 1; ++dx)
+          {
+            const int distance = std::abs(dx) + std::abs(dy) + std::abs(dz);
+            if (distance == 0 || (!fullyConnected && distance > 1))
+            {
+              continue;
+            }
+            const IndexType neighbor{ { index[0] + dx, index[1] + dy, index[2] + dz } };
+            if (region.IsInside(neighbor) && mask->GetPixel(neighbor) != 0 && labels->GetPixel(neighbor) == 0)
+            {
+              labels->SetPixel(neighbor, numberOfComponents);
+              front.push(neighbor);
+            }
+          }
+        }
+      }
+    }
+  }
+  return labels;
+}
 } // namespace
 
 
@@ -84,3 +162,40 @@ TEST(ConnectedComponentImageFilter, Checkerboard3D)
   ++it;
   EXPECT_TRUE(it.IsAtEnd());
 }
+
+
+TEST(ConnectedComponentImageFilter, SameLabelsForAnyNumberOfWorkUnits)
+{
+  using MaskImageType = itk::Image<unsigned char, 3>;
+  using LabelImageType = itk::Image<unsigned int, 3>;
+
+  const auto mask = CreateRandomMask();
+
+  for (const bool fullyConnected : { false, true })
+  {
+    const auto expected = FloodFillComponents(mask, fullyConnected);
+
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 2, 5, 16 })
+    {
+      auto connected = itk::ConnectedComponentImageFilter<MaskImageType, LabelImageType>::New();
+      connected->SetInput(mask);
+      connected->SetFullyConnected(fullyConnected);
+      connected->SetNumberOfWorkUnits(numberOfWorkUnits);
+      connected->Update();
+
+      itk::ImageRegionConstIterator<LabelImageType> it(connected->GetOutput(),
+                                                       connected->GetOutput()->GetLargestPossibleRegion());
+      itk::ImageRegionConstIterator<LabelImageType> eit(expected, expected->GetLargestPossibleRegion());
+      unsigned int                                  numberOfComponents = 0;
+      unsigned int                                  numberOfDifferences = 0;
+      for (; !it.IsAtEnd(); ++it, ++eit)
+      {
+        numberOfComponents = std::max(numberOfComponents, eit.Get());
+        numberOfDifferences += (it.Get() != eit.Get());
+      }
+      EXPECT_EQ(numberOfDifferences, 0u) << "FullyConnected: " << fullyConnected
+                                        << ", NumberOfWorkUnits: " << numberOfWorkUnits;
+      EXPECT_EQ(connected->GetObjectCount(), numberOfComponents);
+    }
+  }
+}
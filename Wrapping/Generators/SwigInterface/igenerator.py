@@ -530,6 +530,7 @@ class SwigInputGenerator:
         r"itk::SmartPointer< *const +itk::Mesh.+ *>",
         r"itk::ObjectFactoryBasePrivate",
         r"itk::ThreadPoolGlobals",
+        r"itk::WorkStealingThreadPoolGlobals",
         r"itk::MultiThreaderBaseGlobals",
         ".+[(][*][)][(].+",  # functor functions
     ]